@@ -39,7 +39,6 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
-#include <string.h>
 #include "error.h"
 #include "adxl372.h"
 
@@ -54,22 +53,7 @@ int32_t adxl372_i2c_reg_read(struct adxl372_dev *dev,
 			     uint8_t reg_addr,
 			     uint8_t *reg_data)
 {
-	uint8_t data;
-	int32_t ret;
-
-	data = reg_addr;
-
-	ret = i2c_write(dev->i2c_desc, &data, 1, 0);
-	if (ret < 0)
-		return ret;
-
-	ret = i2c_read(dev->i2c_desc, &data, 1, 0);
-	if (ret < 0)
-		return ret;
-
-	*reg_data = data;
-
-	return ret;
+	return i2c_write_then_read(dev->i2c_desc, &reg_addr, 1, reg_data, 1);
 }
 
 /**
@@ -105,24 +89,6 @@ int32_t adxl372_i2c_reg_read_multiple(struct adxl372_dev *dev,
 				      uint8_t *reg_data,
 				      uint16_t count)
 {
-	uint8_t buf[512];
-	int32_t ret;
-
-	if (count > 512)
-		return FAILURE;
-
-	buf[0] = reg_addr;
-	memset(&buf[1], 0x00, count - 1);
-
-	ret = i2c_write(dev->i2c_desc, buf, 1, 0);
-	if (ret < 0)
-		return ret;
-
-	ret = i2c_read(dev->i2c_desc, buf, count, 0);
-	if (ret < 0)
-		return ret;
-
-	memcpy(reg_data, buf, count);
-
-	return ret;
+	return i2c_write_then_read(dev->i2c_desc, &reg_addr, 1, reg_data,
+				   count);
 }
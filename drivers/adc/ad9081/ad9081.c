@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include "error.h"
 #include "adi_cms_api_common.h"
@@ -851,23 +852,18 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 			       uint8_t *out_data, uint32_t size_bytes)
 {
 	struct ad9081_phy *phy = user_data;
-	uint8_t data[6];
 	uint16_t bytes_number;
 	int32_t ret;
-	int32_t i;
 
-	bytes_number = (size_bytes & 0xFF);
+	/* streaming bursts from the HAL are longer than one register */
+	bytes_number = (size_bytes & 0xFFFF);
 
-	for (i = 0; i < bytes_number; i++)
-		data[i] =  in_data[i];
+	memcpy(out_data, in_data, bytes_number);
 
-	ret = spi_write_and_read(phy->spi_desc, data, bytes_number);
+	ret = spi_write_and_read(phy->spi_desc, out_data, bytes_number);
 	if (ret != SUCCESS)
 		return FAILURE;
 
-	for (i = 0; i < bytes_number; i++)
-		out_data[i] =  data[i];
-
 	return SUCCESS;
 }
 
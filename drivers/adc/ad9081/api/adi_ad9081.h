@@ -31,6 +31,10 @@
 #define AD9081_JESD_SER_COUNT 8
 #define AD9081_JESD_DESER_COUNT 8
 
+#define AD9081_HAL_TXN_SIZE 64 /*!< Max pending register writes per transaction */
+#define AD9081_HAL_BURST_MAX 64 /*!< Max data bytes per streaming SPI write */
+#define AD9081_HAL_CACHE_SIZE 256 /*!< Number of shadow cache entries, power of 2 */
+
 /*!
  * @brief Enumerates Chip Output Resolution
  */
@@ -597,12 +601,36 @@ typedef struct {
 	uint8_t dev_rev; /*!< Device revision, 0:r0, 1:r1, 2:r1r, 3:r2 */
 } adi_ad9081_info_t;
 
+/*!
+ * @brief Bit-field Transaction Structure, pending direct space register writes
+ */
+typedef struct {
+	uint8_t depth; /*!< Nesting depth of open transactions */
+	uint8_t count; /*!< Number of pending register writes */
+	uint8_t addr_asc; /*!< 1 when device streams with ascending addresses */
+	uint16_t addr[AD9081_HAL_TXN_SIZE]; /*!< Pending register addresses */
+	uint8_t data[AD9081_HAL_TXN_SIZE]; /*!< Pending register values */
+	uint8_t mask[AD9081_HAL_TXN_SIZE]; /*!< Bits of data set by bit-fields */
+} adi_ad9081_hal_txn_t;
+
+/*!
+ * @brief Shadow Cache Structure, direct mapped copy of written/read registers
+ */
+typedef struct {
+	uint16_t addr[AD9081_HAL_CACHE_SIZE]; /*!< Cached register address */
+	uint8_t data[AD9081_HAL_CACHE_SIZE]; /*!< Cached register value */
+	uint8_t valid[AD9081_HAL_CACHE_SIZE]; /*!< 1 if entry holds a value */
+} adi_ad9081_hal_cache_t;
+
 /*!
  * @brief Device Structure
  */
 typedef struct {
 	adi_ad9081_hal_t hal_info;
 	adi_ad9081_info_t dev_info;
+	adi_ad9081_hal_txn_t txn; /*!< Bit-field write transaction state */
+	adi_ad9081_hal_cache_t
+		*cache; /*!< Optional shadow cache for read-modify-write, NULL to disable */
 } adi_ad9081_device_t;
 
 /*============= E X P O R T S ==============*/
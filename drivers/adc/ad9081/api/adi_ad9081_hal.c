@@ -16,6 +16,235 @@
 #include "adi_ad9081_hal.h"
 
 /*============= C O D E ====================*/
+static int32_t adi_ad9081_hal_spi_reg_get(adi_ad9081_device_t *device,
+					 uint32_t reg, uint8_t *data);
+static int32_t adi_ad9081_hal_spi_reg_set(adi_ad9081_device_t *device,
+					 uint32_t reg, uint32_t data);
+
+static void adi_ad9081_hal_cache_update(adi_ad9081_device_t *device,
+					uint16_t reg, uint8_t data)
+{
+	uint16_t idx = reg & (AD9081_HAL_CACHE_SIZE - 1);
+
+	if (device->cache == NULL)
+		return;
+	device->cache->addr[idx] = reg;
+	device->cache->data[idx] = data;
+	device->cache->valid[idx] = 1;
+}
+
+/* keep spi streaming direction and shadow cache coherent with a write */
+static void adi_ad9081_hal_reg_track(adi_ad9081_device_t *device,
+				     uint16_t reg, uint8_t data)
+{
+	uint16_t idx = reg & (AD9081_HAL_CACHE_SIZE - 1);
+
+	if (reg == REG_SPI_INTFCONFA_ADDR) {
+		if ((data & 0x81) != 0) { /* soft reset */
+			device->txn.addr_asc = 0;
+			adi_ad9081_hal_cache_invalidate(device);
+			return;
+		}
+		device->txn.addr_asc = ((data & 0x24) == 0x24) ? 1 : 0;
+	} else if ((reg >= REG_ADC_COARSE_PAGE_ADDR) &&
+		   (reg <= REG_PFILT_COEFF_PAGE_ADDR) && (device->cache != NULL)) {
+		/* paged registers alias each other, drop them on page change */
+		if ((device->cache->valid[idx] == 0) ||
+		    (device->cache->addr[idx] != reg) ||
+		    (device->cache->data[idx] != data))
+			adi_ad9081_hal_cache_invalidate(device);
+	}
+	adi_ad9081_hal_cache_update(device, reg, data);
+}
+
+static int32_t adi_ad9081_hal_cache_reg_get(adi_ad9081_device_t *device,
+					    uint16_t reg, uint8_t *data)
+{
+	int32_t err;
+	uint16_t idx = reg & (AD9081_HAL_CACHE_SIZE - 1);
+
+	if ((device->cache != NULL) && (device->cache->valid[idx] != 0) &&
+	    (device->cache->addr[idx] == reg)) {
+		*data = device->cache->data[idx];
+		return API_CMS_ERROR_OK;
+	}
+	err = adi_ad9081_hal_spi_reg_get(device, reg, data);
+	AD9081_ERROR_RETURN(err);
+	adi_ad9081_hal_cache_update(device, reg, *data);
+
+	return API_CMS_ERROR_OK;
+}
+
+/* write a run of consecutive direct space registers in one spi transfer */
+static int32_t adi_ad9081_hal_burst_set(adi_ad9081_device_t *device,
+					uint16_t reg, uint8_t *data,
+					uint8_t count)
+{
+	uint8_t in_data[AD9081_HAL_BURST_MAX + 2] = { 0 };
+	uint8_t out_data[AD9081_HAL_BURST_MAX + 2] = { 0 };
+	uint8_t i;
+
+	if (count == 1) {
+		if (API_CMS_ERROR_OK !=
+		    adi_ad9081_hal_spi_reg_set(device, reg, data[0]))
+			return API_CMS_ERROR_SPI_XFER;
+		adi_ad9081_hal_reg_track(device, reg, data[0]);
+		return API_CMS_ERROR_OK;
+	}
+
+	in_data[0] = (reg >> 8) & 0x3F;
+	in_data[1] = (reg >> 0) & 0xFF;
+	for (i = 0; i < count; i++)
+		in_data[i + 2] = data[i];
+	if (API_CMS_ERROR_OK !=
+	    device->hal_info.spi_xfer(device->hal_info.user_data, in_data,
+				      out_data, count + 2))
+		return API_CMS_ERROR_SPI_XFER;
+	for (i = 0; i < count; i++) {
+		if (API_CMS_ERROR_OK != AD9081_LOG_SPIW(reg + i, data[i]))
+			return API_CMS_ERROR_LOG_WRITE;
+		adi_ad9081_hal_reg_track(device, reg + i, data[i]);
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+/* resolve and send all pending writes in program order */
+static int32_t adi_ad9081_hal_txn_flush(adi_ad9081_device_t *device)
+{
+	int32_t err = API_CMS_ERROR_OK;
+	adi_ad9081_hal_txn_t *txn = &device->txn;
+	uint8_t i, j, run = 0, len = 0, count = txn->count, old;
+
+	/* clear first so the accessors below do not recurse into the flush */
+	txn->count = 0;
+	for (i = 0; i < count; i++) {
+		if (txn->mask[i] != 0xFF) {
+			/* an earlier pending write holds the current value, as
+			 * long as no page select was written in between */
+			for (j = i; j > 0; j--) {
+				if ((txn->addr[j - 1] == txn->addr[i]) ||
+				    ((txn->addr[j - 1] >= REG_ADC_COARSE_PAGE_ADDR) &&
+				     (txn->addr[j - 1] <= REG_PFILT_COEFF_PAGE_ADDR)))
+					break;
+			}
+			if ((j > 0) && (txn->addr[j - 1] == txn->addr[i])) {
+				old = txn->data[j - 1];
+			} else {
+				/* send what precedes the read, it may select a page */
+				if (len > 0) {
+					err = adi_ad9081_hal_burst_set(
+						device, txn->addr[run],
+						&txn->data[run], len);
+					if (err != API_CMS_ERROR_OK)
+						return err;
+					len = 0;
+				}
+				err = adi_ad9081_hal_cache_reg_get(
+					device, txn->addr[i], &old);
+				if (err != API_CMS_ERROR_OK)
+					return err;
+			}
+			txn->data[i] = (old & ~txn->mask[i]) |
+				       (txn->data[i] & txn->mask[i]);
+		}
+
+		if ((len > 0) && (txn->addr_asc != 0) &&
+		    (len < AD9081_HAL_BURST_MAX) &&
+		    (txn->addr[i] == txn->addr[run] + len) &&
+		    (txn->addr[run] > REG_SPI_INTFCONFB_ADDR)) {
+			len++;
+			continue;
+		}
+		if (len > 0) {
+			err = adi_ad9081_hal_burst_set(device, txn->addr[run],
+						       &txn->data[run], len);
+			if (err != API_CMS_ERROR_OK)
+				return err;
+		}
+		run = i;
+		len = 1;
+	}
+	if (len > 0)
+		err = adi_ad9081_hal_burst_set(device, txn->addr[run],
+					       &txn->data[run], len);
+
+	return err;
+}
+
+/* queue bits of a direct space register, merging with the previous write */
+static int32_t adi_ad9081_hal_txn_add(adi_ad9081_device_t *device,
+				      uint16_t reg, uint8_t data, uint8_t mask)
+{
+	int32_t err;
+	adi_ad9081_hal_txn_t *txn = &device->txn;
+
+	if ((txn->count > 0) && (txn->addr[txn->count - 1] == reg)) {
+		txn->data[txn->count - 1] &= ~mask;
+		txn->data[txn->count - 1] |= (data & mask);
+		txn->mask[txn->count - 1] |= mask;
+		return API_CMS_ERROR_OK;
+	}
+	if (txn->count == AD9081_HAL_TXN_SIZE) {
+		err = adi_ad9081_hal_txn_flush(device);
+		AD9081_ERROR_RETURN(err);
+	}
+	txn->addr[txn->count] = reg;
+	txn->data[txn->count] = data & mask;
+	txn->mask[txn->count] = mask;
+	txn->count++;
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_hal_bf_txn_begin(adi_ad9081_device_t *device)
+{
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_INVALID_PARAM_RETURN(device->txn.depth == 0xFF);
+
+	device->txn.depth++;
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_hal_bf_txn_commit(adi_ad9081_device_t *device)
+{
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_INVALID_PARAM_RETURN(device->txn.depth == 0);
+
+	device->txn.depth--;
+	if (device->txn.depth > 0)
+		return API_CMS_ERROR_OK;
+
+	return adi_ad9081_hal_txn_flush(device);
+}
+
+int32_t adi_ad9081_hal_cache_set(adi_ad9081_device_t *device,
+				 adi_ad9081_hal_cache_t *cache)
+{
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	err = adi_ad9081_hal_txn_flush(device);
+	AD9081_ERROR_RETURN(err);
+	device->cache = cache;
+
+	return adi_ad9081_hal_cache_invalidate(device);
+}
+
+int32_t adi_ad9081_hal_cache_invalidate(adi_ad9081_device_t *device)
+{
+	uint16_t i;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	if (device->cache == NULL)
+		return API_CMS_ERROR_OK;
+	for (i = 0; i < AD9081_HAL_CACHE_SIZE; i++)
+		device->cache->valid[i] = 0;
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_hal_hw_open(adi_ad9081_device_t *device)
 {
 	AD9081_NULL_POINTER_RETURN(device);
@@ -42,8 +271,13 @@ int32_t adi_ad9081_hal_hw_close(adi_ad9081_device_t *device)
 
 int32_t adi_ad9081_hal_delay_us(adi_ad9081_device_t *device, uint32_t us)
 {
+	int32_t err;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(device->hal_info.delay_us);
+
+	/* writes queued before a delay must reach the device first */
+	err = adi_ad9081_hal_txn_flush(device);
+	AD9081_ERROR_RETURN(err);
 	if (API_CMS_ERROR_OK !=
 	    device->hal_info.delay_us(device->hal_info.user_data, us)) {
 		return API_CMS_ERROR_DELAY_US;
@@ -62,6 +296,11 @@ int32_t adi_ad9081_hal_reset_pin_ctrl(adi_ad9081_device_t *device,
 		return API_CMS_ERROR_RESET_PIN_CTRL;
 	}
 
+	/* registers return to their defaults, spi streams descending again */
+	device->txn.count = 0;
+	device->txn.addr_asc = 0;
+	adi_ad9081_hal_cache_invalidate(device);
+
 	return API_CMS_ERROR_OK;
 }
 
@@ -162,7 +401,7 @@ int32_t adi_ad9081_hal_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 			      uint32_t info, uint64_t value)
 {
 	int32_t err;
-	uint8_t reg_offset = 0, data8 = 0;
+	uint8_t reg_offset = 0, data8 = 0, mask8 = 0;
 	uint8_t offset = (uint8_t)(info >> 0), width = (uint8_t)(info >> 8);
 	uint32_t data32 = 0, mask = 0;
 	uint8_t reg_bytes =
@@ -172,33 +411,26 @@ int32_t adi_ad9081_hal_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 	AD9081_INVALID_PARAM_RETURN(width < 1);
 
 	if (reg < 0x4000) {
+		/* queue the touched bits, read-modify-write happens on flush */
 		for (reg_offset = 0; reg_offset < reg_bytes; reg_offset++) {
 			if ((offset + width) <= 8) { /* last 8bits */
-				if ((offset > 0) || ((offset + width) < 8)) {
-					err = adi_ad9081_hal_reg_get(
-						device, reg + reg_offset,
-						&data8);
-					AD9081_ERROR_RETURN(err);
-				}
 				mask = (1 << width) - 1;
-				data8 = data8 & (~(mask << offset));
-				data8 = data8 | ((value & mask) << offset);
+				data8 = (uint8_t)((value & mask) << offset);
+				mask8 = (uint8_t)(mask << offset);
 			} else {
-				if (offset > 0) {
-					err = adi_ad9081_hal_reg_get(
-						device, reg + reg_offset,
-						&data8);
-					AD9081_ERROR_RETURN(err);
-				}
 				mask = (1 << (8 - offset)) - 1;
-				data8 = data8 & (~(mask << offset));
-				data8 = data8 | ((value & mask) << offset);
+				data8 = (uint8_t)((value & mask) << offset);
+				mask8 = (uint8_t)(mask << offset);
 				value = value >> (8 - offset);
 				width = offset + width - 8;
 				offset = 0;
 			}
-			err = adi_ad9081_hal_reg_set(device, reg + reg_offset,
-						     data8);
+			err = adi_ad9081_hal_txn_add(device, reg + reg_offset,
+						     data8, mask8);
+			AD9081_ERROR_RETURN(err);
+		}
+		if (device->txn.depth == 0) {
+			err = adi_ad9081_hal_txn_flush(device);
 			AD9081_ERROR_RETURN(err);
 		}
 	} else { /* access extended space */
@@ -236,8 +468,8 @@ int32_t adi_ad9081_hal_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 	return API_CMS_ERROR_OK;
 }
 
-int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
-			       uint8_t *data)
+static int32_t adi_ad9081_hal_spi_reg_get(adi_ad9081_device_t *device,
+					 uint32_t reg, uint8_t *data)
 {
 	uint8_t in_data[6] = { 0 }, out_data[6] = { 0 };
 	AD9081_NULL_POINTER_RETURN(device);
@@ -332,8 +564,8 @@ int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
 	return API_CMS_ERROR_OK;
 }
 
-int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
-			       uint32_t data)
+static int32_t adi_ad9081_hal_spi_reg_set(adi_ad9081_device_t *device,
+					 uint32_t reg, uint32_t data)
 {
 	uint8_t in_data[6] = { 0 }, out_data[6] = { 0 };
 	AD9081_NULL_POINTER_RETURN(device);
@@ -424,6 +656,39 @@ int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
 	return API_CMS_ERROR_OK;
 }
 
+int32_t adi_ad9081_hal_reg_get(adi_ad9081_device_t *device, uint32_t reg,
+			       uint8_t *data)
+{
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	/* reads must observe all earlier writes */
+	err = adi_ad9081_hal_txn_flush(device);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_spi_reg_get(device, reg, data);
+	AD9081_ERROR_RETURN(err);
+	if (reg < 0x4000)
+		adi_ad9081_hal_cache_update(device, reg, *data);
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_hal_reg_set(adi_ad9081_device_t *device, uint32_t reg,
+			       uint32_t data)
+{
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	err = adi_ad9081_hal_txn_flush(device);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_spi_reg_set(device, reg, data);
+	AD9081_ERROR_RETURN(err);
+	if (reg < 0x4000)
+		adi_ad9081_hal_reg_track(device, reg, (uint8_t)data);
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_hal_cbusjrx_reg_get(adi_ad9081_device_t *device,
 				       uint32_t reg, uint8_t *data,
 				       uint8_t lane)
@@ -998,10 +1263,8 @@ int32_t adi_ad9081_hal_multi_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 				    uint32_t *info, uint64_t *value,
 				    uint8_t num_bfs)
 {
-	int32_t err;
-	uint32_t mask = 0;
-	uint8_t data8 = 0, offset = 0, width = 0;
-	uint8_t i = 0, reg_bytes = 0, reg_read_reqd = 1;
+	int32_t err, ret = API_CMS_ERROR_OK;
+	uint8_t i = 0;
 	AD9081_NULL_POINTER_RETURN(device);
 	AD9081_NULL_POINTER_RETURN(info);
 	AD9081_NULL_POINTER_RETURN(value);
@@ -1012,38 +1275,18 @@ int32_t adi_ad9081_hal_multi_bf_set(adi_ad9081_device_t *device, uint32_t reg,
 		return adi_ad9081_hal_bf_set(device, reg, *info, *value);
 	}
 
-	/* Write the bit fields */
+	/* Write the bit fields, the transaction merges them into one write */
+	err = adi_ad9081_hal_bf_txn_begin(device);
+	AD9081_ERROR_RETURN(err);
 	for (i = 0; i < num_bfs; i++) {
-		offset = (uint8_t)(*(info + i) >> 0);
-		width = (uint8_t)(*(info + i) >> 8);
-		reg_bytes = ((width + offset) >> 3) +
-			    (((width + offset) & 7) == 0 ? 0 : 1);
-
-		if (reg_bytes == 1) {
-			if ((reg_read_reqd == 1) &&
-			    ((offset > 0) || ((offset + width) < 8))) {
-				reg_read_reqd = 0;
-				err = adi_ad9081_hal_reg_get(device, reg,
-							     &data8);
-				AD9081_ERROR_RETURN(err);
-			}
-			mask = (1 << width) - 1;
-			data8 = data8 & (~(mask << offset));
-			data8 = data8 | ((*(value + i) & mask) << offset);
-		} else {
-			/* Use non-multi bf set */
-			AD9081_LOG_WARN(
-				"multi bit-field set doesn't support cross register bit-fields. Using standard set. Adds");
-			err = adi_ad9081_hal_bf_set(device, reg, *(info + i),
-						    *(value + i));
-			AD9081_ERROR_RETURN(err);
-		}
-	}
-
-	if (reg_read_reqd == 0) {
-		err = adi_ad9081_hal_reg_set(device, reg, data8);
-		AD9081_ERROR_RETURN(err);
+		ret = adi_ad9081_hal_bf_set(device, reg, *(info + i),
+					    *(value + i));
+		if (ret != API_CMS_ERROR_OK)
+			break;
 	}
+	err = adi_ad9081_hal_bf_txn_commit(device);
+	AD9081_ERROR_RETURN(ret);
+	AD9081_ERROR_RETURN(err);
 
 	return API_CMS_ERROR_OK;
 }
@@ -34,6 +34,12 @@ int32_t adi_ad9081_hal_log_write(adi_ad9081_device_t *device,
 				 adi_cms_log_type_e type, const char *comment,
 				 ...);
 
+int32_t adi_ad9081_hal_bf_txn_begin(adi_ad9081_device_t *device);
+int32_t adi_ad9081_hal_bf_txn_commit(adi_ad9081_device_t *device);
+int32_t adi_ad9081_hal_cache_set(adi_ad9081_device_t *device,
+				 adi_ad9081_hal_cache_t *cache);
+int32_t adi_ad9081_hal_cache_invalidate(adi_ad9081_device_t *device);
+
 int32_t adi_ad9081_hal_bf_get(adi_ad9081_device_t *device, uint32_t reg,
 			      uint32_t info, uint8_t *value,
 			      uint8_t value_size_bytes);
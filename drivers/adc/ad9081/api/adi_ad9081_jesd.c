@@ -203,9 +203,10 @@ adi_ad9081_jesd_rx_syncb_driver_powerdown_set(adi_ad9081_device_t *device,
 	return API_CMS_ERROR_OK;
 }
 
-int32_t adi_ad9081_jesd_rx_link_config_set(adi_ad9081_device_t *device,
-					   adi_ad9081_jesd_link_select_e links,
-					   adi_cms_jesd_param_t *jesd_param)
+static int32_t
+adi_ad9081_jesd_rx_link_config_apply(adi_ad9081_device_t *device,
+				     adi_ad9081_jesd_link_select_e links,
+				     adi_cms_jesd_param_t *jesd_param)
 {
 	int32_t err;
 	uint8_t i, link, not_in_table;
@@ -356,6 +357,24 @@ int32_t adi_ad9081_jesd_rx_link_config_set(adi_ad9081_device_t *device,
 	return API_CMS_ERROR_OK;
 }
 
+int32_t adi_ad9081_jesd_rx_link_config_set(adi_ad9081_device_t *device,
+					   adi_ad9081_jesd_link_select_e links,
+					   adi_cms_jesd_param_t *jesd_param)
+{
+	int32_t err, ret;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	/* coalesce the link bit-fields into streaming register writes */
+	err = adi_ad9081_hal_bf_txn_begin(device);
+	AD9081_ERROR_RETURN(err);
+	ret = adi_ad9081_jesd_rx_link_config_apply(device, links, jesd_param);
+	err = adi_ad9081_hal_bf_txn_commit(device);
+	AD9081_ERROR_RETURN(ret);
+	AD9081_ERROR_RETURN(err);
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_jesd_rx_lmfc_delay_set(adi_ad9081_device_t *device,
 					  adi_ad9081_jesd_link_select_e links,
 					  uint16_t delay)
@@ -2098,9 +2117,10 @@ int32_t adi_ad9081_jesd_tx_link_conv_sel_set(
 	return API_CMS_ERROR_OK;
 }
 
-int32_t adi_ad9081_jesd_tx_link_config_set(adi_ad9081_device_t *device,
-					   adi_ad9081_jesd_link_select_e links,
-					   adi_cms_jesd_param_t *jesd_param)
+static int32_t
+adi_ad9081_jesd_tx_link_config_apply(adi_ad9081_device_t *device,
+				     adi_ad9081_jesd_link_select_e links,
+				     adi_cms_jesd_param_t *jesd_param)
 {
 	int32_t err;
 	uint8_t i, j, link;
@@ -2454,6 +2474,24 @@ int32_t adi_ad9081_jesd_tx_link_config_set(adi_ad9081_device_t *device,
 	return API_CMS_ERROR_OK;
 }
 
+int32_t adi_ad9081_jesd_tx_link_config_set(adi_ad9081_device_t *device,
+					   adi_ad9081_jesd_link_select_e links,
+					   adi_cms_jesd_param_t *jesd_param)
+{
+	int32_t err, ret;
+	AD9081_NULL_POINTER_RETURN(device);
+
+	/* coalesce the link bit-fields into streaming register writes */
+	err = adi_ad9081_hal_bf_txn_begin(device);
+	AD9081_ERROR_RETURN(err);
+	ret = adi_ad9081_jesd_tx_link_config_apply(device, links, jesd_param);
+	err = adi_ad9081_hal_bf_txn_commit(device);
+	AD9081_ERROR_RETURN(ret);
+	AD9081_ERROR_RETURN(err);
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_jesd_tx_link_reset(adi_ad9081_device_t *device,
 				      uint8_t reset)
 {
@@ -91,10 +91,10 @@ int32_t axi_adc_set_pnsel(struct axi_adc *adc,
 }
 
 /***************************************************************************//**
- * @brief axi_adc_pn_mon
+ * @brief axi_adc_pn_mon_enable
 *******************************************************************************/
-int32_t axi_adc_pn_mon(struct axi_adc *adc,
-		       enum axi_adc_pn_sel sel, uint32_t delay_ms)
+static void axi_adc_pn_mon_enable(struct axi_adc *adc,
+				  enum axi_adc_pn_sel sel)
 {
 	uint8_t	ch;
 	uint32_t reg_data;
@@ -105,12 +105,23 @@ int32_t axi_adc_pn_mon(struct axi_adc *adc,
 		axi_adc_write(adc, AXI_ADC_REG_CHAN_CNTRL(ch), reg_data);
 		axi_adc_set_pnsel(adc, ch, sel);
 	}
-	mdelay(1);
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_pn_mon_check
+*******************************************************************************/
+static int32_t axi_adc_pn_mon_check(struct axi_adc *adc,
+				    uint32_t dwell_us)
+{
+	uint8_t	ch;
+	uint32_t reg_data;
 
 	for (ch = 0; ch < adc->num_channels; ch++) {
 		axi_adc_write(adc, AXI_ADC_REG_CHAN_STATUS(ch), 0xff);
 	}
-	mdelay(delay_ms);
+	if (dwell_us >= 1000)
+		mdelay(dwell_us / 1000);
+	udelay(dwell_us % 1000);
 
 	for (ch = 0; ch < adc->num_channels; ch++) {
 		axi_adc_read(adc, AXI_ADC_REG_CHAN_STATUS(ch), &reg_data);
@@ -121,6 +132,18 @@ int32_t axi_adc_pn_mon(struct axi_adc *adc,
 	return SUCCESS;
 }
 
+/***************************************************************************//**
+ * @brief axi_adc_pn_mon
+*******************************************************************************/
+int32_t axi_adc_pn_mon(struct axi_adc *adc,
+		       enum axi_adc_pn_sel sel, uint32_t delay_ms)
+{
+	axi_adc_pn_mon_enable(adc, sel);
+	mdelay(1);
+
+	return axi_adc_pn_mon_check(adc, delay_ms * 1000);
+}
+
 /***************************************************************************//**
  * @brief axi_adc_get_sampling_freq
 *******************************************************************************/
@@ -182,86 +205,153 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 }
 
 /***************************************************************************//**
- * @brief axi_adc_delay_calibrate
+ * @brief axi_adc_delay_check
 *******************************************************************************/
-int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
-				uint32_t no_of_lanes,
-				enum axi_adc_pn_sel sel)
+static int32_t axi_adc_delay_check(struct axi_adc *adc,
+				   const struct axi_adc_delay_calib *calib)
 {
-	uint8_t err_field[32] = {0};
-	uint16_t valid_range[5] = {0};
-	uint16_t invalid_range[5] = {0};
-	uint16_t delay = 0;
-	uint16_t start_valid_delay = 32;
-	uint16_t start_invalid_delay = 32;
-	uint8_t interval = 0;
-	uint8_t max_interval = 0;
-	uint8_t max_valid_range = 0;
-	uint8_t cnt_valid[5] = {0};
-	uint8_t cnt_invalid = 0;
-	uint8_t val = 0;
-	uint8_t max_val = 32;
-
-	for (delay = 0; delay < 32; delay++) {
-		axi_adc_delay_set(adc, no_of_lanes, delay);
-		mdelay(20);
-		if (axi_adc_pn_mon(adc, sel, 100) == 0) {
-			err_field[delay] = 0;
-			start_valid_delay = start_valid_delay == 32 ?
-					    delay : start_valid_delay;
-		} else {
-			err_field[delay] = 1;
+	if (calib->settle_us >= 1000)
+		mdelay(calib->settle_us / 1000);
+	udelay(calib->settle_us % 1000);
+
+	return axi_adc_pn_mon_check(adc, calib->dwell_us);
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_find_eye
+*******************************************************************************/
+static void axi_adc_delay_find_eye(uint8_t *err_field,
+				   struct axi_adc_lane_eye *eye)
+{
+	uint8_t start = 0;
+	uint8_t cnt = 0;
+	uint8_t val;
+
+	eye->start = 0;
+	eye->width = 0;
+	for (val = 0; val < AXI_ADC_NUM_DELAY_TAPS; val++) {
+		if (err_field[val]) {
+			cnt = 0;
+			continue;
+		}
+		if (!cnt)
+			start = val;
+		cnt++;
+		if (cnt > eye->width) {
+			eye->start = start;
+			eye->width = cnt;
 		}
 	}
-	if (start_valid_delay > 31) {
+	eye->center = eye->start + (eye->width ? (eye->width - 1) / 2 : 0);
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_calibrate_eye
+ *
+ * Sweep the IDELAY taps of all the lanes at once and center them in the
+ * widest error free window. When calib->per_lane is set, each lane is then
+ * moved alone, starting from the common center, until the PN monitor reports
+ * errors, giving the eye of every lane. Since the PN status is only available
+ * per channel, the per lane search is done one lane at a time.
+ * The resulting eye (one entry per lane) can be stored and applied later with
+ * axi_adc_delay_eye_set().
+*******************************************************************************/
+int32_t axi_adc_delay_calibrate_eye(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    enum axi_adc_pn_sel sel,
+				    const struct axi_adc_delay_calib *calib,
+				    struct axi_adc_lane_eye *eye)
+{
+	uint8_t err_field[AXI_ADC_NUM_DELAY_TAPS];
+	struct axi_adc_lane_eye common;
+	uint32_t lane;
+	int32_t delay;
+	int32_t ret;
+
+	ret = axi_adc_delay_set(adc, no_of_lanes, 0);
+	if (ret != SUCCESS)
+		return ret;
+
+	axi_adc_pn_mon_enable(adc, sel);
+	for (delay = 0; delay < AXI_ADC_NUM_DELAY_TAPS; delay++) {
+		for (lane = 0; lane < no_of_lanes; lane++)
+			axi_adc_idelay_set(adc, lane, delay);
+		err_field[delay] = (axi_adc_delay_check(adc, calib) != SUCCESS);
+	}
+
+	axi_adc_delay_find_eye(err_field, &common);
+	if (!common.width) {
 		printf("%s FAILED.\n", __func__);
 		axi_adc_delay_set(adc, no_of_lanes, 0);
 		return FAILURE;
 	}
 
-	start_valid_delay = 32;
-	start_invalid_delay = 32;
-	for (val = 0; val < max_val; val++) {
-		if (err_field[val] == 0) {
-			if (start_valid_delay == 32) {
-				start_valid_delay = val;
-			}
-			if (start_valid_delay != 32 && start_invalid_delay != 32 ) {
-				start_valid_delay = 32;
-				start_invalid_delay = 32;
-			}
-			cnt_valid[interval]++;
+	axi_adc_delay_set(adc, no_of_lanes, common.center);
+
+	for (lane = 0; lane < no_of_lanes; lane++) {
+		if (!eye)
+			break;
+		if (!calib->per_lane) {
+			eye[lane] = common;
+			continue;
 		}
-		if((err_field[val] == 1) || (val == max_val - 1)) {
-			if (start_invalid_delay == 32) {
-				start_invalid_delay = val;
-			}
-			if (start_valid_delay != 32 && start_invalid_delay != 32 ) {
-				valid_range[interval] = start_valid_delay;
-				invalid_range[interval] = start_invalid_delay;
-				start_valid_delay = 32;
-				start_invalid_delay = 32;
-				interval++;
-			}
-			cnt_invalid++;
+
+		for (delay = common.center - 1; delay >= 0; delay--) {
+			axi_adc_idelay_set(adc, lane, delay);
+			if (axi_adc_delay_check(adc, calib) != SUCCESS)
+				break;
 		}
-	}
+		eye[lane].start = delay + 1;
 
-	for (val = 0; val < 5; val++) {
-		if (cnt_valid[val] > max_valid_range) {
-			max_valid_range = cnt_valid[val];
-			max_interval = val;
+		for (delay = common.center + 1; delay < AXI_ADC_NUM_DELAY_TAPS;
+		     delay++) {
+			axi_adc_idelay_set(adc, lane, delay);
+			if (axi_adc_delay_check(adc, calib) != SUCCESS)
+				break;
 		}
+		eye[lane].width = delay - eye[lane].start;
+		eye[lane].center = eye[lane].start + (eye[lane].width - 1) / 2;
+
+		/* Keep the lane centered while the next ones are measured */
+		axi_adc_idelay_set(adc, lane, eye[lane].center);
 	}
 
-	delay = (valid_range[max_interval] + invalid_range[max_interval] - 1) / 2;
+	printf("adc_delay: setting zero error delay (%d)\n\r", common.center);
+
+	return SUCCESS;
+}
+
+/***************************************************************************//**
+ * @brief axi_adc_delay_eye_set
+*******************************************************************************/
+int32_t axi_adc_delay_eye_set(struct axi_adc *adc,
+			      uint32_t no_of_lanes,
+			      const struct axi_adc_lane_eye *eye)
+{
+	uint32_t lane;
 
-	printf("adc_delay: setting zero error delay (%d)\n\r", delay);
-	axi_adc_delay_set(adc, no_of_lanes, delay);
+	for (lane = 0; lane < no_of_lanes; lane++)
+		axi_adc_idelay_set(adc, lane, eye[lane].center);
 
 	return SUCCESS;
 }
 
+/***************************************************************************//**
+ * @brief axi_adc_delay_calibrate
+*******************************************************************************/
+int32_t axi_adc_delay_calibrate(struct axi_adc *adc,
+				uint32_t no_of_lanes,
+				enum axi_adc_pn_sel sel)
+{
+	const struct axi_adc_delay_calib calib = {
+		.settle_us = 21000,
+		.dwell_us = 100000,
+		.per_lane = 0,
+	};
+
+	return axi_adc_delay_calibrate_eye(adc, no_of_lanes, sel, &calib, NULL);
+}
+
 /***************************************************************************//**
  * @brief axi_adc_set_calib_phase_scale
 *******************************************************************************/
@@ -114,6 +114,8 @@
 
 #define AXI_ADC_REG_DELAY(l)		(0x0800 + (l) * 0x4)
 
+#define AXI_ADC_NUM_DELAY_TAPS		32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -130,6 +132,21 @@ struct axi_adc_init {
 	uint8_t	num_channels;
 };
 
+struct axi_adc_delay_calib {
+	/* Time allowed for the data to settle after a delay change */
+	uint32_t settle_us;
+	/* Time the PN monitor is observed for errors */
+	uint32_t dwell_us;
+	/* Measure the eye of each lane, not only the common one */
+	uint8_t per_lane;
+};
+
+struct axi_adc_lane_eye {
+	uint8_t start;
+	uint8_t width;
+	uint8_t center;
+};
+
 enum axi_adc_pn_sel {
 	AXI_ADC_PN9 = 0,
 	AXI_ADC_PN23A = 1,
@@ -171,6 +188,14 @@ int32_t axi_adc_delay_set(struct axi_adc *adc,
 int32_t axi_adc_delay_calibrate(struct axi_adc *core,
 				uint32_t no_of_lanes,
 				enum axi_adc_pn_sel sel);
+int32_t axi_adc_delay_calibrate_eye(struct axi_adc *adc,
+				    uint32_t no_of_lanes,
+				    enum axi_adc_pn_sel sel,
+				    const struct axi_adc_delay_calib *calib,
+				    struct axi_adc_lane_eye *eye);
+int32_t axi_adc_delay_eye_set(struct axi_adc *adc,
+			      uint32_t no_of_lanes,
+			      const struct axi_adc_lane_eye *eye);
 int32_t axi_adc_set_calib_phase(struct axi_adc *adc,
 				uint32_t chan,
 				int32_t val,
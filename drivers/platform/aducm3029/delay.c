@@ -41,6 +41,7 @@
 /************************* Include Files **************************************/
 /******************************************************************************/
 
+#include <drivers/pwr/adi_pwr.h>
 #include "delay.h"
 #include "timer.h"
 #include "error.h"
@@ -110,12 +111,79 @@ static void start_and_wait(struct timer_desc *timer, uint32_t value)
 	timer_stop(timer);
 }
 
+/**
+ * @brief Get the core clock frequency, if the cycle counter can be used.
+ *
+ * The cycle counter of the DWT unit is enabled at the first call.
+ * @return The core clock frequency in Hz, 0 if the cycle counter is missing.
+ */
+static uint32_t cycles_hz(void)
+{
+	uint32_t hclk;
+
+	if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk)
+		return 0;
+
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+
+	/* Read at each call, the clock divider may change at runtime */
+	if (adi_pwr_GetClockFrequency(ADI_CLOCK_HCLK, &hclk) != ADI_PWR_SUCCESS)
+		return 0;
+
+	return hclk;
+}
+
+/**
+ * @brief Spin on the cycle counter.
+ * @param cycles - Number of core clock cycles to wait.
+ */
+static void wait_cycles(uint64_t cycles)
+{
+	uint32_t start;
+	uint32_t n;
+
+	while (cycles) {
+		n = cycles > INT32_MAX ? INT32_MAX : cycles;
+		cycles -= n;
+		start = DWT->CYCCNT;
+		while (DWT->CYCCNT - start < n)
+			;
+	}
+}
+
+/**
+ * @brief Wait until nsecs nanoseconds passed.
+ *
+ * Without a cycle counter the delay is rounded up to microseconds.
+ * @param nsecs - Number of nanoseconds to wait
+ */
+void ndelay(uint32_t nsecs)
+{
+	uint32_t hz = cycles_hz();
+
+	if (!hz) {
+		udelay((nsecs + 999) / 1000);
+		return ;
+	}
+	wait_cycles(((uint64_t)nsecs * hz + 999999999ull) / 1000000000ull);
+}
+
 /**
  * @brief Wait until usecs microseconds passed.
  * @param usecs - Number of microseconds to wait
  */
 void udelay(uint32_t usecs)
 {
+	uint32_t hz = cycles_hz();
+
+	if (hz) {
+		wait_cycles(((uint64_t)usecs * hz + 999999ull) / 1000000ull);
+		return ;
+	}
+
 	if (!us_timer)
 		if (!initialize_timer(&us_timer, 1))
 			return ;
@@ -133,3 +201,56 @@ void mdelay(uint32_t msecs)
 			return ;
 	start_and_wait(ms_timer, msecs);
 }
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ *
+ * The condition is checked once more when the timeout expires.
+ * @param cond - Condition, polled until it returns true.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
+{
+	uint32_t	hz = cycles_hz();
+	uint64_t	timeout;
+	uint64_t	elapsed;
+	uint32_t	last;
+	uint32_t	now;
+	int32_t		ret;
+
+	if (hz) {
+		timeout = ((uint64_t)timeout_us * hz + 999999ull) / 1000000ull;
+		last = DWT->CYCCNT;
+	} else {
+		if (!us_timer)
+			if (!initialize_timer(&us_timer, 1))
+				return FAILURE;
+		timeout = timeout_us;
+		timer_counter_set(us_timer, 0);
+		timer_start(us_timer);
+		last = 0;
+	}
+
+	ret = SUCCESS;
+	elapsed = 0;
+	while (!cond(ctx)) {
+		if (hz)
+			now = DWT->CYCCNT;
+		else
+			timer_counter_get(us_timer, &now);
+		/* Accumulate to handle the wrap of the 32 bit counters */
+		elapsed += now - last;
+		last = now;
+		if (elapsed >= timeout) {
+			ret = cond(ctx) ? SUCCESS : -ETIMEDOUT;
+			break;
+		}
+	}
+
+	if (!hz)
+		timer_stop(us_timer);
+
+	return ret;
+}
@@ -144,6 +144,7 @@ int32_t i2c_init(struct i2c_desc **desc,
 	(*desc)->max_speed_hz = param->max_speed_hz;
 	(*desc)->slave_address = param->slave_address;
 	(*desc)->extra = NULL;
+	bus_stats_register(&(*desc)->stats, "i2c", (*desc)->slave_address);
 	nb_created_desc++;
 
 	return SUCCESS;
@@ -163,11 +164,52 @@ int32_t i2c_remove(struct i2c_desc *desc)
 		adi_i2c_Close(i2c_handler);
 		i2c_handler = NULL;
 	}
+	bus_stats_unregister(&desc->stats);
 	free(desc);
 
 	return SUCCESS;
 }
 
+/**
+ * @brief ADuCM3029 specific I2C write, see i2c_write().
+ */
+static int32_t aducm_i2c_write(struct i2c_desc *desc,
+			       uint8_t *data,
+			       uint32_t bytes_number,
+			       uint8_t stop_bit)
+{
+	if (!desc)
+		return FAILURE;
+
+	ADI_I2C_TRANSACTION trans[1];
+	uint32_t errors;
+
+	/* The transaction sizes of the ADI driver are 16 bits wide */
+	if (bytes_number > UINT16_MAX)
+		return FAILURE;
+
+	if (SUCCESS != set_transmission_configuration(desc))
+		return FAILURE;
+
+	if (desc->slave_address == 0) { //General call
+		if (ADI_I2C_SUCCESS != adi_i2c_IssueGeneralCall(i2c_handler,
+				data, bytes_number, &errors))
+			return FAILURE;
+		return SUCCESS;
+	}
+
+	trans->bRepeatStart = (stop_bit == 1) ? 0 : 1;
+	trans->pPrologue = 0;
+	trans->nPrologueSize = 0;
+	trans->pData = data;
+	trans->nDataSize = bytes_number;
+	trans->bReadNotWrite = 0;
+	if (ADI_I2C_SUCCESS != adi_i2c_ReadWrite(i2c_handler, trans, &errors))
+		return FAILURE;
+
+	return SUCCESS;
+}
+
 /**
  * @brief Write data to a slave device
  * @param desc - Descriptor of the I2C device
@@ -180,31 +222,43 @@ int32_t i2c_remove(struct i2c_desc *desc)
  */
 int32_t i2c_write(struct i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t stop_bit)
 {
 	if (!desc)
 		return FAILURE;
 
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      aducm_i2c_write(desc, data, bytes_number,
+					      stop_bit));
+}
+
+/**
+ * @brief ADuCM3029 specific I2C read, see i2c_read().
+ */
+static int32_t aducm_i2c_read(struct i2c_desc *desc,
+			      uint8_t *data,
+			      uint32_t bytes_number,
+			      uint8_t stop_bit)
+{
+	if (!desc)
+		return FAILURE;
+
 	ADI_I2C_TRANSACTION trans[1];
 	uint32_t errors;
 
-	if (SUCCESS != set_transmission_configuration(desc))
+	if (bytes_number > UINT16_MAX)
 		return FAILURE;
 
-	if (desc->slave_address == 0) { //General call
-		if (ADI_I2C_SUCCESS != adi_i2c_IssueGeneralCall(i2c_handler,
-				data, bytes_number, &errors))
-			return FAILURE;
-		return SUCCESS;
-	}
+	if (SUCCESS != set_transmission_configuration(desc))
+		return FAILURE;
 
 	trans->bRepeatStart = (stop_bit == 1) ? 0 : 1;
 	trans->pPrologue = 0;
 	trans->nPrologueSize = 0;
 	trans->pData = data;
 	trans->nDataSize = bytes_number;
-	trans->bReadNotWrite = 0;
+	trans->bReadNotWrite = 1;
 	if (ADI_I2C_SUCCESS != adi_i2c_ReadWrite(i2c_handler, trans, &errors))
 		return FAILURE;
 
@@ -223,26 +277,71 @@ int32_t i2c_write(struct i2c_desc *desc,
  */
 int32_t i2c_read(struct i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t stop_bit)
 {
 	if (!desc)
 		return FAILURE;
 
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      aducm_i2c_read(desc, data, bytes_number,
+					     stop_bit));
+}
+
+/**
+ * @brief ADuCM3029 specific I2C write then read, see i2c_write_then_read().
+ * The written bytes are sent as the prologue of a read transaction, so the
+ * controller issues the repeated start between the two phases.
+ */
+static int32_t aducm_i2c_write_then_read(struct i2c_desc *desc,
+					 uint8_t *wr_data,
+					 uint32_t wr_bytes_number,
+					 uint8_t *rd_data,
+					 uint32_t rd_bytes_number)
+{
 	ADI_I2C_TRANSACTION trans[1];
 	uint32_t errors;
 
+	if (wr_bytes_number > UINT16_MAX || rd_bytes_number > UINT16_MAX)
+		return FAILURE;
+
 	if (SUCCESS != set_transmission_configuration(desc))
 		return FAILURE;
 
-	trans->bRepeatStart = (stop_bit == 1) ? 0 : 1;
-	trans->pPrologue = 0;
-	trans->nPrologueSize = 0;
-	trans->pData = data;
-	trans->nDataSize = bytes_number;
+	trans->bRepeatStart = 1;
+	trans->pPrologue = wr_data;
+	trans->nPrologueSize = wr_bytes_number;
+	trans->pData = rd_data;
+	trans->nDataSize = rd_bytes_number;
 	trans->bReadNotWrite = 1;
 	if (ADI_I2C_SUCCESS != adi_i2c_ReadWrite(i2c_handler, trans, &errors))
 		return FAILURE;
 
 	return SUCCESS;
 }
+
+/**
+ * @brief Write data then read data from a slave device, with a repeated
+ * start and no stop condition between the two.
+ * @param desc - Descriptor of the I2C device
+ * @param wr_data - Buffer that stores the transmission data.
+ * @param wr_bytes_number - Number of bytes to write.
+ * @param rd_data - Buffer that will store the received data.
+ * @param rd_bytes_number - Number of bytes to read.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t i2c_write_then_read(struct i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number)
+{
+	if (!desc)
+		return FAILURE;
+
+	return BUS_STATS_CALL(&desc->stats, wr_bytes_number + rd_bytes_number,
+			      aducm_i2c_write_then_read(desc, wr_data,
+							wr_bytes_number,
+							rd_data,
+							rd_bytes_number));
+}
@@ -45,10 +45,16 @@
 #include "spi.h"
 #include "error.h"
 #include <stdlib.h>
+#include <adi_processor.h>
 #include "util.h"
 
 #define	NB_SPI_DEVICES	3
 #define	MAX_CS_NUMBER	3
+/* Maximum number of bytes of a DMA transaction */
+#define	MAX_DMA_BYTES	2048
+/* Values of the CTL field of the CS_OVERRIDE register */
+#define	CS_OVERRIDE_NONE	0
+#define	CS_OVERRIDE_LOW		2
 
 /******************************************************************************/
 /*****************************  Variables   **********************************/
@@ -57,6 +63,11 @@
 /** Structure storing the device info */
 static struct aducm_device_desc	*devices[NB_SPI_DEVICES];
 
+/** Registers of the SPI devices, used to hold the chip select */
+static ADI_SPI_TypeDef *const	spi_regs[NB_SPI_DEVICES] = {
+	pADI_SPI0, pADI_SPI1, pADI_SPI2
+};
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -115,6 +126,39 @@ static int32_t config_device(struct aducm_device_desc *dev,
 	return SUCCESS;
 }
 
+/**
+ * @brief Get the number of bytes of the next transaction of a transfer.
+ * @param aducm_desc - SPI specific descriptor
+ * @param bytes_number - Number of bytes left to transfer
+ * @return Size of the next transaction.
+ */
+static uint32_t chunk_size(struct aducm_spi_desc *aducm_desc,
+			   uint32_t bytes_number)
+{
+	if (aducm_desc->aducm_conf.dma)
+		return min(bytes_number, MAX_DMA_BYTES);
+
+	return min(bytes_number, UINT16_MAX);
+}
+
+/**
+ * @brief Force the chip select low, or give its control back to the SPI
+ * device.
+ *
+ * The SPI device deasserts the chip select at the end of each transaction, so
+ * it is forced low while a transfer is split in several transactions.
+ * @param aducm_desc - SPI specific descriptor
+ * @param hold - True to force the chip select low.
+ */
+static void cs_hold(struct aducm_spi_desc *aducm_desc, bool hold)
+{
+	if (aducm_desc->aducm_conf.master_mode != MASTER)
+		return ;
+
+	spi_regs[aducm_desc->aducm_conf.spi_channel]->CS_OVERRIDE =
+		hold ? CS_OVERRIDE_LOW : CS_OVERRIDE_NONE;
+}
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -175,6 +219,7 @@ int32_t spi_init(struct spi_desc **desc,
 	}
 	dev->ref_instances++;
 	aducm_desc->dev = dev;
+	bus_stats_register(&spi_desc->stats, "spi", param->chip_select);
 	*desc = spi_desc;
 
 	return SUCCESS;
@@ -201,6 +246,9 @@ int32_t spi_remove(struct spi_desc *desc)
 	if (!aducm_desc->dev)
 		return FAILURE;
 
+	if (aducm_desc->dev->async_desc == desc)
+		spi_complete_transfer(desc, true);
+
 	if (aducm_desc->dev->ref_instances == 1) {
 		if (ADI_SPI_SUCCESS != adi_spi_Close(
 			    aducm_desc->dev->spi_handle))
@@ -208,6 +256,7 @@ int32_t spi_remove(struct spi_desc *desc)
 		free(aducm_desc->dev);
 		devices[aducm_desc->aducm_conf.spi_channel] = NULL;
 	}
+	bus_stats_unregister(&desc->stats);
 	free(aducm_desc);
 	free(desc);
 
@@ -215,19 +264,17 @@ int32_t spi_remove(struct spi_desc *desc)
 }
 
 /**
- * @brief Write and read data to/from SPI. If bytes number is 0 the function will return failure.
- * @param desc - The SPI descriptor.
- * @param data - The buffer with the transmitted/received data.
- * @param bytes_number - Number of bytes to write/read.
- * @return SUCCESS in case of success, FAILURE otherwise.
+ * @brief ADuCM3029 specific SPI write and read, see spi_write_and_read().
  */
-int32_t spi_write_and_read(struct spi_desc *desc,
-			   uint8_t *data,
-			   uint16_t bytes_number)
+static int32_t aducm_spi_write_and_read(struct spi_desc *desc,
+					uint8_t *data,
+					uint16_t bytes_number)
 {
 	struct aducm_spi_desc		*aducm_desc;
 	ADI_SPI_TRANSCEIVER		spi_trans;
+	ADI_SPI_RESULT			ret;
 	uint16_t			n;
+	bool				split;
 
 	if (!desc)
 		return FAILURE;
@@ -236,6 +283,9 @@ int32_t spi_write_and_read(struct spi_desc *desc,
 	if (!aducm_desc->dev)
 		return FAILURE;
 
+	if (aducm_desc->dev->async_busy)
+		return -EBUSY;
+
 	if (SUCCESS != config_device(aducm_desc->dev, desc, false))
 		return FAILURE;
 
@@ -247,34 +297,238 @@ int32_t spi_write_and_read(struct spi_desc *desc,
 	spi_trans.bDMA = aducm_desc->aducm_conf.dma;
 	spi_trans.bRD_CTL = aducm_desc->aducm_conf.half_duplex;
 
+	ret = ADI_SPI_SUCCESS;
+	split = chunk_size(aducm_desc, bytes_number) < bytes_number;
+	if (split)
+		cs_hold(aducm_desc, true);
+
 	while (bytes_number) {
-		if (aducm_desc->aducm_conf.dma)
-			/* Maximum 2048 bytes over dma */
-			n = max(2048, bytes_number);
-		else
-			n = bytes_number;
+		n = chunk_size(aducm_desc, bytes_number);
 
 		spi_trans.TransmitterBytes = n;
 		spi_trans.pTransmitter = data;
 		spi_trans.ReceiverBytes = n;
 		spi_trans.pReceiver = data;
 
-		if (aducm_desc->aducm_conf.master_mode == MASTER) {
-			if (ADI_SPI_SUCCESS != adi_spi_MasterReadWrite(
-				    aducm_desc->dev->spi_handle,
-				    &spi_trans))
-				return FAILURE;
-		} else {
-			if (ADI_SPI_SUCCESS != adi_spi_SlaveReadWrite(
-				    aducm_desc->dev->spi_handle,
-				    &spi_trans))
-				return FAILURE;
-		}
+		if (aducm_desc->aducm_conf.master_mode == MASTER)
+			ret = adi_spi_MasterReadWrite(
+				      aducm_desc->dev->spi_handle,
+				      &spi_trans);
+		else
+			ret = adi_spi_SlaveReadWrite(
+				      aducm_desc->dev->spi_handle,
+				      &spi_trans);
+		if (ret != ADI_SPI_SUCCESS)
+			break;
 
 		data += n;
 		bytes_number -= n;
 	}
 
+	if (split)
+		cs_hold(aducm_desc, false);
+
+	return ret == ADI_SPI_SUCCESS ? SUCCESS : FAILURE;
+}
+
+/**
+ * @brief Write and read data to/from SPI. If bytes number is 0 the function will return failure.
+ *
+ * With DMA, the transfer is split in transactions of at most 2048 bytes and
+ * the chip select is held asserted between them.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t spi_write_and_read(struct spi_desc *desc,
+			   uint8_t *data,
+			   uint16_t bytes_number)
+{
+	if (!desc)
+		return FAILURE;
+
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      aducm_spi_write_and_read(desc, data,
+						       bytes_number));
+}
+
+/**
+ * @brief Submit the next chunk of an asynchronous transfer.
+ * @param dev - SPI instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t async_submit_chunk(struct aducm_device_desc *dev)
+{
+	struct aducm_spi_desc	*aducm_desc = dev->async_desc->extra;
+	ADI_SPI_TRANSCEIVER	*trans = &dev->async_trans;
+	ADI_SPI_RESULT		ret;
+	uint32_t		n;
+
+	n = chunk_size(aducm_desc, dev->async_left);
+
+	trans->nTxIncrement = 1;
+	trans->nRxIncrement = 1;
+	trans->bDMA = aducm_desc->aducm_conf.dma;
+	trans->bRD_CTL = aducm_desc->aducm_conf.half_duplex;
+	trans->TransmitterBytes = n;
+	trans->pTransmitter = dev->async_data;
+	trans->ReceiverBytes = n;
+	trans->pReceiver = dev->async_data;
+
+	if (aducm_desc->aducm_conf.master_mode == MASTER)
+		ret = adi_spi_MasterSubmitBuffer(dev->spi_handle, trans);
+	else
+		ret = adi_spi_SlaveSubmitBuffer(dev->spi_handle, trans);
+	if (ret != ADI_SPI_SUCCESS)
+		return FAILURE;
+
+	dev->async_data += n;
+	dev->async_left -= n;
+
 	return SUCCESS;
 }
 
+/**
+ * @brief End an asynchronous transfer.
+ * @param dev - SPI instance
+ * @param status - Status of the transfer
+ */
+static void async_finish(struct aducm_device_desc *dev, int32_t status)
+{
+	adi_spi_RegisterCallback(dev->spi_handle, NULL, NULL);
+	cs_hold(dev->async_desc->extra, false);
+#ifdef BUS_STATS
+	/* The transaction lasts from the submission to the last chunk */
+	bus_stats_end(&dev->async_desc->stats, dev->async_start,
+		      dev->async_bytes, status < 0);
+#endif
+	dev->async_status = status;
+	dev->async_busy = false;
+	if (dev->async_callback)
+		dev->async_callback(dev->async_ctx, status);
+}
+
+/**
+ * @brief Called by the ADI driver when a chunk is transferred.
+ * @param ctx - SPI instance
+ * @param event - Hardware errors of the chunk
+ * @param arg - Not used
+ */
+static void async_chunk_done(void *ctx, uint32_t event, void *arg)
+{
+	struct aducm_device_desc *dev = ctx;
+
+	if (event != ADI_SPI_HW_ERROR_NONE) {
+		async_finish(dev, -EIO);
+		return ;
+	}
+
+	if (!dev->async_left) {
+		async_finish(dev, SUCCESS);
+		return ;
+	}
+
+	if (SUCCESS != async_submit_chunk(dev))
+		async_finish(dev, FAILURE);
+}
+
+/**
+ * @brief Start an asynchronous write and read to/from SPI.
+ *
+ * The transfer is split in chunks of at most 2048 bytes when DMA is used.
+ * The next chunk is submitted from the interrupt of the previous one and the
+ * chip select is held asserted between chunks.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data. Must stay valid
+ * until the transfer is done.
+ * @param bytes_number - Number of bytes to write/read.
+ * @param callback - Called from interrupt context when the transfer is done.
+ * May be NULL.
+ * @param ctx - Parameter for the callback.
+ * @return SUCCESS if the transfer was started, negative error code otherwise.
+ */
+int32_t spi_submit_transfer(struct spi_desc *desc,
+			    uint8_t *data,
+			    uint32_t bytes_number,
+			    void (*callback)(void *ctx, int32_t status),
+			    void *ctx)
+{
+	struct aducm_spi_desc		*aducm_desc;
+	struct aducm_device_desc	*dev;
+
+	if (!desc || !desc->extra || !data || !bytes_number)
+		return -EINVAL;
+
+	aducm_desc = desc->extra;
+	dev = aducm_desc->dev;
+	if (!dev)
+		return FAILURE;
+
+	if (dev->async_busy)
+		return -EBUSY;
+
+	if (SUCCESS != config_device(dev, desc, false))
+		return FAILURE;
+
+	dev->async_desc = desc;
+	dev->async_data = data;
+	dev->async_left = bytes_number;
+	dev->async_callback = callback;
+	dev->async_ctx = ctx;
+	dev->async_status = SUCCESS;
+	dev->async_busy = true;
+#ifdef BUS_STATS
+	dev->async_start = bus_stats_start();
+	dev->async_bytes = bytes_number;
+#endif
+
+	if (ADI_SPI_SUCCESS != adi_spi_RegisterCallback(dev->spi_handle,
+			async_chunk_done, dev)) {
+		dev->async_busy = false;
+		return FAILURE;
+	}
+
+	if (chunk_size(aducm_desc, bytes_number) < bytes_number)
+		cs_hold(aducm_desc, true);
+
+	if (SUCCESS != async_submit_chunk(dev)) {
+		adi_spi_RegisterCallback(dev->spi_handle, NULL, NULL);
+		cs_hold(aducm_desc, false);
+		dev->async_busy = false;
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Check or wait for the end of the asynchronous transfer.
+ * @param desc - The SPI descriptor.
+ * @param wait - If true, block until the transfer is done.
+ * @return
+ *  - \ref SUCCESS : The transfer is done
+ *  - -EINPROGRESS : The transfer is not done and wait is false
+ *  - Negative error code if the transfer failed
+ */
+int32_t spi_complete_transfer(struct spi_desc *desc,
+			      bool wait)
+{
+	struct aducm_spi_desc		*aducm_desc;
+	struct aducm_device_desc	*dev;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	aducm_desc = desc->extra;
+	dev = aducm_desc->dev;
+	if (!dev)
+		return FAILURE;
+
+	if (dev->async_busy && !wait)
+		return -EINPROGRESS;
+	while (dev->async_busy)
+		;
+
+	return dev->async_status;
+}
@@ -96,6 +96,28 @@ struct aducm_device_desc {
 	enum master_mode	master_mode;
 	/** Enable or disable continuous mode */
 	bool			continuous_mode;
+	/** Set while an asynchronous transfer is in progress */
+	volatile bool		async_busy;
+	/** Status of the last asynchronous transfer */
+	volatile int32_t	async_status;
+	/** Instance that started the asynchronous transfer */
+	struct spi_desc		*async_desc;
+	/** Transceiver of the chunk in progress */
+	ADI_SPI_TRANSCEIVER	async_trans;
+	/** Data not submitted yet */
+	uint8_t			*async_data;
+	/** Number of bytes not submitted yet */
+	uint32_t		async_left;
+	/** Called when the asynchronous transfer is done */
+	void			(*async_callback)(void *ctx, int32_t status);
+	/** Parameter for the callback */
+	void			*async_ctx;
+#ifdef BUS_STATS
+	/** Start time of the asynchronous transfer */
+	uint64_t		async_start;
+	/** Number of bytes of the asynchronous transfer */
+	uint32_t		async_bytes;
+#endif
 };
 
 /**
@@ -113,8 +135,8 @@ struct aducm_spi_init_param {
 	/** If true, it enables half duplex mode. The default if false */
 	bool			half_duplex;
 	/**
-	 * If true, it enables dma. The maximum number of a transaction with
-	 * dma is 2048
+	 * If true, it enables dma. Transfers longer than 2048 bytes are split
+	 * in several transactions, with the chip select held between them
 	 */
 	bool			dma;
 };
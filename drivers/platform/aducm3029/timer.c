@@ -63,6 +63,9 @@
 #define FREQ_1MHZ	1000000u
 /** Converts the timer value into microseconds */
 #define MHZ26_TO_US(count)	((HFOSC_LOAD - count) / (HFOSC_LOAD / 1000u))
+/** Converts the timer value into nanoseconds */
+#define MHZ26_TO_NS(count)	\
+	((HFOSC_LOAD - count) * 1000u / (HFOSC_LOAD / 1000u))
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -76,20 +79,62 @@ static uint32_t			nb_instances;
 static uint32_t			nb_enables;
 /** Current hardware timer used */
 static uint32_t			timer_id;
+/** Instances with a callback set, checked by \ref tmr_callback() */
+static struct aducm_timer_desc	*g_callbacks;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
 /**
- * Called each millisecond and used to increment a global counter
+ * Called each millisecond and used to increment a global counter and to call
+ * the expired instance callbacks.
  * @param param - Unused
  * @param tmr_event - Unused
  * @param arg - Unused
  */
 static void tmr_callback(void *param, uint32_t tmr_event, void *arg)
 {
+	struct aducm_timer_desc **it;
+	struct aducm_timer_desc *tmr;
+
 	g_count++;
+
+	it = &g_callbacks;
+	while ((tmr = *it)) {
+		if (g_count < tmr->next_ms) {
+			it = &tmr->next;
+			continue;
+		}
+		if (tmr->period_ms) {
+			tmr->next_ms += tmr->period_ms;
+			it = &tmr->next;
+		} else {
+			/* One-shot, remove it from the list */
+			*it = tmr->next;
+		}
+		/* The callback may set or cancel callbacks */
+		tmr->callback(tmr->ctx);
+	}
+}
+
+/**
+ * Remove an instance from the list of instances with a callback.
+ * @param tmr - Instance to remove.
+ */
+static void callback_unlink(struct aducm_timer_desc *tmr)
+{
+	struct aducm_timer_desc **it;
+	uint32_t		primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (it = &g_callbacks; *it; it = &(*it)->next)
+		if (*it == tmr) {
+			*it = tmr->next;
+			break;
+		}
+	__set_PRIMASK(primask);
 }
 
 /**
@@ -160,6 +205,7 @@ int32_t timer_remove(struct timer_desc *desc)
 {
 	if (!desc)
 		return FAILURE;
+	timer_cancel(desc);
 	free(desc->extra);
 	free(desc);
 	nb_instances--;
@@ -173,16 +219,32 @@ int32_t timer_remove(struct timer_desc *desc)
 	return SUCCESS;
 }
 
+/**
+ * Read the millisecond count together with the hardware timer count.
+ *
+ * g_count is 64 bits wide and is incremented from the interrupt, so it is
+ * read again until it doesn't change during the read of the hardware count.
+ * @param ms - Pointer where the millisecond count is stored.
+ * @param count - Pointer where the hardware timer count is stored.
+ */
+static void read_count(uint64_t *ms, uint16_t *count)
+{
+	do {
+		*ms = g_count;
+		adi_tmr_GetCurrentCount(timer_id, count);
+	} while (*ms != g_count);
+}
+
 static inline uint64_t get_current_time(struct timer_desc *desc)
 {
+	uint64_t		local_count;
 	uint16_t		count_us = 0;
 
-	if (desc->freq_hz > FREQ_1KHZ) {
-		adi_tmr_GetCurrentCount(timer_id, &count_us);
-		return g_count * 1000u + MHZ26_TO_US(count_us);
-	} else {
-		return g_count;
-	}
+	read_count(&local_count, &count_us);
+	if (desc->freq_hz > FREQ_1KHZ)
+		return local_count * 1000u + MHZ26_TO_US(count_us);
+	else
+		return local_count;
 }
 
 /**
@@ -203,7 +265,7 @@ int32_t timer_start(struct timer_desc *desc)
 	tmr_desc = desc->extra;
 	if (tmr_desc->started)
 		return FAILURE;
-	if (nb_enables == 0)
+	if (nb_enables == 0 && !g_callbacks)
 		while (ADI_TMR_DEVICE_BUSY == adi_tmr_Enable(timer_id, true));
 	tmr_desc->old_time = get_current_time(desc);
 	tmr_desc->started = true;
@@ -233,7 +295,7 @@ int32_t timer_stop(struct timer_desc *desc)
 
 	timer_counter_get(desc, &counter);
 	desc->load_value = counter;
-	if (nb_enables == 1)
+	if (nb_enables == 1 && !g_callbacks)
 		while (ADI_TMR_DEVICE_BUSY == adi_tmr_Enable(timer_id, false));
 	nb_enables--;
 	tmr_desc->started = false;
@@ -267,9 +329,8 @@ int32_t timer_counter_get(struct timer_desc *desc, uint32_t *counter)
 	 * Save the global count to local variable because it can suffer
 	 * modifications during calculations.
 	 */
-	local_count = g_count;
+	read_count(&local_count, &count_us);
 	if (desc->freq_hz > FREQ_1KHZ) {
-		adi_tmr_GetCurrentCount(timer_id, &count_us);
 		count_us = MHZ26_TO_US(count_us);
 		new_time = local_count * 1000u + count_us;
 		if (new_time < tmr_desc->old_time)
@@ -346,3 +407,129 @@ int32_t timer_count_clk_set(struct timer_desc *desc, uint32_t freq_hz)
 
 	return SUCCESS;
 }
+
+/**
+ * @brief Call a function after a number of milliseconds.
+ * @param desc - Descriptor of the timer instance.
+ * @param time_us - Period or delay in microseconds.
+ * @param periodic - true to call the function periodically.
+ * @param callback - Function to call.
+ * @param ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+static int32_t timer_set_callback(struct timer_desc *desc, uint32_t time_us,
+				  bool periodic, void (*callback)(void *ctx),
+				  void *ctx)
+{
+	struct aducm_timer_desc *tmr_desc;
+	uint32_t		time_ms;
+	uint32_t		primask;
+
+	if (!desc || !callback || !time_us)
+		return FAILURE;
+
+	tmr_desc = desc->extra;
+	timer_cancel(desc);
+
+	/* The timer interrupt comes each millisecond */
+	time_ms = time_us / 1000u + !!(time_us % 1000u);
+	tmr_desc->callback = callback;
+	tmr_desc->ctx = ctx;
+	tmr_desc->period_ms = periodic ? time_ms : 0;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (nb_enables == 0 && !g_callbacks)
+		while (ADI_TMR_DEVICE_BUSY == adi_tmr_Enable(timer_id, true));
+	tmr_desc->next_ms = g_count + time_ms;
+	tmr_desc->next = g_callbacks;
+	g_callbacks = tmr_desc;
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Call a function periodically, from the timer interrupt.
+ *
+ * The period is rounded up to milliseconds, the resolution of the timer
+ * interrupt. The first call may come up to one millisecond early.
+ * @param desc - Descriptor of the timer instance.
+ * @param period_us - Period in microseconds.
+ * @param callback - Function to call.
+ * @param ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t timer_set_periodic(struct timer_desc *desc, uint32_t period_us,
+			   void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, period_us, true, callback, ctx);
+}
+
+/**
+ * @brief Call a function once, from the timer interrupt, after a delay.
+ *
+ * The delay is rounded up to milliseconds, the resolution of the timer
+ * interrupt. The call may come up to one millisecond early.
+ * @param desc - Descriptor of the timer instance.
+ * @param delay_us - Delay in microseconds.
+ * @param callback - Function to call.
+ * @param ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t timer_set_oneshot(struct timer_desc *desc, uint32_t delay_us,
+			  void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, delay_us, false, callback, ctx);
+}
+
+/**
+ * @brief Stop calling the function set by timer_set_periodic/oneshot().
+ *
+ * If there are no more callbacks or timer instances started it also stops the
+ * hardware timer.
+ * @param desc - Descriptor of the timer instance.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t timer_cancel(struct timer_desc *desc)
+{
+	struct aducm_timer_desc *tmr_desc;
+
+	if (!desc)
+		return FAILURE;
+
+	tmr_desc = desc->extra;
+	if (!tmr_desc->callback)
+		return SUCCESS;
+
+	callback_unlink(tmr_desc);
+	tmr_desc->callback = NULL;
+	if (nb_enables == 0 && !g_callbacks)
+		while (ADI_TMR_DEVICE_BUSY == adi_tmr_Enable(timer_id, false));
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get a 64-bit monotonic timestamp in nanoseconds.
+ *
+ * The timestamp only advances while a timer instance is started or a callback
+ * is set.
+ * @param desc - Descriptor of the timer instance.
+ * @param ns - Pointer where the timestamp is stored.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t timer_get_time_ns(struct timer_desc *desc, uint64_t *ns)
+{
+	uint64_t	local_count;
+	uint16_t	count;
+
+	if (!desc || !ns)
+		return FAILURE;
+
+	read_count(&local_count, &count);
+
+	*ns = local_count * 1000000u + MHZ26_TO_NS(count);
+
+	return SUCCESS;
+}
@@ -53,6 +53,16 @@ struct aducm_timer_desc {
 	uint64_t	old_time;
 	/** 1 if the instance is counting, 0 otherwise */
 	bool		started;
+	/** Function set by timer_set_periodic/oneshot(), NULL if none */
+	void		(*callback)(void *ctx);
+	/** Parameter for the callback */
+	void		*ctx;
+	/** Callback period in milliseconds, 0 for one-shot callbacks */
+	uint32_t	period_ms;
+	/** Value of the millisecond count for the next call */
+	uint64_t	next_ms;
+	/** Next instance in the list of instances with a callback */
+	struct aducm_timer_desc *next;
 };
 
 #endif /* TIMER_EXTRA_H */
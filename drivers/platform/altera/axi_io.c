@@ -44,6 +44,7 @@
 #include <io.h>
 #include "error.h"
 #include "axi_io.h"
+#include "bus_stats.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -58,9 +59,8 @@
  */
 int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-	*data = IORD_32DIRECT(base, offset);
-
-	return SUCCESS;
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(*data),
+			      (*data = IORD_32DIRECT(base, offset), SUCCESS));
 }
 
 /**
@@ -72,8 +72,7 @@ int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-	IOWR_32DIRECT(base, offset, data);
-
-	return SUCCESS;
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(data),
+			      (IOWR_32DIRECT(base, offset, data), SUCCESS));
 }
 
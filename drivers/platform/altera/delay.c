@@ -42,6 +42,7 @@
 /******************************************************************************/
 
 #include "delay.h"
+#include "error.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -66,3 +67,38 @@ void mdelay(uint32_t msecs)
 {
 	usleep(msecs * 1000);
 }
+
+/**
+ * @brief Generate nanoseconds delay.
+ * @param nsecs - Delay in nanoseconds, rounded up to microseconds.
+ * @return None.
+ */
+void ndelay(uint32_t nsecs)
+{
+	usleep((nsecs + 999) / 1000);
+}
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ *
+ * The condition is polled every microsecond and checked once more when the
+ * timeout expires. The time spent in the condition is not counted, so the
+ * wait may be longer than the timeout, but never shorter.
+ * @param cond - Condition, polled until it returns true.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
+{
+	uint32_t elapsed = 0;
+
+	while (!cond(ctx)) {
+		if (elapsed >= timeout_us)
+			return cond(ctx) ? SUCCESS : -ETIMEDOUT;
+		usleep(1);
+		elapsed++;
+	}
+
+	return SUCCESS;
+}
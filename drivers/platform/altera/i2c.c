@@ -96,7 +96,7 @@ int32_t i2c_remove(struct i2c_desc *desc)
  */
 int32_t i2c_write(struct i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t stop_bit)
 {
 	if (desc) {
@@ -130,7 +130,7 @@ int32_t i2c_write(struct i2c_desc *desc,
  */
 int32_t i2c_read(struct i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t stop_bit)
 {
 	if (desc) {
@@ -151,3 +151,28 @@ int32_t i2c_read(struct i2c_desc *desc,
 
 	return SUCCESS;
 }
+
+/**
+ * @brief Write data then read data from a slave device, with a repeated
+ * start and no stop condition between the two.
+ * @param desc - The I2C descriptor.
+ * @param wr_data - Buffer that stores the transmission data.
+ * @param wr_bytes_number - Number of bytes to write.
+ * @param rd_data - Buffer that will store the received data.
+ * @param rd_bytes_number - Number of bytes to read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t i2c_write_then_read(struct i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number)
+{
+	int32_t ret;
+
+	ret = i2c_write(desc, wr_data, wr_bytes_number, 0);
+	if (ret != SUCCESS)
+		return ret;
+
+	return i2c_read(desc, rd_data, rd_bytes_number, 1);
+}
@@ -42,6 +42,7 @@
 /******************************************************************************/
 
 #include "delay.h"
+#include "error.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -70,3 +71,31 @@ void mdelay(uint32_t msecs)
 		// Unused variable - fix compiler warning
 	}
 }
+
+/**
+ * @brief Generate nanoseconds delay.
+ * @param nsecs - Delay in nanoseconds.
+ * @return None.
+ */
+void ndelay(uint32_t nsecs)
+{
+	if (nsecs) {
+		// Unused variable - fix compiler warning
+	}
+}
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ * @param cond - Condition, polled until it returns true.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
+{
+	if (timeout_us) {
+		// Unused variable - fix compiler warning
+	}
+
+	return cond(ctx) ? SUCCESS : -ETIMEDOUT;
+}
@@ -182,3 +182,96 @@ int32_t timer_count_clk_set(struct timer_desc *desc, uint32_t freq_hz)
 	return SUCCESS;
 }
 
+
+/**
+ * @brief Call a function periodically, from the timer interrupt.
+ * @param [in] desc      - Pointer to the device handler.
+ * @param [in] period_us - Period in microseconds.
+ * @param [in] callback  - Function to call.
+ * @param [in] ctx       - Parameter for the function.
+ * @return -ENOSYS, not implemented on this platform.
+ */
+int32_t timer_set_periodic(struct timer_desc *desc, uint32_t period_us,
+			   void (*callback)(void *ctx), void *ctx)
+{
+	if (desc) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (period_us) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (callback) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (ctx) {
+		// Unused variable - fix compiler warning
+	}
+
+	return -ENOSYS;
+}
+
+/**
+ * @brief Call a function once, from the timer interrupt, after a delay.
+ * @param [in] desc     - Pointer to the device handler.
+ * @param [in] delay_us - Delay in microseconds.
+ * @param [in] callback - Function to call.
+ * @param [in] ctx      - Parameter for the function.
+ * @return -ENOSYS, not implemented on this platform.
+ */
+int32_t timer_set_oneshot(struct timer_desc *desc, uint32_t delay_us,
+			  void (*callback)(void *ctx), void *ctx)
+{
+	if (desc) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (delay_us) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (callback) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (ctx) {
+		// Unused variable - fix compiler warning
+	}
+
+	return -ENOSYS;
+}
+
+/**
+ * @brief Stop calling the function set by timer_set_periodic/oneshot().
+ * @param [in] desc - Pointer to the device handler.
+ * @return 0 in case of success, error code otherwise.
+ */
+int32_t timer_cancel(struct timer_desc *desc)
+{
+	if (desc) {
+		// Unused variable - fix compiler warning
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get a 64-bit monotonic timestamp in nanoseconds.
+ * @param [in]  desc - Pointer to the device handler.
+ * @param [out] ns   - Pointer to the timestamp.
+ * @return -ENOSYS, not implemented on this platform.
+ */
+int32_t timer_get_time_ns(struct timer_desc *desc, uint64_t *ns)
+{
+	if (desc) {
+		// Unused variable - fix compiler warning
+	}
+
+	if (ns) {
+		// Unused variable - fix compiler warning
+	}
+
+	return -ENOSYS;
+}
@@ -47,6 +47,7 @@
 #include <sys/mman.h>
 #include "error.h"
 #include "axi_io.h"
+#include "bus_stats.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -119,7 +120,8 @@ close:
  */
 int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-	return axi_io_read_write(base, offset, data, NULL);
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(*data),
+			      axi_io_read_write(base, offset, data, NULL));
 }
 
 /**
@@ -131,5 +133,6 @@ int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-	return axi_io_read_write(base, offset, NULL, &data);
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(data),
+			      axi_io_read_write(base, offset, NULL, &data));
 }
@@ -0,0 +1,700 @@
+/***************************************************************************//**
+ *   @file   linux/irq.c
+ *   @brief  Implementation of the IRQ controller over Linux UIO devices and
+ *           file descriptors.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "error.h"
+#include "irq.h"
+#include "irq_extra.h"
+#include "util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of UIO devices and file descriptors handled by one controller */
+#ifndef LINUX_IRQ_MAX_LINES
+#define LINUX_IRQ_MAX_LINES	16
+#endif
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_line
+ * @brief Interrupt of one UIO device or file descriptor
+ */
+struct linux_irq_line {
+	/** Set while a callback is registered */
+	bool			used;
+	/**
+	 * UIO index, the interrupt is that of /dev/uio<irq_id>, or the id
+	 * given to linux_irq_register_fd()
+	 */
+	uint32_t		irq_id;
+	/** UIO device or watched file descriptor */
+	int			fd;
+	/**
+	 * Set if fd was given to linux_irq_register_fd(). It is not read nor
+	 * closed by the controller and it is masked by not watching it.
+	 */
+	bool			is_fd;
+	/** Registered callback */
+	struct callback_desc	callback;
+	/** Set by irq_enable(), cleared by irq_disable() */
+	bool			enabled;
+	/** Set when an interrupt was read but the callback was not called */
+	bool			pending;
+	/** Interrupt count read from the UIO device, or number of events */
+	uint32_t		count;
+};
+
+/**
+ * @struct linux_irq_desc
+ * @brief Linux specific IRQ controller descriptor
+ */
+struct linux_irq_desc {
+	/** Thread waiting for the interrupts and calling the callbacks */
+	pthread_t		thread;
+	/** Protects the fields below */
+	pthread_mutex_t		lock;
+	/** Signaled when a callback returns */
+	pthread_cond_t		idle;
+	/** Waits on the UIO devices, the file descriptors and on wake_fd */
+	int			epoll_fd;
+	/** Event used to wake up the thread */
+	int			wake_fd;
+	/** Set by irq_ctrl_remove() to stop the thread */
+	bool			stop;
+	/** Set by irq_global_enable(), cleared by irq_global_disable() */
+	bool			global_enabled;
+	/** Line whose callback is running, NULL if none */
+	struct linux_irq_line	*running;
+	/** Interrupt lines */
+	struct linux_irq_line	lines[LINUX_IRQ_MAX_LINES];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Get the line registered for irq_id, NULL if none */
+static struct linux_irq_line *linux_irq_find(struct linux_irq_desc *ldesc,
+		uint32_t irq_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++)
+		if (ldesc->lines[i].used && ldesc->lines[i].irq_id == irq_id)
+			return &ldesc->lines[i];
+
+	return NULL;
+}
+
+/*
+ * Unmask or mask the interrupt through the UIO irqcontrol write. A file
+ * descriptor is masked by not watching it anymore.
+ */
+static int32_t linux_irq_control(struct linux_irq_desc *ldesc,
+				 struct linux_irq_line *line, bool unmask)
+{
+	struct epoll_event	event;
+	uint32_t		value = unmask;
+
+	if (line->is_fd) {
+		event.events = unmask ? EPOLLIN : 0;
+		event.data.u64 = line - ldesc->lines + 1;
+		if (epoll_ctl(ldesc->epoll_fd, EPOLL_CTL_MOD, line->fd,
+			      &event) < 0)
+			return -errno;
+
+		return SUCCESS;
+	}
+
+	if (write(line->fd, &value, sizeof(value)) != sizeof(value))
+		return -errno;
+
+	return SUCCESS;
+}
+
+/*
+ * Unmask the interrupt only if it is enabled, the interrupts are globally
+ * enabled and its callback is not running. Called with the lock held.
+ */
+static int32_t linux_irq_update(struct linux_irq_desc *ldesc,
+				struct linux_irq_line *line)
+{
+	return linux_irq_control(ldesc, line, line->enabled &&
+				 ldesc->global_enabled && !line->pending &&
+				 ldesc->running != line);
+}
+
+/* Wake up the thread to look at the pending interrupts */
+static void linux_irq_wake(struct linux_irq_desc *ldesc)
+{
+	if (eventfd_write(ldesc->wake_fd, 1) < 0)
+		printf("%s: Can't wake up the IRQ thread\n\r", __func__);
+}
+
+/* Call the callbacks of the pending interrupts. Called with the lock held */
+static void linux_irq_dispatch(struct linux_irq_desc *ldesc)
+{
+	struct linux_irq_line	*line;
+	struct callback_desc	callback;
+	uint32_t		count;
+	uint32_t		i;
+	int			fd;
+
+	if (!ldesc->global_enabled)
+		return;
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++) {
+		line = &ldesc->lines[i];
+		if (!line->used || !line->pending || !line->enabled)
+			continue;
+
+		line->pending = false;
+		callback = line->callback;
+		count = line->count;
+		fd = line->fd;
+		ldesc->running = line;
+
+		pthread_mutex_unlock(&ldesc->lock);
+		callback.callback(callback.ctx, count, callback.config);
+		pthread_mutex_lock(&ldesc->lock);
+
+		ldesc->running = NULL;
+		pthread_cond_broadcast(&ldesc->idle);
+
+		/* The line may have been unregistered by the callback */
+		if (line->used && line->fd == fd)
+			linux_irq_update(ldesc, line);
+
+		if (!ldesc->global_enabled || ldesc->stop)
+			return;
+	}
+}
+
+/* Wait for the interrupts and call the callbacks until stopped */
+static void *linux_irq_thread(void *arg)
+{
+	struct linux_irq_desc	*ldesc = arg;
+	struct epoll_event	events[LINUX_IRQ_MAX_LINES + 1];
+	struct linux_irq_line	*line;
+	eventfd_t		wake;
+	uint32_t		count;
+	int			n;
+	int			i;
+
+	while (true) {
+		n = epoll_wait(ldesc->epoll_fd, events, ARRAY_SIZE(events), -1);
+		if (n < 0 && errno != EINTR)
+			break;
+
+		pthread_mutex_lock(&ldesc->lock);
+		if (ldesc->stop) {
+			pthread_mutex_unlock(&ldesc->lock);
+			break;
+		}
+
+		for (i = 0; i < n; i++) {
+			if (!events[i].data.u64) {
+				eventfd_read(ldesc->wake_fd, &wake);
+				continue;
+			}
+
+			line = &ldesc->lines[events[i].data.u64 - 1];
+			if (!line->used)
+				continue;
+
+			if (line->is_fd) {
+				/*
+				 * The data stays in the file until the callback
+				 * reads it, so stop watching the file meanwhile.
+				 */
+				linux_irq_control(ldesc, line, false);
+				line->count++;
+				line->pending = true;
+				continue;
+			}
+
+			/*
+			 * The UIO devices are non-blocking, so an event of a
+			 * line unregistered meanwhile does not block here.
+			 */
+			if (read(line->fd, &count, sizeof(count)) !=
+			    sizeof(count))
+				continue;
+
+			line->count = count;
+			line->pending = true;
+		}
+
+		linux_irq_dispatch(ldesc);
+		pthread_mutex_unlock(&ldesc->lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the IRQ controller. The interrupts are those of the
+ * Linux UIO devices and of the file descriptors given to
+ * linux_irq_register_fd(), and are handled by a thread of the controller.
+ * The interrupts are globally disabled until irq_global_enable().
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ parameters. The extra
+ *                field is not used.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
+		      const struct irq_init_param *param)
+{
+	struct irq_ctrl_desc	*descriptor;
+	struct linux_irq_desc	*ldesc;
+	struct epoll_event	event;
+	int32_t			ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = (struct irq_ctrl_desc *)calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ldesc = (struct linux_irq_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		free(descriptor);
+		return -ENOMEM;
+	}
+
+	ret = -pthread_mutex_init(&ldesc->lock, NULL);
+	if (ret)
+		goto error_free;
+
+	ret = -pthread_cond_init(&ldesc->idle, NULL);
+	if (ret)
+		goto error_mutex;
+
+	ldesc->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (ldesc->epoll_fd < 0) {
+		ret = -errno;
+		goto error_cond;
+	}
+
+	ldesc->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (ldesc->wake_fd < 0) {
+		ret = -errno;
+		goto error_epoll;
+	}
+
+	/* Lines are identified by their index + 1, the wake event by 0 */
+	event.events = EPOLLIN;
+	event.data.u64 = 0;
+	if (epoll_ctl(ldesc->epoll_fd, EPOLL_CTL_ADD, ldesc->wake_fd,
+		      &event) < 0) {
+		ret = -errno;
+		goto error_wake;
+	}
+
+	ret = -pthread_create(&ldesc->thread, NULL, linux_irq_thread, ldesc);
+	if (ret)
+		goto error_wake;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = ldesc;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+
+error_wake:
+	close(ldesc->wake_fd);
+error_epoll:
+	close(ldesc->epoll_fd);
+error_cond:
+	pthread_cond_destroy(&ldesc->idle);
+error_mutex:
+	pthread_mutex_destroy(&ldesc->lock);
+error_free:
+	free(ldesc);
+	free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by irq_ctrl_init(). The registered
+ * callbacks are not called anymore when this returns.
+ * It can't be called from a callback, the thread of the controller still
+ * uses the descriptor when the callback returns.
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, -EBUSY if called from a callback,
+ * negative error code otherwise.
+ */
+int32_t irq_ctrl_remove(struct irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc	*ldesc;
+	uint32_t		i;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	/* A callback can't wait for its own thread to return */
+	if (pthread_equal(ldesc->thread, pthread_self()))
+		return -EBUSY;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->stop = true;
+	linux_irq_wake(ldesc);
+	pthread_mutex_unlock(&ldesc->lock);
+
+	pthread_join(ldesc->thread, NULL);
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++) {
+		if (!ldesc->lines[i].used || ldesc->lines[i].is_fd)
+			continue;
+		linux_irq_control(ldesc, &ldesc->lines[i], false);
+		close(ldesc->lines[i].fd);
+	}
+
+	close(ldesc->wake_fd);
+	close(ldesc->epoll_fd);
+	pthread_cond_destroy(&ldesc->idle);
+	pthread_mutex_destroy(&ldesc->lock);
+	free(ldesc);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/*
+ * Add a line watching fd, masked and disabled. Called with the lock held.
+ * Returns the line or NULL if all the lines are used.
+ */
+static struct linux_irq_line *linux_irq_add(struct linux_irq_desc *ldesc,
+		uint32_t irq_id, int fd, bool is_fd,
+		struct callback_desc *callback_desc)
+{
+	struct linux_irq_line	*line;
+	struct epoll_event	event;
+	uint32_t		i;
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++)
+		if (!ldesc->lines[i].used)
+			break;
+	if (i == LINUX_IRQ_MAX_LINES) {
+		errno = ENOSPC;
+		return NULL;
+	}
+	line = &ldesc->lines[i];
+	line->fd = fd;
+	line->is_fd = is_fd;
+
+	/* A file descriptor is added masked, a UIO device is masked first */
+	if (!is_fd && linux_irq_control(ldesc, line, false) != SUCCESS)
+		return NULL;
+
+	event.events = is_fd ? 0 : EPOLLIN;
+	event.data.u64 = i + 1;
+	if (epoll_ctl(ldesc->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+		return NULL;
+
+	line->irq_id = irq_id;
+	line->callback = *callback_desc;
+	line->enabled = false;
+	line->pending = false;
+	line->count = 0;
+	line->used = true;
+
+	return line;
+}
+
+/**
+ * @brief Register a callback to handle the interrupt of /dev/uio<irq_id>.
+ *
+ * The callback is called from the thread of the controller, with the number
+ * of interrupts of the UIO device so far as event and callback_desc.config as
+ * extra. The interrupt stays masked while the callback runs and is unmasked
+ * when it returns. The interrupt is disabled until irq_enable().
+ * If irq_id was registered by linux_irq_register_fd(), only the callback is
+ * replaced.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - UIO device index.
+ * @param callback_desc - Callback descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_register_callback(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			      struct callback_desc *callback_desc)
+{
+	struct linux_irq_desc	*ldesc;
+	struct linux_irq_line	*line;
+	char			path[32];
+	int32_t			ret;
+	int			fd;
+
+	if (!desc || !callback_desc || !callback_desc->callback)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+
+	line = linux_irq_find(ldesc, irq_id);
+	if (line) {
+		line->callback = *callback_desc;
+		pthread_mutex_unlock(&ldesc->lock);
+		return SUCCESS;
+	}
+
+	sprintf(path, "/dev/uio%"PRIu32"", irq_id);
+	fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		ret = -errno;
+		goto unlock;
+	}
+
+	ret = SUCCESS;
+	if (!linux_irq_add(ldesc, irq_id, fd, false, callback_desc)) {
+		ret = -errno;
+		close(fd);
+	}
+unlock:
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Register a callback called when a file descriptor is readable, for
+ * example the one of a serial device.
+ *
+ * The file descriptor is handled as the interrupt irq_id, which must not be
+ * the index of a UIO device used with the same controller. The callback is
+ * called from the thread of the controller, with the number of events so far
+ * as event and callback_desc.config as extra. It must read the available data,
+ * otherwise it is called again when it returns. The interrupt is disabled
+ * until irq_enable(). The file descriptor is not closed by the controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt id given to the file descriptor.
+ * @param fd - File descriptor to watch.
+ * @param callback_desc - Callback descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_register_fd(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			      int fd, struct callback_desc *callback_desc)
+{
+	struct linux_irq_desc	*ldesc;
+	int32_t			ret = SUCCESS;
+
+	if (!desc || fd < 0 || !callback_desc || !callback_desc->callback)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	if (linux_irq_find(ldesc, irq_id))
+		ret = -EBUSY;
+	else if (!linux_irq_add(ldesc, irq_id, fd, true, callback_desc))
+		ret = -errno;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Unregister the callback of an interrupt and close its UIO device.
+ * A file descriptor given to linux_irq_register_fd() is only not watched
+ * anymore. When called from outside the callback, the callback is not running
+ * anymore when this returns.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - UIO device index.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_unregister(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct linux_irq_desc	*ldesc;
+	struct linux_irq_line	*line;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+
+	line = linux_irq_find(ldesc, irq_id);
+	if (!line) {
+		pthread_mutex_unlock(&ldesc->lock);
+		return -EINVAL;
+	}
+
+	while (ldesc->running == line &&
+	       !pthread_equal(ldesc->thread, pthread_self()))
+		pthread_cond_wait(&ldesc->idle, &ldesc->lock);
+
+	/* The line may have been unregistered while waiting */
+	if (line->used && line->irq_id == irq_id) {
+		epoll_ctl(ldesc->epoll_fd, EPOLL_CTL_DEL, line->fd, NULL);
+		if (!line->is_fd) {
+			linux_irq_control(ldesc, line, false);
+			close(line->fd);
+		}
+		memset(line, 0, sizeof(*line));
+	}
+
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return SUCCESS;
+}
+
+/* Set the global enable state and update all the lines */
+static int32_t linux_irq_global_set(struct irq_ctrl_desc *desc, bool enable)
+{
+	struct linux_irq_desc	*ldesc;
+	int32_t			ret = SUCCESS;
+	uint32_t		i;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->global_enabled = enable;
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++)
+		if (ldesc->lines[i].used &&
+		    linux_irq_update(ldesc, &ldesc->lines[i]) != SUCCESS)
+			ret = -EIO;
+	/* Deliver the interrupts received while disabled */
+	if (enable)
+		linux_irq_wake(ldesc);
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable global interrupts.
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_global_enable(struct irq_ctrl_desc *desc)
+{
+	return linux_irq_global_set(desc, true);
+}
+
+/**
+ * @brief Disable global interrupts. The interrupts received while disabled
+ * are delivered when enabled again.
+ * @param desc - The IRQ controller descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_global_disable(struct irq_ctrl_desc *desc)
+{
+	return linux_irq_global_set(desc, false);
+}
+
+/* Set the enable state of a line and update it */
+static int32_t linux_irq_set(struct irq_ctrl_desc *desc, uint32_t irq_id,
+			     bool enable)
+{
+	struct linux_irq_desc	*ldesc;
+	struct linux_irq_line	*line;
+	int32_t			ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	line = linux_irq_find(ldesc, irq_id);
+	if (!line) {
+		pthread_mutex_unlock(&ldesc->lock);
+		return -EINVAL;
+	}
+
+	line->enabled = enable;
+	ret = linux_irq_update(ldesc, line);
+	if (enable && line->pending)
+		linux_irq_wake(ldesc);
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable specific interrupt. The callback must be registered first.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - UIO device index.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_enable(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	return linux_irq_set(desc, irq_id, true);
+}
+
+/**
+ * @brief Disable specific interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - UIO device index.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t irq_disable(struct irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	return linux_irq_set(desc, irq_id, false);
+}
@@ -0,0 +1,677 @@
+/***************************************************************************//**
+ *   @file   linux/linux_socket.c
+ *   @brief  BSD socket implementation of the network interface.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "error.h"
+#include "linux_socket.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define DEFAULT_TIMEOUT_MS	10000
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/* Socket slot */
+struct linux_socket {
+	/* Set while the slot is used */
+	bool			used;
+	/* Protocol of the socket */
+	enum socket_protocol	proto;
+	/* File descriptor, -1 until connect, bind or sendto */
+	int			fd;
+	/* Requested receive buffer size */
+	uint32_t		buff_size;
+	/* Port set by bind */
+	uint16_t		port;
+	/* Printable address of the last recvfrom peer */
+	char			from_addr[INET6_ADDRSTRLEN];
+};
+
+/* Socket backend descriptor */
+struct linux_socket_desc {
+	/* Socket slots. The socket id is the index */
+	struct linux_socket		sockets[LINUX_SOCKET_MAX];
+	/* Network interface */
+	struct network_interface	interface;
+	/* Connect timeout */
+	uint32_t			connect_timeout_ms;
+	/* Send timeout */
+	uint32_t			send_timeout_ms;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Get a used socket slot */
+static struct linux_socket *get_socket(struct linux_socket_desc *desc,
+				       uint32_t sock_id)
+{
+	if (!desc || sock_id >= LINUX_SOCKET_MAX ||
+	    !desc->sockets[sock_id].used)
+		return NULL;
+
+	return &desc->sockets[sock_id];
+}
+
+/* Create the file descriptor of a socket */
+static int32_t create_fd(struct linux_socket *sock, int family)
+{
+	int	type;
+	int	val;
+	int	fd;
+
+	type = sock->proto == PROTOCOL_TCP ? SOCK_STREAM : SOCK_DGRAM;
+	fd = socket(family, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -errno;
+
+	val = 1;
+	if (sock->proto == PROTOCOL_TCP)
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &val, sizeof(val));
+	if (sock->buff_size) {
+		val = sock->buff_size;
+		setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &val, sizeof(val));
+	}
+	sock->fd = fd;
+
+	return SUCCESS;
+}
+
+/* Close the file descriptor of a socket */
+static void close_fd(struct linux_socket *sock)
+{
+	if (sock->fd < 0)
+		return ;
+
+	close(sock->fd);
+	sock->fd = -1;
+}
+
+/* Resolve an address. The result must be freed with freeaddrinfo */
+static int32_t resolve(const struct socket_address *addr,
+		       enum socket_protocol proto, struct addrinfo **res)
+{
+	struct addrinfo	hints;
+	char		port[8];
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = proto == PROTOCOL_TCP ? SOCK_STREAM : SOCK_DGRAM;
+	sprintf(port, "%u", addr->port);
+
+	if (getaddrinfo(addr->addr, port, &hints, res))
+		return -EHOSTUNREACH;
+
+	return SUCCESS;
+}
+
+/* Wait for events on a file descriptor. Return 1 if ready, 0 on timeout */
+static int32_t wait_fd(int fd, short events, int32_t timeout_ms)
+{
+	struct pollfd	pfd;
+	int		ret;
+
+	pfd.fd = fd;
+	pfd.events = events;
+	do {
+		ret = poll(&pfd, 1, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0)
+		return -errno;
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_open */
+static int32_t linux_socket_open(struct linux_socket_desc *desc,
+				 uint32_t *sock_id, enum socket_protocol proto,
+				 uint32_t buff_size)
+{
+	uint32_t i;
+
+	if (!desc || !sock_id)
+		return -EINVAL;
+
+	for (i = 0; i < LINUX_SOCKET_MAX; i++)
+		if (!desc->sockets[i].used)
+			break;
+	if (i == LINUX_SOCKET_MAX)
+		return -EMLINK;
+
+	memset(&desc->sockets[i], 0, sizeof(desc->sockets[i]));
+	desc->sockets[i].used = true;
+	desc->sockets[i].proto = proto;
+	desc->sockets[i].buff_size = buff_size;
+	desc->sockets[i].fd = -1;
+	*sock_id = i;
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_close */
+static int32_t linux_socket_close(struct linux_socket_desc *desc,
+				  uint32_t sock_id)
+{
+	struct linux_socket *sock;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	close_fd(sock);
+	sock->used = false;
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_connect */
+static int32_t linux_socket_connect(struct linux_socket_desc *desc,
+				    uint32_t sock_id,
+				    struct socket_address *addr)
+{
+	struct linux_socket	*sock;
+	struct addrinfo		*res;
+	struct addrinfo		*it;
+	socklen_t		len;
+	int32_t			ret;
+	int			err;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !addr || !addr->addr)
+		return -EINVAL;
+
+	if (sock->fd >= 0)
+		return -EISCONN;
+
+	ret = resolve(addr, sock->proto, &res);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = -ECONNREFUSED;
+	for (it = res; it; it = it->ai_next) {
+		ret = create_fd(sock, it->ai_family);
+		if (IS_ERR_VALUE(ret))
+			continue;
+
+		if (!connect(sock->fd, it->ai_addr, it->ai_addrlen))
+			break;
+		ret = -errno;
+		if (ret == -EINPROGRESS) {
+			ret = wait_fd(sock->fd, POLLOUT,
+				      desc->connect_timeout_ms);
+			if (ret == 0) {
+				ret = -ETIMEDOUT;
+			} else if (ret > 0) {
+				len = sizeof(err);
+				getsockopt(sock->fd, SOL_SOCKET, SO_ERROR,
+					   &err, &len);
+				ret = -err;
+			}
+			if (ret == SUCCESS)
+				break;
+		}
+		close_fd(sock);
+	}
+	freeaddrinfo(res);
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_disconnect */
+static int32_t linux_socket_disconnect(struct linux_socket_desc *desc,
+				       uint32_t sock_id)
+{
+	struct linux_socket *sock;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->fd >= 0 && sock->proto == PROTOCOL_TCP)
+		shutdown(sock->fd, SHUT_RDWR);
+	close_fd(sock);
+
+	return SUCCESS;
+}
+
+/* Send all the data, waiting while the kernel buffer is full */
+static int32_t send_all(struct linux_socket_desc *desc,
+			struct linux_socket *sock, const void *data,
+			uint32_t size, const struct sockaddr *to,
+			socklen_t to_len)
+{
+	const uint8_t	*buff = data;
+	uint32_t	sent;
+	ssize_t		ret;
+	int32_t		err;
+
+	sent = 0;
+	while (sent < size) {
+		ret = sendto(sock->fd, buff + sent, size - sent, MSG_NOSIGNAL,
+			     to, to_len);
+		if (ret >= 0) {
+			sent += ret;
+			continue;
+		}
+		if (errno == EINTR)
+			continue;
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			return -errno;
+
+		err = wait_fd(sock->fd, POLLOUT, desc->send_timeout_ms);
+		if (err == 0)
+			return sent ? (int32_t)sent : -ETIMEDOUT;
+		if (IS_ERR_VALUE(err))
+			return err;
+	}
+
+	return sent;
+}
+
+/** @brief See \ref network_interface.socket_send */
+static int32_t linux_socket_send(struct linux_socket_desc *desc,
+				 uint32_t sock_id, const void *data,
+				 uint32_t size)
+{
+	struct linux_socket *sock;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !data)
+		return -EINVAL;
+
+	if (sock->fd < 0)
+		return -ENOTCONN;
+
+	return send_all(desc, sock, data, size, NULL, 0);
+}
+
+/** @brief See \ref network_interface.socket_recv */
+static int32_t linux_socket_recv(struct linux_socket_desc *desc,
+				 uint32_t sock_id, void *data, uint32_t size)
+{
+	struct linux_socket	*sock;
+	ssize_t			ret;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !data || !size)
+		return -EINVAL;
+
+	if (sock->fd < 0)
+		return -ENOTCONN;
+
+	do {
+		ret = recv(sock->fd, data, size, 0);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0)
+		return (errno == EWOULDBLOCK) ? -EAGAIN : -errno;
+	/* Orderly shutdown from the peer */
+	if (ret == 0 && sock->proto == PROTOCOL_TCP)
+		return -ENOTCONN;
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_sendto */
+static int32_t linux_socket_sendto(struct linux_socket_desc *desc,
+				   uint32_t sock_id, const void *data,
+				   uint32_t size,
+				   const struct socket_address *to)
+{
+	struct linux_socket	*sock;
+	struct addrinfo		*res;
+	int32_t			ret;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !data || !to || !to->addr)
+		return -EINVAL;
+
+	if (sock->proto != PROTOCOL_UDP)
+		return -EPROTOTYPE;
+
+	ret = resolve(to, sock->proto, &res);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	if (sock->fd < 0)
+		ret = create_fd(sock, res->ai_family);
+	if (!IS_ERR_VALUE(ret))
+		ret = send_all(desc, sock, data, size, res->ai_addr,
+			       res->ai_addrlen);
+	freeaddrinfo(res);
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_recvfrom */
+static int32_t linux_socket_recvfrom(struct linux_socket_desc *desc,
+				     uint32_t sock_id, void *data,
+				     uint32_t size,
+				     struct socket_address *from)
+{
+	struct sockaddr_storage	addr;
+	struct sockaddr_in6	*addr6;
+	struct sockaddr_in	*addr4;
+	struct linux_socket	*sock;
+	socklen_t		len;
+	ssize_t			ret;
+	void			*src;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !data || !size)
+		return -EINVAL;
+
+	if (sock->proto != PROTOCOL_UDP)
+		return -EPROTOTYPE;
+
+	if (sock->fd < 0)
+		return -EAGAIN;
+
+	len = sizeof(addr);
+	do {
+		ret = recvfrom(sock->fd, data, size, 0,
+			       (struct sockaddr *)&addr, &len);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0)
+		return (errno == EWOULDBLOCK) ? -EAGAIN : -errno;
+
+	if (from) {
+		if (addr.ss_family == AF_INET6) {
+			addr6 = (struct sockaddr_in6 *)&addr;
+			src = &addr6->sin6_addr;
+			from->port = ntohs(addr6->sin6_port);
+		} else {
+			addr4 = (struct sockaddr_in *)&addr;
+			src = &addr4->sin_addr;
+			from->port = ntohs(addr4->sin_port);
+		}
+		inet_ntop(addr.ss_family, src, sock->from_addr,
+			  sizeof(sock->from_addr));
+		from->addr = sock->from_addr;
+	}
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_bind */
+static int32_t linux_socket_bind(struct linux_socket_desc *desc,
+				 uint32_t sock_id, uint16_t port)
+{
+	struct sockaddr_in6	addr;
+	struct linux_socket	*sock;
+	int32_t			ret;
+	int			val;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->fd >= 0)
+		return -EISCONN;
+
+	/* Dual stack socket, accepts IPv4 too */
+	ret = create_fd(sock, AF_INET6);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	val = 1;
+	setsockopt(sock->fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+	val = 0;
+	setsockopt(sock->fd, IPPROTO_IPV6, IPV6_V6ONLY, &val, sizeof(val));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin6_family = AF_INET6;
+	addr.sin6_addr = in6addr_any;
+	addr.sin6_port = htons(port);
+	if (bind(sock->fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		ret = -errno;
+		close_fd(sock);
+		return ret;
+	}
+	sock->port = port;
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_listen */
+static int32_t linux_socket_listen(struct linux_socket_desc *desc,
+				   uint32_t sock_id, uint32_t back_log)
+{
+	struct linux_socket *sock;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	/* Socket bind must be done before listen */
+	if (sock->fd < 0 || sock->proto != PROTOCOL_TCP)
+		return -ENOTCONN;
+
+	if (listen(sock->fd, back_log ? (int)back_log : SOMAXCONN))
+		return -errno;
+
+	return SUCCESS;
+}
+
+/** @brief See \ref network_interface.socket_accept */
+static int32_t linux_socket_accept(struct linux_socket_desc *desc,
+				   uint32_t sock_id,
+				   uint32_t *client_socket_id)
+{
+	struct linux_socket	*sock;
+	struct linux_socket	*cli;
+	uint32_t		id;
+	int32_t			ret;
+	int			val;
+	int			fd;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock || !client_socket_id)
+		return -EINVAL;
+
+	if (sock->fd < 0)
+		return -ENOTCONN;
+
+	fd = accept(sock->fd, NULL, NULL);
+	if (fd < 0)
+		return (errno == EWOULDBLOCK) ? -EAGAIN : -errno;
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+	ret = linux_socket_open(desc, &id, PROTOCOL_TCP, sock->buff_size);
+	if (IS_ERR_VALUE(ret)) {
+		close(fd);
+		return ret;
+	}
+
+	val = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &val, sizeof(val));
+	cli = &desc->sockets[id];
+	cli->fd = fd;
+	*client_socket_id = id;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Wait until a socket has data to read or, for a listening socket, a
+ * connection to accept.
+ * @param desc - Socket backend descriptor.
+ * @param sock_id - Socket id.
+ * @param timeout_ms - Maximum time to wait.
+ * @return
+ *  - 1 : If the socket is ready
+ *  - 0 : On timeout
+ *  - Negative error code on failure
+ */
+int32_t linux_socket_wait(struct linux_socket_desc *desc, uint32_t sock_id,
+			  uint32_t timeout_ms)
+{
+	struct linux_socket *sock;
+
+	sock = get_socket(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->fd < 0)
+		return -ENOTCONN;
+
+	return wait_fd(sock->fd, POLLIN, timeout_ms);
+}
+
+/**
+ * @brief Initialize the socket backend.
+ * @param desc - Address where to store the descriptor.
+ * @param param - Initialization parameters. May be NULL for the defaults.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_socket_init(struct linux_socket_desc **desc,
+			  struct linux_socket_init_param *param)
+{
+	struct linux_socket_desc	*ldesc;
+	struct network_interface	*net;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = (struct linux_socket_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	ldesc->connect_timeout_ms = DEFAULT_TIMEOUT_MS;
+	ldesc->send_timeout_ms = DEFAULT_TIMEOUT_MS;
+	if (param && param->connect_timeout_ms)
+		ldesc->connect_timeout_ms = param->connect_timeout_ms;
+	if (param && param->send_timeout_ms)
+		ldesc->send_timeout_ms = param->send_timeout_ms;
+
+	net = &ldesc->interface;
+	net->net = ldesc;
+	net->socket_open = (int32_t (*)(void *, uint32_t *,
+					enum socket_protocol, uint32_t))
+			   linux_socket_open;
+	net->socket_close = (int32_t (*)(void *, uint32_t))
+			    linux_socket_close;
+	net->socket_connect = (int32_t (*)(void *, uint32_t,
+					   struct socket_address *))
+			      linux_socket_connect;
+	net->socket_disconnect = (int32_t (*)(void *, uint32_t))
+				 linux_socket_disconnect;
+	net->socket_send = (int32_t (*)(void *, uint32_t, const void *,
+					uint32_t))
+			   linux_socket_send;
+	net->socket_recv = (int32_t (*)(void *, uint32_t, void *, uint32_t))
+			   linux_socket_recv;
+	net->socket_sendto = (int32_t (*)(void *, uint32_t, const void *,
+					  uint32_t,
+					  const struct socket_address *))
+			     linux_socket_sendto;
+	net->socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t,
+					    struct socket_address *))
+			       linux_socket_recvfrom;
+	net->socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))
+			   linux_socket_bind;
+	net->socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))
+			     linux_socket_listen;
+	net->socket_accept = (int32_t (*)(void *, uint32_t, uint32_t *))
+			     linux_socket_accept;
+	net->socket_wait = (int32_t (*)(void *, uint32_t, uint32_t))
+			   linux_socket_wait;
+
+	*desc = ldesc;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Close all the sockets and free the resources allocated by
+ * linux_socket_init().
+ * @param desc - Socket backend descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_socket_remove(struct linux_socket_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (i = 0; i < LINUX_SOCKET_MAX; i++)
+		if (desc->sockets[i].used)
+			close_fd(&desc->sockets[i]);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the network interface of the backend.
+ * @param desc - Socket backend descriptor.
+ * @param net - Address where to store the reference to the network interface.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t linux_socket_get_network_interface(struct linux_socket_desc *desc,
+		struct network_interface **net)
+{
+	if (!desc || !net)
+		return -EINVAL;
+
+	*net = &desc->interface;
+
+	return SUCCESS;
+}
@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ *   @file   linux/linux_socket.h
+ *   @brief  BSD socket implementation of the network interface.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_SOCKET_H_
+#define LINUX_SOCKET_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "network_interface.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of sockets opened at the same time */
+#define LINUX_SOCKET_MAX	32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_socket_init_param
+ * @brief Parameters to initialize the socket backend
+ */
+struct linux_socket_init_param {
+	/** Maximum time to wait for a TCP connection. 0 for 10 s */
+	uint32_t	connect_timeout_ms;
+	/** Maximum time to wait for a blocked send. 0 for 10 s */
+	uint32_t	send_timeout_ms;
+};
+
+/**
+ * @struct linux_socket_desc
+ * @brief Socket backend descriptor
+ */
+struct linux_socket_desc;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Initialize the socket backend. */
+int32_t linux_socket_init(struct linux_socket_desc **desc,
+			  struct linux_socket_init_param *param);
+
+/* Free the resources allocated by linux_socket_init(). */
+int32_t linux_socket_remove(struct linux_socket_desc *desc);
+
+/* Get the network interface of the backend. */
+int32_t linux_socket_get_network_interface(struct linux_socket_desc *desc,
+		struct network_interface **net);
+
+/* Wait until a socket has data to read or a connection to accept. */
+int32_t linux_socket_wait(struct linux_socket_desc *desc, uint32_t sock_id,
+			  uint32_t timeout_ms);
+
+#endif /* LINUX_SOCKET_H_ */
@@ -40,16 +40,44 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
+#include <sched.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include "platform_drivers.h"
+#include <linux/gpio.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <linux/spi/spidev.h>
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Chip used by gpio_get() if the sysfs GPIO class is not available */
+#ifndef LINUX_GPIO_CHIP
+#define LINUX_GPIO_CHIP	"/dev/gpiochip0"
+#endif
+
+/*
+ * The delays sleep until this many nanoseconds before the deadline and spin
+ * for the rest, to hide the wake-up latency of the scheduler.
+ */
+#ifndef LINUX_DELAY_SPIN_NS
+#define LINUX_DELAY_SPIN_NS	100000
+#endif
+
+#define NSEC_PER_SEC		1000000000ull
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -77,6 +105,7 @@ int32_t i2c_init(i2c_desc **desc,
 	}
 
 	descriptor->slave_address = param->slave_address;
+	descriptor->selected_address = -1;
 
 	*desc = descriptor;
 
@@ -103,6 +132,31 @@ int32_t i2c_remove(i2c_desc *desc)
 	return SUCCESS;
 }
 
+/**
+ * @brief Select the slave address used by read() and write() on the I2C
+ * file, unless it is already selected.
+ * @param desc - The I2C descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t i2c_select_slave(i2c_desc *desc)
+{
+	int ret;
+
+	if (desc->selected_address == desc->slave_address)
+		return SUCCESS;
+
+	ret = ioctl(desc->fd, I2C_SLAVE, desc->slave_address);
+	if (ret < 0) {
+		printf("%s: Can't select device\n\r", __func__);
+		desc->selected_address = -1;
+		return FAILURE;
+	}
+
+	desc->selected_address = desc->slave_address;
+
+	return SUCCESS;
+}
+
 /**
  * @brief Write data to a slave device.
  * @param desc - The I2C descriptor.
@@ -115,19 +169,17 @@ int32_t i2c_remove(i2c_desc *desc)
  */
 int32_t i2c_write(i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t stop_bit)
 {
 	int ret;
 
-	ret = ioctl(desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
+	ret = i2c_select_slave(desc);
+	if (ret != SUCCESS)
 		return FAILURE;
-	}
 
 	ret = write(desc->fd, data, bytes_number);
-	if (ret < 0) {
+	if (ret != (int)bytes_number) {
 		printf("%s: Can't write to file\n\r", __func__);
 		return FAILURE;
 	}
@@ -151,19 +203,17 @@ int32_t i2c_write(i2c_desc *desc,
  */
 int32_t i2c_read(i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t stop_bit)
 {
 	int ret;
 
-	ret = ioctl(desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
+	ret = i2c_select_slave(desc);
+	if (ret != SUCCESS)
 		return FAILURE;
-	}
 
 	ret = read(desc->fd, data, bytes_number);
-	if (ret < 0) {
+	if (ret != (int)bytes_number) {
 		printf("%s: Can't read from file\n\r", __func__);
 		return FAILURE;
 	}
@@ -175,6 +225,55 @@ int32_t i2c_read(i2c_desc *desc,
 	return SUCCESS;
 }
 
+/**
+ * @brief Write data then read data from a slave device, in a single
+ * I2C_RDWR transaction with a repeated start between the two messages.
+ * @param desc - The I2C descriptor.
+ * @param wr_data - Buffer that stores the transmission data.
+ * @param wr_bytes_number - Number of bytes to write.
+ * @param rd_data - Buffer that will store the received data.
+ * @param rd_bytes_number - Number of bytes to read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t i2c_write_then_read(i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number)
+{
+	struct i2c_msg msgs[2] = {
+		{
+			.addr = desc->slave_address,
+			.flags = 0,
+			.len = wr_bytes_number,
+			.buf = wr_data,
+		},
+		{
+			.addr = desc->slave_address,
+			.flags = I2C_M_RD,
+			.len = rd_bytes_number,
+			.buf = rd_data,
+		},
+	};
+	struct i2c_rdwr_ioctl_data rdwr = {
+		.msgs = msgs,
+		.nmsgs = 2,
+	};
+	int ret;
+
+	/* The message length is 16 bits wide */
+	if (wr_bytes_number > UINT16_MAX || rd_bytes_number > UINT16_MAX)
+		return FAILURE;
+
+	ret = ioctl(desc->fd, I2C_RDWR, &rdwr);
+	if (ret < 0) {
+		printf("%s: Can't transfer\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -267,6 +366,527 @@ int32_t spi_write_and_read(spi_desc *desc,
 	return SUCCESS;
 }
 
+#ifdef GPIO_V2_GET_LINE_IOCTL
+
+/**
+ * @brief Check that a GPIO character device is the chip with the given label
+ * and number of lines.
+ * @param chip - Path of the character device.
+ * @param label - Label of the chip.
+ * @param ngpio - Number of lines of the chip.
+ * @return true if the character device matches, false otherwise.
+ */
+static bool gpio_chip_matches(const char *chip, const char *label,
+			      uint32_t ngpio)
+{
+	struct gpiochip_info info;
+	int fd;
+	int ret;
+
+	fd = open(chip, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	ret = ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &info);
+	close(fd);
+	if (ret < 0)
+		return false;
+
+	return info.lines == ngpio &&
+	       !strncmp(info.label, label, sizeof(info.label));
+}
+
+/**
+ * @brief Find the character device and the line offset of a GPIO number.
+ * The number uses the global sysfs numbering. If the sysfs GPIO class is
+ * not available, the number is used as offset on LINUX_GPIO_CHIP.
+ * @param gpio_number - The number of the GPIO.
+ * @param chip - Buffer where to store the character device path.
+ * @param offset - The line offset on the chip.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t gpio_find_line(uint32_t gpio_number, char *chip,
+			      uint32_t *offset)
+{
+	struct dirent *ent;
+	struct dirent *dev;
+	char path[300];
+	char label[GPIO_MAX_NAME_SIZE];
+	uint32_t base;
+	uint32_t ngpio;
+	FILE *f;
+	DIR *dir;
+	DIR *ddir;
+	int32_t ret = FAILURE;
+
+	dir = opendir("/sys/class/gpio");
+	if (!dir) {
+		strcpy(chip, LINUX_GPIO_CHIP);
+		*offset = gpio_number;
+		return SUCCESS;
+	}
+
+	while (ret != SUCCESS && (ent = readdir(dir))) {
+		if (strncmp(ent->d_name, "gpiochip", 8))
+			continue;
+
+		if (sscanf(ent->d_name + 8, "%"SCNu32, &base) != 1 ||
+		    gpio_number < base)
+			continue;
+
+		sprintf(path, "/sys/class/gpio/%s/ngpio", ent->d_name);
+		f = fopen(path, "r");
+		if (!f)
+			continue;
+		if (fscanf(f, "%"SCNu32, &ngpio) != 1)
+			ngpio = 0;
+		fclose(f);
+		if (gpio_number >= base + ngpio)
+			continue;
+
+		sprintf(path, "/sys/class/gpio/%s/label", ent->d_name);
+		f = fopen(path, "r");
+		if (!f)
+			continue;
+		if (!fgets(label, sizeof(label), f))
+			label[0] = '\0';
+		fclose(f);
+		label[strcspn(label, "\n")] = '\0';
+
+		/*
+		 * The character device is a sibling under the parent device,
+		 * which may register several chips. Pick the one with the same
+		 * label and number of lines.
+		 */
+		sprintf(path, "/sys/class/gpio/%s/device", ent->d_name);
+		ddir = opendir(path);
+		if (!ddir)
+			continue;
+		while ((dev = readdir(ddir))) {
+			if (strncmp(dev->d_name, "gpiochip", 8))
+				continue;
+			sprintf(chip, "/dev/%s", dev->d_name);
+			if (gpio_chip_matches(chip, label, ngpio)) {
+				*offset = gpio_number - base;
+				ret = SUCCESS;
+				break;
+			}
+		}
+		closedir(ddir);
+	}
+	closedir(dir);
+
+	return ret;
+}
+
+/**
+ * @brief Request lines from a GPIO character device.
+ * @param chip - Path of the character device.
+ * @param offsets - Line offsets.
+ * @param nb_lines - Number of lines.
+ * @return Line request file descriptor, negative in case of error.
+ */
+static int gpio_request_lines(const char *chip, const uint32_t *offsets,
+			      uint8_t nb_lines)
+{
+	struct gpio_v2_line_request req;
+	int chip_fd;
+	int ret;
+
+	chip_fd = open(chip, O_RDWR | O_CLOEXEC);
+	if (chip_fd < 0)
+		return -1;
+
+	/* No direction flags: the lines are requested as-is */
+	memset(&req, 0, sizeof(req));
+	memcpy(req.offsets, offsets, nb_lines * sizeof(*offsets));
+	req.num_lines = nb_lines;
+	strcpy(req.consumer, "no-OS");
+
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+	close(chip_fd);
+	if (ret < 0)
+		return -1;
+
+	return req.fd;
+}
+
+/**
+ * @brief Get the direction of a line from the kernel.
+ * @param chip - Path of the character device.
+ * @param offset - Line offset.
+ * @param direction - The direction.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t gpio_read_direction(const char *chip, uint32_t offset,
+				   uint8_t *direction)
+{
+	struct gpio_v2_line_info info;
+	int chip_fd;
+	int ret;
+
+	chip_fd = open(chip, O_RDWR | O_CLOEXEC);
+	if (chip_fd < 0)
+		return FAILURE;
+
+	memset(&info, 0, sizeof(info));
+	info.offset = offset;
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &info);
+	close(chip_fd);
+	if (ret < 0)
+		return FAILURE;
+
+	if (info.flags & GPIO_V2_LINE_FLAG_OUTPUT)
+		*direction = GPIO_OUT;
+	else
+		*direction = GPIO_IN;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Reconfigure requested lines.
+ * @param fd - Line request file descriptor.
+ * @param nb_lines - Number of requested lines.
+ * @param output - 1 for output, 0 for input.
+ * @param values - Output values, bit i for line i.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t gpio_set_config(int fd, uint8_t nb_lines, uint8_t output,
+			       uint64_t values)
+{
+	struct gpio_v2_line_config config;
+	uint64_t mask;
+
+	memset(&config, 0, sizeof(config));
+	mask = (nb_lines == 64) ? ~0ull : (1ull << nb_lines) - 1;
+	if (output) {
+		config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+		/* Set the initial values together with the direction */
+		config.num_attrs = 1;
+		config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		config.attrs[0].attr.values = values;
+		config.attrs[0].mask = mask;
+	} else {
+		config.flags = GPIO_V2_LINE_FLAG_INPUT;
+	}
+
+	if (ioctl(fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0)
+		return FAILURE;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Obtain the descriptor of a line of a GPIO character device.
+ * The line is requested once and kept until gpio_remove().
+ * @param desc - The GPIO descriptor.
+ * @param chip - Path of the character device, for example /dev/gpiochip0.
+ * @param offset - The line offset on the chip.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_get_line(gpio_desc **desc,
+		      const char *chip,
+		      uint32_t offset)
+{
+	gpio_desc *descriptor;
+
+	descriptor = (gpio_desc *)calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->fd = gpio_request_lines(chip, &offset, 1);
+	if (descriptor->fd < 0) {
+		printf("%s: Can't request line %"PRIu32" of %s\n\r", __func__,
+		       offset, chip);
+		free(descriptor);
+		return FAILURE;
+	}
+
+	if (gpio_read_direction(chip, offset,
+				&descriptor->direction) != SUCCESS)
+		descriptor->direction = GPIO_IN;
+	descriptor->offset = offset;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Obtain the GPIO decriptor.
+ * @param desc - The GPIO descriptor.
+ * @param gpio_number - The number of the GPIO, in the sysfs numbering.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_get(gpio_desc **desc,
+		 uint8_t gpio_number)
+{
+	char chip[300];
+	uint32_t offset;
+	int32_t ret;
+
+	ret = gpio_find_line(gpio_number, chip, &offset);
+	if (ret != SUCCESS) {
+		printf("%s: Can't find GPIO %d\n\r", __func__, gpio_number);
+		return FAILURE;
+	}
+
+	ret = gpio_get_line(desc, chip, offset);
+	if (ret != SUCCESS)
+		return FAILURE;
+
+	(*desc)->number = gpio_number;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by gpio_get().
+ * @param desc - The GPIO descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_remove(gpio_desc *desc)
+{
+	int ret;
+
+	ret = close(desc->fd);
+	free(desc);
+	if (ret < 0) {
+		printf("%s: Can't close device\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_direction_input(gpio_desc *desc)
+{
+	if (gpio_set_config(desc->fd, 1, 0, 0) != SUCCESS) {
+		printf("%s: Can't set direction\n\r", __func__);
+		return FAILURE;
+	}
+	desc->direction = GPIO_IN;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: GPIO_HIGH
+ *                         GPIO_LOW
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_direction_output(gpio_desc *desc,
+			      uint8_t value)
+{
+	if (gpio_set_config(desc->fd, 1, 1, value ? 1 : 0) != SUCCESS) {
+		printf("%s: Can't set direction\n\r", __func__);
+		return FAILURE;
+	}
+	desc->direction = GPIO_OUT;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ *                    Example: GPIO_OUT
+ *                             GPIO_IN
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_get_direction(gpio_desc *desc,
+			   uint8_t *direction)
+{
+	/* The line is owned by this descriptor, no one else can change it */
+	*direction = desc->direction;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: GPIO_HIGH
+ *                         GPIO_LOW
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_set_value(gpio_desc *desc,
+		       uint8_t value)
+{
+	struct gpio_v2_line_values values;
+
+	values.mask = 1;
+	values.bits = value ? 1 : 0;
+	if (ioctl(desc->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0) {
+		printf("%s: Can't set value\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: GPIO_HIGH
+ *                         GPIO_LOW
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_get_value(gpio_desc *desc,
+		       uint8_t *value)
+{
+	struct gpio_v2_line_values values;
+
+	values.mask = 1;
+	values.bits = 0;
+	if (ioctl(desc->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+		printf("%s: Can't get value\n\r", __func__);
+		return FAILURE;
+	}
+
+	*value = (values.bits & 1) ? GPIO_HIGH : GPIO_LOW;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Request several lines of a GPIO character device at once.
+ * Line i of the group is bit i of the masks and values of the group
+ * functions.
+ * @param desc - The GPIO group descriptor.
+ * @param chip - Path of the character device, for example /dev/gpiochip0.
+ * @param offsets - The line offsets on the chip.
+ * @param nb_lines - Number of lines, at most GPIO_GROUP_MAX_LINES.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_group_get(gpio_group_desc **desc,
+		       const char *chip,
+		       const uint32_t *offsets,
+		       uint8_t nb_lines)
+{
+	gpio_group_desc *descriptor;
+
+	if (!nb_lines || nb_lines > GPIO_GROUP_MAX_LINES)
+		return FAILURE;
+
+	descriptor = (gpio_group_desc *)calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return FAILURE;
+
+	descriptor->fd = gpio_request_lines(chip, offsets, nb_lines);
+	if (descriptor->fd < 0) {
+		printf("%s: Can't request lines of %s\n\r", __func__, chip);
+		free(descriptor);
+		return FAILURE;
+	}
+	descriptor->nb_lines = nb_lines;
+
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by gpio_group_get().
+ * @param desc - The GPIO group descriptor.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_group_remove(gpio_group_desc *desc)
+{
+	int ret;
+
+	ret = close(desc->fd);
+	free(desc);
+	if (ret < 0) {
+		printf("%s: Can't close device\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the direction of all the lines of a group.
+ * @param desc - The GPIO group descriptor.
+ * @param direction - GPIO_OUT or GPIO_IN.
+ * @param values - Initial values of the outputs.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_group_direction(gpio_group_desc *desc,
+			     uint8_t direction,
+			     uint64_t values)
+{
+	if (gpio_set_config(desc->fd, desc->nb_lines, direction == GPIO_OUT,
+			    values) != SUCCESS) {
+		printf("%s: Can't set direction\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the values of several lines of a group with a single call.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Lines to be set.
+ * @param values - The values.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_group_set_values(gpio_group_desc *desc,
+			      uint64_t mask,
+			      uint64_t values)
+{
+	struct gpio_v2_line_values lvalues;
+
+	lvalues.mask = mask;
+	lvalues.bits = values;
+	if (ioctl(desc->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lvalues) < 0) {
+		printf("%s: Can't set values\n\r", __func__);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the values of several lines of a group with a single call.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Lines to be read.
+ * @param values - The values. Bits not in mask are 0.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_group_get_values(gpio_group_desc *desc,
+			      uint64_t mask,
+			      uint64_t *values)
+{
+	struct gpio_v2_line_values lvalues;
+
+	lvalues.mask = mask;
+	lvalues.bits = 0;
+	if (ioctl(desc->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &lvalues) < 0) {
+		printf("%s: Can't get values\n\r", __func__);
+		return FAILURE;
+	}
+
+	*values = lvalues.bits & mask;
+
+	return SUCCESS;
+}
+
+#else /* GPIO_V2_GET_LINE_IOCTL */
+
 /**
  * @brief Obtain the GPIO decriptor.
  * @param desc - The GPIO descriptor.
@@ -554,6 +1174,56 @@ int32_t gpio_get_value(gpio_desc *desc,
 	return SUCCESS;
 }
 
+#endif /* GPIO_V2_GET_LINE_IOCTL */
+
+/**
+ * @brief Get the value of the monotonic clock.
+ * @return Time in nanoseconds.
+ */
+static uint64_t delay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * @brief Wait until the monotonic clock reaches a deadline.
+ * @param deadline - Deadline in nanoseconds.
+ * @return None.
+ */
+static void delay_until_ns(uint64_t deadline)
+{
+	struct timespec	ts;
+	uint64_t	wake;
+
+	if (deadline > LINUX_DELAY_SPIN_NS) {
+		wake = deadline - LINUX_DELAY_SPIN_NS;
+		if (wake > delay_now_ns()) {
+			ts.tv_sec = wake / NSEC_PER_SEC;
+			ts.tv_nsec = wake % NSEC_PER_SEC;
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+					       &ts, NULL) == EINTR)
+				;
+		}
+	}
+
+	while (delay_now_ns() < deadline)
+		;
+}
+
+/**
+ * @brief Generate nanoseconds delay.
+ * @param nsecs - Delay in nanoseconds.
+ * @return None.
+ */
+void ndelay(uint32_t nsecs)
+{
+	delay_until_ns(delay_now_ns() + nsecs);
+}
+
 /**
  * @brief Generate microseconds delay.
  * @param usecs - Delay in microseconds.
@@ -561,7 +1231,7 @@ int32_t gpio_get_value(gpio_desc *desc,
  */
 void udelay(uint32_t usecs)
 {
-	usleep(usecs);
+	delay_until_ns(delay_now_ns() + usecs * 1000ull);
 }
 
 /**
@@ -571,5 +1241,33 @@ void udelay(uint32_t usecs)
  */
 void mdelay(uint32_t msecs)
 {
-	usleep(msecs * 1000);
+	delay_until_ns(delay_now_ns() + msecs * 1000000ull);
+}
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ *
+ * The condition is checked once more after the deadline, so that a thread
+ * preempted while polling doesn't report a false timeout.
+ * @param cond - Condition, polled until it returns true.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
+{
+	uint64_t deadline;
+	uint64_t now;
+
+	deadline = delay_now_ns() + timeout_us * 1000ull;
+	while (!cond(ctx)) {
+		now = delay_now_ns();
+		if (now >= deadline)
+			return cond(ctx) ? SUCCESS : -ETIMEDOUT;
+		/* Let other threads run during long waits */
+		if (deadline - now > LINUX_DELAY_SPIN_NS)
+			sched_yield();
+	}
+
+	return SUCCESS;
 }
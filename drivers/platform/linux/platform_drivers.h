@@ -40,6 +40,13 @@
 #ifndef PLATFORM_DRIVERS_H_
 #define PLATFORM_DRIVERS_H_
 
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
@@ -56,6 +63,8 @@
 #define GPIO_HIGH	0x01
 #define GPIO_LOW	0x00
 
+#define GPIO_GROUP_MAX_LINES	64
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -78,6 +87,8 @@ typedef struct {
 	int		fd;
 	uint32_t	max_speed_hz;
 	uint8_t		slave_address;
+	/* Slave address last selected on fd, -1 if none */
+	int32_t		selected_address;
 } i2c_desc;
 
 typedef enum {
@@ -117,8 +128,21 @@ typedef struct {
 	gpio_type	type;
 	uint32_t	id;
 	uint8_t		number;
+	/* Line request file descriptor (GPIO character device only) */
+	int		fd;
+	/* Line offset on the chip (GPIO character device only) */
+	uint32_t	offset;
+	/* Cached direction (GPIO character device only) */
+	uint8_t		direction;
 } gpio_desc;
 
+typedef struct {
+	/* Line request file descriptor */
+	int		fd;
+	/* Number of requested lines */
+	uint8_t		nb_lines;
+} gpio_group_desc;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -133,15 +157,22 @@ int32_t i2c_remove(i2c_desc *desc);
 /* Write data to a slave device. */
 int32_t i2c_write(i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t option);
 
 /* Read data from a slave device. */
 int32_t i2c_read(i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t option);
 
+/* Write data then read data from a slave device, with a repeated start. */
+int32_t i2c_write_then_read(i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number);
+
 /* Initialize the SPI communication peripheral. */
 int32_t spi_init(spi_desc **desc,
 		 const spi_init_param *param);
@@ -180,10 +211,50 @@ int32_t gpio_set_value(gpio_desc *desc,
 int32_t gpio_get_value(gpio_desc *desc,
 		       uint8_t *value);
 
+/*
+ * The following need the GPIO character device uAPI v2 (Linux 5.10). With
+ * older kernel headers the sysfs interface is used and they are missing.
+ */
+
+/* Obtain the descriptor of a line of a GPIO character device. */
+int32_t gpio_get_line(gpio_desc **desc,
+		      const char *chip,
+		      uint32_t offset);
+
+/* Request several lines of a GPIO character device at once. */
+int32_t gpio_group_get(gpio_group_desc **desc,
+		       const char *chip,
+		       const uint32_t *offsets,
+		       uint8_t nb_lines);
+
+/* Free the resources allocated by gpio_group_get(). */
+int32_t gpio_group_remove(gpio_group_desc *desc);
+
+/* Set the direction of all the lines of a group. */
+int32_t gpio_group_direction(gpio_group_desc *desc,
+			     uint8_t direction,
+			     uint64_t values);
+
+/* Set the values of several lines of a group. */
+int32_t gpio_group_set_values(gpio_group_desc *desc,
+			      uint64_t mask,
+			      uint64_t values);
+
+/* Get the values of several lines of a group. */
+int32_t gpio_group_get_values(gpio_group_desc *desc,
+			      uint64_t mask,
+			      uint64_t *values);
+
 /* Generate microseconds delay. */
 void udelay(uint32_t usecs);
 
 /* Generate miliseconds delay. */
 void mdelay(uint32_t msecs);
 
+/* Generate nanoseconds delay. */
+void ndelay(uint32_t nsecs);
+
+/* Wait until a condition is true or a timeout expires. */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us);
+
 #endif // PLATFORM_DRIVERS_H_
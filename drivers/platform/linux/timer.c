@@ -0,0 +1,506 @@
+/***************************************************************************//**
+ *   @file   linux/timer.c
+ *   @brief  Implementation of the timer driver over the monotonic clock.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include "error.h"
+#include "timer.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_timer_desc
+ * @brief Linux specific timer descriptor
+ */
+struct linux_timer_desc {
+	/** Monotonic time in ns corresponding to the load value */
+	uint64_t	start_ns;
+	/** Counter value while the timer is stopped */
+	uint32_t	stopped_value;
+	/** Set while the timer is counting */
+	bool		running;
+	/** Thread calling the callback */
+	pthread_t	thread;
+	/** Set while the callback thread must be joined */
+	bool		thread_started;
+	/** Protects the callback fields */
+	pthread_mutex_t	lock;
+	/** Signaled to wake up the callback thread */
+	pthread_cond_t	cond;
+	/** Function set by timer_set_periodic/oneshot(), NULL if none */
+	void		(*callback)(void *ctx);
+	/** Parameter for the callback */
+	void		*ctx;
+	/** Callback period in ns, 0 for one-shot callbacks */
+	uint64_t	period_ns;
+	/** Monotonic time in ns of the next call */
+	uint64_t	next_ns;
+	/** Incremented by timer_cancel() to stop the callback thread */
+	uint32_t	generation;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Get the monotonic time in ns */
+static uint64_t timer_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* Get the counter value at the given time */
+static uint32_t timer_value_at(struct timer_desc *desc, uint64_t now_ns)
+{
+	struct linux_timer_desc	*ldesc = desc->extra;
+	uint64_t		elapsed;
+
+	elapsed = now_ns - ldesc->start_ns;
+
+	/* Split to avoid overflowing for high frequencies */
+	return desc->load_value +
+	       (uint32_t)((elapsed / 1000000000ull) * desc->freq_hz +
+			  (elapsed % 1000000000ull) * desc->freq_hz /
+			  1000000000ull);
+}
+
+/* Set the start time so that the counter has the value now */
+static void timer_rebase(struct timer_desc *desc, uint32_t value)
+{
+	struct linux_timer_desc	*ldesc = desc->extra;
+	uint64_t		ticks;
+
+	ticks = (uint32_t)(value - desc->load_value);
+	ldesc->start_ns = timer_now_ns() -
+			  ticks * 1000000000ull / desc->freq_hz;
+}
+
+/* Initialize the mutex and the condition, which waits on the monotonic clock */
+static int32_t timer_sync_init(struct linux_timer_desc *ldesc)
+{
+	pthread_condattr_t	attr;
+	int			ret;
+
+	ret = pthread_mutex_init(&ldesc->lock, NULL);
+	if (ret)
+		return -ret;
+
+	ret = pthread_condattr_init(&attr);
+	if (ret)
+		goto error_mutex;
+	ret = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (!ret)
+		ret = pthread_cond_init(&ldesc->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	if (ret)
+		goto error_mutex;
+
+	return SUCCESS;
+
+error_mutex:
+	pthread_mutex_destroy(&ldesc->lock);
+
+	return -ret;
+}
+
+/**
+ * @brief Initialize the timer. The counter counts up at freq_hz, starting
+ * from load_value, using the monotonic clock of the host.
+ * @param desc - Pointer to the device handler.
+ * @param param - Pointer to the initialization structure.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_init(struct timer_desc **desc,
+		   struct timer_init_param *param)
+{
+	struct linux_timer_desc	*ldesc;
+	struct timer_desc	*tdesc;
+	int32_t			ret;
+
+	if (!desc || !param || !param->freq_hz ||
+	    param->freq_hz > 1000000000)
+		return -EINVAL;
+
+	tdesc = (struct timer_desc *)calloc(1, sizeof(*tdesc));
+	if (!tdesc)
+		return -ENOMEM;
+
+	ldesc = (struct linux_timer_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		free(tdesc);
+		return -ENOMEM;
+	}
+
+	ret = timer_sync_init(ldesc);
+	if (ret != SUCCESS) {
+		free(ldesc);
+		free(tdesc);
+		return ret;
+	}
+
+	tdesc->id = param->id;
+	tdesc->freq_hz = param->freq_hz;
+	tdesc->load_value = param->load_value;
+	tdesc->extra = ldesc;
+	ldesc->stopped_value = param->load_value;
+
+	*desc = tdesc;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the memory allocated by timer_init().
+ * @param desc - Pointer to the device handler.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_remove(struct timer_desc *desc)
+{
+	struct linux_timer_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	timer_cancel(desc);
+	pthread_cond_destroy(&ldesc->cond);
+	pthread_mutex_destroy(&ldesc->lock);
+	free(ldesc);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Start the timer from the current counter value.
+ * @param desc - Pointer to the device handler.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_start(struct timer_desc *desc)
+{
+	struct linux_timer_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	if (ldesc->running)
+		return SUCCESS;
+
+	timer_rebase(desc, ldesc->stopped_value);
+	ldesc->running = true;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Stop the timer. The counter keeps its value.
+ * @param desc - Pointer to the device handler.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_stop(struct timer_desc *desc)
+{
+	struct linux_timer_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	if (!ldesc->running)
+		return SUCCESS;
+
+	ldesc->stopped_value = timer_value_at(desc, timer_now_ns());
+	ldesc->running = false;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the value of the counter.
+ * @param desc - Pointer to the device handler.
+ * @param counter - Pointer to the counter value.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_counter_get(struct timer_desc *desc, uint32_t *counter)
+{
+	struct linux_timer_desc *ldesc;
+
+	if (!desc || !counter)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	if (ldesc->running)
+		*counter = timer_value_at(desc, timer_now_ns());
+	else
+		*counter = ldesc->stopped_value;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the value of the counter.
+ * @param desc - Pointer to the device handler.
+ * @param new_val - Value to be set.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_counter_set(struct timer_desc *desc, uint32_t new_val)
+{
+	struct linux_timer_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	if (ldesc->running)
+		timer_rebase(desc, new_val);
+	else
+		ldesc->stopped_value = new_val;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the frequency of the counter.
+ * @param desc - Pointer to the device handler.
+ * @param freq_hz - Pointer to the frequency value.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_count_clk_get(struct timer_desc *desc, uint32_t *freq_hz)
+{
+	if (!desc || !freq_hz)
+		return -EINVAL;
+
+	*freq_hz = desc->freq_hz;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Set the frequency of the counter. The counter keeps its value.
+ * @param desc - Pointer to the device handler.
+ * @param freq_hz - New frequency, at most 1 GHz.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_count_clk_set(struct timer_desc *desc, uint32_t freq_hz)
+{
+	uint32_t value;
+
+	if (!desc || !freq_hz || freq_hz > 1000000000)
+		return -EINVAL;
+
+	timer_counter_get(desc, &value);
+	desc->freq_hz = freq_hz;
+	timer_counter_set(desc, value);
+
+	return SUCCESS;
+}
+
+/* Call the callback at the absolute deadlines until cancelled */
+static void *timer_thread(void *arg)
+{
+	struct linux_timer_desc	*ldesc = arg;
+	struct timespec		ts;
+	uint32_t		generation;
+	uint64_t		now;
+	void			(*callback)(void *ctx);
+	void			*ctx;
+
+	pthread_mutex_lock(&ldesc->lock);
+	generation = ldesc->generation;
+	while (generation == ldesc->generation) {
+		now = timer_now_ns();
+		if (now < ldesc->next_ns) {
+			ts.tv_sec = ldesc->next_ns / 1000000000ull;
+			ts.tv_nsec = ldesc->next_ns % 1000000000ull;
+			pthread_cond_timedwait(&ldesc->cond, &ldesc->lock, &ts);
+			continue;
+		}
+
+		callback = ldesc->callback;
+		ctx = ldesc->ctx;
+		if (!ldesc->period_ns) {
+			ldesc->callback = NULL;
+		} else {
+			/* Skip the periods missed by a slow callback */
+			do {
+				ldesc->next_ns += ldesc->period_ns;
+			} while (ldesc->next_ns <= now);
+		}
+
+		pthread_mutex_unlock(&ldesc->lock);
+		callback(ctx);
+		pthread_mutex_lock(&ldesc->lock);
+
+		if (!ldesc->period_ns)
+			break;
+	}
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return NULL;
+}
+
+/* Start the callback thread */
+static int32_t timer_set_callback(struct timer_desc *desc, uint64_t time_ns,
+				  bool periodic, void (*callback)(void *ctx),
+				  void *ctx)
+{
+	struct linux_timer_desc	*ldesc;
+	int			ret;
+
+	if (!desc || !callback || !time_ns)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	timer_cancel(desc);
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->callback = callback;
+	ldesc->ctx = ctx;
+	ldesc->period_ns = periodic ? time_ns : 0;
+	ldesc->next_ns = timer_now_ns() + time_ns;
+	ret = pthread_create(&ldesc->thread, NULL, timer_thread, ldesc);
+	if (ret)
+		ldesc->callback = NULL;
+	else
+		ldesc->thread_started = true;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return -ret;
+}
+
+/**
+ * @brief Call a function periodically, from a thread of the timer.
+ *
+ * The deadlines are absolute, so the period does not drift. The periods missed
+ * while the function runs are skipped.
+ * @param desc - Pointer to the device handler.
+ * @param period_us - Period in microseconds.
+ * @param callback - Function to call.
+ * @param ctx - Parameter for the function.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_set_periodic(struct timer_desc *desc, uint32_t period_us,
+			   void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, period_us * 1000ull, true, callback,
+				  ctx);
+}
+
+/**
+ * @brief Call a function once, from a thread of the timer, after a delay.
+ * @param desc - Pointer to the device handler.
+ * @param delay_us - Delay in microseconds.
+ * @param callback - Function to call.
+ * @param ctx - Parameter for the function.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_set_oneshot(struct timer_desc *desc, uint32_t delay_us,
+			  void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, delay_us * 1000ull, false, callback,
+				  ctx);
+}
+
+/**
+ * @brief Stop calling the function set by timer_set_periodic/oneshot().
+ *
+ * When called from outside the callback, the function is not running anymore
+ * when this returns.
+ * @param desc - Pointer to the device handler.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_cancel(struct timer_desc *desc)
+{
+	struct linux_timer_desc	*ldesc;
+	pthread_t		thread;
+	bool			started;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->generation++;
+	ldesc->callback = NULL;
+	started = ldesc->thread_started;
+	thread = ldesc->thread;
+	ldesc->thread_started = false;
+	pthread_cond_signal(&ldesc->cond);
+	pthread_mutex_unlock(&ldesc->lock);
+
+	if (!started)
+		return SUCCESS;
+
+	/* The callback can't wait for itself to return */
+	if (pthread_equal(thread, pthread_self()))
+		pthread_detach(thread);
+	else
+		pthread_join(thread, NULL);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get a 64-bit monotonic timestamp in nanoseconds.
+ * @param desc - Pointer to the device handler.
+ * @param ns - Pointer to the timestamp.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t timer_get_time_ns(struct timer_desc *desc, uint64_t *ns)
+{
+	if (!desc || !ns)
+		return -EINVAL;
+
+	*ns = timer_now_ns();
+
+	return SUCCESS;
+}
@@ -0,0 +1,397 @@
+/***************************************************************************//**
+ *   @file   linux/uart.c
+ *   @brief  Implementation of the UART driver over a termios serial device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include "error.h"
+#include "irq.h"
+#include "irq_extra.h"
+#include "uart.h"
+#include "uart_extra.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Convert a baud rate to the termios speed constant.
+ * @param baud_rate - Baud rate.
+ * @param speed - Termios speed.
+ * @return SUCCESS in case of success, -EINVAL for unsupported rates.
+ */
+static int32_t uart_get_speed(uint32_t baud_rate, speed_t *speed)
+{
+	static const struct {
+		uint32_t	rate;
+		speed_t		speed;
+	} speeds[] = {
+		{9600, B9600}, {19200, B19200}, {38400, B38400},
+		{57600, B57600}, {115200, B115200}, {230400, B230400},
+#ifdef B460800
+		{460800, B460800}, {921600, B921600}, {1000000, B1000000},
+		{2000000, B2000000}, {3000000, B3000000}, {4000000, B4000000},
+#endif
+	};
+	uint32_t i;
+
+	for (i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++)
+		if (speeds[i].rate == baud_rate) {
+			*speed = speeds[i].speed;
+			return SUCCESS;
+		}
+
+	return -EINVAL;
+}
+
+/**
+ * @brief Read data from UART device. Blocks until all the data is received
+ * or the read timeout expires.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to read.
+ * @return Number of bytes read in case of success, negative error code
+ * otherwise.
+ */
+int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
+{
+	struct linux_uart_desc	*ldesc;
+	struct pollfd		pfd;
+	uint32_t		i;
+	ssize_t			ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	pfd.fd = ldesc->fd;
+	pfd.events = POLLIN;
+	i = 0;
+	while (i < bytes_number) {
+		ret = poll(&pfd, 1, ldesc->read_timeout_ms ?
+			   (int)ldesc->read_timeout_ms : -1);
+		if (ret == 0)
+			return i ? (int32_t)i : -ETIMEDOUT;
+		if (ret > 0)
+			ret = read(ldesc->fd, data + i, bytes_number - i);
+		if (ret < 0) {
+			if (errno == EINTR || errno == EAGAIN)
+				continue;
+			ldesc->errors++;
+			return -errno;
+		}
+		i += ret;
+	}
+
+	return i;
+}
+
+/**
+ * @brief Write data to UART device. Blocks until all the data is
+ * transmitted.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes written in case of success, negative error code
+ * otherwise.
+ */
+int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
+		   uint32_t bytes_number)
+{
+	struct linux_uart_desc	*ldesc;
+	struct pollfd		pfd;
+	uint32_t		i;
+	int32_t			ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	pfd.fd = ldesc->fd;
+	pfd.events = POLLOUT;
+	i = 0;
+	while (i < bytes_number) {
+		ret = uart_write_nonblocking(desc, data + i, bytes_number - i);
+		if (ret == -EAGAIN) {
+			/* Kernel buffer full, wait for room */
+			if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+				ldesc->errors++;
+				return -errno;
+			}
+			continue;
+		}
+		if (IS_ERR_VALUE(ret))
+			return ret;
+		i += ret;
+	}
+
+	if (tcdrain(ldesc->fd)) {
+		ldesc->errors++;
+		return -errno;
+	}
+
+	return i;
+}
+
+/**
+ * @brief Read the data already received by the UART device, without waiting.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read, 0 if no data is available or negative error
+ * code otherwise.
+ */
+int32_t uart_read_nonblocking(struct uart_desc *desc, uint8_t *data,
+			      uint32_t bytes_number)
+{
+	struct linux_uart_desc	*ldesc;
+	ssize_t			ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	do {
+		ret = read(ldesc->fd, data, bytes_number);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0) {
+		if (errno == EAGAIN)
+			return 0;
+		ldesc->errors++;
+		return -errno;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Queue data for transmission, without waiting. Only the data that
+ * fits in the kernel buffer is queued.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes queued, -EAGAIN if the kernel buffer is full or
+ * negative error code otherwise.
+ */
+int32_t uart_write_nonblocking(struct uart_desc *desc, const uint8_t *data,
+			       uint32_t bytes_number)
+{
+	struct linux_uart_desc	*ldesc;
+	uint32_t		i;
+	ssize_t			ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	i = 0;
+	while (i < bytes_number) {
+		ret = write(ldesc->fd, data + i, bytes_number - i);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN)
+				return i ? (int32_t)i : -EAGAIN;
+			ldesc->errors++;
+			return -errno;
+		}
+		i += ret;
+	}
+
+	return i;
+}
+
+/**
+ * @brief Called by the IRQ controller when the device has data to read.
+ * @param ctx - Instance of UART.
+ * @param event - Number of events so far, not used.
+ * @param extra - Not used.
+ */
+static void uart_rx_handler(void *ctx, uint32_t event, void *extra)
+{
+	struct uart_desc	*desc = ctx;
+	struct linux_uart_desc	*ldesc = desc->extra;
+	void			(*callback)(void *callback_ctx, uint32_t event,
+					    void *extra);
+
+	callback = desc->callback;
+	if (!callback) {
+		/* Nobody reads the data, stop watching until enabled again */
+		irq_disable(ldesc->irq_desc, ldesc->irq_id);
+		return;
+	}
+
+	callback(desc->callback_ctx, READ_DONE, NULL);
+}
+
+/**
+ * @brief Initialize the UART communication peripheral.
+ * @param desc - The UART descriptor.
+ * @param param - The structure that contains the UART parameters.
+ * extra must point to a struct linux_uart_init_param.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
+{
+	struct linux_uart_init_param	*lparam;
+	struct linux_uart_desc		*ldesc;
+	struct uart_desc		*udesc;
+	struct callback_desc		callback_desc;
+	struct termios			tio;
+	speed_t				speed;
+	int32_t				ret;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	lparam = param->extra;
+	ret = uart_get_speed(param->baud_rate, &speed);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	udesc = (struct uart_desc *)calloc(1, sizeof(*udesc));
+	if (!udesc)
+		return -ENOMEM;
+
+	ldesc = (struct linux_uart_desc *)calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		ret = -ENOMEM;
+		goto error_desc;
+	}
+
+	ldesc->fd = open(lparam->device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (ldesc->fd < 0) {
+		ret = -errno;
+		goto error_extra;
+	}
+
+	if (tcgetattr(ldesc->fd, &tio)) {
+		ret = -errno;
+		goto error_fd;
+	}
+
+	/* Raw 8N1, no flow control */
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+	tio.c_cc[VMIN] = 0;
+	tio.c_cc[VTIME] = 0;
+	cfsetispeed(&tio, speed);
+	cfsetospeed(&tio, speed);
+	if (tcsetattr(ldesc->fd, TCSANOW, &tio)) {
+		ret = -errno;
+		goto error_fd;
+	}
+	tcflush(ldesc->fd, TCIOFLUSH);
+
+	ldesc->read_timeout_ms = lparam->read_timeout_ms;
+	udesc->device_id = param->device_id;
+	udesc->baud_rate = param->baud_rate;
+	udesc->extra = ldesc;
+
+	if (lparam->irq_desc) {
+		callback_desc.callback = uart_rx_handler;
+		callback_desc.ctx = udesc;
+		callback_desc.config = NULL;
+		ret = linux_irq_register_fd(lparam->irq_desc, lparam->irq_id,
+					    ldesc->fd, &callback_desc);
+		if (IS_ERR_VALUE(ret))
+			goto error_fd;
+		ldesc->irq_desc = lparam->irq_desc;
+		ldesc->irq_id = lparam->irq_id;
+	}
+
+	*desc = udesc;
+
+	return SUCCESS;
+
+error_fd:
+	close(ldesc->fd);
+error_extra:
+	free(ldesc);
+error_desc:
+	free(udesc);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by uart_init().
+ * @param desc - The UART descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t uart_remove(struct uart_desc *desc)
+{
+	struct linux_uart_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	if (ldesc->irq_desc)
+		irq_unregister(ldesc->irq_desc, ldesc->irq_id);
+	close(ldesc->fd);
+	free(ldesc);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the number of failed reads and writes.
+ * @param desc - The UART descriptor.
+ * @return Number of errors.
+ */
+uint32_t uart_get_errors(struct uart_desc *desc)
+{
+	struct linux_uart_desc *ldesc;
+
+	if (!desc)
+		return 0;
+
+	ldesc = desc->extra;
+
+	return ldesc->errors;
+}
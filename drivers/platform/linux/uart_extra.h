@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ *   @file   linux/uart_extra.h
+ *   @brief  Header file of the Linux termios UART driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef UART_EXTRA_H_
+#define UART_EXTRA_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "irq.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_uart_init_param
+ * @brief Linux specific UART parameters, given as uart_init_param.extra
+ */
+struct linux_uart_init_param {
+	/** Serial device path, for example /dev/ttyUSB0 */
+	const char	*device;
+	/** Maximum time to wait for data in uart_read(). 0 to wait forever */
+	uint32_t	read_timeout_ms;
+	/**
+	 * Optional Linux IRQ controller. If set, the device is watched as
+	 * interrupt irq_id and uart_desc.callback is called with READ_DONE,
+	 * from the thread of the controller, when data is received. The
+	 * callback must read the data with uart_read_nonblocking().
+	 * The events are delivered once irq_enable() is called for irq_id.
+	 */
+	struct irq_ctrl_desc	*irq_desc;
+	/** Interrupt id of the device on irq_desc, not used by a UIO device */
+	uint32_t	irq_id;
+};
+
+/**
+ * @struct linux_uart_desc
+ * @brief Linux specific UART descriptor
+ */
+struct linux_uart_desc {
+	/** Serial device file descriptor */
+	int		fd;
+	/** Maximum time to wait for data in uart_read() */
+	uint32_t	read_timeout_ms;
+	/** Number of failed reads and writes */
+	uint32_t	errors;
+	/** IRQ controller delivering the receive events, NULL if none */
+	struct irq_ctrl_desc	*irq_desc;
+	/** Interrupt id of the device on irq_desc */
+	uint32_t	irq_id;
+};
+
+#endif /* UART_EXTRA_H_ */
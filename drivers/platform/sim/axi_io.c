@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ *   @file   sim/axi_io.c
+ *   @brief  Implementation of the simulation platform AXI IO driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include "error.h"
+#include "axi_io.h"
+#include "bus_stats.h"
+#include "sim_bus.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Forward an AXI access to the model attached to the address and
+ * account its duration.
+ * @param address - Absolute address.
+ * @param data - Location of the read or written data.
+ * @param write - True for a write access.
+ * @return SUCCESS in case of success, -ENODEV if no model handles the address,
+ * the model error code otherwise.
+ */
+static int32_t sim_axi_access(uint32_t address, uint32_t *data, bool write)
+{
+	struct sim_model *model;
+	struct sim_timing timing;
+	uint32_t offset;
+	int32_t ret;
+
+	model = sim_axi_find(address, &offset);
+	if (!model)
+		ret = -ENODEV;
+	else if (write)
+		ret = model->ops->axi_write(model->priv, offset, *data);
+	else
+		ret = model->ops->axi_read(model->priv, offset, data);
+
+	if (ret < 0 && !write)
+		*data = 0;
+
+	sim_get_timing(&timing);
+	sim_account(sizeof(*data), timing.axi_access_ns, ret);
+
+	return ret;
+}
+
+/**
+ * @brief AXI IO simulation platform specific read function.
+ * @param base - Base address
+ * @param offset - Address offset
+ * @param data - variable where returned data is stored
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(*data),
+			      sim_axi_access(base + offset, data, false));
+}
+
+/**
+ * @brief AXI IO simulation platform specific write function.
+ * @param base - Base address
+ * @param offset - Address offset
+ * @param data - data to be written.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	return BUS_STATS_CALL(bus_stats_axi(base), sizeof(data),
+			      sim_axi_access(base + offset, &data, true));
+}
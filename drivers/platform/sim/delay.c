@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ *   @file   sim/delay.c
+ *   @brief  Implementation of the simulation platform delay functions.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "delay.h"
+#include "error.h"
+#include "sim_bus.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*
+ * The delays don't sleep, they only advance the simulated time, so the
+ * drivers run as fast as the host allows while the reported times stay the
+ * ones of the real hardware.
+ */
+
+/**
+ * @brief Generate microseconds delay.
+ * @param usecs - Delay in microseconds.
+ * @return None.
+ */
+void udelay(uint32_t usecs)
+{
+	sim_advance_ns((uint64_t)usecs * 1000);
+}
+
+/**
+ * @brief Generate miliseconds delay.
+ * @param msecs - Delay in miliseconds.
+ * @return None.
+ */
+void mdelay(uint32_t msecs)
+{
+	sim_advance_ns((uint64_t)msecs * 1000000);
+}
+
+/**
+ * @brief Generate nanoseconds delay.
+ * @param nsecs - Delay in nanoseconds.
+ * @return None.
+ */
+void ndelay(uint32_t nsecs)
+{
+	sim_advance_ns(nsecs);
+}
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ * @param cond - Condition, polled until it returns true. Bus accesses done by
+ * the condition advance the simulated time; a condition that does none is
+ * polled once per simulated microsecond.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
+{
+	uint64_t deadline = sim_get_time_ns() + (uint64_t)timeout_us * 1000;
+	uint64_t before;
+
+	while (1) {
+		before = sim_get_time_ns();
+		if (cond(ctx))
+			return SUCCESS;
+		if (sim_get_time_ns() >= deadline)
+			return -ETIMEDOUT;
+		if (sim_get_time_ns() == before)
+			sim_advance_ns(1000);
+	}
+}
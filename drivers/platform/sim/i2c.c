@@ -0,0 +1,279 @@
+/***************************************************************************//**
+ *   @file   sim/i2c.c
+ *   @brief  Implementation of the simulation platform I2C driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "i2c.h"
+#include "i2c_extra.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the I2C communication peripheral.
+ * @param desc - The I2C descriptor.
+ * @param param - The structure that contains the I2C parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t i2c_init(struct i2c_desc **desc,
+		 const struct i2c_init_param *param)
+{
+	struct i2c_desc *descriptor;
+	struct sim_i2c_desc *sim_desc;
+	struct sim_i2c_init_param *sim_param;
+
+	if (!param || !param->extra || !param->max_speed_hz)
+		return -EINVAL;
+
+	sim_param = param->extra;
+	if (!sim_param->model || !sim_param->model->ops->i2c_write ||
+	    !sim_param->model->ops->i2c_read)
+		return -EINVAL;
+
+	descriptor = calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	sim_desc = calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		free(descriptor);
+		return -ENOMEM;
+	}
+
+	sim_desc->model = sim_param->model;
+
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->slave_address = param->slave_address;
+	descriptor->extra = sim_desc;
+
+	bus_stats_register(&descriptor->stats, "i2c",
+			   descriptor->slave_address);
+	*desc = descriptor;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by i2c_init().
+ * @param desc - The I2C descriptor.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t i2c_remove(struct i2c_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	bus_stats_unregister(&desc->stats);
+	free(desc->extra);
+	free(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Account the time an I2C transfer would take on the bus: the address
+ * byte and the data bytes, 9 clocks each, plus the start and stop overhead.
+ * @param desc - The I2C descriptor.
+ * @param bytes_number - Number of data bytes.
+ * @param status - Status returned by the model.
+ * @return None.
+ */
+static void sim_i2c_account(struct i2c_desc *desc, uint32_t bytes_number,
+			    int32_t status)
+{
+	struct sim_timing timing;
+	uint64_t ns;
+
+	sim_get_timing(&timing);
+	ns = sim_bits_ns((uint64_t)(bytes_number + 1) * 9, desc->max_speed_hz);
+	sim_account(bytes_number, ns + timing.i2c_overhead_ns, status);
+}
+
+/**
+ * @brief Simulation platform specific I2C write, see i2c_write().
+ */
+static int32_t sim_i2c_write(struct i2c_desc *desc,
+			     uint8_t *data,
+			     uint32_t bytes_number,
+			     uint8_t stop_bit)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_model *model;
+	int32_t ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	model = sim_desc->model;
+
+	ret = model->ops->i2c_write(model->priv, data, bytes_number, stop_bit);
+	sim_i2c_account(desc, bytes_number, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Write data to a slave device.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer that stores the transmission data.
+ * @param bytes_number - Number of bytes to write.
+ * @param stop_bit - Stop condition control.
+ *                   Example: 0 - A stop condition will not be generated;
+ *                            1 - A stop condition will be generated.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t i2c_write(struct i2c_desc *desc,
+		  uint8_t *data,
+		  uint32_t bytes_number,
+		  uint8_t stop_bit)
+{
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      sim_i2c_write(desc, data, bytes_number,
+					    stop_bit));
+}
+
+/**
+ * @brief Simulation platform specific I2C read, see i2c_read().
+ */
+static int32_t sim_i2c_read(struct i2c_desc *desc,
+			    uint8_t *data,
+			    uint32_t bytes_number,
+			    uint8_t stop_bit)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_model *model;
+	int32_t ret;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	model = sim_desc->model;
+
+	ret = model->ops->i2c_read(model->priv, data, bytes_number, stop_bit);
+	sim_i2c_account(desc, bytes_number, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Read data from a slave device.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer that will store the received data.
+ * @param bytes_number - Number of bytes to read.
+ * @param stop_bit - Stop condition control.
+ *                   Example: 0 - A stop condition will not be generated;
+ *                            1 - A stop condition will be generated.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t i2c_read(struct i2c_desc *desc,
+		 uint8_t *data,
+		 uint32_t bytes_number,
+		 uint8_t stop_bit)
+{
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      sim_i2c_read(desc, data, bytes_number,
+					   stop_bit));
+}
+
+/**
+ * @brief Simulation platform specific I2C write then read, see
+ * i2c_write_then_read(). The model sees a write without stop followed by a
+ * read and the bus time is that of one transaction with a repeated start.
+ */
+static int32_t sim_i2c_write_then_read(struct i2c_desc *desc,
+				       uint8_t *wr_data,
+				       uint32_t wr_bytes_number,
+				       uint8_t *rd_data,
+				       uint32_t rd_bytes_number)
+{
+	struct sim_i2c_desc *sim_desc;
+	struct sim_timing timing;
+	struct sim_model *model;
+	uint64_t ns;
+	int32_t ret;
+
+	if (!desc || !wr_data || !rd_data)
+		return -EINVAL;
+
+	sim_desc = desc->extra;
+	model = sim_desc->model;
+
+	ret = model->ops->i2c_write(model->priv, wr_data, wr_bytes_number, 0);
+	if (ret == SUCCESS)
+		ret = model->ops->i2c_read(model->priv, rd_data,
+					   rd_bytes_number, 1);
+
+	/* Two address bytes, one after the start and one after the restart */
+	sim_get_timing(&timing);
+	ns = sim_bits_ns((uint64_t)(wr_bytes_number + rd_bytes_number + 2) * 9,
+			 desc->max_speed_hz);
+	sim_account(wr_bytes_number + rd_bytes_number,
+		    ns + timing.i2c_overhead_ns, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Write data then read data from a slave device, with a repeated
+ * start and no stop condition between the two.
+ * @param desc - The I2C descriptor.
+ * @param wr_data - Buffer that stores the transmission data.
+ * @param wr_bytes_number - Number of bytes to write.
+ * @param rd_data - Buffer that will store the received data.
+ * @param rd_bytes_number - Number of bytes to read.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t i2c_write_then_read(struct i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number)
+{
+	return BUS_STATS_CALL(&desc->stats, wr_bytes_number + rd_bytes_number,
+			      sim_i2c_write_then_read(desc, wr_data,
+						      wr_bytes_number,
+						      rd_data,
+						      rd_bytes_number));
+}
@@ -0,0 +1,334 @@
+/***************************************************************************//**
+ *   @file   sim/sim_ad7124.c
+ *   @brief  Register-map model of the AD7124.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "sim_models.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define AD7124_SIM_REG_NO		0x39
+#define AD7124_SIM_STATUS		0x00
+#define AD7124_SIM_ADC_CTRL		0x01
+#define AD7124_SIM_DATA			0x02
+#define AD7124_SIM_ID			0x05
+#define AD7124_SIM_ERROR		0x06
+#define AD7124_SIM_ERROR_EN		0x07
+
+#define AD7124_SIM_COMM_WEN		0x80
+#define AD7124_SIM_COMM_RD		0x40
+#define AD7124_SIM_COMM_RA(x)		((x) & 0x3F)
+#define AD7124_SIM_STATUS_RDY		0x80
+#define AD7124_SIM_STATUS_POR		0x10
+#define AD7124_SIM_CTRL_DATA_STATUS	0x400
+#define AD7124_SIM_ERR_CRC		0x04
+#define AD7124_SIM_ERREN_CRC		0x04
+
+#define AD7124_SIM_CRC8_POLY		0x07
+#define AD7124_SIM_DEFAULT_CONV_NS	1000000
+#define AD7124_SIM_DEFAULT_ID		0x14
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad7124
+ * @brief AD7124 model state.
+ */
+struct sim_ad7124 {
+	/** Register values */
+	uint32_t	regs[AD7124_SIM_REG_NO];
+	/** Conversion time */
+	uint32_t	conv_ns;
+	/** Value of the ID register */
+	uint8_t		id;
+	/** Simulated time at which the next conversion is ready */
+	uint64_t	ready_ns;
+	/** Number of conversions read, used as synthetic data */
+	uint32_t	sample;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Get the size of a register.
+ * @param addr - Register address.
+ * @return Size in bytes.
+ */
+static uint8_t sim_ad7124_reg_size(uint8_t addr)
+{
+	switch (addr) {
+	case AD7124_SIM_STATUS:
+	case AD7124_SIM_ID:
+	case 0x08:
+		return 1;
+	case AD7124_SIM_ADC_CTRL:
+	case 0x04:
+		return 2;
+	default:
+		return (addr >= 0x09 && addr <= 0x20) ? 2 : 3;
+	}
+}
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_ad7124_reset(struct sim_ad7124 *dev)
+{
+	uint8_t i;
+
+	memset(dev->regs, 0, sizeof(dev->regs));
+	dev->regs[AD7124_SIM_STATUS] = AD7124_SIM_STATUS_RDY |
+				       AD7124_SIM_STATUS_POR;
+	dev->regs[AD7124_SIM_ID] = dev->id;
+	dev->regs[AD7124_SIM_ERROR_EN] = 0x40;
+	dev->regs[0x09] = 0x8001;
+	for (i = 0x0A; i <= 0x18; i++)
+		dev->regs[i] = 0x0001;
+	for (i = 0x19; i <= 0x20; i++)
+		dev->regs[i] = 0x0860;
+	for (i = 0x21; i <= 0x28; i++)
+		dev->regs[i] = 0x060180;
+	for (i = 0x29; i <= 0x30; i++)
+		dev->regs[i] = 0x800000;
+	for (i = 0x31; i <= 0x38; i++)
+		dev->regs[i] = 0x500000;
+	dev->ready_ns = sim_get_time_ns() + dev->conv_ns;
+}
+
+/**
+ * @brief Compute the CRC8 used on the SPI interface.
+ * @param buf - Data.
+ * @param len - Data length.
+ * @return The CRC.
+ */
+static uint8_t sim_ad7124_crc8(const uint8_t *buf, uint32_t len)
+{
+	uint8_t crc = 0;
+	uint8_t i;
+
+	while (len--) {
+		crc ^= *buf++;
+		for (i = 0; i < 8; i++)
+			crc = (crc & 0x80) ? (crc << 1) ^ AD7124_SIM_CRC8_POLY :
+			      crc << 1;
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Create the model.
+ * @param priv - The model state.
+ * @param param - struct sim_ad7124_init_param, or NULL for the defaults.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t sim_ad7124_init(void **priv, const void *param)
+{
+	const struct sim_ad7124_init_param *init = param;
+	struct sim_ad7124 *dev;
+
+	dev = calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	dev->conv_ns = (init && init->conv_ns) ? init->conv_ns :
+		       AD7124_SIM_DEFAULT_CONV_NS;
+	dev->id = (init && init->id) ? init->id : AD7124_SIM_DEFAULT_ID;
+	sim_ad7124_reset(dev);
+
+	*priv = dev;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the model.
+ * @param priv - The model state.
+ * @return SUCCESS.
+ */
+static int32_t sim_ad7124_remove(void *priv)
+{
+	free(priv);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Update the status register and get the value of a register.
+ * @param dev - The model state.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint32_t sim_ad7124_read_reg(struct sim_ad7124 *dev, uint8_t addr)
+{
+	uint32_t val;
+
+	if (sim_get_time_ns() >= dev->ready_ns)
+		dev->regs[AD7124_SIM_STATUS] &= ~AD7124_SIM_STATUS_RDY;
+
+	val = dev->regs[addr];
+	switch (addr) {
+	case AD7124_SIM_STATUS:
+		dev->regs[addr] &= ~AD7124_SIM_STATUS_POR;
+		break;
+	case AD7124_SIM_ERROR:
+		/* The error flags are cleared when read */
+		dev->regs[addr] = 0;
+		break;
+	case AD7124_SIM_DATA:
+		val = (0x800000 + dev->sample++ * 0x100) & 0xFFFFFF;
+		dev->regs[AD7124_SIM_STATUS] |= AD7124_SIM_STATUS_RDY;
+		dev->ready_ns = sim_get_time_ns() + dev->conv_ns;
+		break;
+	default:
+		break;
+	}
+
+	return val;
+}
+
+/**
+ * @brief Handle an SPI frame: a write to the communications register followed
+ * by the data of the addressed register and the optional status and CRC bytes.
+ * @param priv - The model state.
+ * @param data - The frame, replaced with the data driven on MISO.
+ * @param bytes_number - Frame length.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t sim_ad7124_spi_xfer(void *priv, uint8_t *data,
+				   uint32_t bytes_number)
+{
+	struct sim_ad7124 *dev = priv;
+	bool crc = dev->regs[AD7124_SIM_ERROR_EN] & AD7124_SIM_ERREN_CRC;
+	bool data_status;
+	uint8_t addr, size, status, i;
+	uint32_t val, len;
+
+	if (!bytes_number)
+		return SUCCESS;
+
+	/* 64 or more consecutive ones reset the interface */
+	for (i = 0; i < bytes_number && data[i] == 0xFF; i++)
+		;
+	if (i >= 8) {
+		sim_ad7124_reset(dev);
+		return SUCCESS;
+	}
+
+	/* The frame is ignored if the write enable bit is not 0 */
+	if (data[0] & AD7124_SIM_COMM_WEN) {
+		memset(data, 0xFF, bytes_number);
+		return SUCCESS;
+	}
+
+	addr = AD7124_SIM_COMM_RA(data[0]);
+	if (addr >= AD7124_SIM_REG_NO)
+		return -EINVAL;
+	size = sim_ad7124_reg_size(addr);
+
+	if (data[0] & AD7124_SIM_COMM_RD) {
+		data_status = dev->regs[AD7124_SIM_ADC_CTRL] &
+			      AD7124_SIM_CTRL_DATA_STATUS;
+		len = 1 + size;
+		if (addr == AD7124_SIM_DATA && data_status)
+			len++;
+		if (bytes_number < len + crc)
+			return -EINVAL;
+
+		status = dev->regs[AD7124_SIM_STATUS];
+		val = sim_ad7124_read_reg(dev, addr);
+		for (i = 0; i < size; i++)
+			data[size - i] = val >> (8 * i);
+		if (len > 1u + size)
+			data[len - 1] = status;
+		if (crc)
+			data[len] = sim_ad7124_crc8(data, len);
+
+		return SUCCESS;
+	}
+
+	if (bytes_number < 1u + size + crc)
+		return -EINVAL;
+
+	if (crc && sim_ad7124_crc8(data, 2 + size)) {
+		dev->regs[AD7124_SIM_ERROR] |= AD7124_SIM_ERR_CRC;
+		return SUCCESS;
+	}
+
+	val = 0;
+	for (i = 1; i <= size; i++)
+		val = (val << 8) | data[i];
+
+	switch (addr) {
+	case AD7124_SIM_STATUS:
+	case AD7124_SIM_DATA:
+	case AD7124_SIM_ID:
+	case AD7124_SIM_ERROR:
+	case 0x08:
+		/* Read only */
+		break;
+	default:
+		dev->regs[addr] = val;
+		break;
+	}
+	memset(data, 0, bytes_number);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief AD7124 model ops.
+ */
+const struct sim_model_ops sim_ad7124_ops = {
+	.init = &sim_ad7124_init,
+	.remove = &sim_ad7124_remove,
+	.spi_xfer = &sim_ad7124_spi_xfer,
+};
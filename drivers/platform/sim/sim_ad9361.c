@@ -0,0 +1,262 @@
+/***************************************************************************//**
+ *   @file   sim/sim_ad9361.c
+ *   @brief  Register-map model of the AD9361.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "sim_models.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define AD9361_SIM_REG_NO		0x400
+#define AD9361_SIM_SPI_CONF		0x000
+#define AD9361_SIM_ENSM_MODE		0x013
+#define AD9361_SIM_ENSM_CONFIG_1	0x014
+#define AD9361_SIM_CALIBRATION_CTRL	0x016
+#define AD9361_SIM_STATE		0x017
+#define AD9361_SIM_PRODUCT_ID		0x037
+#define AD9361_SIM_CH_1_OVERFLOW	0x05E
+#define AD9361_SIM_RX_VCO_LOCK		0x247
+#define AD9361_SIM_TX_VCO_LOCK		0x287
+
+#define AD9361_SIM_CMD_WRITE		0x8000
+#define AD9361_SIM_CMD_CNT(x)		((((x) >> 12) & 0x7) + 1)
+#define AD9361_SIM_CMD_ADDR(x)		((x) & 0x3FF)
+#define AD9361_SIM_SOFT_RESET		0x81
+#define AD9361_SIM_PRODUCT_ID_VAL	0x0A
+#define AD9361_SIM_BBPLL_LOCK		0x80
+#define AD9361_SIM_VCO_LOCK		0x02
+#define AD9361_SIM_FDD_MODE		0x01
+#define AD9361_SIM_FORCE_RX_ON		0x40
+#define AD9361_SIM_FORCE_TX_ON		0x20
+#define AD9361_SIM_FORCE_ALERT		0x05
+#define AD9361_SIM_ENSM_ALERT		0x5
+#define AD9361_SIM_ENSM_TX		0x6
+#define AD9361_SIM_ENSM_RX		0x8
+#define AD9361_SIM_ENSM_FDD		0xA
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad9361
+ * @brief AD9361 model state.
+ */
+struct sim_ad9361 {
+	/** Register values */
+	uint8_t	regs[AD9361_SIM_REG_NO];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_ad9361_reset(struct sim_ad9361 *dev)
+{
+	memset(dev->regs, 0, sizeof(dev->regs));
+	dev->regs[AD9361_SIM_PRODUCT_ID] = AD9361_SIM_PRODUCT_ID_VAL;
+}
+
+/**
+ * @brief Read a register. The calibrations complete instantly and the PLLs
+ * are always locked, so the driver polling loops end on the first read.
+ * @param dev - The model state.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint8_t sim_ad9361_read_reg(struct sim_ad9361 *dev, uint16_t addr)
+{
+	switch (addr) {
+	case AD9361_SIM_CALIBRATION_CTRL:
+		return 0;
+	case AD9361_SIM_CH_1_OVERFLOW:
+		return dev->regs[addr] | AD9361_SIM_BBPLL_LOCK;
+	case AD9361_SIM_RX_VCO_LOCK:
+	case AD9361_SIM_TX_VCO_LOCK:
+		return dev->regs[addr] | AD9361_SIM_VCO_LOCK;
+	default:
+		return dev->regs[addr];
+	}
+}
+
+/**
+ * @brief Move the enable state machine to the state forced through the ENSM
+ * configuration register. The transition is instant.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_ad9361_ensm_update(struct sim_ad9361 *dev)
+{
+	uint8_t conf = dev->regs[AD9361_SIM_ENSM_CONFIG_1];
+	bool fdd = dev->regs[AD9361_SIM_ENSM_MODE] & AD9361_SIM_FDD_MODE;
+	uint8_t state;
+
+	if (conf & AD9361_SIM_FORCE_RX_ON)
+		state = AD9361_SIM_ENSM_RX;
+	else if (conf & AD9361_SIM_FORCE_TX_ON)
+		state = fdd ? AD9361_SIM_ENSM_FDD : AD9361_SIM_ENSM_TX;
+	else if (conf & AD9361_SIM_FORCE_ALERT)
+		state = AD9361_SIM_ENSM_ALERT;
+	else
+		return;
+
+	dev->regs[AD9361_SIM_STATE] = (dev->regs[AD9361_SIM_STATE] & 0xF0) |
+				      state;
+}
+
+/**
+ * @brief Write a register.
+ * @param dev - The model state.
+ * @param addr - Register address.
+ * @param val - Register value.
+ * @return None.
+ */
+static void sim_ad9361_write_reg(struct sim_ad9361 *dev, uint16_t addr,
+				 uint8_t val)
+{
+	switch (addr) {
+	case AD9361_SIM_SPI_CONF:
+		if (val & AD9361_SIM_SOFT_RESET) {
+			sim_ad9361_reset(dev);
+			return;
+		}
+		break;
+	case AD9361_SIM_STATE:
+	case AD9361_SIM_PRODUCT_ID:
+		return;
+	default:
+		break;
+	}
+
+	dev->regs[addr] = val;
+	if (addr == AD9361_SIM_ENSM_CONFIG_1)
+		sim_ad9361_ensm_update(dev);
+}
+
+/**
+ * @brief Create the model.
+ * @param priv - The model state.
+ * @param param - Unused.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t sim_ad9361_init(void **priv, const void *param)
+{
+	struct sim_ad9361 *dev;
+
+	dev = calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	sim_ad9361_reset(dev);
+
+	*priv = dev;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the model.
+ * @param priv - The model state.
+ * @return SUCCESS.
+ */
+static int32_t sim_ad9361_remove(void *priv)
+{
+	free(priv);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Handle an SPI frame: a 16-bit instruction holding the direction, the
+ * byte count and the address, followed by up to 8 data bytes. The address is
+ * decremented after each byte.
+ * @param priv - The model state.
+ * @param data - The frame, replaced with the data driven on MISO.
+ * @param bytes_number - Frame length.
+ * @return SUCCESS in case of success, -EINVAL if the frame is too short.
+ */
+static int32_t sim_ad9361_spi_xfer(void *priv, uint8_t *data,
+				   uint32_t bytes_number)
+{
+	struct sim_ad9361 *dev = priv;
+	uint16_t cmd, addr;
+	uint8_t cnt, i;
+
+	if (bytes_number < 2)
+		return -EINVAL;
+
+	cmd = (data[0] << 8) | data[1];
+	cnt = AD9361_SIM_CMD_CNT(cmd);
+	addr = AD9361_SIM_CMD_ADDR(cmd);
+	if (bytes_number < 2u + cnt)
+		return -EINVAL;
+
+	for (i = 0; i < cnt; i++, addr = (addr - 1) & 0x3FF) {
+		if (cmd & AD9361_SIM_CMD_WRITE) {
+			sim_ad9361_write_reg(dev, addr, data[2 + i]);
+			data[2 + i] = 0;
+		} else {
+			data[2 + i] = sim_ad9361_read_reg(dev, addr);
+		}
+	}
+	data[0] = 0;
+	data[1] = 0;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief AD9361 model ops.
+ */
+const struct sim_model_ops sim_ad9361_ops = {
+	.init = &sim_ad9361_init,
+	.remove = &sim_ad9361_remove,
+	.spi_xfer = &sim_ad9361_spi_xfer,
+};
@@ -0,0 +1,449 @@
+/***************************************************************************//**
+ *   @file   sim/sim_adxl372.c
+ *   @brief  Register-map model of the ADXL372.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "sim_models.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define ADXL372_SIM_REG_NO		0x43
+#define ADXL372_SIM_REVID		0x03
+#define ADXL372_SIM_STATUS_1		0x04
+#define ADXL372_SIM_FIFO_ENTRIES_2	0x06
+#define ADXL372_SIM_FIFO_ENTRIES_1	0x07
+#define ADXL372_SIM_X_DATA_H		0x08
+#define ADXL372_SIM_OFFSET_X		0x20
+#define ADXL372_SIM_FIFO_SAMPLES	0x39
+#define ADXL372_SIM_FIFO_CTL		0x3A
+#define ADXL372_SIM_TIMING		0x3D
+#define ADXL372_SIM_POWER_CTL		0x3F
+#define ADXL372_SIM_RESET		0x41
+#define ADXL372_SIM_FIFO_DATA		0x42
+
+#define ADXL372_SIM_STATUS_DATA_RDY	0x01
+#define ADXL372_SIM_STATUS_FIFO_RDY	0x02
+#define ADXL372_SIM_STATUS_FIFO_FULL	0x04
+#define ADXL372_SIM_STATUS_FIFO_OVR	0x08
+#define ADXL372_SIM_RESET_CODE		0x52
+#define ADXL372_SIM_FIFO_SIZE		512
+#define ADXL372_SIM_DEFAULT_REVID	0x03
+
+/* Samples generated at once at most, older ones would be lost anyway */
+#define ADXL372_SIM_MAX_BURST		(2 * ADXL372_SIM_FIFO_SIZE)
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_adxl372
+ * @brief ADXL372 model state.
+ */
+struct sim_adxl372 {
+	/** Register values */
+	uint8_t		regs[ADXL372_SIM_REG_NO];
+	/** Value of the REVID register */
+	uint8_t		rev_id;
+	/** FIFO entries, 12-bit samples left aligned */
+	uint16_t	fifo[ADXL372_SIM_FIFO_SIZE];
+	/** Index of the oldest FIFO entry */
+	uint16_t	fifo_head;
+	/** Number of FIFO entries */
+	uint16_t	fifo_cnt;
+	/** True if the low byte of the oldest entry is read next */
+	bool		fifo_low;
+	/** Simulated time of the last generated sample */
+	uint64_t	sample_ns;
+	/** Number of samples generated, used as synthetic data */
+	uint32_t	sample;
+	/** Register address used by the next I2C read */
+	uint8_t		i2c_addr;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_adxl372_reset(struct sim_adxl372 *dev)
+{
+	memset(dev->regs, 0, sizeof(dev->regs));
+	dev->regs[0x00] = 0xAD;
+	dev->regs[0x01] = 0x1D;
+	dev->regs[0x02] = 0xFA;
+	dev->regs[ADXL372_SIM_REVID] = dev->rev_id;
+	dev->regs[ADXL372_SIM_FIFO_SAMPLES] = 0x80;
+	dev->fifo_head = 0;
+	dev->fifo_cnt = 0;
+	dev->fifo_low = false;
+	dev->sample_ns = sim_get_time_ns();
+}
+
+/**
+ * @brief Add an entry to the FIFO.
+ * @param dev - The model state.
+ * @param val - 12-bit sample.
+ * @return None.
+ */
+static void sim_adxl372_fifo_push(struct sim_adxl372 *dev, uint16_t val)
+{
+	if (dev->fifo_cnt == ADXL372_SIM_FIFO_SIZE) {
+		dev->regs[ADXL372_SIM_STATUS_1] |= ADXL372_SIM_STATUS_FIFO_OVR;
+		return;
+	}
+
+	dev->fifo[(dev->fifo_head + dev->fifo_cnt) % ADXL372_SIM_FIFO_SIZE] =
+		val << 4;
+	dev->fifo_cnt++;
+}
+
+/**
+ * @brief Get the next byte of the FIFO.
+ * @param dev - The model state.
+ * @return The byte, 0 if the FIFO is empty.
+ */
+static uint8_t sim_adxl372_fifo_pop(struct sim_adxl372 *dev)
+{
+	uint16_t val;
+
+	if (!dev->fifo_cnt)
+		return 0;
+
+	val = dev->fifo[dev->fifo_head];
+	if (!dev->fifo_low) {
+		dev->fifo_low = true;
+		return val >> 8;
+	}
+
+	dev->fifo_low = false;
+	dev->fifo_head = (dev->fifo_head + 1) % ADXL372_SIM_FIFO_SIZE;
+	dev->fifo_cnt--;
+
+	return val & 0xFF;
+}
+
+/**
+ * @brief Generate the samples taken since the last update, at the output data
+ * rate set in the TIMING register, while not in standby.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_adxl372_update(struct sim_adxl372 *dev)
+{
+	uint64_t period, now = sim_get_time_ns();
+	uint64_t n;
+	uint16_t xyz[3];
+	uint8_t odr, fifo_mode, fifo_format, i;
+	uint16_t watermark;
+
+	if (!(dev->regs[ADXL372_SIM_POWER_CTL] & 0x3)) {
+		dev->sample_ns = now;
+		return;
+	}
+
+	/* 400 Hz shifted left by the ODR field */
+	odr = (dev->regs[ADXL372_SIM_TIMING] >> 5) & 0x7;
+	period = 1000000000ull / (400u << odr);
+	n = (now - dev->sample_ns) / period;
+	dev->sample_ns += n * period;
+	if (n > ADXL372_SIM_MAX_BURST) {
+		dev->sample += n - ADXL372_SIM_MAX_BURST;
+		n = ADXL372_SIM_MAX_BURST;
+	}
+
+	fifo_mode = (dev->regs[ADXL372_SIM_FIFO_CTL] >> 1) & 0x3;
+	fifo_format = (dev->regs[ADXL372_SIM_FIFO_CTL] >> 3) & 0x7;
+	while (n--) {
+		xyz[0] = dev->sample & 0xFFF;
+		xyz[1] = (dev->sample + 0x555) & 0xFFF;
+		xyz[2] = (dev->sample + 0xAAA) & 0xFFF;
+		dev->sample++;
+
+		for (i = 0; i < 3; i++) {
+			dev->regs[ADXL372_SIM_X_DATA_H + 2 * i] = xyz[i] >> 4;
+			dev->regs[ADXL372_SIM_X_DATA_H + 2 * i + 1] =
+				(xyz[i] & 0xF) << 4;
+		}
+		dev->regs[ADXL372_SIM_STATUS_1] |= ADXL372_SIM_STATUS_DATA_RDY;
+
+		/* Format 0 is XYZ, 1 to 6 select axes as a bit mask of ZYX */
+		if (fifo_mode)
+			for (i = 0; i < 3; i++)
+				if (!fifo_format || fifo_format > 6 ||
+				    (fifo_format & (1 << i)))
+					sim_adxl372_fifo_push(dev, xyz[i]);
+	}
+
+	watermark = dev->regs[ADXL372_SIM_FIFO_SAMPLES] |
+		    ((dev->regs[ADXL372_SIM_FIFO_CTL] & 0x1) << 8);
+	dev->regs[ADXL372_SIM_STATUS_1] &= ~(ADXL372_SIM_STATUS_FIFO_RDY |
+					     ADXL372_SIM_STATUS_FIFO_FULL);
+	if (dev->fifo_cnt)
+		dev->regs[ADXL372_SIM_STATUS_1] |= ADXL372_SIM_STATUS_FIFO_RDY;
+	if (dev->fifo_cnt >= watermark)
+		dev->regs[ADXL372_SIM_STATUS_1] |= ADXL372_SIM_STATUS_FIFO_FULL;
+	dev->regs[ADXL372_SIM_FIFO_ENTRIES_2] = (dev->fifo_cnt >> 8) & 0x3;
+	dev->regs[ADXL372_SIM_FIFO_ENTRIES_1] = dev->fifo_cnt & 0xFF;
+}
+
+/**
+ * @brief Read a register.
+ * @param dev - The model state.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint8_t sim_adxl372_read_reg(struct sim_adxl372 *dev, uint8_t addr)
+{
+	uint8_t val;
+
+	if (addr == ADXL372_SIM_FIFO_DATA)
+		return sim_adxl372_fifo_pop(dev);
+	if (addr >= ADXL372_SIM_REG_NO)
+		return 0;
+
+	val = dev->regs[addr];
+	switch (addr) {
+	case ADXL372_SIM_STATUS_1:
+		/* The overrun flag is cleared when read */
+		dev->regs[addr] &= ~ADXL372_SIM_STATUS_FIFO_OVR;
+		break;
+	case ADXL372_SIM_X_DATA_H:
+		dev->regs[ADXL372_SIM_STATUS_1] &= ~ADXL372_SIM_STATUS_DATA_RDY;
+		break;
+	default:
+		break;
+	}
+
+	return val;
+}
+
+/**
+ * @brief Write a register.
+ * @param dev - The model state.
+ * @param addr - Register address.
+ * @param val - Register value.
+ * @return None.
+ */
+static void sim_adxl372_write_reg(struct sim_adxl372 *dev, uint8_t addr,
+				  uint8_t val)
+{
+	/* The ID, status and data registers are read only */
+	if (addr < ADXL372_SIM_OFFSET_X || addr >= ADXL372_SIM_FIFO_DATA)
+		return;
+
+	if (addr == ADXL372_SIM_RESET) {
+		if (val == ADXL372_SIM_RESET_CODE)
+			sim_adxl372_reset(dev);
+		return;
+	}
+
+	dev->regs[addr] = val;
+	if (addr == ADXL372_SIM_FIFO_CTL) {
+		dev->fifo_cnt = 0;
+		dev->fifo_low = false;
+	}
+}
+
+/**
+ * @brief Read consecutive registers. The address is not incremented while
+ * reading the FIFO.
+ * @param dev - The model state.
+ * @param addr - First register address.
+ * @param data - Location where the values will be stored.
+ * @param len - Number of bytes.
+ * @return The address following the last one read.
+ */
+static uint8_t sim_adxl372_read(struct sim_adxl372 *dev, uint8_t addr,
+				uint8_t *data, uint32_t len)
+{
+	sim_adxl372_update(dev);
+	while (len--) {
+		*data++ = sim_adxl372_read_reg(dev, addr);
+		if (addr != ADXL372_SIM_FIFO_DATA)
+			addr++;
+	}
+
+	return addr;
+}
+
+/**
+ * @brief Write consecutive registers.
+ * @param dev - The model state.
+ * @param addr - First register address.
+ * @param data - Values to write.
+ * @param len - Number of bytes.
+ * @return The address following the last one written.
+ */
+static uint8_t sim_adxl372_write(struct sim_adxl372 *dev, uint8_t addr,
+				 const uint8_t *data, uint32_t len)
+{
+	sim_adxl372_update(dev);
+	while (len--)
+		sim_adxl372_write_reg(dev, addr++, *data++);
+
+	return addr;
+}
+
+/**
+ * @brief Create the model.
+ * @param priv - The model state.
+ * @param param - struct sim_adxl372_init_param, or NULL for the defaults.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t sim_adxl372_init(void **priv, const void *param)
+{
+	const struct sim_adxl372_init_param *init = param;
+	struct sim_adxl372 *dev;
+
+	dev = calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	dev->rev_id = (init && init->rev_id) ? init->rev_id :
+		      ADXL372_SIM_DEFAULT_REVID;
+	sim_adxl372_reset(dev);
+
+	*priv = dev;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the model.
+ * @param priv - The model state.
+ * @return SUCCESS.
+ */
+static int32_t sim_adxl372_remove(void *priv)
+{
+	free(priv);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Handle an SPI frame: the register address and the R/W bit, followed
+ * by the data.
+ * @param priv - The model state.
+ * @param data - The frame, replaced with the data driven on MISO.
+ * @param bytes_number - Frame length.
+ * @return SUCCESS.
+ */
+static int32_t sim_adxl372_spi_xfer(void *priv, uint8_t *data,
+				    uint32_t bytes_number)
+{
+	struct sim_adxl372 *dev = priv;
+	uint8_t addr;
+
+	if (bytes_number < 2)
+		return SUCCESS;
+
+	addr = data[0] >> 1;
+	if (data[0] & 0x1) {
+		sim_adxl372_read(dev, addr, &data[1], bytes_number - 1);
+	} else {
+		sim_adxl372_write(dev, addr, &data[1], bytes_number - 1);
+		memset(&data[1], 0, bytes_number - 1);
+	}
+	data[0] = 0;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Handle an I2C write: the register address, followed by the data.
+ * @param priv - The model state.
+ * @param data - Written bytes.
+ * @param bytes_number - Number of bytes.
+ * @param stop - 0 if a repeated start follows.
+ * @return SUCCESS.
+ */
+static int32_t sim_adxl372_i2c_write(void *priv, uint8_t *data,
+				     uint32_t bytes_number, uint8_t stop)
+{
+	struct sim_adxl372 *dev = priv;
+
+	if (!bytes_number)
+		return SUCCESS;
+
+	dev->i2c_addr = sim_adxl372_write(dev, data[0], &data[1],
+					  bytes_number - 1);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Handle an I2C read, starting at the last register address.
+ * @param priv - The model state.
+ * @param data - Location where the read bytes will be stored.
+ * @param bytes_number - Number of bytes.
+ * @param stop - 0 if a repeated start follows.
+ * @return SUCCESS.
+ */
+static int32_t sim_adxl372_i2c_read(void *priv, uint8_t *data,
+				    uint32_t bytes_number, uint8_t stop)
+{
+	struct sim_adxl372 *dev = priv;
+
+	dev->i2c_addr = sim_adxl372_read(dev, dev->i2c_addr, data,
+					 bytes_number);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief ADXL372 model ops.
+ */
+const struct sim_model_ops sim_adxl372_ops = {
+	.init = &sim_adxl372_init,
+	.remove = &sim_adxl372_remove,
+	.spi_xfer = &sim_adxl372_spi_xfer,
+	.i2c_write = &sim_adxl372_i2c_write,
+	.i2c_read = &sim_adxl372_i2c_read,
+};
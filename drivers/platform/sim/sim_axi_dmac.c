@@ -0,0 +1,320 @@
+/***************************************************************************//**
+ *   @file   sim/sim_axi_dmac.c
+ *   @brief  Model of the AXI DMAC with a synthetic data source.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include "error.h"
+#include "util.h"
+#include "sim_models.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define DMAC_SIM_REG_IRQ_MASK		0x80
+#define DMAC_SIM_REG_IRQ_PENDING	0x84
+#define DMAC_SIM_REG_CTRL		0x400
+#define DMAC_SIM_REG_TRANSFER_ID	0x404
+#define DMAC_SIM_REG_START_TRANSFER	0x408
+#define DMAC_SIM_REG_FLAGS		0x40c
+#define DMAC_SIM_REG_DEST_ADDRESS	0x410
+#define DMAC_SIM_REG_SRC_ADDRESS	0x414
+#define DMAC_SIM_REG_X_LENGTH		0x418
+#define DMAC_SIM_REG_Y_LENGTH		0x41c
+#define DMAC_SIM_REG_DEST_STRIDE	0x420
+#define DMAC_SIM_REG_SRC_STRIDE		0x424
+#define DMAC_SIM_REG_TRANSFER_DONE	0x428
+#define DMAC_SIM_REG_NO		(DMAC_SIM_REG_TRANSFER_DONE / 4 + 1)
+
+#define DMAC_SIM_IRQ_SOT		0x1
+#define DMAC_SIM_IRQ_EOT		0x2
+#define DMAC_SIM_CTRL_ENABLE		0x1
+#define DMAC_SIM_FLAG_CYCLIC		0x1
+
+#define DMAC_SIM_DEFAULT_RATE		100000000
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_axi_dmac
+ * @brief AXI DMAC model state. One transfer is in flight at most; a transfer
+ * submitted while another one is running stays queued until it ends.
+ */
+struct sim_axi_dmac {
+	/** Register values */
+	uint32_t	regs[DMAC_SIM_REG_NO];
+	/** Model parameters */
+	struct sim_axi_dmac_init_param param;
+	/** True if a transfer is in flight */
+	bool		busy;
+	/** ID of the transfer in flight */
+	uint8_t		id;
+	/** Address, length and flags of the transfer in flight */
+	uint32_t	address;
+	uint32_t	len;
+	uint32_t	flags;
+	/** Simulated time at which the transfer in flight ends */
+	uint64_t	end_ns;
+	/** Last value of the built-in source */
+	uint16_t	sample;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Built-in data source, a 16-bit counter.
+ * @param dev - The model state.
+ * @param buf - Destination.
+ * @param len - Destination length.
+ * @return None.
+ */
+static void sim_axi_dmac_ramp(struct sim_axi_dmac *dev, uint8_t *buf,
+			      uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		buf[i] = dev->sample & 0xFF;
+		buf[i + 1] = dev->sample >> 8;
+		dev->sample++;
+	}
+}
+
+/**
+ * @brief Get the time needed to move a number of bytes at the device rate.
+ * @param dev - The model state.
+ * @param len - Number of bytes.
+ * @return Duration in nanoseconds, at least 1.
+ */
+static uint64_t sim_axi_dmac_duration(struct sim_axi_dmac *dev, uint32_t len)
+{
+	uint64_t ns;
+
+	ns = div_u64((uint64_t)len * 1000000000ull, dev->param.bytes_per_sec);
+
+	return ns ? ns : 1;
+}
+
+/**
+ * @brief Start the queued transfer.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_axi_dmac_start(struct sim_axi_dmac *dev)
+{
+	dev->id = dev->regs[DMAC_SIM_REG_TRANSFER_ID / 4];
+	dev->regs[DMAC_SIM_REG_TRANSFER_ID / 4] = (dev->id + 1) & 0x3;
+	dev->regs[DMAC_SIM_REG_TRANSFER_DONE / 4] &= ~(1u << dev->id);
+	dev->regs[DMAC_SIM_REG_START_TRANSFER / 4] = 0;
+
+	dev->address = dev->regs[(dev->param.mem_to_dev ?
+				  DMAC_SIM_REG_SRC_ADDRESS :
+				  DMAC_SIM_REG_DEST_ADDRESS) / 4];
+	dev->len = dev->regs[DMAC_SIM_REG_X_LENGTH / 4] + 1;
+	dev->flags = dev->regs[DMAC_SIM_REG_FLAGS / 4];
+	dev->end_ns = sim_get_time_ns() + sim_axi_dmac_duration(dev, dev->len);
+	dev->busy = true;
+
+	dev->regs[DMAC_SIM_REG_IRQ_PENDING / 4] |= DMAC_SIM_IRQ_SOT;
+}
+
+/**
+ * @brief Complete the transfers that ended since the last register access and
+ * start the queued one.
+ * @param dev - The model state.
+ * @return None.
+ */
+static void sim_axi_dmac_update(struct sim_axi_dmac *dev)
+{
+	uint8_t *buf;
+
+	while (dev->busy && sim_get_time_ns() >= dev->end_ns) {
+		buf = sim_mem_ptr(dev->address, dev->len);
+		if (buf && !dev->param.mem_to_dev) {
+			if (dev->param.source)
+				dev->param.source(dev->param.ctx, buf,
+						  dev->len);
+			else
+				sim_axi_dmac_ramp(dev, buf, dev->len);
+		}
+
+		if (dev->flags & DMAC_SIM_FLAG_CYCLIC) {
+			/* Cyclic transfers restart and never complete */
+			dev->end_ns += sim_axi_dmac_duration(dev, dev->len);
+			continue;
+		}
+
+		dev->regs[DMAC_SIM_REG_IRQ_PENDING / 4] |= DMAC_SIM_IRQ_EOT;
+		dev->regs[DMAC_SIM_REG_TRANSFER_DONE / 4] |= 1u << dev->id;
+		dev->busy = false;
+		if (dev->regs[DMAC_SIM_REG_START_TRANSFER / 4])
+			sim_axi_dmac_start(dev);
+	}
+}
+
+/**
+ * @brief Create the model.
+ * @param priv - The model state.
+ * @param param - struct sim_axi_dmac_init_param, or NULL for the defaults.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t sim_axi_dmac_init(void **priv, const void *param)
+{
+	struct sim_axi_dmac *dev;
+
+	dev = calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	if (param)
+		dev->param = *(const struct sim_axi_dmac_init_param *)param;
+	if (!dev->param.bytes_per_sec)
+		dev->param.bytes_per_sec = DMAC_SIM_DEFAULT_RATE;
+
+	*priv = dev;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the model.
+ * @param priv - The model state.
+ * @return SUCCESS.
+ */
+static int32_t sim_axi_dmac_remove(void *priv)
+{
+	free(priv);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Read a register.
+ * @param priv - The model state.
+ * @param offset - Register offset.
+ * @param data - Location where the value will be stored.
+ * @return SUCCESS in case of success, -EINVAL for an unaligned or out of
+ * range offset.
+ */
+static int32_t sim_axi_dmac_read(void *priv, uint32_t offset, uint32_t *data)
+{
+	struct sim_axi_dmac *dev = priv;
+
+	if ((offset & 0x3) || offset / 4 >= DMAC_SIM_REG_NO)
+		return -EINVAL;
+
+	sim_axi_dmac_update(dev);
+	*data = dev->regs[offset / 4];
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Write a register.
+ * @param priv - The model state.
+ * @param offset - Register offset.
+ * @param data - Register value.
+ * @return SUCCESS in case of success, -EINVAL for an unaligned or out of
+ * range offset, -EFAULT if a transfer is started outside of the simulated
+ * memory.
+ */
+static int32_t sim_axi_dmac_write(void *priv, uint32_t offset, uint32_t data)
+{
+	struct sim_axi_dmac *dev = priv;
+	uint32_t address;
+
+	if ((offset & 0x3) || offset / 4 >= DMAC_SIM_REG_NO)
+		return -EINVAL;
+
+	sim_axi_dmac_update(dev);
+
+	switch (offset) {
+	case DMAC_SIM_REG_IRQ_PENDING:
+		/* Write 1 to clear */
+		dev->regs[offset / 4] &= ~data;
+		break;
+	case DMAC_SIM_REG_CTRL:
+		dev->regs[offset / 4] = data;
+		if (!(data & DMAC_SIM_CTRL_ENABLE)) {
+			/* Disabling the DMAC aborts all the transfers */
+			dev->busy = false;
+			dev->regs[DMAC_SIM_REG_START_TRANSFER / 4] = 0;
+		}
+		break;
+	case DMAC_SIM_REG_START_TRANSFER:
+		if (!(data & 0x1) ||
+		    !(dev->regs[DMAC_SIM_REG_CTRL / 4] & DMAC_SIM_CTRL_ENABLE))
+			break;
+		address = dev->regs[(dev->param.mem_to_dev ?
+				     DMAC_SIM_REG_SRC_ADDRESS :
+				     DMAC_SIM_REG_DEST_ADDRESS) / 4];
+		if (!sim_mem_ptr(address,
+				 dev->regs[DMAC_SIM_REG_X_LENGTH / 4] + 1))
+			return -EFAULT;
+		dev->regs[offset / 4] = 1;
+		if (!dev->busy)
+			sim_axi_dmac_start(dev);
+		break;
+	case DMAC_SIM_REG_TRANSFER_ID:
+	case DMAC_SIM_REG_TRANSFER_DONE:
+		/* Read only */
+		break;
+	default:
+		dev->regs[offset / 4] = data;
+		break;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief AXI DMAC model ops.
+ */
+const struct sim_model_ops sim_axi_dmac_ops = {
+	.init = &sim_axi_dmac_init,
+	.remove = &sim_axi_dmac_remove,
+	.axi_read = &sim_axi_dmac_read,
+	.axi_write = &sim_axi_dmac_write,
+};
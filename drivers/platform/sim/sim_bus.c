@@ -0,0 +1,359 @@
+/***************************************************************************//**
+ *   @file   sim/sim_bus.c
+ *   @brief  Simulated bus clock, timing and device model interface.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "error.h"
+#include "util.h"
+#include "sim_bus.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_axi_region
+ * @brief Address range of the simulated AXI bus decoded to a model.
+ */
+struct sim_axi_region {
+	/** Base address */
+	uint32_t		base;
+	/** Size of the range in bytes */
+	uint32_t		size;
+	/** Model handling the range, NULL if the entry is free */
+	struct sim_model	*model;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+static struct sim_timing sim_timing = {
+	.spi_cs_ns = 200,
+	.i2c_overhead_ns = 2000,
+	.axi_access_ns = 100,
+};
+
+static struct sim_counters sim_counters;
+
+static uint64_t sim_time_ns;
+
+static struct sim_axi_region sim_axi_regions[SIM_AXI_MAX_REGIONS];
+
+static uint8_t *sim_mem;
+static uint32_t sim_mem_base;
+static uint32_t sim_mem_size;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Create a device model.
+ * @param model - The model instance.
+ * @param param - The model parameters.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t sim_model_init(struct sim_model **model,
+		       const struct sim_model_init_param *param)
+{
+	struct sim_model *m;
+	int32_t ret;
+
+	if (!model || !param || !param->ops)
+		return -EINVAL;
+
+	m = calloc(1, sizeof(*m));
+	if (!m)
+		return -ENOMEM;
+
+	m->name = param->name;
+	m->ops = param->ops;
+	if (m->ops->init) {
+		ret = m->ops->init(&m->priv, param->extra);
+		if (ret != SUCCESS) {
+			free(m);
+			return ret;
+		}
+	}
+
+	*model = m;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the resources allocated by sim_model_init().
+ * @param model - The model instance.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t sim_model_remove(struct sim_model *model)
+{
+	int32_t ret = SUCCESS;
+
+	if (!model)
+		return -EINVAL;
+
+	sim_axi_detach(model);
+	if (model->ops->remove)
+		ret = model->ops->remove(model->priv);
+	free(model);
+
+	return ret;
+}
+
+/**
+ * @brief Set the bus timing.
+ * @param timing - The new timing. The AXI access time can't be 0, or the
+ * drivers polling a model register would never see the simulated time pass.
+ * @return SUCCESS in case of success, -EINVAL otherwise.
+ */
+int32_t sim_set_timing(const struct sim_timing *timing)
+{
+	if (!timing || !timing->axi_access_ns)
+		return -EINVAL;
+
+	sim_timing = *timing;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get the bus timing.
+ * @param timing - Location where the timing will be stored.
+ * @return None.
+ */
+void sim_get_timing(struct sim_timing *timing)
+{
+	*timing = sim_timing;
+}
+
+/**
+ * @brief Get the simulated time.
+ * @return Nanoseconds elapsed since the program started, as seen by the
+ * models.
+ */
+uint64_t sim_get_time_ns(void)
+{
+	return sim_time_ns;
+}
+
+/**
+ * @brief Advance the simulated time without accounting a transaction.
+ * @param ns - Nanoseconds.
+ * @return None.
+ */
+void sim_advance_ns(uint64_t ns)
+{
+	sim_time_ns += ns;
+}
+
+/**
+ * @brief Time needed to shift bits on a serial bus.
+ * @param bits - Number of bits.
+ * @param hz - Bus clock frequency.
+ * @return Duration in nanoseconds, rounded up.
+ */
+uint64_t sim_bits_ns(uint64_t bits, uint32_t hz)
+{
+	return div_u64(bits * 1000000000ull + hz - 1, hz);
+}
+
+/**
+ * @brief Account a bus transaction and advance the simulated time.
+ * @param bytes_number - Number of bytes moved by the transaction.
+ * @param ns - Duration of the transaction.
+ * @param status - Status returned by the model.
+ * @return None.
+ */
+void sim_account(uint32_t bytes_number, uint64_t ns, int32_t status)
+{
+	sim_counters.transactions++;
+	sim_counters.bytes += bytes_number;
+	sim_counters.bus_ns += ns;
+	if (status < 0)
+		sim_counters.errors++;
+	sim_time_ns += ns;
+}
+
+/**
+ * @brief Get the transaction counters.
+ * @param counters - Location where the counters will be stored.
+ * @return None.
+ */
+void sim_get_counters(struct sim_counters *counters)
+{
+	*counters = sim_counters;
+}
+
+/**
+ * @brief Clear the transaction counters. The simulated time is not reset.
+ * @return None.
+ */
+void sim_reset_counters(void)
+{
+	memset(&sim_counters, 0, sizeof(sim_counters));
+}
+
+/**
+ * @brief Attach a model to an AXI address range.
+ * @param base - Base address of the range.
+ * @param size - Size of the range in bytes.
+ * @param model - The model. Must implement the AXI callbacks.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t sim_axi_attach(uint32_t base, uint32_t size, struct sim_model *model)
+{
+	uint32_t i;
+
+	if (!model || !size || !model->ops->axi_read || !model->ops->axi_write)
+		return -EINVAL;
+
+	for (i = 0; i < SIM_AXI_MAX_REGIONS; i++) {
+		if (sim_axi_regions[i].model)
+			continue;
+		sim_axi_regions[i].base = base;
+		sim_axi_regions[i].size = size;
+		sim_axi_regions[i].model = model;
+		return SUCCESS;
+	}
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Detach a model from all the AXI address ranges it handles.
+ * @param model - The model.
+ * @return SUCCESS in case of success, -EINVAL otherwise.
+ */
+int32_t sim_axi_detach(struct sim_model *model)
+{
+	uint32_t i;
+
+	if (!model)
+		return -EINVAL;
+
+	for (i = 0; i < SIM_AXI_MAX_REGIONS; i++)
+		if (sim_axi_regions[i].model == model)
+			sim_axi_regions[i].model = NULL;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Find the model attached to an AXI address.
+ * @param address - The address.
+ * @param offset - Location where the offset relative to the range base will
+ * be stored.
+ * @return The model, or NULL if no model handles the address.
+ */
+struct sim_model *sim_axi_find(uint32_t address, uint32_t *offset)
+{
+	struct sim_axi_region *r;
+	uint32_t i;
+
+	for (i = 0; i < SIM_AXI_MAX_REGIONS; i++) {
+		r = &sim_axi_regions[i];
+		if (r->model && address - r->base < r->size) {
+			*offset = address - r->base;
+			return r->model;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Allocate the simulated memory used as DMA target. The DMA addresses
+ * used by the drivers are 32-bit, so they can't be host pointers.
+ * @param base - Address of the memory as seen by the drivers.
+ * @param size - Size of the memory in bytes.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t sim_mem_init(uint32_t base, uint32_t size)
+{
+	if (!size)
+		return -EINVAL;
+
+	sim_mem_remove();
+
+	sim_mem = calloc(1, size);
+	if (!sim_mem)
+		return -ENOMEM;
+
+	sim_mem_base = base;
+	sim_mem_size = size;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Free the simulated memory.
+ * @return None.
+ */
+void sim_mem_remove(void)
+{
+	free(sim_mem);
+	sim_mem = NULL;
+	sim_mem_size = 0;
+}
+
+/**
+ * @brief Translate a simulated memory range to a host pointer.
+ * @param address - Start of the range.
+ * @param size - Size of the range in bytes.
+ * @return The host pointer, or NULL if the range is not fully inside the
+ * simulated memory.
+ */
+void *sim_mem_ptr(uint32_t address, uint32_t size)
+{
+	uint32_t offset;
+
+	if (!sim_mem)
+		return NULL;
+
+	offset = address - sim_mem_base;
+	if (offset >= sim_mem_size || size > sim_mem_size - offset)
+		return NULL;
+
+	return sim_mem + offset;
+}
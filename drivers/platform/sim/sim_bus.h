@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ *   @file   sim/sim_bus.h
+ *   @brief  Simulated bus clock, timing and device model interface.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_BUS_H_
+#define SIM_BUS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of models attached to the simulated AXI bus */
+#define SIM_AXI_MAX_REGIONS	8
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_timing
+ * @brief Bus timing used to compute the simulated duration of a transaction.
+ *
+ * The SPI and I2C bit times are derived from the max_speed_hz of the
+ * descriptor; the fields below add the fixed cost of each transaction.
+ */
+struct sim_timing {
+	/** SPI chip select setup and hold time, per transaction */
+	uint32_t	spi_cs_ns;
+	/** I2C start, stop and bus turnaround time, per transaction */
+	uint32_t	i2c_overhead_ns;
+	/** AXI register access latency */
+	uint32_t	axi_access_ns;
+};
+
+/**
+ * @struct sim_counters
+ * @brief Transactions done through the simulation platform.
+ */
+struct sim_counters {
+	/** Number of SPI, I2C and AXI transactions */
+	uint32_t	transactions;
+	/** Number of bytes moved on the buses */
+	uint64_t	bytes;
+	/** Simulated time spent on the buses */
+	uint64_t	bus_ns;
+	/** Number of transactions that failed */
+	uint32_t	errors;
+};
+
+/**
+ * @struct sim_model_ops
+ * @brief Callbacks of a device model. The bus callbacks a model does not
+ * implement may be NULL.
+ */
+struct sim_model_ops {
+	/** Allocate the model state from the model specific parameters */
+	int32_t (*init)(void **priv, const void *param);
+	/** Free the model state */
+	int32_t (*remove)(void *priv);
+	/** Full-duplex SPI frame, the chip select is held for all the bytes */
+	int32_t (*spi_xfer)(void *priv, uint8_t *data, uint32_t bytes_number);
+	/** I2C write, stop is 0 if a repeated start follows */
+	int32_t (*i2c_write)(void *priv, uint8_t *data, uint32_t bytes_number,
+			     uint8_t stop);
+	/** I2C read, stop is 0 if a repeated start follows */
+	int32_t (*i2c_read)(void *priv, uint8_t *data, uint32_t bytes_number,
+			    uint8_t stop);
+	/** AXI register read, offset is relative to the attached base */
+	int32_t (*axi_read)(void *priv, uint32_t offset, uint32_t *data);
+	/** AXI register write, offset is relative to the attached base */
+	int32_t (*axi_write)(void *priv, uint32_t offset, uint32_t data);
+};
+
+/**
+ * @struct sim_model_init_param
+ * @brief Parameters used to create a device model.
+ */
+struct sim_model_init_param {
+	/** Model name, used in reports */
+	const char			*name;
+	/** Model callbacks, e.g. &sim_ad7124_ops */
+	const struct sim_model_ops	*ops;
+	/** Model specific parameters, may be NULL */
+	const void			*extra;
+};
+
+/**
+ * @struct sim_model
+ * @brief Device model instance.
+ */
+struct sim_model {
+	/** Model name */
+	const char			*name;
+	/** Model callbacks */
+	const struct sim_model_ops	*ops;
+	/** Model state */
+	void				*priv;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Create a device model. */
+int32_t sim_model_init(struct sim_model **model,
+		       const struct sim_model_init_param *param);
+
+/* Free the resources allocated by sim_model_init(). */
+int32_t sim_model_remove(struct sim_model *model);
+
+/* Set the bus timing. */
+int32_t sim_set_timing(const struct sim_timing *timing);
+
+/* Get the bus timing. */
+void sim_get_timing(struct sim_timing *timing);
+
+/* Get the simulated time. */
+uint64_t sim_get_time_ns(void);
+
+/* Advance the simulated time. */
+void sim_advance_ns(uint64_t ns);
+
+/* Time needed to shift bits on a serial bus. */
+uint64_t sim_bits_ns(uint64_t bits, uint32_t hz);
+
+/* Account a bus transaction and advance the simulated time. */
+void sim_account(uint32_t bytes_number, uint64_t ns, int32_t status);
+
+/* Get the transaction counters. */
+void sim_get_counters(struct sim_counters *counters);
+
+/* Clear the transaction counters. */
+void sim_reset_counters(void);
+
+/* Attach a model to an AXI address range. */
+int32_t sim_axi_attach(uint32_t base, uint32_t size, struct sim_model *model);
+
+/* Detach a model from the AXI bus. */
+int32_t sim_axi_detach(struct sim_model *model);
+
+/* Find the model attached to an AXI address. */
+struct sim_model *sim_axi_find(uint32_t address, uint32_t *offset);
+
+/* Allocate the simulated memory used as DMA target. */
+int32_t sim_mem_init(uint32_t base, uint32_t size);
+
+/* Free the simulated memory. */
+void sim_mem_remove(void);
+
+/* Translate a simulated memory range to a host pointer. */
+void *sim_mem_ptr(uint32_t address, uint32_t size);
+
+#endif // SIM_BUS_H_
@@ -0,0 +1,108 @@
+/***************************************************************************//**
+ *   @file   sim/sim_models.h
+ *   @brief  Register-map models used by the simulation platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef SIM_MODELS_H_
+#define SIM_MODELS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim_bus.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad7124_init_param
+ * @brief AD7124 model parameters.
+ */
+struct sim_ad7124_init_param {
+	/** Conversion time. The RDY bit of the status register is set for this
+	 *  long after the data register is read. */
+	uint32_t	conv_ns;
+	/** Value of the ID register */
+	uint8_t		id;
+};
+
+/**
+ * @struct sim_adxl372_init_param
+ * @brief ADXL372 model parameters.
+ */
+struct sim_adxl372_init_param {
+	/** Value of the REVID register */
+	uint8_t		rev_id;
+};
+
+/**
+ * @struct sim_axi_dmac_init_param
+ * @brief AXI DMAC model parameters.
+ */
+struct sim_axi_dmac_init_param {
+	/** True if the DMAC moves data from memory to the device */
+	bool		mem_to_dev;
+	/** Rate at which the device produces or consumes data */
+	uint32_t	bytes_per_sec;
+	/** Fills the destination of a device to memory transfer. NULL for the
+	 *  built-in source, a 16-bit counter incremented for every sample. */
+	void		(*source)(void *ctx, uint8_t *buf, uint32_t len);
+	/** Parameter for the source */
+	void		*ctx;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/** AD7124 model, SPI. Parameters: struct sim_ad7124_init_param or NULL */
+extern const struct sim_model_ops sim_ad7124_ops;
+
+/** ADXL372 model, SPI and I2C. Parameters: struct sim_adxl372_init_param or
+ *  NULL */
+extern const struct sim_model_ops sim_adxl372_ops;
+
+/** AD9361 model, SPI. No parameters */
+extern const struct sim_model_ops sim_ad9361_ops;
+
+/** AXI DMAC model, AXI. Parameters: struct sim_axi_dmac_init_param or NULL */
+extern const struct sim_model_ops sim_axi_dmac_ops;
+
+#endif // SIM_MODELS_H_
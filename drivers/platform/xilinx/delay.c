@@ -41,13 +41,100 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <xparameters.h>
+#ifdef _XPARAMETERS_PS_H_
+#include <xtime_l.h>
+#endif
 #include "delay.h"
-#include <sleep.h>
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#ifdef _XPARAMETERS_PS_H_
+/* Frequency of the global timer read by XTime_GetTime() */
+#define DELAY_TICKS_PER_SEC	COUNTS_PER_SECOND
+#else
+/* MicroBlaze has no free running counter, the delays count CPU cycles */
+#define DELAY_TICKS_PER_SEC	XPAR_CPU_CORE_CLOCK_FREQ_HZ
+
+/* CPU cycles taken by one iteration of the delay loop */
+#ifndef XIL_DELAY_LOOP_CYCLES
+#define XIL_DELAY_LOOP_CYCLES	3
+#endif
+#endif
+
+/* Delay ticks in a nanosecond/microsecond/millisecond, rounded up */
+#define NS_TO_TICKS(ns)		(((uint64_t)(ns) * DELAY_TICKS_PER_SEC + \
+				  999999999ull) / 1000000000ull)
+#define US_TO_TICKS(us)		(((uint64_t)(us) * DELAY_TICKS_PER_SEC + \
+				  999999ull) / 1000000ull)
+#define MS_TO_TICKS(ms)		((uint64_t)(ms) * \
+				 ((DELAY_TICKS_PER_SEC + 999ull) / 1000ull))
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+#ifdef _XPARAMETERS_PS_H_
+/**
+ * @brief Get the value of the global timer.
+ * @return Number of ticks since the timer was started.
+ */
+static uint64_t delay_now(void)
+{
+	XTime now;
+
+	XTime_GetTime(&now);
+
+	return now;
+}
+
+/**
+ * @brief Spin for a number of timer ticks.
+ * @param ticks - Delay in timer ticks.
+ * @return None.
+ */
+static void delay_ticks(uint64_t ticks)
+{
+	uint64_t start = delay_now();
+
+	while (delay_now() - start < ticks)
+		;
+}
+#else
+/**
+ * @brief Spin for a number of CPU cycles.
+ * @param ticks - Delay in CPU cycles.
+ * @return None.
+ */
+static void delay_ticks(uint64_t ticks)
+{
+	uint64_t	loops = ticks / XIL_DELAY_LOOP_CYCLES;
+	uint32_t	n;
+
+	while (loops) {
+		n = loops > UINT32_MAX ? UINT32_MAX : loops;
+		loops -= n;
+		__asm__ volatile("1:	addik	%0, %0, -1\n"
+				 "	bneid	%0, 1b\n"
+				 "	nop\n"
+				 : "+r" (n));
+	}
+}
+#endif
+
+/**
+ * @brief Generate nanoseconds delay.
+ * @param nsecs - Delay in nanoseconds.
+ * @return None.
+ */
+void ndelay(uint32_t nsecs)
+{
+	delay_ticks(NS_TO_TICKS(nsecs));
+}
+
 /**
  * @brief Generate microseconds delay.
  * @param usecs - Delay in microseconds.
@@ -55,11 +142,7 @@
  */
 void udelay(uint32_t usecs)
 {
-#ifdef _XPARAMETERS_PS_H_
-	usleep(usecs);
-#else
-	usleep(usecs / 20);	// FIXME
-#endif
+	delay_ticks(US_TO_TICKS(usecs));
 }
 
 /**
@@ -68,10 +151,39 @@ void udelay(uint32_t usecs)
  * @return None.
  */
 void mdelay(uint32_t msecs)
+{
+	delay_ticks(MS_TO_TICKS(msecs));
+}
+
+/**
+ * @brief Wait until a condition is true or a timeout expires.
+ *
+ * The condition is checked once more when the timeout expires. On MicroBlaze
+ * the time spent in the condition is not counted, so the wait may be longer
+ * than the timeout, but never shorter.
+ * @param cond - Condition, polled until it returns true.
+ * @param ctx - Parameter for the condition.
+ * @param timeout_us - Timeout in microseconds.
+ * @return SUCCESS if the condition became true, -ETIMEDOUT otherwise.
+ */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us)
 {
 #ifdef _XPARAMETERS_PS_H_
-	usleep(msecs * 1000);
+	uint64_t deadline = delay_now() + US_TO_TICKS(timeout_us);
+
+	while (!cond(ctx))
+		if (delay_now() >= deadline)
+			return cond(ctx) ? SUCCESS : -ETIMEDOUT;
 #else
-	usleep(msecs * 50);	// FIXME
+	uint32_t elapsed = 0;
+
+	while (!cond(ctx)) {
+		if (elapsed >= timeout_us)
+			return cond(ctx) ? SUCCESS : -ETIMEDOUT;
+		delay_ticks(US_TO_TICKS(1));
+		elapsed++;
+	}
 #endif
+
+	return SUCCESS;
 }
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include <xparameters.h>
@@ -136,6 +137,27 @@ static int32_t i2c_set_transmission_config(struct i2c_desc *desc)
 	return SUCCESS;
 }
 
+#ifdef XIICPS_H
+/**
+ * @brief Keep the PS bus held after the next transfer or release it.
+ * @param instance - PS I2C instance.
+ * @param hold - true to end the next transfer with a repeated start,
+ *               false to end it with a stop condition.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+static int32_t xil_i2c_ps_set_repeated_start(XIicPs *instance, bool hold)
+{
+	int32_t ret;
+
+	if (hold)
+		ret = XIicPs_SetOptions(instance, XIICPS_REP_START_OPTION);
+	else
+		ret = XIicPs_ClearOptions(instance, XIICPS_REP_START_OPTION);
+
+	return ret == XST_SUCCESS ? SUCCESS : FAILURE;
+}
+#endif
+
 /**
  * @brief Initialize the I2C communication peripheral.
  * @param desc - The I2C descriptor.
@@ -282,6 +304,7 @@ ps_error:
 		break;
 	}
 
+	bus_stats_register(&idesc->stats, "i2c", idesc->slave_address);
 	*desc = idesc;
 
 	return SUCCESS;
@@ -358,12 +381,72 @@ error:
 		break;
 	}
 
+	bus_stats_unregister(&desc->stats);
 	free(desc->extra);
 	free(desc);
 
 	return SUCCESS;
 }
 
+/**
+ * @brief Xilinx specific I2C write, see i2c_write().
+ */
+static int32_t xil_i2c_write(struct i2c_desc *desc,
+			     uint8_t *data,
+			     uint32_t bytes_number,
+			     uint8_t stop_bit)
+{
+	xil_i2c_desc	*xdesc;
+	int32_t		ret;
+
+	xdesc = desc->extra;
+
+	switch (xdesc->type) {
+	case IIC_PL:
+#ifdef XIIC_H
+		ret = i2c_set_transmission_config(desc);
+		if (ret != SUCCESS)
+			return FAILURE;
+
+		XIic_Send(((XIic*)xdesc->instance)->BaseAddress,
+			  desc->slave_address,
+			  data,
+			  bytes_number,
+			  stop_bit ? XIIC_STOP : XIIC_REPEATED_START);
+		break;
+#endif
+		goto error;
+	case IIC_PS:
+#ifdef XIICPS_H
+		ret = i2c_set_transmission_config(desc);
+		if (ret != SUCCESS)
+			return FAILURE;
+
+		ret = xil_i2c_ps_set_repeated_start(xdesc->instance,
+						    !stop_bit);
+		if(ret != SUCCESS)
+			goto error;
+
+		ret = XIicPs_MasterSendPolled(xdesc->instance,
+					      data,
+					      bytes_number,
+					      desc->slave_address);
+		if(ret != SUCCESS)
+			goto error;
+
+		break;
+#endif
+		/* Intended fallthrough */
+error:
+	default:
+
+		return FAILURE;
+		break;
+	}
+
+	return SUCCESS;
+}
+
 /**
  * @brief Write data to a slave device.
  * @param desc - The I2C descriptor.
@@ -376,8 +459,21 @@ error:
  */
 int32_t i2c_write(struct i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t stop_bit)
+{
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      xil_i2c_write(desc, data, bytes_number,
+					    stop_bit));
+}
+
+/**
+ * @brief Xilinx specific I2C read, see i2c_read().
+ */
+static int32_t xil_i2c_read(struct i2c_desc *desc,
+			    uint8_t *data,
+			    uint32_t bytes_number,
+			    uint8_t stop_bit)
 {
 	xil_i2c_desc	*xdesc;
 	int32_t		ret;
@@ -391,11 +487,14 @@ int32_t i2c_write(struct i2c_desc *desc,
 		if (ret != SUCCESS)
 			return FAILURE;
 
-		XIic_Send(((XIic*)xdesc->instance)->BaseAddress,
-			  desc->slave_address,
-			  data,
-			  bytes_number,
-			  stop_bit ? XIIC_STOP : XIIC_REPEATED_START);
+		ret = XIic_Recv(((XIic*)xdesc->instance)->BaseAddress,
+				desc->slave_address,
+				data,
+				bytes_number,
+				stop_bit ? XIIC_STOP : XIIC_REPEATED_START);
+		if(ret != (int32_t)bytes_number)
+			goto error;
+
 		break;
 #endif
 		goto error;
@@ -405,15 +504,15 @@ int32_t i2c_write(struct i2c_desc *desc,
 		if (ret != SUCCESS)
 			return FAILURE;
 
-		ret = XIicPs_SetOptions(xdesc->instance,
-					stop_bit ? 0 : XIIC_REPEATED_START);
+		ret = xil_i2c_ps_set_repeated_start(xdesc->instance,
+						    !stop_bit);
 		if(ret != SUCCESS)
 			goto error;
 
-		XIicPs_MasterSend(xdesc->instance,
-				  data,
-				  bytes_number,
-				  desc->slave_address);
+		ret = XIicPs_MasterRecvPolled(xdesc->instance,
+					      data,
+					      bytes_number,
+					      desc->slave_address);
 		if(ret != SUCCESS)
 			goto error;
 
@@ -422,8 +521,8 @@ int32_t i2c_write(struct i2c_desc *desc,
 		/* Intended fallthrough */
 error:
 	default:
-
 		return FAILURE;
+
 		break;
 	}
 
@@ -442,27 +541,49 @@ error:
  */
 int32_t i2c_read(struct i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t stop_bit)
+{
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      xil_i2c_read(desc, data, bytes_number,
+					   stop_bit));
+}
+
+/**
+ * @brief Xilinx specific I2C write then read, see i2c_write_then_read().
+ */
+static int32_t xil_i2c_write_then_read(struct i2c_desc *desc,
+				       uint8_t *wr_data,
+				       uint32_t wr_bytes_number,
+				       uint8_t *rd_data,
+				       uint32_t rd_bytes_number)
 {
 	xil_i2c_desc	*xdesc;
 	int32_t		ret;
 
 	xdesc = desc->extra;
 
+	ret = i2c_set_transmission_config(desc);
+	if (ret != SUCCESS)
+		return FAILURE;
+
 	switch (xdesc->type) {
 	case IIC_PL:
 #ifdef XIIC_H
-		ret = i2c_set_transmission_config(desc);
-		if (ret != SUCCESS)
-			return FAILURE;
+		ret = XIic_Send(((XIic*)xdesc->instance)->BaseAddress,
+				desc->slave_address,
+				wr_data,
+				wr_bytes_number,
+				XIIC_REPEATED_START);
+		if(ret != (int32_t)wr_bytes_number)
+			goto error;
 
 		ret = XIic_Recv(((XIic*)xdesc->instance)->BaseAddress,
 				desc->slave_address,
-				data,
-				bytes_number,
-				stop_bit ? XIIC_STOP : XIIC_REPEATED_START);
-		if(ret != bytes_number)
+				rd_data,
+				rd_bytes_number,
+				XIIC_STOP);
+		if(ret != (int32_t)rd_bytes_number)
 			goto error;
 
 		break;
@@ -470,19 +591,27 @@ int32_t i2c_read(struct i2c_desc *desc,
 		goto error;
 	case IIC_PS:
 #ifdef XIICPS_H
-		ret = i2c_set_transmission_config(desc);
-		if (ret != SUCCESS)
-			return FAILURE;
+		ret = xil_i2c_ps_set_repeated_start(xdesc->instance, true);
+		if(ret != SUCCESS)
+			goto error;
 
-		ret = XIicPs_SetOptions(xdesc->instance,
-					stop_bit ? 0 : XIIC_REPEATED_START);
+		ret = XIicPs_MasterSendPolled(xdesc->instance,
+					      wr_data,
+					      wr_bytes_number,
+					      desc->slave_address);
+		if(ret != SUCCESS) {
+			xil_i2c_ps_set_repeated_start(xdesc->instance, false);
+			goto error;
+		}
+
+		ret = xil_i2c_ps_set_repeated_start(xdesc->instance, false);
 		if(ret != SUCCESS)
 			goto error;
 
-		XIicPs_MasterRecv(xdesc->instance,
-				  data,
-				  bytes_number,
-				  desc->slave_address);
+		ret = XIicPs_MasterRecvPolled(xdesc->instance,
+					      rd_data,
+					      rd_bytes_number,
+					      desc->slave_address);
 		if(ret != SUCCESS)
 			goto error;
 
@@ -498,3 +627,26 @@ error:
 
 	return SUCCESS;
 }
+
+/**
+ * @brief Write data then read data from a slave device, with a repeated
+ * start and no stop condition between the two.
+ * @param desc - The I2C descriptor.
+ * @param wr_data - Buffer that stores the transmission data.
+ * @param wr_bytes_number - Number of bytes to write.
+ * @param rd_data - Buffer that will store the received data.
+ * @param rd_bytes_number - Number of bytes to read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t i2c_write_then_read(struct i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number)
+{
+	return BUS_STATS_CALL(&desc->stats, wr_bytes_number + rd_bytes_number,
+			      xil_i2c_write_then_read(desc, wr_data,
+						      wr_bytes_number,
+						      rd_data,
+						      rd_bytes_number));
+}
@@ -44,7 +44,9 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "spi.h"
+#include "irq.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -82,8 +84,19 @@ typedef struct xil_spi_init_param {
 	uint32_t		flags;
 	/** Device ID */
 	uint32_t		device_id;
+	/**
+	 * Interrupt controller used by the asynchronous transfers of the PS
+	 * SPI. The interrupt belongs to the controller: the first descriptor
+	 * that sets it registers it for all the descriptors of the controller.
+	 * If no descriptor sets it, spi_submit_transfer() is blocking.
+	 */
+	struct irq_ctrl_desc	*irq_desc;
+	/** Interrupt ID of the PS SPI controller */
+	uint32_t		irq_id;
 } xil_spi_init_param;
 
+struct xil_spi_ctrl;
+
 /**
  * @struct xil_spi_desc
  * @brief Xilinx platform specific SPI descriptor
@@ -97,6 +110,22 @@ typedef struct xil_spi_desc {
 	void			*config;
 	/** SPI instance */
 	void			*instance;
+	/** Device ID */
+	uint32_t		device_id;
+	/** Input clock of the PS SPI */
+	uint32_t		input_clock;
+	/** Controller state shared with the other descriptors */
+	struct xil_spi_ctrl	*ctrl;
+	/** Buffer used to gather the segments of spi_transfer() */
+	uint8_t			*msg_buff;
+	/** Size of msg_buff */
+	uint32_t		msg_buff_size;
+	/** Status of the last asynchronous transfer */
+	volatile int32_t	status;
+	/** Called when the asynchronous transfer is done */
+	void			(*callback)(void *ctx, int32_t status);
+	/** Parameter for the callback */
+	void			*ctx;
 } xil_spi_desc;
 
 /**
@@ -124,4 +153,17 @@ int32_t xil_spi_remove(struct spi_desc *desc);
 int32_t xil_spi_write_and_read(struct spi_desc *desc, uint8_t *data,
 			       uint16_t bytes_number);
 
+/* Start an asynchronous write and read to/from SPI. */
+int32_t xil_spi_submit(struct spi_desc *desc, uint8_t *data,
+		       uint32_t bytes_number,
+		       void (*callback)(void *ctx, int32_t status),
+		       void *ctx);
+
+/* Check or wait for the end of the asynchronous transfer. */
+int32_t xil_spi_complete(struct spi_desc *desc, bool wait);
+
+/* Transfer several segments with the chip select held between them. */
+int32_t xil_spi_transfer(struct spi_desc *desc, struct spi_msg *msgs,
+			 uint32_t len);
+
 #endif // SPI_EXTRA_H_
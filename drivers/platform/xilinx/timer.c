@@ -43,9 +43,14 @@
 
 #include <stdlib.h>
 #include <xparameters.h>
+#ifdef _XPARAMETERS_PS_H_
+#include <xtime_l.h>
+#endif
 #include "timer.h"
 #include "timer_extra.h"
+#include "irq.h"
 #include "error.h"
+#include "util.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -92,6 +97,9 @@ int32_t timer_init(struct timer_desc **desc,
 	dev->extra = xdesc;
 	xdesc->active_tmr = xinit->active_tmr;
 	xdesc->type = xinit->type;
+	xdesc->irq_desc = xinit->irq_desc;
+	xdesc->irq_id = xinit->irq_id;
+	xdesc->reload = param->load_value;
 
 	switch (xdesc->type) {
 	case TIMER_PS:
@@ -173,6 +181,8 @@ int32_t timer_remove(struct timer_desc *desc)
 
 	xdesc = desc->extra;
 
+	timer_cancel(desc);
+
 	switch (xdesc->type) {
 	case TIMER_PS:
 #ifdef XSCUTIMER_H
@@ -220,7 +230,9 @@ int32_t timer_start(struct timer_desc *desc)
 		return FAILURE;
 	case TIMER_PL:
 #ifdef XTMRCTR_H
+		/* The counter is loaded with the reload value */
 		XTmrCtr_Start(xdesc->instance, xdesc->active_tmr);
+		xdesc->last_count = xdesc->reload;
 		break;
 #endif
 		return FAILURE;
@@ -326,6 +338,8 @@ int32_t timer_counter_set(struct timer_desc *desc, uint32_t new_val)
 #ifdef XTMRCTR_H
 		XTmrCtr_SetResetValue(xdesc->instance, xdesc->active_tmr, new_val);
 		XTmrCtr_Reset(xdesc->instance, xdesc->active_tmr);
+		xdesc->reload = new_val;
+		xdesc->last_count = new_val;
 		break;
 #endif
 		return FAILURE;
@@ -413,3 +427,311 @@ int32_t timer_count_clk_set(struct timer_desc *desc, uint32_t freq_hz)
 
 	return SUCCESS;
 }
+
+#ifdef XTMRCTR_H
+/**
+ * @brief Update the PL timestamp with the ticks counted since the last update.
+ *
+ * The counter counts down and is reloaded after reaching 0, so it must be
+ * read at least once per reload period. The timer interrupt does it when the
+ * callbacks are used.
+ * @param [in] desc - Pointer to the device handler.
+ * @return The number of ticks counted since the timer was initialized.
+ */
+static uint64_t timer_pl_ticks(struct timer_desc *desc)
+{
+	struct xil_timer_desc	*xdesc = desc->extra;
+	uint32_t		now;
+
+	now = XTmrCtr_GetValue(xdesc->instance, xdesc->active_tmr);
+	if (now <= xdesc->last_count)
+		xdesc->ticks += xdesc->last_count - now;
+	else
+		xdesc->ticks += (uint64_t)xdesc->last_count + xdesc->reload +
+				1 - now;
+	xdesc->last_count = now;
+
+	return xdesc->ticks;
+}
+#endif
+
+/**
+ * @brief Timer interrupt handler, calls the function set by
+ * timer_set_periodic() or timer_set_oneshot().
+ * @param [in] ctx - Pointer to the device handler.
+ */
+static void timer_irq_handler(void *ctx)
+{
+	struct timer_desc	*desc = ctx;
+	struct xil_timer_desc	*xdesc = desc->extra;
+#ifdef XTMRCTR_H
+	XTmrCtr			*tmr = xdesc->instance;
+	uint32_t		csr;
+#endif
+
+	switch (xdesc->type) {
+	case TIMER_PS:
+#ifdef XSCUTIMER_H
+		XScuTimer_ClearInterruptStatus((XScuTimer *)xdesc->instance);
+		if (xdesc->oneshot)
+			XScuTimer_Stop(xdesc->instance);
+		break;
+#endif
+		return;
+	case TIMER_PL:
+#ifdef XTMRCTR_H
+		timer_pl_ticks(desc);
+		csr = XTmrCtr_ReadReg(tmr->BaseAddress, xdesc->active_tmr,
+				      XTC_TCSR_OFFSET);
+		csr |= XTC_CSR_INT_OCCURED_MASK;
+		XTmrCtr_WriteReg(tmr->BaseAddress, xdesc->active_tmr,
+				 XTC_TCSR_OFFSET, csr);
+		if (xdesc->oneshot)
+			XTmrCtr_Stop(xdesc->instance, xdesc->active_tmr);
+		break;
+#endif
+		return;
+	default:
+		return;
+	}
+
+	if (xdesc->callback)
+		xdesc->callback(xdesc->ctx);
+}
+
+/**
+ * @brief Program the timer to interrupt after a number of microseconds.
+ * @param [in] desc - Pointer to the device handler.
+ * @param [in] time_us - Period or delay in microseconds.
+ * @param [in] oneshot - true to call the function only once.
+ * @param [in] callback - Function to call.
+ * @param [in] ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise
+ */
+static int32_t timer_set_callback(struct timer_desc *desc, uint32_t time_us,
+				  bool oneshot, void (*callback)(void *ctx),
+				  void *ctx)
+{
+	struct xil_timer_desc	*xdesc;
+	struct callback_desc	callback_desc;
+	uint32_t		freq_hz;
+	uint64_t		ticks;
+	int32_t			ret;
+
+	if (!desc || !callback || !time_us)
+		return FAILURE;
+
+	xdesc = desc->extra;
+	if (!xdesc->irq_desc)
+		return FAILURE;
+
+	ret = timer_count_clk_get(desc, &freq_hz);
+	if (ret != SUCCESS)
+		return FAILURE;
+
+	ticks = (uint64_t)time_us * freq_hz / 1000000u;
+	if (!ticks || ticks > UINT32_MAX)
+		return FAILURE;
+
+	timer_cancel(desc);
+
+	xdesc->callback = callback;
+	xdesc->ctx = ctx;
+	xdesc->oneshot = oneshot;
+
+	callback_desc.callback = (void (*)(void *, uint32_t, void *))
+				 timer_irq_handler;
+	callback_desc.ctx = desc;
+	callback_desc.config = xdesc->instance;
+	ret = irq_register_callback(xdesc->irq_desc, xdesc->irq_id,
+				    &callback_desc);
+	if (ret != SUCCESS)
+		goto error;
+
+	/* The interrupt comes when the counter goes past 0 */
+	switch (xdesc->type) {
+	case TIMER_PS:
+#ifdef XSCUTIMER_H
+		XScuTimer_Stop(xdesc->instance);
+		XScuTimer_LoadTimer((XScuTimer *)xdesc->instance, ticks - 1);
+		if (oneshot)
+			XScuTimer_DisableAutoReload(
+				(XScuTimer *)xdesc->instance);
+		else
+			XScuTimer_EnableAutoReload(
+				(XScuTimer *)xdesc->instance);
+		XScuTimer_EnableInterrupt((XScuTimer *)xdesc->instance);
+		break;
+#endif
+		goto error_unregister;
+	case TIMER_PL:
+#ifdef XTMRCTR_H
+		timer_pl_ticks(desc);
+		XTmrCtr_Stop(xdesc->instance, xdesc->active_tmr);
+		XTmrCtr_SetOptions(xdesc->instance, xdesc->active_tmr,
+				   XTC_DOWN_COUNT_OPTION | XTC_INT_MODE_OPTION |
+				   (oneshot ? 0 : XTC_AUTO_RELOAD_OPTION));
+		xdesc->reload = ticks - 1;
+		XTmrCtr_SetResetValue(xdesc->instance, xdesc->active_tmr,
+				      xdesc->reload);
+		break;
+#endif
+		goto error_unregister;
+	default:
+		goto error_unregister;
+	}
+
+	ret = irq_enable(xdesc->irq_desc, xdesc->irq_id);
+	if (ret != SUCCESS)
+		goto error_unregister;
+
+	return timer_start(desc);
+
+error_unregister:
+	irq_unregister(xdesc->irq_desc, xdesc->irq_id);
+error:
+	xdesc->callback = NULL;
+
+	return FAILURE;
+}
+
+/**
+ * @brief Call a function periodically, from the timer interrupt.
+ *
+ * The timer is reprogrammed and started. The period is rounded down to timer
+ * ticks.
+ * @param [in] desc - Pointer to the device handler.
+ * @param [in] period_us - Period in microseconds.
+ * @param [in] callback - Function to call.
+ * @param [in] ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise
+ */
+int32_t timer_set_periodic(struct timer_desc *desc, uint32_t period_us,
+			   void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, period_us, false, callback, ctx);
+}
+
+/**
+ * @brief Call a function once, from the timer interrupt, after a delay.
+ *
+ * The timer is reprogrammed and started. It stops after the call.
+ * @param [in] desc - Pointer to the device handler.
+ * @param [in] delay_us - Delay in microseconds.
+ * @param [in] callback - Function to call.
+ * @param [in] ctx - Parameter for the function.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise
+ */
+int32_t timer_set_oneshot(struct timer_desc *desc, uint32_t delay_us,
+			  void (*callback)(void *ctx), void *ctx)
+{
+	return timer_set_callback(desc, delay_us, true, callback, ctx);
+}
+
+/**
+ * @brief Stop calling the function set by timer_set_periodic/oneshot().
+ *
+ * The timer is stopped and gets back the configuration done by timer_init().
+ * @param [in] desc - Pointer to the device handler.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise
+ */
+int32_t timer_cancel(struct timer_desc *desc)
+{
+	struct xil_timer_desc *xdesc;
+
+	if (!desc)
+		return FAILURE;
+
+	xdesc = desc->extra;
+	if (!xdesc->callback)
+		return SUCCESS;
+
+	irq_disable(xdesc->irq_desc, xdesc->irq_id);
+
+	switch (xdesc->type) {
+	case TIMER_PS:
+#ifdef XSCUTIMER_H
+		XScuTimer_Stop(xdesc->instance);
+		XScuTimer_LoadTimer((XScuTimer *)xdesc->instance,
+				    desc->load_value);
+		XScuTimer_EnableAutoReload((XScuTimer *)xdesc->instance);
+#endif
+		break;
+	case TIMER_PL:
+#ifdef XTMRCTR_H
+		timer_pl_ticks(desc);
+		XTmrCtr_Stop(xdesc->instance, xdesc->active_tmr);
+		XTmrCtr_SetOptions(xdesc->instance, xdesc->active_tmr,
+				   XTC_DOWN_COUNT_OPTION | XTC_INT_MODE_OPTION |
+				   XTC_AUTO_RELOAD_OPTION);
+		xdesc->reload = desc->load_value;
+		XTmrCtr_SetResetValue(xdesc->instance, xdesc->active_tmr,
+				      xdesc->reload);
+#endif
+		break;
+	default:
+		break;
+	}
+
+	irq_unregister(xdesc->irq_desc, xdesc->irq_id);
+	xdesc->callback = NULL;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Get a 64-bit monotonic timestamp in nanoseconds.
+ *
+ * On PS the global timer is used, it is always running. On PL the timestamp
+ * only advances while the timer runs, and must be read at least once per
+ * reload period if no callback is set.
+ * @param [in] desc - Pointer to the device handler.
+ * @param [out] ns - Pointer to the timestamp.
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise
+ */
+int32_t timer_get_time_ns(struct timer_desc *desc, uint64_t *ns)
+{
+	struct xil_timer_desc	*xdesc;
+	uint64_t		ticks;
+	uint32_t		freq_hz;
+	uint32_t		rem;
+#ifdef _XPARAMETERS_PS_H_
+	XTime			now;
+#endif
+
+	if (!desc || !ns)
+		return FAILURE;
+
+	xdesc = desc->extra;
+
+	switch (xdesc->type) {
+	case TIMER_PS:
+#ifdef _XPARAMETERS_PS_H_
+		XTime_GetTime(&now);
+		ticks = now;
+		freq_hz = COUNTS_PER_SECOND;
+		break;
+#endif
+		return FAILURE;
+	case TIMER_PL:
+#ifdef XTMRCTR_H
+		/* The interrupt handler also updates the timestamp */
+		if (xdesc->callback)
+			irq_disable(xdesc->irq_desc, xdesc->irq_id);
+		ticks = timer_pl_ticks(desc);
+		if (xdesc->callback)
+			irq_enable(xdesc->irq_desc, xdesc->irq_id);
+		freq_hz = ((XTmrCtr_Config *)xdesc->config)->SysClockFreqHz;
+		break;
+#endif
+		return FAILURE;
+	default:
+		return FAILURE;
+	}
+
+	ticks = div_u64_rem(ticks, freq_hz, &rem);
+	*ns = ticks * 1000000000ull + div_u64((uint64_t)rem * 1000000000ull,
+					      freq_hz);
+
+	return SUCCESS;
+}
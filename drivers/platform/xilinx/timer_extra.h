@@ -44,6 +44,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <stdbool.h>
 #include <xparameters.h>
 #ifdef XPAR_XSCUTIMER_NUM_INSTANCES
 #include <xscutimer.h>
@@ -80,6 +81,22 @@ struct xil_timer_desc {
 	uint8_t active_tmr;
 	/** Platform selection parameter */
 	enum xil_timer_type type;
+	/** Interrupt controller used by the timer callbacks */
+	struct irq_ctrl_desc *irq_desc;
+	/** Interrupt ID of the timer */
+	uint32_t irq_id;
+	/** Function set by timer_set_periodic/oneshot(), NULL if none */
+	void (*callback)(void *ctx);
+	/** Parameter for the callback */
+	void *ctx;
+	/** Set if the callback is called only once */
+	bool oneshot;
+	/** PL counter reload value */
+	uint32_t reload;
+	/** PL counter value at the last timestamp update */
+	uint32_t last_count;
+	/** PL ticks counted until the last timestamp update */
+	uint64_t ticks;
 };
 
 /**
@@ -91,6 +108,13 @@ struct xil_timer_init_param {
 	uint8_t active_tmr;
 	/** Platform selection parameter */
 	enum xil_timer_type type;
+	/**
+	 * Interrupt controller used by timer_set_periodic/oneshot(). May be
+	 * NULL if the callbacks are not used.
+	 */
+	struct irq_ctrl_desc *irq_desc;
+	/** Interrupt ID of the timer */
+	uint32_t irq_id;
 };
 
 #endif /* SRC_TIMER_EXTRA_H_ */
@@ -36,11 +36,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "error.h"
+#include "util.h"
+#include "irq.h"
+#include "circular_buffer.h"
 #include "uart.h"
 #include "uart_extra.h"
 #ifdef XPAR_XUARTPS_NUM_INSTANCES
-#include "irq.h"
-#include "fifo.h"
 #include <xil_exception.h>
 #include <xuartps.h>
 #endif
@@ -53,90 +54,273 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
-#define WRITE_SIZE 255
+/* Depth of the UART Lite FIFOs */
+#define UART_LITE_FIFO_SIZE	16
+/* Depth of the PS UART FIFOs */
+#define UART_PS_FIFO_SIZE	64
+/* PS UART RX FIFO level that raises an interrupt */
+#define UART_PS_RX_TRIGGER	32
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
-#ifdef XUARTPS_H
 /**
- * @brief Save received data into fifo.
- * @param desc - Instance descriptor containing a fifo element.
- * @return SUCCESS in case of success, FAILURE otherwise.
+ * @brief Move data from the TX ring to an empty hardware FIFO.
+ *
+ * Called from the interrupt handler, or with the UART interrupt disabled.
+ * If the FIFO is not empty, the next TX empty interrupt calls it again.
+ * @param xil_uart_desc - Platform specific UART descriptor.
  */
-static int32_t uart_fifo_insert(struct uart_desc *desc)
+static void uart_tx_fill(struct xil_uart_desc *xil_uart_desc)
 {
-	int32_t ret;
-	struct xil_uart_desc *xil_uart_desc = desc->extra;
-	struct irq_ctrl_desc *irq_desc = xil_uart_desc->irq_desc;
-
-	if (xil_uart_desc->bytes_received > 0) {
-		ret = irq_disable(irq_desc, xil_uart_desc->irq_id);
-		if (ret < 0)
-			return ret;
-		ret = fifo_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
-				  xil_uart_desc->bytes_received);
-		if (ret < 0)
-			return ret;
-		xil_uart_desc->bytes_received = 0;
-		switch(xil_uart_desc->type) {
-		case UART_PS:
-			XUartPs_Recv(xil_uart_desc->instance, (u8*)(xil_uart_desc->buff),
-				     UART_BUFF_LENGTH);
-			break;
-		case UART_PL:
+#ifdef XUARTLITE_H
+	XUartLite	*lite = xil_uart_desc->instance;
+#endif
+#ifdef XUARTPS_H
+	XUartPs		*ps = xil_uart_desc->instance;
+	uint32_t	base = 0;
+#endif
+	uint32_t	room = 0;
+	uint32_t	len;
+	uint32_t	i;
+	uint8_t		*buff;
+	int32_t		ret;
 
-			break;
-		default:
-			return FAILURE;
-			break;
+	switch(xil_uart_desc->type) {
+	case UART_PS:
+#ifdef XUARTPS_H
+		base = ps->Config.BaseAddress;
+		if (!(XUartPs_ReadReg(base, XUARTPS_SR_OFFSET) &
+		      XUARTPS_SR_TXEMPTY)) {
+			XUartPs_WriteReg(base, XUARTPS_IER_OFFSET,
+					 XUARTPS_IXR_TXEMPTY);
+			return;
 		}
-		ret = irq_enable(irq_desc, xil_uart_desc->irq_id);
-		if (ret < 0)
-			return ret;
+		room = UART_PS_FIFO_SIZE;
+#endif // XUARTPS_H
+		break;
+	case UART_PL:
+#ifdef XUARTLITE_H
+		if (!(XUartLite_ReadReg(lite->RegBaseAddress,
+					XUL_STATUS_REG_OFFSET) &
+		      XUL_SR_TX_FIFO_EMPTY))
+			return;
+		room = UART_LITE_FIFO_SIZE;
+#endif // XUARTLITE_H
+		break;
+	default:
+		return;
 	}
 
-	return SUCCESS;
-}
+	ret = cb_prepare_async_read(xil_uart_desc->tx_ring, room,
+				    (void **)&buff, &len);
+	if (ret != SUCCESS) {
+#ifdef XUARTPS_H
+		/* Nothing left to send */
+		if (xil_uart_desc->type == UART_PS)
+			XUartPs_WriteReg(base, XUARTPS_IDR_OFFSET,
+					 XUARTPS_IXR_TXEMPTY);
 #endif // XUARTPS_H
+		return;
+	}
+
+	switch(xil_uart_desc->type) {
+	case UART_PS:
+#ifdef XUARTPS_H
+		for (i = 0; i < len; i++)
+			XUartPs_WriteReg(base, XUARTPS_FIFO_OFFSET, buff[i]);
+		XUartPs_WriteReg(base, XUARTPS_IER_OFFSET,
+				 XUARTPS_IXR_TXEMPTY);
+#endif // XUARTPS_H
+		break;
+	case UART_PL:
+#ifdef XUARTLITE_H
+		for (i = 0; i < len; i++)
+			XUartLite_WriteReg(lite->RegBaseAddress,
+					   XUL_TX_FIFO_OFFSET, buff[i]);
+#endif // XUARTLITE_H
+		break;
+	default:
+		break;
+	}
+
+	cb_end_async_read(xil_uart_desc->tx_ring);
+}
 
 /**
- * @brief Read byte from fifo.
- * @param desc - Instance descriptor containing a fifo element
- * @param data - read value.
- * @return SUCCESS in case of success, FAILURE otherwise.
+ * @brief UART interrupt handler.
+ *
+ * Empties the RX FIFO into the RX ring and refills the TX FIFO from the TX
+ * ring. The UART callback, if set, is called with READ_DONE when new data
+ * is in the RX ring.
+ * @param ctx - Instance of UART.
  */
-static int32_t uart_read_byte(struct uart_desc *desc, uint8_t *data)
+static void uart_irq_handler(void *ctx)
 {
-	struct xil_uart_desc *xil_uart_desc = desc->extra;
+	struct uart_desc	*desc = ctx;
+	struct xil_uart_desc	*xil_uart_desc = desc->extra;
+	void			(*callback)(void *callback_ctx, uint32_t event,
+					    void *extra);
 #ifdef XUARTLITE_H
-	XUartLite *instance = xil_uart_desc->instance;
+	XUartLite		*lite = xil_uart_desc->instance;
 #endif
 #ifdef XUARTPS_H
-	int32_t ret;
+	XUartPs			*ps = xil_uart_desc->instance;
+	uint32_t		isr;
 #endif
+	uint8_t			buff[UART_PS_FIFO_SIZE];
+	uint32_t		status;
+	uint32_t		n = 0;
 
 	switch(xil_uart_desc->type) {
 	case UART_PS:
 #ifdef XUARTPS_H
-		while (xil_uart_desc->fifo == NULL) {
-			/* nothing in fifo, wait until something is received */
-			ret = uart_fifo_insert(desc);
-			if (ret < 0)
-				return ret;
-		}
-
-		*data = xil_uart_desc->fifo->data[xil_uart_desc->fifo_read_offset];
-		xil_uart_desc->fifo_read_offset++;
+		isr = XUartPs_ReadReg(ps->Config.BaseAddress,
+				      XUARTPS_IMR_OFFSET);
+		isr &= XUartPs_ReadReg(ps->Config.BaseAddress,
+				       XUARTPS_ISR_OFFSET);
+		XUartPs_WriteReg(ps->Config.BaseAddress, XUARTPS_ISR_OFFSET,
+				 isr);
+
+		if (isr & (XUARTPS_IXR_OVER | XUARTPS_IXR_FRAMING |
+			   XUARTPS_IXR_PARITY | XUARTPS_IXR_RBRK))
+			xil_uart_desc->total_error_count++;
 
-		if (xil_uart_desc->fifo->len - xil_uart_desc->fifo_read_offset <= 0) {
-			xil_uart_desc->fifo_read_offset = 0;
-			xil_uart_desc->fifo = fifo_remove(xil_uart_desc->fifo);
-		}
+		/* Copy the whole FIFO, it is at most UART_PS_FIFO_SIZE */
+		do {
+			status = XUartPs_ReadReg(ps->Config.BaseAddress,
+						 XUARTPS_SR_OFFSET);
+			if (status & XUARTPS_SR_RXEMPTY)
+				break;
+			buff[n++] = XUartPs_ReadReg(ps->Config.BaseAddress,
+						    XUARTPS_FIFO_OFFSET);
+		} while (n < sizeof(buff));
+		if (n)
+			cb_write(xil_uart_desc->rx_ring, buff, n);
+
+		if (isr & XUARTPS_IXR_TXEMPTY)
+			uart_tx_fill(xil_uart_desc);
 #endif // XUARTPS_H
 		break;
 	case UART_PL:
+#ifdef XUARTLITE_H
+		/* Reading the status register clears the error flags */
+		status = XUartLite_ReadReg(lite->RegBaseAddress,
+					   XUL_STATUS_REG_OFFSET);
+		while (status & XUL_SR_RX_FIFO_VALID_DATA &&
+		       n < UART_LITE_FIFO_SIZE) {
+			if (status & (XUL_SR_OVERRUN_ERROR |
+				      XUL_SR_FRAMING_ERROR |
+				      XUL_SR_PARITY_ERROR))
+				xil_uart_desc->total_error_count++;
+			buff[n++] = XUartLite_ReadReg(lite->RegBaseAddress,
+						      XUL_RX_FIFO_OFFSET);
+			status = XUartLite_ReadReg(lite->RegBaseAddress,
+						   XUL_STATUS_REG_OFFSET);
+		}
+		if (n)
+			cb_write(xil_uart_desc->rx_ring, buff, n);
+
+		uart_tx_fill(xil_uart_desc);
+#endif // XUARTLITE_H
+		break;
+	default:
+		break;
+	}
+
+	callback = desc->callback;
+	if (n && callback)
+		callback(desc->callback_ctx, READ_DONE, NULL);
+}
+
+/**
+ * @brief Queue data in the TX ring and start the transmission.
+ * @param xil_uart_desc - Platform specific UART descriptor.
+ * @param data - Data to send.
+ * @param bytes_number - Number of bytes to send.
+ * @return Number of queued bytes, negative error code otherwise.
+ */
+static int32_t uart_tx_queue(struct xil_uart_desc *xil_uart_desc,
+			     const uint8_t *data, uint32_t bytes_number)
+{
+	uint32_t	used;
+	int32_t		ret;
+
+	/*
+	 * The ring indexes are not updated atomically, so the interrupt
+	 * handler must not read the TX ring while it is written.
+	 */
+	ret = irq_disable(xil_uart_desc->irq_desc, xil_uart_desc->irq_id);
+	if (ret < 0)
+		return ret;
+
+	cb_size(xil_uart_desc->tx_ring, &used);
+	bytes_number = min(bytes_number, xil_uart_desc->tx_ring_size - used);
+	if (bytes_number) {
+		ret = cb_write(xil_uart_desc->tx_ring, data, bytes_number);
+		if (ret >= 0)
+			uart_tx_fill(xil_uart_desc);
+	}
+
+	if (irq_enable(xil_uart_desc->irq_desc, xil_uart_desc->irq_id) < 0)
+		return FAILURE;
+	if (ret < 0)
+		return ret;
+
+	return bytes_number;
+}
+
+/**
+ * @brief Read data from the RX ring.
+ * @param xil_uart_desc - Platform specific UART descriptor.
+ * @param data - Buffer for the received data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read, negative error code otherwise.
+ */
+static int32_t uart_rx_dequeue(struct xil_uart_desc *xil_uart_desc,
+			       uint8_t *data, uint32_t bytes_number)
+{
+	uint32_t	available;
+	int32_t		ret;
+
+	/* The interrupt handler must not write the RX ring while it is read */
+	ret = irq_disable(xil_uart_desc->irq_desc, xil_uart_desc->irq_id);
+	if (ret < 0)
+		return ret;
+
+	ret = cb_size(xil_uart_desc->rx_ring, &available);
+	if (ret == -EOVERRUN)
+		xil_uart_desc->total_error_count++;
+
+	bytes_number = min(bytes_number, available);
+	ret = SUCCESS;
+	if (bytes_number)
+		ret = cb_read(xil_uart_desc->rx_ring, data, bytes_number);
+
+	if (irq_enable(xil_uart_desc->irq_desc, xil_uart_desc->irq_id) < 0)
+		return FAILURE;
+	if (ret < 0 && ret != -EOVERRUN)
+		return ret;
+
+	return bytes_number;
+}
+
+/**
+ * @brief Read byte from the UART Lite without interrupts.
+ * @param desc - Instance descriptor.
+ * @param data - read value.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t uart_read_byte(struct uart_desc *desc, uint8_t *data)
+{
+	struct xil_uart_desc *xil_uart_desc = desc->extra;
+#ifdef XUARTLITE_H
+	XUartLite *instance = xil_uart_desc->instance;
+#endif
+
+	switch(xil_uart_desc->type) {
+	case UART_PL:
 #ifdef XUARTLITE_H
 		while (!(Xil_In32(instance->RegBaseAddress + XUL_STATUS_REG_OFFSET) &
 			 XUL_SR_RX_FIFO_VALID_DATA));
@@ -144,7 +328,7 @@ static int32_t uart_read_byte(struct uart_desc *desc, uint8_t *data)
 #endif // XUARTLITE_H
 		break;
 	default:
-		break;
+		return FAILURE;
 	}
 
 	return SUCCESS;
@@ -152,15 +336,34 @@ static int32_t uart_read_byte(struct uart_desc *desc, uint8_t *data)
 
 /**
  * @brief Read data from UART device.
+ *
+ * In interrupt mode whole runs are copied from the RX ring.
  * @param desc - Instance of UART.
  * @param data - Pointer to buffer containing data.
  * @param bytes_number - Number of bytes to read.
- * @return SUCCESS in case of success, FAILURE otherwise.
+ * @return Number of bytes read in case of success, negative error code
+ * otherwise.
  */
 int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 {
-	ssize_t ret;
-	for (uint32_t i = 0; i < bytes_number; i++) {
+	struct xil_uart_desc	*xil_uart_desc = desc->extra;
+	uint32_t		i;
+	int32_t			ret;
+
+	if (xil_uart_desc->rx_ring) {
+		i = 0;
+		while (i < bytes_number) {
+			ret = uart_rx_dequeue(xil_uart_desc, data + i,
+					      bytes_number - i);
+			if (ret < 0)
+				return ret;
+			i += ret;
+		}
+
+		return bytes_number;
+	}
+
+	for (i = 0; i < bytes_number; i++) {
 		ret = uart_read_byte(desc, &data[i]);
 		if (ret < 0)
 			return ret;
@@ -169,8 +372,48 @@ int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 	return bytes_number;
 }
 
+/**
+ * @brief Read the data already received by the UART device.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read in case of success, negative error code
+ * otherwise.
+ */
+int32_t uart_read_nonblocking(struct uart_desc *desc, uint8_t *data,
+			      uint32_t bytes_number)
+{
+	struct xil_uart_desc	*xil_uart_desc = desc->extra;
+#ifdef XUARTLITE_H
+	XUartLite		*instance = xil_uart_desc->instance;
+#endif
+	uint32_t		i = 0;
+
+	if (xil_uart_desc->rx_ring)
+		return uart_rx_dequeue(xil_uart_desc, data, bytes_number);
+
+	switch(xil_uart_desc->type) {
+	case UART_PL:
+#ifdef XUARTLITE_H
+		while (i < bytes_number &&
+		       (Xil_In32(instance->RegBaseAddress +
+				 XUL_STATUS_REG_OFFSET) &
+			XUL_SR_RX_FIFO_VALID_DATA))
+			data[i++] = Xil_In32(instance->RegBaseAddress +
+					     XUL_RX_FIFO_OFFSET);
+#endif // XUARTLITE_H
+		break;
+	default:
+		return FAILURE;
+	}
+
+	return i;
+}
+
 /**
  * @brief Write data to UART device.
+ *
+ * In interrupt mode the function returns as soon as all the data is queued.
  * @param desc - Instance of UART.
  * @param data - Pointer to buffer containing data.
  * @param bytes_number - Number of bytes to read.
@@ -182,24 +425,23 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 	struct xil_uart_desc *xil_uart_desc = desc->extra;
 #ifdef XUARTLITE_H
 	XUartLite *instance = xil_uart_desc->instance;
-#endif
-#ifdef XUARTPS_H
-	size_t bytes_sent, len;
 #endif
 	uint32_t offset = 0;
+	int32_t ret;
 
-	switch(xil_uart_desc->type) {
-	case UART_PS:
-#ifdef XUARTPS_H
+	if (xil_uart_desc->tx_ring) {
 		while (offset < bytes_number) {
-			len = ((bytes_number - offset) < WRITE_SIZE) ? (bytes_number - offset) :
-			      WRITE_SIZE;
-			bytes_sent = XUartPs_Send(xil_uart_desc->instance, (u8*)(data + offset),
-						  len);
-			offset += bytes_sent;
+			ret = uart_tx_queue(xil_uart_desc, data + offset,
+					    bytes_number - offset);
+			if (ret < 0)
+				return ret;
+			offset += ret;
 		}
-		break;
-#endif // XUARTPS_H
+
+		return SUCCESS;
+	}
+
+	switch(xil_uart_desc->type) {
 	case UART_PL:
 #ifdef XUARTLITE_H
 		while (offset < bytes_number) {
@@ -220,62 +462,44 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 	return SUCCESS;
 }
 
-#ifdef XUARTPS_H
 /**
- * @brief UART interrupt handler.
- * @param call_back_ref - Instance of UART.
- * @param event - Event that caused the interrupt.
- * @param data_len - number of bytes received.
+ * @brief Write as much data as fits without waiting.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes written in case of success, negative error code
+ * otherwise.
  */
-static void uart_irq_handler(void *call_back_ref, uint32_t event,
-			     uint32_t data_len)
+int32_t uart_write_nonblocking(struct uart_desc *desc, const uint8_t *data,
+			       uint32_t bytes_number)
 {
-	struct xil_uart_desc *xil_uart_desc = call_back_ref;
+	struct xil_uart_desc	*xil_uart_desc = desc->extra;
+#ifdef XUARTLITE_H
+	XUartLite		*instance = xil_uart_desc->instance;
+#endif
+	uint32_t		i = 0;
+
+	if (xil_uart_desc->tx_ring)
+		return uart_tx_queue(xil_uart_desc, data, bytes_number);
 
 	switch(xil_uart_desc->type) {
-	case UART_PS:
-		switch(event) {
-		/* All of the data has been received */
-		case XUARTPS_EVENT_RECV_DATA:
-		/*
-		 * Data was received, but not the expected number of bytes, a
-		 * timeout just indicates the data stopped for configured character time
-		 */
-		case XUARTPS_EVENT_RECV_TOUT:
-			xil_uart_desc->bytes_received = data_len;
-			break;
-		/*
-		 * Data was received with an error, keep the data but determine
-		 * what kind of errors occurred
-		 */
-		case XUARTPS_EVENT_RECV_ERROR:
-		/*
-		 * Data was received with an parity or frame or break error, keep the data
-		 * but determine what kind of errors occurred. Specific to Zynq Ultrascale+
-		 * MP.
-		 */
-		case XUARTPS_EVENT_PARE_FRAME_BRKE:
-		/*
-		 * Data was received with an overrun error, keep the data but determine
-		 * what kind of errors occurred. Specific to Zynq Ultrascale+ MP.
-		 */
-		case XUARTPS_EVENT_RECV_ORERR:
-			xil_uart_desc->total_error_count++;
-			break;
-		default:
-			break;
-		}
-		break;
 	case UART_PL:
-
+#ifdef XUARTLITE_H
+		while (i < bytes_number &&
+		       !(Xil_In32(instance->RegBaseAddress +
+				  XUL_STATUS_REG_OFFSET) &
+			 XUL_SR_TX_FIFO_FULL))
+			Xil_Out32(instance->RegBaseAddress + XUL_TX_FIFO_OFFSET,
+				  data[i++]);
+#endif // XUARTLITE_H
 		break;
 	default:
-		break;
+		return FAILURE;
 	}
+
+	return i;
 }
-#endif // XUARTPS_H
 
-#ifdef XUARTPS_H
 /**
  * @brief UART interrupt init.
  * @param desc - Instance of UART containing a pointer to handler.
@@ -284,33 +508,40 @@ static void uart_irq_handler(void *call_back_ref, uint32_t event,
 static int32_t uart_irq_init(struct uart_desc *descriptor)
 {
 	int32_t status;
-	uint32_t uart_irq_mask;
 	struct xil_uart_desc *xil_uart_desc = descriptor->extra;
 	struct callback_desc callback_desc;
 
+	callback_desc.callback = (void (*)(void *, uint32_t, void *))
+				 uart_irq_handler;
+	callback_desc.ctx = descriptor;
+	callback_desc.config = NULL;
+	status = irq_register_callback(xil_uart_desc->irq_desc,
+				       xil_uart_desc->irq_id,
+				       &callback_desc);
+	if (status < 0)
+		return status;
+
 	switch(xil_uart_desc->type) {
 	case UART_PS:
-		callback_desc.callback = XUartPs_InterruptHandler;
-		callback_desc.ctx = xil_uart_desc->instance;
-		status = irq_register_callback(xil_uart_desc->irq_desc,
-					       xil_uart_desc->irq_id,
-					       &callback_desc);
-		if (status < 0)
-			return status;
-		XUartPs_SetHandler(xil_uart_desc->instance, uart_irq_handler, xil_uart_desc);
+#ifdef XUARTPS_H
 		/*
-		 * Enable the interrupt of the UART so interrupts will occur
+		 * RX interrupts at the FIFO trigger level and at the receive
+		 * timeout. TX empty is enabled while the TX ring has data.
 		 */
-		uart_irq_mask =
-			XUARTPS_IXR_TOUT | XUARTPS_IXR_PARITY | XUARTPS_IXR_FRAMING |
-			XUARTPS_IXR_OVER | XUARTPS_IXR_TXEMPTY | XUARTPS_IXR_RXFULL |
-			XUARTPS_IXR_RXOVR | XUARTPS_IXR_RBRK;
-
-		XUartPs_SetInterruptMask(xil_uart_desc->instance, uart_irq_mask);
-
+		XUartPs_SetFifoThreshold(xil_uart_desc->instance,
+					 UART_PS_RX_TRIGGER);
+		XUartPs_SetInterruptMask(xil_uart_desc->instance,
+					 XUARTPS_IXR_TOUT | XUARTPS_IXR_PARITY |
+					 XUARTPS_IXR_FRAMING |
+					 XUARTPS_IXR_OVER | XUARTPS_IXR_RXOVR |
+					 XUARTPS_IXR_RBRK);
+#endif // XUARTPS_H
 		break;
 	case UART_PL:
-
+#ifdef XUARTLITE_H
+		/* The UART Lite interrupts on RX data and on TX FIFO empty */
+		XUartLite_EnableInterrupt(xil_uart_desc->instance);
+#endif // XUARTLITE_H
 		break;
 	default:
 		return FAILURE;
@@ -323,10 +554,54 @@ static int32_t uart_irq_init(struct uart_desc *descriptor)
 
 	return SUCCESS;
 }
-#endif // XUARTPS_H
+
+/**
+ * @brief Allocate the rings and enable the interrupts.
+ * @param descriptor - The UART descriptor.
+ * @param param - Platform specific UART init param.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t uart_ring_init(struct uart_desc *descriptor,
+			      struct xil_uart_init_param *param)
+{
+	struct xil_uart_desc	*xil_uart_desc = descriptor->extra;
+	uint32_t		rx_size;
+	int32_t			ret;
+
+	rx_size = param->rx_ring_size ? param->rx_ring_size :
+		  UART_RING_LENGTH;
+	xil_uart_desc->tx_ring_size = param->tx_ring_size ?
+				      param->tx_ring_size : UART_RING_LENGTH;
+
+	ret = cb_init(&xil_uart_desc->rx_ring, rx_size);
+	if (ret < 0)
+		return ret;
+
+	ret = cb_init(&xil_uart_desc->tx_ring, xil_uart_desc->tx_ring_size);
+	if (ret < 0)
+		goto error_rx;
+
+	ret = uart_irq_init(descriptor);
+	if (ret < 0)
+		goto error_tx;
+
+	return SUCCESS;
+
+error_tx:
+	cb_remove(xil_uart_desc->tx_ring);
+	xil_uart_desc->tx_ring = NULL;
+error_rx:
+	cb_remove(xil_uart_desc->rx_ring);
+	xil_uart_desc->rx_ring = NULL;
+
+	return ret;
+}
 
 /**
  * @brief Initialize the UART communication peripheral.
+ *
+ * The PS UART always works in interrupt mode. The UART Lite works in interrupt
+ * mode if an interrupt controller is given and polls otherwise.
  * @param desc - The UART descriptor.
  * @param param - The structure that contains the UART parameters.
  * @return SUCCESS in case of success, FAILURE otherwise.
@@ -363,6 +638,9 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 	switch(xil_uart_desc->type) {
 	case UART_PS:
 #ifdef XUARTPS_H
+		if (!xil_uart_desc->irq_desc)
+			goto error_free_xil_uart_desc;
+
 		xil_uart_desc->instance = calloc(1, sizeof(XUartPs));
 		if (!(xil_uart_desc->instance))
 			goto error_free_xil_uart_desc;
@@ -396,17 +674,15 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 		 */
 		XUartPs_SetRecvTimeout(xil_uart_desc->instance, 8);
 
-		status = uart_irq_init(descriptor);
-		if (status != XST_SUCCESS)
+		status = uart_ring_init(descriptor, xil_uart_init_param);
+		if (status < 0)
 			goto error_free_instance;
 
 		*desc = descriptor;
 
-		XUartPs_Recv(xil_uart_desc->instance, (u8*)xil_uart_desc->buff,
-			     UART_BUFF_LENGTH);
-
 		break;
 #endif // XUARTPS_H
+		goto error_free_xil_uart_desc;
 	case UART_PL:
 #ifdef XUARTLITE_H
 		xil_uart_desc->instance = calloc(1, sizeof(XUartLite));
@@ -425,6 +701,13 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 		/* Discard old data */
 		while (XUartLite_Recv(xil_uart_desc->instance, (uint8_t *)&status, 1));
 
+		if (xil_uart_desc->irq_desc) {
+			status = uart_ring_init(descriptor,
+						xil_uart_init_param);
+			if (status < 0)
+				goto error_free_instance;
+		}
+
 		*desc = descriptor;
 #endif // XUARTLITE_H
 		break;
@@ -447,12 +730,46 @@ error_free_descriptor:
 
 /**
  * @brief Free the resources allocated by uart_init().
+ *
+ * In interrupt mode the data still in the TX ring is sent first.
  * @param desc - The UART descriptor.
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
 int32_t uart_remove(struct uart_desc *desc)
 {
-	struct xil_uart_desc *xil_uart_desc = desc->extra;
+	struct xil_uart_desc	*xil_uart_desc = desc->extra;
+	uint32_t		pending;
+
+	if (xil_uart_desc->tx_ring) {
+		do {
+			irq_disable(xil_uart_desc->irq_desc,
+				    xil_uart_desc->irq_id);
+			cb_size(xil_uart_desc->tx_ring, &pending);
+			irq_enable(xil_uart_desc->irq_desc,
+				   xil_uart_desc->irq_id);
+		} while (pending);
+
+		irq_disable(xil_uart_desc->irq_desc, xil_uart_desc->irq_id);
+		switch(xil_uart_desc->type) {
+		case UART_PS:
+#ifdef XUARTPS_H
+			XUartPs_SetInterruptMask(xil_uart_desc->instance, 0);
+#endif // XUARTPS_H
+			break;
+		case UART_PL:
+#ifdef XUARTLITE_H
+			XUartLite_DisableInterrupt(xil_uart_desc->instance);
+#endif // XUARTLITE_H
+			break;
+		default:
+			break;
+		}
+		irq_unregister(xil_uart_desc->irq_desc, xil_uart_desc->irq_id);
+
+		cb_remove(xil_uart_desc->tx_ring);
+		cb_remove(xil_uart_desc->rx_ring);
+	}
+
 	free(xil_uart_desc->instance);
 	free(xil_uart_desc);
 	free(desc);
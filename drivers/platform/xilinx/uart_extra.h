@@ -48,7 +48,8 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
-#define UART_BUFF_LENGTH 256
+/* Default size of the RX and TX rings */
+#define UART_RING_LENGTH 1024
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -75,8 +76,15 @@ struct xil_uart_init_param {
 	enum xil_uart_type	type;
 	/** Interrupt Request ID */
 	uint32_t			irq_id;
-	/** Interrupt Request Descriptor */
+	/**
+	 * Interrupt Request Descriptor. Mandatory for the PS UART. For the
+	 * UART Lite, if NULL the UART is polled.
+	 */
 	struct irq_ctrl_desc *irq_desc;
+	/** Size of the RX ring, 0 for UART_RING_LENGTH */
+	uint32_t			rx_ring_size;
+	/** Size of the TX ring, 0 for UART_RING_LENGTH */
+	uint32_t			tx_ring_size;
 };
 
 /**
@@ -90,14 +98,12 @@ struct xil_uart_desc {
 	uint32_t			irq_id;
 	/** Interrupt Request Descriptor */
 	struct irq_ctrl_desc *irq_desc;
-	/** FIFO */
-	struct fifo_element	*fifo;
-	/** FIFO read offset */
-	uint32_t 			fifo_read_offset;
-	/** UART Buffer */
-	char 				buff[UART_BUFF_LENGTH];
-	/** Number of bytes received */
-	uint32_t 			bytes_received;
+	/** Received data, filled by the interrupt handler. NULL if polled */
+	struct circular_buffer	*rx_ring;
+	/** Data to send, emptied by the interrupt handler. NULL if polled */
+	struct circular_buffer	*tx_ring;
+	/** Size of the TX ring */
+	uint32_t			tx_ring_size;
 	/** Total number of errors */
 	uint32_t 			total_error_count;
 	/** UART Instance */
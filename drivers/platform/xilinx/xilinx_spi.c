@@ -42,6 +42,7 @@
 /******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <xparameters.h>
 #ifdef XPAR_XSPI_NUM_INSTANCES
@@ -65,6 +66,53 @@
 #define SPI_NUM_INSTANCES	0
 #endif
 
+/* Maximum number of SPI controllers, PS and PL */
+#define XIL_SPI_MAX_CTRL	8
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct xil_spi_ctrl
+ * @brief State of a SPI controller shared by all its descriptors: driver
+ * instance, interrupt, asynchronous transfer in progress and last applied
+ * configuration.
+ */
+struct xil_spi_ctrl {
+	/** Xilinx architecture */
+	enum xil_spi_type	type;
+	/** Device ID */
+	uint32_t		device_id;
+	/** Number of descriptors using the controller */
+	uint32_t		refs;
+	/** Driver instance, initialized by the first descriptor */
+	void			*instance;
+	/** Interrupt controller, NULL if not used */
+	struct irq_ctrl_desc	*irq_desc;
+	/** Interrupt ID */
+	uint32_t		irq_id;
+	/** Set while an asynchronous transfer is in progress */
+	volatile bool		busy;
+	/** Descriptor of the asynchronous transfer in progress */
+	struct spi_desc		*volatile active;
+	/** Descriptor that applied the configuration, NULL if unknown */
+	struct spi_desc		*owner;
+	/** Applied SPI mode */
+	enum spi_mode		mode;
+	/** Selected chip, PL only. The PS chip select is set per transfer. */
+	uint8_t			chip_select;
+	/** Applied speed */
+	uint32_t		max_speed_hz;
+};
+
+/******************************************************************************/
+/*****************************  Variables   **********************************/
+/******************************************************************************/
+
+/** State of the used controllers */
+static struct xil_spi_ctrl xil_spi_ctrls[XIL_SPI_MAX_CTRL];
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -76,9 +124,224 @@
 const struct spi_platform_ops xil_platform_ops = {
 	.spi_ops_init = &xil_spi_init,
 	.spi_ops_write_and_read = &xil_spi_write_and_read,
-	.spi_ops_remove = &xil_spi_remove
+	.spi_ops_remove = &xil_spi_remove,
+	.spi_ops_submit = &xil_spi_submit,
+	.spi_ops_complete = &xil_spi_complete,
+	.spi_ops_transfer = &xil_spi_transfer
 };
 
+/**
+ * @brief Get the shared state of a controller
+ *
+ * @param type Xilinx architecture
+ * @param device_id Device ID
+ * @return struct xil_spi_ctrl* NULL if too many controllers are used
+ */
+static struct xil_spi_ctrl *spi_ctrl_get(enum xil_spi_type type,
+		uint32_t device_id)
+{
+	struct xil_spi_ctrl	*free_ctrl = NULL;
+	uint32_t		i;
+
+	for (i = 0; i < XIL_SPI_MAX_CTRL; i++) {
+		if (!xil_spi_ctrls[i].refs) {
+			if (!free_ctrl)
+				free_ctrl = &xil_spi_ctrls[i];
+			continue;
+		}
+		if (xil_spi_ctrls[i].type == type &&
+		    xil_spi_ctrls[i].device_id == device_id) {
+			xil_spi_ctrls[i].refs++;
+			return &xil_spi_ctrls[i];
+		}
+	}
+
+	if (free_ctrl) {
+		memset(free_ctrl, 0, sizeof(*free_ctrl));
+		free_ctrl->type = type;
+		free_ctrl->device_id = device_id;
+		free_ctrl->refs = 1;
+	}
+
+	return free_ctrl;
+}
+
+/**
+ * @brief Release the shared state of a controller
+ *
+ * The last descriptor stops the controller, releases its interrupt and frees
+ * the driver instance.
+ * @param desc SPI descriptor
+ */
+static void spi_ctrl_put(struct spi_desc *desc)
+{
+	struct xil_spi_desc	*xdesc = desc->extra;
+	struct xil_spi_ctrl	*ctrl = xdesc->ctrl;
+
+	if (!ctrl)
+		return;
+
+	xdesc->ctrl = NULL;
+	xdesc->instance = NULL;
+	if (ctrl->owner == desc)
+		ctrl->owner = NULL;
+	if (--ctrl->refs)
+		return;
+
+	if (!ctrl->instance)
+		return;
+
+	switch (ctrl->type) {
+	case SPI_PL:
+#ifdef XSPI_H
+		XSpi_Stop(ctrl->instance);
+#endif
+		break;
+	case SPI_PS:
+#ifdef XSPIPS_H
+		if (ctrl->irq_desc) {
+			irq_disable(ctrl->irq_desc, ctrl->irq_id);
+			irq_unregister(ctrl->irq_desc, ctrl->irq_id);
+		}
+#endif
+		break;
+	default:
+		break;
+	}
+	free(ctrl->instance);
+	ctrl->instance = NULL;
+}
+
+#ifdef XSPIPS_H
+/**
+ * @brief Compute the PS SPI prescaler for a speed
+ *
+ * @param input_clock Controller input clock
+ * @param max_speed_hz Maximum SPI clock, 0 for the default prescaler
+ * @return uint32_t Prescaler
+ */
+static uint32_t spi_prescaler_ps(uint32_t input_clock, uint32_t max_speed_hz)
+{
+	const uint32_t	prescaler_default = XSPIPS_CLK_PRESCALE_64;
+	const uint32_t	prescaler_min = XSPIPS_CLK_PRESCALE_4;
+	const uint32_t	prescaler_max = XSPIPS_CLK_PRESCALE_256;
+	uint32_t	prescaler = 0u;
+
+	if (max_speed_hz != 0u) {
+		uint32_t div = input_clock / max_speed_hz;
+		uint32_t rem = input_clock % max_speed_hz;
+		uint32_t po2 = !(div & (div - 1)) && !rem;
+
+		// find the power of two just higher than div and
+		// store the exponent in prescaler
+		while(div) {
+			prescaler += 1;
+			div >>= 1u;
+		}
+
+		// this exponent - 1 is needed because of the way
+		// xilinx stores it into registers
+		if (prescaler)
+			prescaler -= 1;
+
+		// this exponent - 1 is needed when initial div was
+		// precisely a power of two
+		if (prescaler && po2)
+			prescaler -= 1;
+
+		if (prescaler < prescaler_min)
+			prescaler = prescaler_min;
+
+		if (prescaler > prescaler_max)
+			prescaler = prescaler_max;
+	} else
+		prescaler = prescaler_default;
+
+	return prescaler;
+}
+#endif
+
+/**
+ * @brief Apply the settings of a descriptor to its controller
+ *
+ * Only the settings that differ from the last applied ones are programmed.
+ * Everything is programmed when the previous transfer on the controller was
+ * done by another descriptor.
+ * @param desc SPI descriptor
+ * @return int32_t FAILURE if the controller couldn't be configured
+ */
+static int32_t spi_config(struct spi_desc *desc)
+{
+	int32_t			ret = FAILURE;
+	struct xil_spi_desc	*xdesc = desc->extra;
+	struct xil_spi_ctrl	*ctrl = xdesc->ctrl;
+	bool			all = (ctrl->owner != desc);
+	uint32_t		options;
+	uint32_t		prescaler;
+
+	/* Reprogram everything if this fails halfway */
+	ctrl->owner = NULL;
+
+	switch (xdesc->type) {
+	case SPI_PL:
+#ifdef XSPI_H
+		if (all || ctrl->mode != desc->mode) {
+			options = XSP_MASTER_OPTION;
+			if (desc->mode & SPI_CPOL)
+				options |= XSP_CLK_ACTIVE_LOW_OPTION;
+			if (desc->mode & SPI_CPHA)
+				options |= XSP_CLK_PHASE_1_OPTION;
+			ret = XSpi_SetOptions(xdesc->instance, options);
+			if (ret != SUCCESS)
+				return FAILURE;
+		}
+
+		if (all || ctrl->chip_select != desc->chip_select) {
+			ret = XSpi_SetSlaveSelect(xdesc->instance,
+						  0x01 << desc->chip_select);
+			if (ret != SUCCESS)
+				return FAILURE;
+		}
+#endif
+		break;
+	case SPI_PS:
+#ifdef XSPIPS_H
+		if (all || ctrl->mode != desc->mode) {
+			options = XSPIPS_MASTER_OPTION |
+				  XSPIPS_FORCE_SSELECT_OPTION;
+			if (xdesc->flags & SPI_CS_DECODE)
+				options |= XSPIPS_DECODE_SSELECT_OPTION;
+			if (desc->mode & SPI_CPOL)
+				options |= XSPIPS_CLK_ACTIVE_LOW_OPTION;
+			if (desc->mode & SPI_CPHA)
+				options |= XSPIPS_CLK_PHASE_1_OPTION;
+			ret = XSpiPs_SetOptions(xdesc->instance, options);
+			if (ret != SUCCESS)
+				return FAILURE;
+		}
+
+		if (all || ctrl->max_speed_hz != desc->max_speed_hz) {
+			prescaler = spi_prescaler_ps(xdesc->input_clock,
+						     desc->max_speed_hz);
+			ret = XSpiPs_SetClkPrescaler(xdesc->instance,
+						     prescaler);
+			if (ret != SUCCESS)
+				return FAILURE;
+		}
+#endif
+		break;
+	default:
+		return FAILURE;
+	}
+
+	ctrl->mode = desc->mode;
+	ctrl->chip_select = desc->chip_select;
+	ctrl->max_speed_hz = desc->max_speed_hz;
+	ctrl->owner = desc;
+
+	return SUCCESS;
+}
+
 /**
  * @brief Initialize the hardware SPI peripherial
  *
@@ -93,8 +356,9 @@ static int32_t spi_init_pl(struct spi_desc *desc,
 	int32_t				ret;
 	struct xil_spi_desc 		*xdesc;
 	struct xil_spi_init_param	*xinit;
+	XSpi				*instance = NULL;
 
-	xdesc = (xil_spi_desc*)malloc(sizeof(xil_spi_desc));
+	xdesc = (xil_spi_desc*)calloc(1, sizeof(xil_spi_desc));
 	if(!xdesc) {
 		free(xdesc);
 		return FAILURE;
@@ -105,49 +369,141 @@ static int32_t spi_init_pl(struct spi_desc *desc,
 	xdesc->type = xinit->type;
 	xdesc->flags = xinit->flags;
 
-	xdesc->instance = (XSpi*)calloc(1, sizeof(XSpi));
-	if(!xdesc->instance)
-		goto pl_error;
-
 	xdesc->config = XSpi_LookupConfig(xinit->device_id);
 	if(xdesc->config == NULL)
 		goto pl_error;
 
-	ret = XSpi_CfgInitialize(xdesc->instance,
-				 xdesc->config,
-				 ((XSpi_Config*)xdesc->config)
-				 ->BaseAddress);
-	if(ret != SUCCESS)
+	xdesc->device_id = xinit->device_id;
+	xdesc->ctrl = spi_ctrl_get(SPI_PL, xinit->device_id);
+	if (!xdesc->ctrl)
 		goto pl_error;
 
-	ret = XSpi_Initialize(xdesc->instance, xinit->device_id);
-	if (ret != SUCCESS)
-		goto pl_error;
+	/* The other descriptors of the controller share its instance */
+	if (!xdesc->ctrl->instance) {
+		instance = (XSpi*)calloc(1, sizeof(XSpi));
+		if(!instance)
+			goto pl_error;
 
-	ret = XSpi_SetOptions(xdesc->instance,
-			      XSP_MASTER_OPTION |
-			      ((desc->mode & SPI_CPOL) ?
-			       XSP_CLK_ACTIVE_LOW_OPTION : 0) |
-			      ((desc->mode & SPI_CPHA) ?
-			       XSP_CLK_PHASE_1_OPTION : 0));
-	if (ret != SUCCESS)
-		goto pl_error;
+		ret = XSpi_CfgInitialize(instance,
+					 xdesc->config,
+					 ((XSpi_Config*)xdesc->config)
+					 ->BaseAddress);
+		if(ret != SUCCESS)
+			goto pl_error;
 
-	ret = XSpi_Start(xdesc->instance);
-	if (ret != SUCCESS)
-		goto pl_error;
+		ret = XSpi_Initialize(instance, xinit->device_id);
+		if (ret != SUCCESS)
+			goto pl_error;
+
+		ret = XSpi_SetOptions(instance,
+				      XSP_MASTER_OPTION |
+				      ((desc->mode & SPI_CPOL) ?
+				       XSP_CLK_ACTIVE_LOW_OPTION : 0) |
+				      ((desc->mode & SPI_CPHA) ?
+				       XSP_CLK_PHASE_1_OPTION : 0));
+		if (ret != SUCCESS)
+			goto pl_error;
+
+		ret = XSpi_Start(instance);
+		if (ret != SUCCESS)
+			goto pl_error;
 
-	XSpi_IntrGlobalDisable((XSpi *)(xdesc->instance));
+		XSpi_IntrGlobalDisable(instance);
+
+		xdesc->ctrl->instance = instance;
+		instance = NULL;
+	}
+	xdesc->instance = xdesc->ctrl->instance;
 
 	return SUCCESS;
 
 pl_error:
-	free(xdesc->instance);
+	spi_ctrl_put(desc);
+	free(instance);
 	free(xdesc);
 #endif
 	return FAILURE;
 }
 
+#ifdef XSPIPS_H
+/**
+ * @brief PS SPI status handler, called from the interrupt handler
+ *
+ * Completes the asynchronous transfer of the descriptor that started it.
+ * @param ctx Controller state
+ * @param event Status event
+ * @param byte_count Number of bytes not transferred
+ */
+static void spi_status_handler_ps(void *ctx, uint32_t event,
+				  uint32_t byte_count)
+{
+	struct xil_spi_ctrl	*ctrl = ctx;
+	struct spi_desc		*desc = ctrl->active;
+	struct xil_spi_desc	*xdesc;
+
+	if (!desc)
+		return;
+
+	xdesc = desc->extra;
+	if (event != XST_SPI_TRANSFER_DONE)
+		xdesc->status = -EIO;
+
+	/* A mode fault aborts the transfer, the other errors don't */
+	if (event != XST_SPI_TRANSFER_DONE && event != XST_SPI_MODE_FAULT)
+		return;
+
+	XSpiPs_SetSlaveSelect(ctrl->instance, SPI_DEASSERT_CURRENT_SS);
+	ctrl->active = NULL;
+	ctrl->busy = false;
+	if (xdesc->callback)
+		xdesc->callback(xdesc->ctx, xdesc->status);
+}
+
+/**
+ * @brief Connect the PS SPI controller to the interrupt controller
+ *
+ * The interrupt belongs to the controller, it is registered once and used by
+ * all its descriptors.
+ * @param ctrl Controller state
+ * @param xinit Platform specific SPI init param
+ * @return int32_t FAILURE if the interrupt couldn't be registered or another
+ * descriptor registered a different one
+ */
+static int32_t spi_irq_init_ps(struct xil_spi_ctrl *ctrl,
+			       struct xil_spi_init_param *xinit)
+{
+	int32_t			ret;
+	struct callback_desc	callback_desc;
+
+	if (ctrl->irq_desc)
+		return (ctrl->irq_desc == xinit->irq_desc &&
+			ctrl->irq_id == xinit->irq_id) ? SUCCESS : FAILURE;
+
+	callback_desc.callback = (void (*)(void *, uint32_t, void *))
+				 XSpiPs_InterruptHandler;
+	callback_desc.ctx = ctrl->instance;
+	callback_desc.config = NULL;
+	ret = irq_register_callback(xinit->irq_desc, xinit->irq_id,
+				    &callback_desc);
+	if (ret != SUCCESS)
+		return FAILURE;
+
+	XSpiPs_SetStatusHandler(ctrl->instance, ctrl,
+				(XSpiPs_StatusHandler)spi_status_handler_ps);
+
+	ret = irq_enable(xinit->irq_desc, xinit->irq_id);
+	if (ret != SUCCESS) {
+		irq_unregister(xinit->irq_desc, xinit->irq_id);
+		return FAILURE;
+	}
+
+	ctrl->irq_desc = xinit->irq_desc;
+	ctrl->irq_id = xinit->irq_id;
+
+	return SUCCESS;
+}
+#endif
+
 /**
  * @brief Initialize the hardware SPI peripherial
  *
@@ -162,13 +518,9 @@ static int32_t spi_init_ps(struct spi_desc *desc,
 	int32_t				ret;
 	struct xil_spi_desc 		*xdesc;
 	struct xil_spi_init_param	*xinit;
-	const uint32_t			prescaler_default = XSPIPS_CLK_PRESCALE_64;
-	const uint32_t			prescaler_min = XSPIPS_CLK_PRESCALE_4;
-	const uint32_t			prescaler_max = XSPIPS_CLK_PRESCALE_256;
-	uint32_t			prescaler = 0u;
-	uint32_t			input_clock;
+	XSpiPs				*instance = NULL;
 
-	xdesc = (xil_spi_desc*)malloc(sizeof(xil_spi_desc));
+	xdesc = (xil_spi_desc*)calloc(1, sizeof(xil_spi_desc));
 	if(!xdesc) {
 		free(xdesc);
 		return FAILURE;
@@ -179,75 +531,59 @@ static int32_t spi_init_ps(struct spi_desc *desc,
 	xdesc->type = xinit->type;
 	xdesc->flags = xinit->flags;
 
-	xdesc->instance = (XSpiPs*)malloc(sizeof(XSpiPs));
-	if(!xdesc->instance)
-		goto ps_error;
-
 	xdesc->config = XSpiPs_LookupConfig(xinit->device_id);
 	if(xdesc->config == NULL)
 		goto ps_error;
 
-	ret = XSpiPs_CfgInitialize(xdesc->instance,
-				   xdesc->config,
-				   ((XSpiPs_Config*)xdesc->config)
-				   ->BaseAddress);
-	if(ret != SUCCESS)
-		goto ps_error;
-
 	switch (xinit->device_id) {
 #if (SPI_NUM_INSTANCES >= 1)
 	case 0:
-		input_clock = SPI_CLK_FREQ_HZ(0);
+		xdesc->input_clock = SPI_CLK_FREQ_HZ(0);
 		break;
 #endif
 #if (SPI_NUM_INSTANCES >= 2)
 	case 1:
-		input_clock = SPI_CLK_FREQ_HZ(1);
+		xdesc->input_clock = SPI_CLK_FREQ_HZ(1);
 		break;
 #endif
 	default:
 		goto ps_error;
 	};
 
-	if (desc->max_speed_hz != 0u) {
-		uint32_t div = input_clock / desc->max_speed_hz;
-		uint32_t rem = input_clock % desc->max_speed_hz;
-		uint32_t po2 = !(div & (div - 1)) && !rem;
-
-		// find the power of two just higher than div and
-		// store the exponent in prescaler
-		while(div) {
-			prescaler += 1;
-			div >>= 1u;
-		}
-
-		// this exponent - 1 is needed because of the way
-		// xilinx stores it into registers
-		if (prescaler)
-			prescaler -= 1;
-
-		// this exponent - 1 is needed when initial div was
-		// precisely a power of two
-		if (prescaler && po2)
-			prescaler -= 1;
+	xdesc->device_id = xinit->device_id;
+	xdesc->ctrl = spi_ctrl_get(SPI_PS, xinit->device_id);
+	if (!xdesc->ctrl)
+		goto ps_error;
 
-		if (prescaler < prescaler_min)
-			prescaler = prescaler_min;
+	/* The other descriptors of the controller share its instance */
+	if (!xdesc->ctrl->instance) {
+		instance = (XSpiPs*)malloc(sizeof(XSpiPs));
+		if(!instance)
+			goto ps_error;
 
-		if (prescaler > prescaler_max)
-			prescaler = prescaler_max;
-	} else
-		prescaler = prescaler_default;
+		ret = XSpiPs_CfgInitialize(instance,
+					   xdesc->config,
+					   ((XSpiPs_Config*)xdesc->config)
+					   ->BaseAddress);
+		if(ret != SUCCESS)
+			goto ps_error;
 
-	ret = XSpiPs_SetClkPrescaler(xdesc->instance, prescaler);
+		xdesc->ctrl->instance = instance;
+		instance = NULL;
+	}
+	xdesc->instance = xdesc->ctrl->instance;
 
-	if(ret != SUCCESS)
-		goto ps_error;
+	if (xinit->irq_desc) {
+		ret = spi_irq_init_ps(xdesc->ctrl, xinit);
+		if (ret != SUCCESS)
+			goto ps_error;
+	}
 
 	return SUCCESS;
 
 ps_error:
-	free(xdesc->instance);
+	spi_ctrl_put(desc);
+	free(instance);
 	free(xdesc);
 #endif
 	return FAILURE;
@@ -314,50 +650,26 @@ init_error:
  */
 int32_t xil_spi_remove(struct spi_desc *desc)
 {
-#ifdef XSPI_H
-	int32_t				ret;
-#endif
-	struct xil_spi_desc	*xdesc = NULL;
-	enum xil_spi_type	*spi_type;
-
-	spi_type = desc->extra;
+	struct xil_spi_desc	*xdesc;
 
-	if(!spi_type)
+	if (!desc || !desc->extra)
 		return FAILURE;
 
-	switch (*spi_type ) {
+	xdesc = desc->extra;
+	switch (xdesc->type) {
 	case SPI_PL:
-#ifdef XSPI_H
-		xdesc = desc->extra;
-
-		if(!xdesc)
-			return FAILURE;
-
-		ret = XSpi_Stop((XSpi *)(xdesc->instance));
-		if(ret != SUCCESS)
-			goto error;
-#endif
 		break;
 	case SPI_PS:
-#ifdef XSPIPS_H
-		xdesc = desc->extra;
-
-		if(!xdesc)
-			return FAILURE;
-#endif
+		/* The interrupt handler must not complete a freed descriptor */
+		xil_spi_complete(desc, true);
 		break;
-
-		/* Intended fallthrough */
-#ifdef XSPI_H
-error:
-#endif
 	default:
 		return FAILURE;
-		break;
 	}
 
-	if(xdesc)
-		free(xdesc->instance);
+	/* The last descriptor of the controller stops it */
+	spi_ctrl_put(desc);
+	free(xdesc->msg_buff);
 	free(desc->extra);
 	free(desc);
 
@@ -365,15 +677,15 @@ error:
 }
 
 /**
- * @brief Write and read data to/from SPI.
+ * @brief Do a blocking transfer with the chip select held for its duration
  * @param desc - The SPI descriptor.
  * @param data - The buffer with the transmitted/received data.
  * @param bytes_number - Number of bytes to write/read.
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-int32_t xil_spi_write_and_read(struct spi_desc *desc,
-			       uint8_t *data,
-			       uint16_t bytes_number)
+static int32_t spi_xfer(struct spi_desc *desc,
+			uint8_t *data,
+			uint32_t bytes_number)
 {
 	int32_t			ret;
 	struct xil_spi_desc	*xdesc;
@@ -387,21 +699,13 @@ int32_t xil_spi_write_and_read(struct spi_desc *desc,
 		return FAILURE;
 
 	xdesc = desc->extra;
+	if (xdesc->ctrl->busy)
+		return -EBUSY;
 
 	switch (*spi_type) {
 	case SPI_PL:
 #ifdef XSPI_H
-		ret = XSpi_SetOptions(xdesc->instance,
-				      XSP_MASTER_OPTION |
-				      ((desc->mode & SPI_CPOL) ?
-				       XSP_CLK_ACTIVE_LOW_OPTION : 0) |
-				      ((desc->mode & SPI_CPHA) ?
-				       XSP_CLK_PHASE_1_OPTION : 0));
-		if (ret != SUCCESS)
-			goto error;
-
-		ret = XSpi_SetSlaveSelect(xdesc->instance,
-					  0x01 << desc->chip_select);
+		ret = spi_config(desc);
 		if (ret != SUCCESS)
 			goto error;
 
@@ -415,18 +719,14 @@ int32_t xil_spi_write_and_read(struct spi_desc *desc,
 		break;
 	case SPI_PS:
 #ifdef XSPIPS_H
-		ret = XSpiPs_SetOptions(xdesc->instance,
-					XSPIPS_MASTER_OPTION |
-					((xdesc->flags & SPI_CS_DECODE) ?
-					 XSPIPS_DECODE_SSELECT_OPTION : 0) |
-					XSPIPS_FORCE_SSELECT_OPTION |
-					((desc->mode & SPI_CPOL) ?
-					 XSPIPS_CLK_ACTIVE_LOW_OPTION : 0) |
-					((desc->mode & SPI_CPHA) ?
-					 XSPIPS_CLK_PHASE_1_OPTION : 0));
+		ret = spi_config(desc);
 		if (ret != SUCCESS)
 			goto error;
 
+		/*
+		 * With the forced slave select, setting it drives the chip
+		 * select, so it is only done for the duration of the transfer.
+		 */
 		ret = XSpiPs_SetSlaveSelect(xdesc->instance,
 					    desc->chip_select);
 		if (ret != SUCCESS)
@@ -435,9 +735,8 @@ int32_t xil_spi_write_and_read(struct spi_desc *desc,
 					    data,
 					    data,
 					    bytes_number);
-		if (ret != SUCCESS)
-			goto error;
-		ret = XSpiPs_SetSlaveSelect(xdesc->instance, SPI_DEASSERT_CURRENT_SS);
+		XSpiPs_SetSlaveSelect(xdesc->instance,
+				      SPI_DEASSERT_CURRENT_SS);
 		if (ret != SUCCESS)
 			goto error;
 #endif
@@ -450,3 +749,192 @@ error:
 
 	return ret;
 }
+
+/**
+ * @brief Write and read data to/from SPI.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t xil_spi_write_and_read(struct spi_desc *desc,
+			       uint8_t *data,
+			       uint16_t bytes_number)
+{
+	return spi_xfer(desc, data, bytes_number);
+}
+
+/**
+ * @brief Transfer several segments with the chip select held between them.
+ *
+ * The segments are gathered in a buffer kept by the descriptor and sent in a
+ * single transfer. A single in-place segment is sent without copying.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Segments to transfer.
+ * @param len - Number of segments.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t xil_spi_transfer(struct spi_desc *desc,
+			 struct spi_msg *msgs,
+			 uint32_t len)
+{
+	struct xil_spi_desc	*xdesc;
+	uint32_t		total;
+	uint32_t		i;
+	uint8_t			*buff;
+	int32_t			ret;
+
+	if (!desc || !desc->extra || !msgs || !len)
+		return -EINVAL;
+
+	total = 0;
+	for (i = 0; i < len; i++)
+		total += msgs[i].bytes_number;
+	if (!total)
+		return -EINVAL;
+
+	if (len == 1 && msgs[0].tx_buff == msgs[0].rx_buff && msgs[0].tx_buff)
+		return spi_xfer(desc, msgs[0].tx_buff, msgs[0].bytes_number);
+
+	xdesc = desc->extra;
+
+	if (total > xdesc->msg_buff_size) {
+		buff = realloc(xdesc->msg_buff, total);
+		if (!buff)
+			return -ENOMEM;
+		xdesc->msg_buff = buff;
+		xdesc->msg_buff_size = total;
+	}
+
+	buff = xdesc->msg_buff;
+	for (i = 0; i < len; i++) {
+		if (msgs[i].tx_buff)
+			memcpy(buff, msgs[i].tx_buff, msgs[i].bytes_number);
+		else
+			memset(buff, 0, msgs[i].bytes_number);
+		buff += msgs[i].bytes_number;
+	}
+
+	ret = spi_xfer(desc, xdesc->msg_buff, total);
+	if (ret != SUCCESS)
+		return ret;
+
+	buff = xdesc->msg_buff;
+	for (i = 0; i < len; i++) {
+		if (msgs[i].rx_buff)
+			memcpy(msgs[i].rx_buff, buff, msgs[i].bytes_number);
+		buff += msgs[i].bytes_number;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Start an asynchronous write and read to/from SPI.
+ *
+ * On PS SPI with an interrupt controller the transfer is interrupt driven.
+ * Otherwise it is done in blocking chunks before returning.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @param callback - Called when the transfer is done. May be NULL.
+ * @param ctx - Parameter for the callback.
+ * @return SUCCESS if the transfer was started, negative error code otherwise.
+ */
+int32_t xil_spi_submit(struct spi_desc *desc,
+		       uint8_t *data,
+		       uint32_t bytes_number,
+		       void (*callback)(void *ctx, int32_t status),
+		       void *ctx)
+{
+	int32_t			ret;
+	struct xil_spi_desc	*xdesc;
+	uint16_t		n;
+#ifdef XSPIPS_H
+	struct xil_spi_ctrl	*ctrl;
+#endif
+
+	if (!desc || !desc->extra || !data || !bytes_number)
+		return -EINVAL;
+
+	xdesc = desc->extra;
+#ifdef XSPIPS_H
+	ctrl = xdesc->ctrl;
+	if (xdesc->type == SPI_PS && ctrl->irq_desc) {
+		if (ctrl->busy)
+			return -EBUSY;
+
+		ret = spi_config(desc);
+		if (ret != SUCCESS)
+			return FAILURE;
+
+		ret = XSpiPs_SetSlaveSelect(ctrl->instance,
+					    desc->chip_select);
+		if (ret != SUCCESS)
+			return FAILURE;
+
+		xdesc->callback = callback;
+		xdesc->ctx = ctx;
+		xdesc->status = SUCCESS;
+		ctrl->active = desc;
+		ctrl->busy = true;
+		ret = XSpiPs_Transfer(ctrl->instance, data, data,
+				      bytes_number);
+		if (ret != SUCCESS) {
+			XSpiPs_SetSlaveSelect(ctrl->instance,
+					      SPI_DEASSERT_CURRENT_SS);
+			ctrl->busy = false;
+			ctrl->active = NULL;
+			return -EBUSY;
+		}
+
+		return SUCCESS;
+	}
+#endif
+
+	/* Blocking fallback */
+	ret = SUCCESS;
+	while (bytes_number) {
+		n = bytes_number > UINT16_MAX ? UINT16_MAX : bytes_number;
+		ret = spi_xfer(desc, data, n);
+		if (ret != SUCCESS)
+			break;
+		data += n;
+		bytes_number -= n;
+	}
+	xdesc->status = ret;
+	if (callback)
+		callback(ctx, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Check or wait for the end of the asynchronous transfer.
+ * @param desc - The SPI descriptor.
+ * @param wait - If true, block until the transfer is done.
+ * @return
+ *  - \ref SUCCESS : The transfer is done
+ *  - -EINPROGRESS : The transfer is not done and wait is false
+ *  - Negative error code if the transfer failed
+ */
+int32_t xil_spi_complete(struct spi_desc *desc, bool wait)
+{
+	struct xil_spi_desc *xdesc;
+	struct xil_spi_ctrl *ctrl;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	xdesc = desc->extra;
+	ctrl = xdesc->ctrl;
+	if (!ctrl)
+		return xdesc->status;
+	if (ctrl->active == desc && !wait)
+		return -EINPROGRESS;
+	/* The controller may be busy with a transfer of another descriptor */
+	while (ctrl->active == desc)
+		;
+
+	return xdesc->status;
+}
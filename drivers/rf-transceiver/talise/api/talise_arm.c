@@ -797,6 +797,75 @@ uint32_t TALISE_readArmMem(taliseDevice_t *device, uint32_t address,
 	return (uint32_t)retVal;
 }
 
+#if TALISE_ARM_SPI_STREAMING
+/**
+ * \brief Private helper to switch the SPI port in or out of streaming mode
+ *        around ARM memory writes.
+ *
+ * With streaming and ascending addresses enabled, a HAL that coalesces
+ * consecutive register addresses sends each DMA_DATA0..DMA_DATA3 run as a
+ * single SPI frame instead of one 3 byte frame per data byte. The original
+ * SPI configuration is saved on enable and restored on disable.
+ *
+ * \param device Pointer to the Talise device data structure
+ * \param enable 1 = save the current config and enable streaming, 0 = restore
+ * \param spiCfg Two byte storage for the saved CONFIG_A/CONFIG_B values
+ *
+ * \retval TALACT_NO_ACTION Function completed successfully
+ * \retval TALACT_ERR_RESET_SPI Recovery action for SPI reset required
+ */
+static talRecoveryActions_t talArmSpiStreaming(taliseDevice_t *device,
+		uint8_t enable, uint8_t *spiCfg)
+{
+	talRecoveryActions_t retVal = TALACT_NO_ACTION;
+	adiHalErr_t halError = ADIHAL_OK;
+
+	static const uint8_t SOFT_RESET_BITS = 0x81;
+	static const uint8_t ADDR_ASCENSION_BITS = 0x24;
+	static const uint8_t SINGLE_INSTRUCTION_BIT = 0x80;
+
+	if (enable > 0) {
+		halError = talSpiReadByte(device->devHalInfo,
+					  TALISE_ADDR_SPI_INTERFACE_CONFIG_A, &spiCfg[0]);
+		retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
+					  TALACT_ERR_RESET_SPI);
+		IF_ERR_RETURN(retVal);
+
+		halError = talSpiReadByte(device->devHalInfo,
+					  TALISE_ADDR_SPI_INTERFACE_CONFIG_B, &spiCfg[1]);
+		retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
+					  TALACT_ERR_RESET_SPI);
+		IF_ERR_RETURN(retVal);
+
+		halError = talSpiWriteByte(device->devHalInfo,
+					   TALISE_ADDR_SPI_INTERFACE_CONFIG_A,
+					   (spiCfg[0] & ~SOFT_RESET_BITS) | ADDR_ASCENSION_BITS);
+		retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
+					  TALACT_ERR_RESET_SPI);
+		IF_ERR_RETURN(retVal);
+
+		halError = talSpiWriteByte(device->devHalInfo,
+					   TALISE_ADDR_SPI_INTERFACE_CONFIG_B,
+					   spiCfg[1] & ~SINGLE_INSTRUCTION_BIT);
+	} else {
+		halError = talSpiWriteByte(device->devHalInfo,
+					   TALISE_ADDR_SPI_INTERFACE_CONFIG_B, spiCfg[1]);
+		retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
+					  TALACT_ERR_RESET_SPI);
+		IF_ERR_RETURN(retVal);
+
+		halError = talSpiWriteByte(device->devHalInfo,
+					   TALISE_ADDR_SPI_INTERFACE_CONFIG_A,
+					   spiCfg[0] & ~SOFT_RESET_BITS);
+	}
+
+	retVal = talApiErrHandler(device,TAL_ERRHDL_HAL_SPI, halError, retVal,
+				  TALACT_ERR_RESET_SPI);
+
+	return retVal;
+}
+#endif
+
 uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 			    uint8_t *data, uint32_t byteCount)
 {
@@ -810,6 +879,9 @@ uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 	uint32_t dataIndex = 0;
 	uint32_t spiBufferSize = HAL_SPIWRITEARRAY_BUFFERSIZE;
 	uint16_t addrArray[HAL_SPIWRITEARRAY_BUFFERSIZE] = {0};
+#if TALISE_ARM_SPI_STREAMING
+	uint8_t spiCfg[2] = {0};
+#endif
 
 	static const uint8_t FORCE_AUTO_INC = 0x02;
 	static const uint8_t LEGACY_MODE_BIT = 0x20;
@@ -864,6 +936,12 @@ uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 				  TALACT_ERR_RESET_SPI);
 	IF_ERR_RETURN_U32(retVal);
 
+#if TALISE_ARM_SPI_STREAMING
+	/* DMA data bytes are written in ascending order, let the HAL burst them */
+	retVal = talArmSpiStreaming(device, 1, &spiCfg[0]);
+	IF_ERR_RETURN_U32(retVal);
+#endif
+
 	/* starting write at zero address offset */
 	for (i = 0; i < byteCount; i++) {
 		addrArray[addrIndex++] = (uint16_t)(TALISE_ADDR_ARM_DMA_DATA0 + (((
@@ -890,6 +968,11 @@ uint32_t TALISE_writeArmMem(taliseDevice_t *device, uint32_t address,
 		IF_ERR_RETURN_U32(retVal);
 	}
 
+#if TALISE_ARM_SPI_STREAMING
+	retVal = talArmSpiStreaming(device, 0, &spiCfg[0]);
+	IF_ERR_RETURN_U32(retVal);
+#endif
+
 	return (uint32_t)retVal;
 }
 
@@ -88,6 +88,11 @@ extern "C" {
 /* 3 Bytes per SPI transaction * 341 transactions = ~1024 byte buffer size */
 /* Minimum MYK_SPIWRITEARRAY_BUFFERSIZE = 18 */
 
+/* Stream consecutive ARM DMA data bytes in one SPI frame when loading ARM memory */
+#ifndef TALISE_ARM_SPI_STREAMING
+#define TALISE_ARM_SPI_STREAMING 1
+#endif
+
 #define TALISE_VERBOSE 1
 #define TALISE_LOGGING 0xF      /*LogLevel Set to All*/
 #define TALISE_RESET_ON_ERR  1   /*API Reset on Severe Errors*/
@@ -59,6 +59,10 @@
 
 #define CMD0_RETRY_NUMBER		(5u)
 #define WAIT_RESP_TIMEOUT		(1000u) //1000ms
+/* Bytes polled back to back before waiting 1ms between polls */
+#define WAIT_RESP_SPIN			(512u)
+/* Idle polls of sd_process() after which the card is considered stuck */
+#define ASYNC_POLL_LIMIT		(1000000u)
 
 #define R1_READY_STATE			(0x00u)
 #define R1_IDLE_STATE			(0x01u)
@@ -86,6 +90,10 @@
 #define MASK_RESPONSE_TOKEN		(0x0Eu)
 #define MASK_ERROR_TOKEN		(0xF0u)
 
+#define FRAME_DATA_IDX			(1u)
+#define FRAME_CRC_IDX			(FRAME_DATA_IDX + DATA_BLOCK_LEN)
+#define FRAME_RESP_IDX			(FRAME_CRC_IDX + CRC_LEN)
+
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -102,9 +110,13 @@ static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
 	uint32_t	not_timeout;
 	int32_t		ret;
 
+	uint32_t	spin;
+
 	ret = FAILURE;
 	not_timeout = WAIT_RESP_TIMEOUT;
+	spin = WAIT_RESP_SPIN;
 	do {
+		*data_out = 0xFF;
 		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc,
 						  data_out, 1))
 			break;
@@ -112,8 +124,14 @@ static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
 			ret = SUCCESS;
 			break;
 		}
-		mdelay(1);
-	} while (not_timeout--);
+		/* Only the delayed polls count against the timeout */
+		if (spin) {
+			spin--;
+		} else {
+			mdelay(1);
+			not_timeout--;
+		}
+	} while (not_timeout);
 
 	return ret;
 }
@@ -129,8 +147,11 @@ static int32_t wait_until_not_busy(struct sd_desc *sd_desc)
 	int32_t		ret;
 	uint8_t		data;
 
+	uint32_t	spin;
+
 	ret = FAILURE;
 	not_timeout = WAIT_RESP_TIMEOUT;
+	spin = WAIT_RESP_SPIN;
 	do {
 		data = 0xFF;
 		if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, &data, 1))
@@ -139,8 +160,13 @@ static int32_t wait_until_not_busy(struct sd_desc *sd_desc)
 			ret = SUCCESS;
 			break;
 		}
-		mdelay(1);
-	} while (not_timeout--);
+		if (spin) {
+			spin--;
+		} else {
+			mdelay(1);
+			not_timeout--;
+		}
+	} while (not_timeout);
 
 	return ret;
 }
@@ -211,33 +237,37 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 }
 
 /**
- * Send one block of data to the SD card
- * @param sd_desc	- Instance of the SD card
- * @param data		- Data to be written
+ * Build the frame of one block: start token, data, CRC and one byte
+ * for the data response token
+ * @param frame		- Frame buffer of DATA_FRAME_LEN bytes
+ * @param data		- Block of data to be written
  * @param nb_of_blocks	- Number of blocks written in the executing command
- * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
-			   uint32_t nb_of_blocks)
+static void prepare_frame(uint8_t *frame, uint8_t *data, uint32_t nb_of_blocks)
 {
-	/* Send start block token */
-	sd_desc->buff[0] = START_N_BLOCK_TOKEN;
+	frame[0] = START_N_BLOCK_TOKEN;
 	if (nb_of_blocks == 1)
-		sd_desc->buff[0] = START_1_BLOCK_TOKEN;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, 1))
-		return FAILURE;
-
-	/* Send data with CRC */
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
-		return FAILURE;
-	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
-		return FAILURE;
+		frame[0] = START_1_BLOCK_TOKEN;
+	memcpy(frame + FRAME_DATA_IDX, data, DATA_BLOCK_LEN);
+	memset(frame + FRAME_CRC_IDX, 0xFF, CRC_LEN + 1);
+}
 
-	/* Read response and check if write was ok */
+/**
+ * Check the data response token of a sent frame
+ * @param sd_desc	- Instance of the SD card
+ * @param frame		- Frame that was sent
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t check_data_response(struct sd_desc *sd_desc, uint8_t *frame)
+{
 	uint8_t		response;
-	if (SUCCESS != wait_for_response(sd_desc, &response))
-		return FAILURE;
+
+	/* The token is usually clocked in with the frame itself */
+	response = frame[FRAME_RESP_IDX];
+	if (response == 0xFF)
+		if (SUCCESS != wait_for_response(sd_desc, &response))
+			return FAILURE;
+
 	switch (response & MASK_RESPONSE_TOKEN) {
 	case 0x4:
 		break;
@@ -251,24 +281,42 @@ static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
 		DEBUG_MSG("Other problem\n");
 		return FAILURE;
 	}
-	if (SUCCESS != wait_until_not_busy(sd_desc))
-		return FAILURE;
 
 	return SUCCESS;
 }
 
 /**
- * Read one block of data to the SD card
+ * Send one block of data to the SD card. Token, data and CRC are sent in a
+ * single transfer.
  * @param sd_desc	- Instance of the SD card
- * @param data		- Buffer were data will be read
+ * @param data		- Data to be written
+ * @param nb_of_blocks	- Number of blocks written in the executing command
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
+static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
+			   uint32_t nb_of_blocks)
 {
-	/* Reading Start block token */
-	uint8_t	response;
-	if (SUCCESS != wait_for_response(sd_desc, &response))
+	uint8_t		*frame = sd_desc->frame[0];
+
+	prepare_frame(frame, data, nb_of_blocks);
+	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, frame,
+					  DATA_FRAME_LEN))
+		return FAILURE;
+	if (SUCCESS != check_data_response(sd_desc, frame))
 		return FAILURE;
+	if (SUCCESS != wait_until_not_busy(sd_desc))
+		return FAILURE;
+
+	return SUCCESS;
+}
+
+/**
+ * Check the token received before a data block
+ * @param response	- Received token
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t check_start_token(uint8_t response)
+{
 	if ((response & MASK_ERROR_TOKEN) == 0) {
 		DEBUG_MSG("Received data error token on read\n");
 		switch (response) {
@@ -295,19 +343,53 @@ static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
 		return FAILURE;
 	}
 
-	/* Read data block */
-	memset(data, 0xff, DATA_BLOCK_LEN);
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
-		return FAILURE;
+	return SUCCESS;
+}
 
-	/* Read crc*/
-	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
+/**
+ * Read the data and the CRC of a block, after the start token, in a single
+ * transfer and copy the requested part of it.
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Buffer were data will be read
+ * @param first_idx	- Index in the block of the first byte to copy
+ * @param len		- Number of bytes to copy
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t read_block_data(struct sd_desc *sd_desc, uint8_t *data,
+			       uint16_t first_idx, uint16_t len)
+{
+	uint8_t		*frame = sd_desc->frame[0];
+
+	memset(frame, 0xFF, DATA_BLOCK_LEN + CRC_LEN);
+	if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, frame,
+					  DATA_BLOCK_LEN + CRC_LEN))
 		return FAILURE;
+	memcpy(data, frame + first_idx, len);
 
 	return SUCCESS;
 }
 
+/**
+ * Read one block of data to the SD card
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Buffer were data will be read
+ * @param first_idx	- Index in the block of the first byte to copy
+ * @param len		- Number of bytes to copy
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data,
+			  uint16_t first_idx, uint16_t len)
+{
+	/* Reading Start block token */
+	uint8_t	response;
+	if (SUCCESS != wait_for_response(sd_desc, &response))
+		return FAILURE;
+	if (SUCCESS != check_start_token(response))
+		return FAILURE;
+
+	return read_block_data(sd_desc, data, first_idx, len);
+}
+
 /**
  * Prepare and write data block by block
  * @param sd_desc	- Instance of the SD card
@@ -329,6 +411,8 @@ static int32_t write_multiple_blocks(struct sd_desc *sd_desc,
 	uint16_t	buff_copy_len;
 	uint32_t	i;
 	uint64_t	data_idx;
+	uint8_t		*block;
+	uint8_t		*frame;
 	uint32_t	nb_of_blocks = get_nb_of_blocks(addr, len);
 
 	data_idx = 0;
@@ -342,23 +426,52 @@ static int32_t write_multiple_blocks(struct sd_desc *sd_desc,
 			buff_copy_len = ((addr + len - 1) & MASK_ADDR_IN_BLOCK) - buff_first_idx + 1;
 		if (buff_first_idx == 0x0000u && buff_copy_len == DATA_BLOCK_LEN) {
 			/* Write every block beside the first and last if the write is not the entire block */
-			if (SUCCESS != write_block(sd_desc, data + data_idx, nb_of_blocks))
-				return FAILURE;
+			block = data + data_idx;
 		} else {			/* If we are not writing a full block */
 			if (i == 0) {		/* If is the first block */
 				memcpy(first_block + buff_first_idx, data + data_idx, buff_copy_len);
-				if (SUCCESS != write_block(sd_desc, first_block, nb_of_blocks))
-					return FAILURE;
+				block = first_block;
 			} else {		/* Is the last block */
 				memcpy(last_block, data + data_idx, buff_copy_len);
-				if (SUCCESS != write_block(sd_desc, last_block, nb_of_blocks))
+				block = last_block;
+			}
+		}
+
+		if (!sd_desc->spi_xfer_start) {
+			if (SUCCESS != write_block(sd_desc, block, nb_of_blocks))
+				return FAILURE;
+		} else {
+			/* Build this frame while the previous one is transferred */
+			frame = sd_desc->frame[i & 1];
+			prepare_frame(frame, block, nb_of_blocks);
+			if (i > 0) {
+				if (SUCCESS != sd_desc->spi_xfer_wait(sd_desc->spi_desc))
+					return FAILURE;
+				if (SUCCESS != check_data_response(sd_desc,
+								   sd_desc->frame[(i - 1) & 1]))
+					return FAILURE;
+				if (SUCCESS != wait_until_not_busy(sd_desc))
 					return FAILURE;
 			}
+			if (SUCCESS != sd_desc->spi_xfer_start(sd_desc->spi_desc,
+							       frame,
+							       DATA_FRAME_LEN))
+				return FAILURE;
 		}
 		data_idx += buff_copy_len;
 		i++;
 	}
 
+	if (sd_desc->spi_xfer_start) {
+		if (SUCCESS != sd_desc->spi_xfer_wait(sd_desc->spi_desc))
+			return FAILURE;
+		if (SUCCESS != check_data_response(sd_desc,
+						   sd_desc->frame[(i - 1) & 1]))
+			return FAILURE;
+		if (SUCCESS != wait_until_not_busy(sd_desc))
+			return FAILURE;
+	}
+
 	return SUCCESS;
 }
 
@@ -374,7 +487,6 @@ static int32_t write_multiple_blocks(struct sd_desc *sd_desc,
 static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
 				    uint8_t *data, uint64_t addr, uint64_t len)
 {
-	uint8_t		buff[DATA_BLOCK_LEN] __attribute__ ((aligned));
 	uint32_t	i;
 	uint64_t	data_idx;
 
@@ -390,14 +502,9 @@ static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
 		buff_copy_len = DATA_BLOCK_LEN - buff_first_idx;
 		if (i == get_nb_of_blocks(addr, len) - 1)
 			buff_copy_len = ((addr + len - 1) & MASK_ADDR_IN_BLOCK) - buff_first_idx + 1;
-		if (buff_first_idx == 0x0000u && buff_copy_len == DATA_BLOCK_LEN) {
-			if (SUCCESS != read_block(sd_desc, data + data_idx))
-				return FAILURE;
-		} else {
-			if (SUCCESS != read_block(sd_desc, buff))
-				return FAILURE;
-			memcpy(data + data_idx, buff + buff_first_idx, buff_copy_len);
-		}
+		if (SUCCESS != read_block(sd_desc, data + data_idx,
+					  buff_first_idx, buff_copy_len))
+			return FAILURE;
 		data_idx += buff_copy_len;
 		i++;
 	}
@@ -406,25 +513,18 @@ static int32_t read_multiple_blocks(struct sd_desc *sd_desc,
 }
 
 /**
- * Read data of size len from the specified address and store it in data.
- * This operation returns only when the read is complete
+ * Read data from the card without looking into the write-back cache
  * @param sd_desc	- Instance of the SD card
  * @param data		- Where data will be read
  * @param address	- Address in memory from where data will be read
  * @param len		- Length in bytes of data to be read
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-int32_t sd_read(struct sd_desc *sd_desc,
-		uint8_t *data, uint64_t address, uint64_t len)
+static int32_t read_data(struct sd_desc *sd_desc,
+			 uint8_t *data, uint64_t address, uint64_t len)
 {
 	struct cmd_desc	cmd_desc;
 
-	/* Initial checks */
-	if (data == NULL || address > sd_desc->memory_size ||
-	    len > sd_desc->memory_size ||
-	    address + len > sd_desc->memory_size)
-		return FAILURE;
-
 	/* Send read command */
 	cmd_desc.cmd = (get_nb_of_blocks(address, len) == 1) ? CMD(17): CMD(18);
 	cmd_desc.arg = address >> DATA_BLOCK_BITS;;
@@ -457,38 +557,22 @@ int32_t sd_read(struct sd_desc *sd_desc,
 }
 
 /**
- * Write data of size len to the specified address
- * This operation returns only when the write is complete
+ * Send the write command, the blocks and the stop token
  * @param sd_desc	- Instance of the SD card
  * @param data		- Data to write
  * @param address	- Address in memory where data will be written
  * @param len		- Length of data in bytes
+ * @param first_block	- First block with the data around the written part.
+ * 			  Not used if address is block aligned.
+ * @param last_block	- Last block with the data around the written part.
+ * 			  Not used if address + len is block aligned.
  * @return SUCCESS in case of success, FAILURE otherwise.
  */
-int32_t sd_write(struct sd_desc *sd_desc, uint8_t *data, uint64_t address,
-		 uint64_t len)
+static int32_t write_data(struct sd_desc *sd_desc, uint8_t *data,
+			  uint64_t address, uint64_t len,
+			  uint8_t *first_block, uint8_t *last_block)
 {
 	struct cmd_desc	cmd_desc;
-	uint8_t		first_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
-	uint8_t		last_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
-
-	/* Initial checks */
-	if (data == NULL || address > sd_desc->memory_size ||
-	    len > sd_desc->memory_size || address + len > sd_desc->memory_size)
-		return FAILURE;
-
-	/* Read first and last block in memory if needed to be updated with user data and then written back                                                                        */
-	/* If not writing from the beginning of a block or */
-	if ((address & MASK_ADDR_IN_BLOCK) != 0 ||
-	    /* If writing from the beginning but not the full block */
-	    ((address & MASK_ADDR_IN_BLOCK) == 0 && len < DATA_BLOCK_LEN))
-		sd_read(sd_desc, first_block, address & MASK_BLOCK_NUMBER, DATA_BLOCK_LEN);
-	/* If the last block is different from the first and */
-	if (((address + len - 1) & MASK_BLOCK_NUMBER) != (address & MASK_BLOCK_NUMBER)
-	    /* If reading less than the full block */
-	    && ((address + len - 1) & MASK_ADDR_IN_BLOCK) != MASK_ADDR_IN_BLOCK)
-		sd_read(sd_desc, last_block, (address + len - 1) & MASK_BLOCK_NUMBER,
-			DATA_BLOCK_LEN);
 
 	/* Send write command to SD */
 	cmd_desc.cmd = (get_nb_of_blocks(address, len) == 1) ? CMD(24): CMD(25);
@@ -519,6 +603,550 @@ int32_t sd_write(struct sd_desc *sd_desc, uint8_t *data, uint64_t address,
 	return SUCCESS;
 }
 
+/**
+ * Write data that does not start or end on a block boundary, without cache.
+ * The first and last blocks are read and written back entirely.
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data to write
+ * @param address	- Address in memory where data will be written
+ * @param len		- Length of data in bytes
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t write_unaligned(struct sd_desc *sd_desc, uint8_t *data,
+			       uint64_t address, uint64_t len)
+{
+	uint8_t		first_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
+	uint8_t		last_block[DATA_BLOCK_LEN] __attribute__ ((aligned));
+
+	/* Read first and last block in memory if needed to be updated with user data and then written back                                                                        */
+	/* If not writing from the beginning of a block or */
+	if ((address & MASK_ADDR_IN_BLOCK) != 0 ||
+	    /* If writing from the beginning but not the full block */
+	    ((address & MASK_ADDR_IN_BLOCK) == 0 && len < DATA_BLOCK_LEN))
+		read_data(sd_desc, first_block, address & MASK_BLOCK_NUMBER, DATA_BLOCK_LEN);
+	/* If the last block is different from the first and */
+	if (((address + len - 1) & MASK_BLOCK_NUMBER) != (address & MASK_BLOCK_NUMBER)
+	    /* If reading less than the full block */
+	    && ((address + len - 1) & MASK_ADDR_IN_BLOCK) != MASK_ADDR_IN_BLOCK)
+		read_data(sd_desc, last_block, (address + len - 1) & MASK_BLOCK_NUMBER,
+			  DATA_BLOCK_LEN);
+
+	return write_data(sd_desc, data, address, len, first_block, last_block);
+}
+
+/**
+ * Find a block in the write-back cache, or load it replacing the least
+ * recently used entry
+ * @param sd_desc	- Instance of the SD card
+ * @param block		- Number of the block
+ * @param load		- Read the block from the card if not cached
+ * @param entry		- The cache entry is returned here
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t cache_get(struct sd_desc *sd_desc, uint64_t block, bool load,
+			 struct sd_cache_block **entry)
+{
+	struct sd_cache_block	*e;
+	struct sd_cache_block	*victim;
+	uint32_t		i;
+
+	victim = &sd_desc->cache[0];
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		e = &sd_desc->cache[i];
+		if (e->valid && e->block == block) {
+			e->last_use = ++sd_desc->cache_tick;
+			*entry = e;
+			return SUCCESS;
+		}
+		if (!e->valid)
+			victim = e;
+		else if (victim->valid && e->last_use < victim->last_use)
+			victim = e;
+	}
+
+	if (victim->valid && victim->dirty) {
+		if (SUCCESS != write_data(sd_desc, victim->data,
+					  victim->block << DATA_BLOCK_BITS,
+					  DATA_BLOCK_LEN, NULL, NULL))
+			return FAILURE;
+	}
+	victim->valid = false;
+	victim->dirty = false;
+	if (load && SUCCESS != read_data(sd_desc, victim->data,
+					 block << DATA_BLOCK_BITS,
+					 DATA_BLOCK_LEN))
+		return FAILURE;
+	victim->block = block;
+	victim->valid = true;
+	victim->last_use = ++sd_desc->cache_tick;
+	*entry = victim;
+
+	return SUCCESS;
+}
+
+/**
+ * Copy data into a cached block and mark it dirty
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data to write
+ * @param address	- Address in memory, all bytes must be in the same block
+ * @param len		- Length of data in bytes
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t cache_write(struct sd_desc *sd_desc, uint8_t *data,
+			   uint64_t address, uint64_t len)
+{
+	struct sd_cache_block	*e;
+
+	if (SUCCESS != cache_get(sd_desc, address >> DATA_BLOCK_BITS,
+				 len != DATA_BLOCK_LEN, &e))
+		return FAILURE;
+	memcpy(e->data + (address & MASK_ADDR_IN_BLOCK), data, len);
+	e->dirty = true;
+
+	return SUCCESS;
+}
+
+/**
+ * Update or drop the cached blocks in a range written directly to the card
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data written, NULL to drop the cached blocks
+ * @param address	- Block aligned address where data was written
+ * @param len		- Block aligned length of data
+ */
+static void cache_sync_range(struct sd_desc *sd_desc, uint8_t *data,
+			     uint64_t address, uint64_t len)
+{
+	struct sd_cache_block	*e;
+	uint64_t		first = address >> DATA_BLOCK_BITS;
+	uint64_t		last = (address + len - 1) >> DATA_BLOCK_BITS;
+	uint32_t		i;
+
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		e = &sd_desc->cache[i];
+		if (!e->valid || e->block < first || e->block > last)
+			continue;
+		if (data)
+			memcpy(e->data, data + ((e->block - first) << DATA_BLOCK_BITS),
+			       DATA_BLOCK_LEN);
+		else
+			e->valid = false;
+		e->dirty = false;
+	}
+}
+
+/**
+ * Write back all the dirty blocks of the cache, in ascending block order
+ * @param sd_desc	- Instance of the SD card
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_flush(struct sd_desc *sd_desc)
+{
+	struct sd_cache_block	*e;
+	struct sd_cache_block	*next;
+	uint32_t		i;
+
+	if (!sd_desc)
+		return FAILURE;
+
+	while (true) {
+		next = NULL;
+		for (i = 0; i < sd_desc->cache_blocks; i++) {
+			e = &sd_desc->cache[i];
+			if (e->valid && e->dirty &&
+			    (!next || e->block < next->block))
+				next = e;
+		}
+		if (!next)
+			return SUCCESS;
+		if (SUCCESS != write_data(sd_desc, next->data,
+					  next->block << DATA_BLOCK_BITS,
+					  DATA_BLOCK_LEN, NULL, NULL))
+			return FAILURE;
+		next->dirty = false;
+	}
+}
+
+/**
+ * Read data of size len from the specified address and store it in data.
+ * This operation returns only when the read is complete
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Where data will be read
+ * @param address	- Address in memory from where data will be read
+ * @param len		- Length in bytes of data to be read
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_read(struct sd_desc *sd_desc,
+		uint8_t *data, uint64_t address, uint64_t len)
+{
+	struct sd_cache_block	*e;
+	uint64_t		start;
+	uint64_t		end;
+	uint32_t		i;
+
+	/* Initial checks */
+	if (data == NULL || address > sd_desc->memory_size ||
+	    len > sd_desc->memory_size ||
+	    address + len > sd_desc->memory_size ||
+	    sd_desc->async.state != SD_ASYNC_IDLE)
+		return FAILURE;
+
+	/* Reads inside one cached block are served from the cache */
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		e = &sd_desc->cache[i];
+		if (e->valid && get_nb_of_blocks(address, len) == 1 &&
+		    e->block == address >> DATA_BLOCK_BITS) {
+			memcpy(data, e->data + (address & MASK_ADDR_IN_BLOCK), len);
+			e->last_use = ++sd_desc->cache_tick;
+			return SUCCESS;
+		}
+	}
+
+	if (SUCCESS != read_data(sd_desc, data, address, len))
+		return FAILURE;
+
+	/* Blocks not yet written back are newer than the card content */
+	for (i = 0; i < sd_desc->cache_blocks; i++) {
+		e = &sd_desc->cache[i];
+		if (!e->valid || !e->dirty)
+			continue;
+		start = e->block << DATA_BLOCK_BITS;
+		end = start + DATA_BLOCK_LEN;
+		if (end <= address || start >= address + len)
+			continue;
+		if (start < address)
+			start = address;
+		if (end > address + len)
+			end = address + len;
+		memcpy(data + (start - address),
+		       e->data + (start & MASK_ADDR_IN_BLOCK), end - start);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Write data of size len to the specified address
+ * This operation returns only when the write is complete, or when the data
+ * is in the write-back cache if one is configured
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data to write
+ * @param address	- Address in memory where data will be written
+ * @param len		- Length of data in bytes
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_write(struct sd_desc *sd_desc, uint8_t *data, uint64_t address,
+		 uint64_t len)
+{
+	uint64_t	part;
+
+	/* Initial checks */
+	if (data == NULL || address > sd_desc->memory_size ||
+	    len > sd_desc->memory_size || address + len > sd_desc->memory_size ||
+	    sd_desc->async.state != SD_ASYNC_IDLE)
+		return FAILURE;
+
+	if (!sd_desc->cache_blocks) {
+		if (((address | len) & MASK_ADDR_IN_BLOCK) == 0)
+			return write_data(sd_desc, data, address, len, NULL, NULL);
+
+		return write_unaligned(sd_desc, data, address, len);
+	}
+
+	/* Partial first block goes to the cache */
+	if (address & MASK_ADDR_IN_BLOCK || len < DATA_BLOCK_LEN) {
+		part = DATA_BLOCK_LEN - (address & MASK_ADDR_IN_BLOCK);
+		if (part > len)
+			part = len;
+		if (SUCCESS != cache_write(sd_desc, data, address, part))
+			return FAILURE;
+		data += part;
+		address += part;
+		len -= part;
+	}
+
+	/*
+	 * A single whole block is cached, these are the FAT and directory
+	 * updates that FatFs rewrites often. Longer runs of whole blocks are
+	 * sent directly from the user buffer.
+	 */
+	part = len & MASK_BLOCK_NUMBER;
+	if (part == DATA_BLOCK_LEN) {
+		if (SUCCESS != cache_write(sd_desc, data, address, part))
+			return FAILURE;
+		data += part;
+		address += part;
+		len -= part;
+	} else if (part) {
+		if (SUCCESS != write_data(sd_desc, data, address, part,
+					  NULL, NULL))
+			return FAILURE;
+		cache_sync_range(sd_desc, data, address, part);
+		data += part;
+		address += part;
+		len -= part;
+	}
+
+	/* Partial last block goes to the cache */
+	if (len)
+		return cache_write(sd_desc, data, address, len);
+
+	return SUCCESS;
+}
+
+/**
+ * Clock one byte out of the SD card
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- The read byte is wrote here
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t poll_byte(struct sd_desc *sd_desc, uint8_t *data)
+{
+	*data = 0xFF;
+
+	return spi_write_and_read(sd_desc->spi_desc, data, 1);
+}
+
+/**
+ * Poll a byte of the asynchronous operation and check its poll budget
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- The read byte is wrote here
+ * @param idle		- Value sent by the card while it is not ready
+ * @return SUCCESS in case of success, FAILURE if the SPI transfer failed or
+ * the card stayed idle for more than ASYNC_POLL_LIMIT polls.
+ */
+static int32_t async_poll(struct sd_desc *sd_desc, uint8_t *data,
+			  uint8_t idle)
+{
+	struct sd_async_op	*op = &sd_desc->async;
+
+	if (SUCCESS != poll_byte(sd_desc, data))
+		return FAILURE;
+	if (*data != idle) {
+		op->polls = 0;
+		return SUCCESS;
+	}
+	if (++op->polls >= ASYNC_POLL_LIMIT) {
+		DEBUG_MSG("Card not responding\n");
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * End the asynchronous operation and call its callback
+ * @param sd_desc	- Instance of the SD card
+ * @param status	- Status reported to the callback
+ * @return status
+ */
+static int32_t async_complete(struct sd_desc *sd_desc, int32_t status)
+{
+	struct sd_async_op	*op = &sd_desc->async;
+
+	op->state = SD_ASYNC_IDLE;
+	if (op->callback)
+		op->callback(op->ctx, status);
+
+	return status;
+}
+
+/**
+ * Check the parameters of an asynchronous operation and send its command
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data buffer of the operation
+ * @param address	- Address in memory, must be block aligned
+ * @param len		- Length in bytes, must be a multiple of the block size
+ * @param cmd		- CMD(17) for read, CMD(24) for write
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t async_start(struct sd_desc *sd_desc, uint8_t *data,
+			   uint64_t address, uint64_t len, uint8_t cmd)
+{
+	struct cmd_desc	cmd_desc;
+	uint32_t	nb_of_blocks;
+
+	if (!sd_desc || !data || !len ||
+	    ((address | len) & MASK_ADDR_IN_BLOCK) ||
+	    address + len > sd_desc->memory_size ||
+	    sd_desc->async.state != SD_ASYNC_IDLE)
+		return FAILURE;
+
+	/* The card must hold the latest data before bypassing the cache */
+	if (SUCCESS != sd_flush(sd_desc))
+		return FAILURE;
+	if (cmd == CMD(24))
+		cache_sync_range(sd_desc, NULL, address, len);
+
+	/* CMD(17)/CMD(24) for a single block, CMD(18)/CMD(25) otherwise */
+	nb_of_blocks = len >> DATA_BLOCK_BITS;
+	cmd_desc.cmd = (nb_of_blocks == 1) ? cmd : cmd + 1;
+	cmd_desc.arg = address >> DATA_BLOCK_BITS;
+	cmd_desc.response_len = R1_LEN;
+	if (SUCCESS != send_command(sd_desc, &cmd_desc))
+		return FAILURE;
+	if (cmd_desc.response[0] != R1_READY_STATE) {
+		DEBUG_MSG("Failed to send data command\n");
+		return FAILURE;
+	}
+
+	sd_desc->async.data = data;
+	sd_desc->async.nb_of_blocks = nb_of_blocks;
+	sd_desc->async.block = 0;
+	sd_desc->async.polls = 0;
+
+	return SUCCESS;
+}
+
+/**
+ * Start reading blocks without waiting for the card. The transfer is
+ * advanced by sd_process() and callback is called when it is complete.
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Where data will be read
+ * @param address	- Address in memory, must be block aligned
+ * @param len		- Length in bytes, must be a multiple of the block size
+ * @param callback	- Called when the read completes or fails. May be NULL.
+ * @param ctx		- Parameter for callback
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_read_async(struct sd_desc *sd_desc, uint8_t *data,
+		      uint64_t address, uint64_t len,
+		      sd_callback callback, void *ctx)
+{
+	if (SUCCESS != async_start(sd_desc, data, address, len, CMD(17)))
+		return FAILURE;
+
+	sd_desc->async.callback = callback;
+	sd_desc->async.ctx = ctx;
+	sd_desc->async.state = SD_ASYNC_READ;
+
+	return sd_process(sd_desc);
+}
+
+/**
+ * Start writing blocks without waiting for the card to program them. The
+ * transfer is advanced by sd_process() and callback is called when it is
+ * complete. data must not be modified until then.
+ * @param sd_desc	- Instance of the SD card
+ * @param data		- Data to write
+ * @param address	- Address in memory, must be block aligned
+ * @param len		- Length in bytes, must be a multiple of the block size
+ * @param callback	- Called when the write completes or fails. May be NULL.
+ * @param ctx		- Parameter for callback
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t sd_write_async(struct sd_desc *sd_desc, uint8_t *data,
+		       uint64_t address, uint64_t len,
+		       sd_callback callback, void *ctx)
+{
+	if (SUCCESS != async_start(sd_desc, data, address, len, CMD(24)))
+		return FAILURE;
+
+	sd_desc->async.callback = callback;
+	sd_desc->async.ctx = ctx;
+	sd_desc->async.state = SD_ASYNC_WRITE;
+
+	return sd_process(sd_desc);
+}
+
+/**
+ * Advance the asynchronous operation in progress as far as possible without
+ * waiting for the card. Must be called periodically until the operation
+ * completes. The operation fails if the card stays not ready for
+ * ASYNC_POLL_LIMIT consecutive polls.
+ * @param sd_desc	- Instance of the SD card
+ * @return SUCCESS in case of success, FAILURE if the operation failed.
+ */
+int32_t sd_process(struct sd_desc *sd_desc)
+{
+	struct sd_async_op	*op;
+	struct cmd_desc		cmd_desc;
+	uint8_t			data;
+	uint8_t			*frame;
+
+	if (!sd_desc)
+		return FAILURE;
+
+	op = &sd_desc->async;
+	frame = sd_desc->frame[0];
+	while (true) {
+		switch (op->state) {
+		case SD_ASYNC_IDLE:
+			return SUCCESS;
+		case SD_ASYNC_READ:
+			if (SUCCESS != async_poll(sd_desc, &data, 0xFF))
+				return async_complete(sd_desc, FAILURE);
+			if (data == 0xFF)
+				return SUCCESS;
+			if (SUCCESS != check_start_token(data))
+				return async_complete(sd_desc, FAILURE);
+			if (SUCCESS != read_block_data(sd_desc, op->data +
+						       ((uint64_t)op->block << DATA_BLOCK_BITS),
+						       0, DATA_BLOCK_LEN))
+				return async_complete(sd_desc, FAILURE);
+			if (++op->block < op->nb_of_blocks)
+				break;
+			if (op->nb_of_blocks != 1) {
+				cmd_desc.cmd = CMD(12);
+				cmd_desc.arg = STUFF_ARG;
+				cmd_desc.response_len = R1_LEN;
+				if (SUCCESS != send_command(sd_desc, &cmd_desc) ||
+				    cmd_desc.response[0] != R1_READY_STATE)
+					return async_complete(sd_desc, FAILURE);
+			}
+
+			return async_complete(sd_desc, SUCCESS);
+		case SD_ASYNC_WRITE:
+			prepare_frame(frame, op->data +
+				      ((uint64_t)op->block << DATA_BLOCK_BITS),
+				      op->nb_of_blocks);
+			if (SUCCESS != spi_write_and_read(sd_desc->spi_desc, frame,
+							  DATA_FRAME_LEN))
+				return async_complete(sd_desc, FAILURE);
+			if (SUCCESS != check_data_response(sd_desc, frame))
+				return async_complete(sd_desc, FAILURE);
+			op->state = SD_ASYNC_WRITE_BUSY;
+			break;
+		case SD_ASYNC_WRITE_BUSY:
+			if (SUCCESS != async_poll(sd_desc, &data, 0x00))
+				return async_complete(sd_desc, FAILURE);
+			if (data == 0x00)
+				return SUCCESS;
+			if (++op->block < op->nb_of_blocks) {
+				op->state = SD_ASYNC_WRITE;
+				break;
+			}
+			if (op->nb_of_blocks == 1)
+				return async_complete(sd_desc, SUCCESS);
+			sd_desc->buff[0] = STOP_TRANSMISSION_TOKEN;
+			sd_desc->buff[1] = 0xFF;
+			if (SUCCESS != spi_write_and_read(sd_desc->spi_desc,
+							  sd_desc->buff, 2))
+				return async_complete(sd_desc, FAILURE);
+			op->state = SD_ASYNC_STOP_BUSY;
+			break;
+		case SD_ASYNC_STOP_BUSY:
+			if (SUCCESS != async_poll(sd_desc, &data, 0x00))
+				return async_complete(sd_desc, FAILURE);
+			if (data == 0x00)
+				return SUCCESS;
+
+			return async_complete(sd_desc, SUCCESS);
+		default:
+			return async_complete(sd_desc, FAILURE);
+		}
+	}
+}
+
+/**
+ * Check if an asynchronous operation is in progress
+ * @param sd_desc	- Instance of the SD card
+ * @return true if sd_process() still has work to do, false otherwise.
+ */
+bool sd_async_busy(struct sd_desc *sd_desc)
+{
+	return sd_desc && sd_desc->async.state != SD_ASYNC_IDLE;
+}
+
 /**
  * Initialize an instance of SD card and stores it to the parameter desc
  * @param sd_desc	- Pointer where to store the instance of the SD
@@ -539,6 +1167,17 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 	if (!local_desc)
 		return FAILURE;
 	local_desc->spi_desc = param->spi_desc;
+	if (param->cache_blocks) {
+		local_desc->cache = calloc(param->cache_blocks,
+					   sizeof(*local_desc->cache));
+		if (!local_desc->cache)
+			goto failure;
+		local_desc->cache_blocks = param->cache_blocks;
+	}
+	if (param->spi_xfer_start && param->spi_xfer_wait) {
+		local_desc->spi_xfer_start = param->spi_xfer_start;
+		local_desc->spi_xfer_wait = param->spi_xfer_wait;
+	}
 
 	/* Synchronize SD card frequency: Send 10 dummy bytes*/
 	memset(local_desc->buff, 0xFF, 10);
@@ -623,10 +1262,15 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 	local_desc->memory_size = ((uint64_t)c_size + 1) *
 				  ((uint64_t)DATA_BLOCK_LEN << 10u);
 
+	/* Get sector_size, the erase unit in blocks, from CSD */
+	local_desc->erase_block_size = (((local_desc->buff[10] & 0x3Fu) << 1) |
+					(local_desc->buff[11] >> 7)) + 1;
+
 	*sd_desc = local_desc;
 
 	return SUCCESS;
 failure:
+	free(local_desc->cache);
 	free(local_desc);
 	return FAILURE;
 }
@@ -638,9 +1282,14 @@ failure:
  */
 int32_t sd_remove(struct sd_desc *desc)
 {
+	int32_t	ret;
+
 	if (desc == NULL)
 		return FAILURE;
 
+	ret = sd_flush(desc);
+	free(desc->cache);
 	free(desc);
-	return SUCCESS;
+
+	return ret;
 }
@@ -66,6 +66,8 @@
 
 #define DATA_BLOCK_LEN			(512u)
 #define MAX_RESPONSE_LEN		(18u)
+/* Start token + data block + CRC + data response token */
+#define DATA_FRAME_LEN			(DATA_BLOCK_LEN + 4u)
 
 #ifdef SD_DEBUG
 #include <stdio.h>
@@ -78,6 +80,68 @@
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Completion callback of an asynchronous read or write
+ * @param ctx		- Context given when the operation was started
+ * @param status	- SUCCESS if the operation completed, FAILURE otherwise
+ */
+typedef void (*sd_callback)(void *ctx, int32_t status);
+
+/**
+ * @enum sd_async_state
+ * @brief State of the asynchronous operation in progress
+ */
+enum sd_async_state {
+	/** No operation in progress */
+	SD_ASYNC_IDLE,
+	/** Waiting for the start token of the next block to read */
+	SD_ASYNC_READ,
+	/** Next block can be sent to the card */
+	SD_ASYNC_WRITE,
+	/** Card is programming the last block sent */
+	SD_ASYNC_WRITE_BUSY,
+	/** Card is finishing a multiple block write */
+	SD_ASYNC_STOP_BUSY
+};
+
+/**
+ * @struct sd_async_op
+ * @brief Asynchronous operation in progress
+ */
+struct sd_async_op {
+	/** Current state */
+	enum sd_async_state	state;
+	/** Data buffer of the operation */
+	uint8_t			*data;
+	/** Number of blocks of the operation */
+	uint32_t		nb_of_blocks;
+	/** Number of blocks completed */
+	uint32_t		block;
+	/** Consecutive polls the card answered as not ready */
+	uint32_t		polls;
+	/** Called when the operation completes or fails */
+	sd_callback		callback;
+	/** Parameter for callback */
+	void			*ctx;
+};
+
+/**
+ * @struct sd_cache_block
+ * @brief Block of the write-back cache
+ */
+struct sd_cache_block {
+	/** Number of the cached block */
+	uint64_t	block;
+	/** Value of the access counter at the last use, for LRU replacement */
+	uint32_t	last_use;
+	/** Entry holds a block */
+	bool		valid;
+	/** Block was modified and not yet written to the card */
+	bool		dirty;
+	/** Block data */
+	uint8_t		data[DATA_BLOCK_LEN];
+};
+
 /**
  * @struct sd_init_param
  * @brief Configuration structure sent in the function sd_init
@@ -85,6 +149,20 @@
 struct sd_init_param {
 	/** Descriptor of an initialized SPI channel */
 	struct spi_desc *spi_desc;
+	/**
+	 * Optional. Start a SPI transfer and return without waiting for it
+	 * (e.g. using DMA). NULL if the platform only has blocking transfers.
+	 */
+	int32_t (*spi_xfer_start)(struct spi_desc *desc, uint8_t *data,
+				  uint16_t bytes_number);
+	/** Wait for the transfer started with spi_xfer_start to complete */
+	int32_t (*spi_xfer_wait)(struct spi_desc *desc);
+	/**
+	 * Number of blocks in the write-back cache for partial and single
+	 * block writes. 0 disables the cache. Cached data reaches the card
+	 * on sd_flush().
+	 */
+	uint32_t cache_blocks;
 };
 
 /**
@@ -96,10 +174,27 @@ struct sd_desc {
 	struct spi_desc	*spi_desc;
 	/** Memory size of the SD card in bytes */
 	uint64_t	memory_size;
+	/** Size of the erasable unit in data blocks, read from CSD */
+	uint32_t	erase_block_size;
 	/** 1 if SD card is HC or XC, 0 otherwise */
 	uint8_t		high_capacity;
 	/** Buffer used for the driver implementation */
 	uint8_t		buff[18];
+	/** Double buffer with the complete frames of the transferred blocks */
+	uint8_t		frame[2][DATA_FRAME_LEN];
+	/** Non-blocking SPI transfer start, may be NULL */
+	int32_t		(*spi_xfer_start)(struct spi_desc *desc, uint8_t *data,
+					  uint16_t bytes_number);
+	/** Wait for a non-blocking SPI transfer */
+	int32_t		(*spi_xfer_wait)(struct spi_desc *desc);
+	/** Asynchronous operation in progress */
+	struct sd_async_op	async;
+	/** Write-back cache entries, NULL if not used */
+	struct sd_cache_block	*cache;
+	/** Number of cache entries */
+	uint32_t		cache_blocks;
+	/** Access counter for the LRU replacement */
+	uint32_t		cache_tick;
 };
 
 /**
@@ -132,6 +227,21 @@ int32_t sd_write(struct sd_desc *desc,
 		 uint8_t *data,
 		 uint64_t address,
 		 uint64_t len);
+int32_t sd_read_async(struct sd_desc *desc,
+		      uint8_t *data,
+		      uint64_t address,
+		      uint64_t len,
+		      sd_callback callback,
+		      void *ctx);
+int32_t sd_write_async(struct sd_desc *desc,
+		       uint8_t *data,
+		       uint64_t address,
+		       uint64_t len,
+		       sd_callback callback,
+		       void *ctx);
+int32_t sd_flush(struct sd_desc *desc);
+int32_t sd_process(struct sd_desc *desc);
+bool sd_async_busy(struct sd_desc *desc);
 
 #endif /* __SD_H__ */
 
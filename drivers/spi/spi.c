@@ -40,6 +40,7 @@
 #include <inttypes.h>
 #include "spi.h"
 #include <stdlib.h>
+#include <string.h>
 #include "error.h"
 
 /**
@@ -58,6 +59,7 @@ int32_t spi_init(struct spi_desc **desc,
 		return FAILURE;
 
 	(*desc)->platform_ops = param->platform_ops;
+	bus_stats_register(&(*desc)->stats, "spi", (*desc)->chip_select);
 
 	return SUCCESS;
 }
@@ -69,6 +71,8 @@ int32_t spi_init(struct spi_desc **desc,
  */
 int32_t spi_remove(struct spi_desc *desc)
 {
+	bus_stats_unregister(&desc->stats);
+
 	return desc->platform_ops->spi_ops_remove(desc);
 }
 
@@ -83,5 +87,140 @@ int32_t spi_write_and_read(struct spi_desc *desc,
 			   uint8_t *data,
 			   uint16_t bytes_number)
 {
-	return desc->platform_ops->spi_ops_write_and_read(desc, data, bytes_number);
+	return BUS_STATS_CALL(&desc->stats, bytes_number,
+			      desc->platform_ops->spi_ops_write_and_read(desc,
+					      data, bytes_number));
+}
+
+/**
+ * @brief Start an asynchronous write and read to/from SPI.
+ *
+ * Only one transfer can be in progress on a descriptor. The data buffer must
+ * stay valid until the transfer is done. Platforms without asynchronous
+ * support do the transfer in blocking chunks of at most 65535 bytes before
+ * returning; the chip select may toggle between the chunks.
+ * @param desc - The SPI descriptor.
+ * @param data - The buffer with the transmitted/received data.
+ * @param bytes_number - Number of bytes to write/read.
+ * @param callback - Function called from interrupt context when the transfer
+ * is done, with ctx and the transfer status. May be NULL.
+ * @param ctx - Parameter for the callback.
+ * @return SUCCESS if the transfer was started, negative error code otherwise.
+ */
+int32_t spi_submit_transfer(struct spi_desc *desc,
+			    uint8_t *data,
+			    uint32_t bytes_number,
+			    void (*callback)(void *ctx, int32_t status),
+			    void *ctx)
+{
+	int32_t		ret;
+	uint16_t	n;
+
+	if (!desc || !data || !bytes_number)
+		return -EINVAL;
+
+	if (desc->platform_ops->spi_ops_submit)
+		return desc->platform_ops->spi_ops_submit(desc, data,
+				bytes_number, callback, ctx);
+
+	ret = SUCCESS;
+	while (bytes_number) {
+		n = bytes_number > UINT16_MAX ? UINT16_MAX : bytes_number;
+		ret = spi_write_and_read(desc, data, n);
+		if (ret != SUCCESS)
+			break;
+		data += n;
+		bytes_number -= n;
+	}
+	if (callback)
+		callback(ctx, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Check or wait for the end of the asynchronous transfer.
+ * @param desc - The SPI descriptor.
+ * @param wait - If true, block until the transfer is done.
+ * @return
+ *  - \ref SUCCESS : The transfer is done or no transfer was started
+ *  - -EINPROGRESS : The transfer is not done and wait is false
+ *  - Negative error code if the transfer failed
+ */
+int32_t spi_complete_transfer(struct spi_desc *desc,
+			      bool wait)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->platform_ops->spi_ops_complete)
+		return desc->platform_ops->spi_ops_complete(desc, wait);
+
+	/* The fallback transfer is done when spi_submit_transfer() returns */
+	return SUCCESS;
+}
+
+/**
+ * @brief Transfer several segments with the chip select held between them.
+ *
+ * Platforms without a dedicated implementation gather the segments in a
+ * temporary buffer and send them with a single spi_write_and_read().
+ * @param desc - The SPI descriptor.
+ * @param msgs - Segments to transfer.
+ * @param len - Number of segments.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t spi_transfer(struct spi_desc *desc,
+		     struct spi_msg *msgs,
+		     uint32_t len)
+{
+	uint8_t		*buff;
+	uint8_t		*p;
+	uint32_t	total;
+	uint32_t	i;
+	int32_t		ret;
+
+	if (!desc || !msgs || !len)
+		return -EINVAL;
+
+	total = 0;
+	for (i = 0; i < len; i++)
+		total += msgs[i].bytes_number;
+
+	if (desc->platform_ops->spi_ops_transfer)
+		return BUS_STATS_CALL(&desc->stats, total,
+				      desc->platform_ops->spi_ops_transfer(desc,
+						      msgs, len));
+
+	if (!total || total > UINT16_MAX)
+		return -EINVAL;
+
+	buff = malloc(total);
+	if (!buff)
+		return -ENOMEM;
+
+	p = buff;
+	for (i = 0; i < len; i++) {
+		if (msgs[i].tx_buff)
+			memcpy(p, msgs[i].tx_buff, msgs[i].bytes_number);
+		else
+			memset(p, 0, msgs[i].bytes_number);
+		p += msgs[i].bytes_number;
+	}
+
+	/* Recorded in the statistics by spi_write_and_read() */
+	ret = spi_write_and_read(desc, buff, total);
+	if (ret == SUCCESS) {
+		p = buff;
+		for (i = 0; i < len; i++) {
+			if (msgs[i].rx_buff)
+				memcpy(msgs[i].rx_buff, p,
+				       msgs[i].bytes_number);
+			p += msgs[i].bytes_number;
+		}
+	}
+
+	free(buff);
+
+	return ret;
 }
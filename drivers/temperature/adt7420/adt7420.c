@@ -56,14 +56,11 @@ uint8_t adt7420_get_register_value(struct adt7420_dev *dev,
 {
 	uint8_t register_value = 0;
 
-	i2c_write(dev->i2c_desc,
-		  &register_address,
-		  1,
-		  0);
-	i2c_read(dev->i2c_desc,
-		 &register_value,
-		 1,
-		 1);
+	i2c_write_then_read(dev->i2c_desc,
+			    &register_address,
+			    1,
+			    &register_value,
+			    1);
 
 	return register_value;
 }
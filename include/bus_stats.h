@@ -0,0 +1,129 @@
+/***************************************************************************//**
+ *   @file   bus_stats.h
+ *   @brief  Header file of the bus transaction statistics.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef BUS_STATS_H_
+#define BUS_STATS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Number of latency histogram buckets */
+#define BUS_STATS_BUCKETS	32
+
+#ifdef BUS_STATS
+/**
+ * Time a call returning a status and record it as a transaction. Evaluates
+ * to the status.
+ */
+#define BUS_STATS_CALL(stats, bytes, call) ({				\
+	uint64_t __start = bus_stats_start();				\
+	__typeof__(call) __ret = (call);				\
+	bus_stats_end(stats, __start, bytes, __ret < 0);		\
+	__ret;								\
+})
+#else
+#define BUS_STATS_CALL(stats, bytes, call)	(call)
+#define bus_stats_register(stats, name, id)	do {} while (0)
+#define bus_stats_unregister(stats)		do {} while (0)
+#endif
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+struct timer_desc;
+
+/**
+ * @struct bus_stats
+ * @brief Transaction statistics of a bus descriptor.
+ */
+struct bus_stats {
+	/** Name shown by bus_stats_dump() */
+	const char		*name;
+	/** Identifier shown by bus_stats_dump() (chip select, address...) */
+	uint32_t		id;
+	/** Number of transactions */
+	uint32_t		count;
+	/** Number of failed transactions */
+	uint32_t		errors;
+	/** Number of bytes transferred */
+	uint64_t		bytes;
+	/** Sum of the latencies in ns */
+	uint64_t		total_ns;
+	/** Highest latency in ns */
+	uint32_t		max_ns;
+	/** Bucket n counts the latencies from 2^n to 2^(n+1) - 1 ns */
+	uint32_t		hist[BUS_STATS_BUCKETS];
+	/** Next registered statistics */
+	struct bus_stats	*next;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+#ifdef BUS_STATS
+/* Set the timer used to measure the latencies. */
+void bus_stats_init(struct timer_desc *timer);
+/* Clear the statistics and add them to the list shown by bus_stats_dump(). */
+void bus_stats_register(struct bus_stats *stats, const char *name,
+			uint32_t id);
+/* Remove the statistics from the list shown by bus_stats_dump(). */
+void bus_stats_unregister(struct bus_stats *stats);
+/* Get the timestamp of the start of a transaction. */
+uint64_t bus_stats_start(void);
+/* Record a transaction. */
+void bus_stats_end(struct bus_stats *stats, uint64_t start, uint32_t bytes,
+		   bool error);
+/* Get the statistics of an AXI base address. */
+struct bus_stats *bus_stats_axi(uint32_t base);
+/* Clear all the registered statistics. */
+void bus_stats_reset(void);
+/* Print all the registered statistics. */
+int32_t bus_stats_dump(char *buf, uint32_t len);
+#endif
+
+#endif /* BUS_STATS_H_ */
@@ -45,6 +45,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
@@ -56,4 +57,10 @@ void udelay(uint32_t usecs);
 /* Generate miliseconds delay. */
 void mdelay(uint32_t msecs);
 
+/* Generate nanoseconds delay. */
+void ndelay(uint32_t nsecs);
+
+/* Wait until a condition is true or a timeout expires. */
+int32_t wait_until(bool (*cond)(void *ctx), void *ctx, uint32_t timeout_us);
+
 #endif // DELAY_H_
@@ -45,6 +45,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include "bus_stats.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -74,6 +75,10 @@ typedef struct i2c_desc {
 	uint8_t		slave_address;
 	/** I2C extra parameters (device specific parameters) */
 	void		*extra;
+#ifdef BUS_STATS
+	/** Transaction statistics */
+	struct bus_stats stats;
+#endif
 } i2c_desc;
 
 /******************************************************************************/
@@ -90,13 +95,20 @@ int32_t i2c_remove(struct i2c_desc *desc);
 /* Write data to a slave device. */
 int32_t i2c_write(struct i2c_desc *desc,
 		  uint8_t *data,
-		  uint8_t bytes_number,
+		  uint32_t bytes_number,
 		  uint8_t stop_bit);
 
 /* Read data from a slave device. */
 int32_t i2c_read(struct i2c_desc *desc,
 		 uint8_t *data,
-		 uint8_t bytes_number,
+		 uint32_t bytes_number,
 		 uint8_t stop_bit);
 
+/* Write data then read data from a slave device, with a repeated start. */
+int32_t i2c_write_then_read(struct i2c_desc *desc,
+			    uint8_t *wr_data,
+			    uint32_t wr_bytes_number,
+			    uint8_t *rd_data,
+			    uint32_t rd_bytes_number);
+
 #endif // I2C_H_
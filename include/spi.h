@@ -45,6 +45,8 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "bus_stats.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -109,8 +111,25 @@ typedef struct spi_desc {
 	const struct spi_platform_ops *platform_ops;
 	/**  SPI extra parameters (device specific) */
 	void		*extra;
+#ifdef BUS_STATS
+	/** Transaction statistics */
+	struct bus_stats stats;
+#endif
 } spi_desc;
 
+/**
+ * @struct spi_msg
+ * @brief Segment of a transfer done with spi_transfer().
+ */
+struct spi_msg {
+	/** Data to send, NULL to send zeros */
+	uint8_t		*tx_buff;
+	/** Buffer for the received data, NULL to drop it. May be tx_buff */
+	uint8_t		*rx_buff;
+	/** Length of the segment */
+	uint32_t	bytes_number;
+};
+
 /**
  * @struct spi_platform_ops
  * @brief Structure holding SPI function pointers that point to the platform
@@ -123,6 +142,14 @@ struct spi_platform_ops {
 	int32_t (*spi_ops_write_and_read)(struct spi_desc *, uint8_t *, uint16_t);
 	/** SPI remove function pointer */
 	int32_t (*spi_ops_remove)(struct spi_desc *);
+	/** SPI asynchronous transfer start function pointer (optional) */
+	int32_t (*spi_ops_submit)(struct spi_desc *, uint8_t *, uint32_t,
+				  void (*)(void *, int32_t), void *);
+	/** SPI asynchronous transfer end function pointer (optional) */
+	int32_t (*spi_ops_complete)(struct spi_desc *, bool);
+	/** SPI multi-segment transfer function pointer (optional) */
+	int32_t (*spi_ops_transfer)(struct spi_desc *, struct spi_msg *,
+				    uint32_t);
 };
 
 /******************************************************************************/
@@ -141,4 +168,20 @@ int32_t spi_write_and_read(struct spi_desc *desc,
 			   uint8_t *data,
 			   uint16_t bytes_number);
 
+/* Start an asynchronous write and read to/from SPI. */
+int32_t spi_submit_transfer(struct spi_desc *desc,
+			    uint8_t *data,
+			    uint32_t bytes_number,
+			    void (*callback)(void *ctx, int32_t status),
+			    void *ctx);
+
+/* Check or wait for the end of the asynchronous transfer. */
+int32_t spi_complete_transfer(struct spi_desc *desc,
+			      bool wait);
+
+/* Transfer several segments with the chip select held between them. */
+int32_t spi_transfer(struct spi_desc *desc,
+		     struct spi_msg *msgs,
+		     uint32_t len);
+
 #endif // SPI_H_
@@ -109,5 +109,19 @@ int32_t timer_count_clk_get(struct timer_desc *desc, uint32_t *freq_hz);
 /* Set the timer clock frequency. */
 int32_t timer_count_clk_set(struct timer_desc *desc, uint32_t freq_hz);
 
+/* Call a function periodically, from the timer interrupt. */
+int32_t timer_set_periodic(struct timer_desc *desc, uint32_t period_us,
+			   void (*callback)(void *ctx), void *ctx);
+
+/* Call a function once, from the timer interrupt, after a delay. */
+int32_t timer_set_oneshot(struct timer_desc *desc, uint32_t delay_us,
+			  void (*callback)(void *ctx), void *ctx);
+
+/* Stop calling the function set by timer_set_periodic/oneshot(). */
+int32_t timer_cancel(struct timer_desc *desc);
+
+/* Get a 64-bit monotonic timestamp in nanoseconds. */
+int32_t timer_get_time_ns(struct timer_desc *desc, uint64_t *ns);
+
 #endif /* SRC_TIMER_H_ */
 
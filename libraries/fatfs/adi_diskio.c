@@ -1,5 +1,5 @@
 /***************************************************************************//**
-*   @file   diskio.c
+*   @file   adi_diskio.c
 *   @brief  Implementation of the Low level disk I/O module for FatFs.
 *   @author Mihail Chindris (mihail.chindris@analog.com)
 ********************************************************************************
@@ -44,22 +44,59 @@
 #include "ff.h"			/* Obtains integer types */
 #include "diskio.h"		/* Declarations of disk functions */
 
+#include "adi_diskio.h"
 #include "sd.h"
 #include "error.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef LINUX_PLATFORM
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
-#define DEV_SD		0	/* Example: Map MMC/SD card to physical drive 0 */
-#define DEV_RAM		1	/* Example: Map Ramdisk to physical drive 1 */
-#define DEV_USB		2	/* Example: Map USB MSD to physical drive 2 */
+#define DISK_SECTOR_SIZE	512u
 
-#define ERASE_SECTOR_SIZE	1u
 uint8_t			sd_init_var = false;
 extern struct sd_desc	*sd_desc;
 
+/**
+ * @struct ram_disk
+ * @brief RAM disk backend state
+ */
+static struct ram_disk {
+	/** Disk content */
+	uint8_t		*mem;
+	/** Number of sectors */
+	LBA_t		sectors;
+	/** mem was allocated by diskio_ram_attach */
+	bool		allocated;
+	/** Set by disk_initialize */
+	bool		init;
+} ram_disk;
+
+#ifdef LINUX_PLATFORM
+/**
+ * @struct file_disk
+ * @brief Host file backend state
+ */
+static struct file_disk {
+	/** Descriptor of the image file, -1 if not attached */
+	int		fd;
+	/** Number of sectors */
+	LBA_t		sectors;
+	/** Set by disk_initialize */
+	bool		init;
+} file_disk = {
+	.fd = -1
+};
+#endif
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -68,6 +105,14 @@ DSTATUS SD_disk_status();
 DSTATUS SD_disk_initialize();
 DRESULT SD_disk_read(BYTE *buff, LBA_t sector, UINT count);
 DRESULT SD_disk_write(BYTE *buff, LBA_t sector, UINT count);
+static DRESULT RAM_disk_read(BYTE *buff, LBA_t sector, UINT count);
+static DRESULT RAM_disk_write(const BYTE *buff, LBA_t sector, UINT count);
+static DRESULT RAM_disk_ioctl(BYTE cmd, void *buff);
+#ifdef LINUX_PLATFORM
+static DRESULT FILE_disk_read(BYTE *buff, LBA_t sector, UINT count);
+static DRESULT FILE_disk_write(const BYTE *buff, LBA_t sector, UINT count);
+static DRESULT FILE_disk_ioctl(BYTE cmd, void *buff);
+#endif
 
 /*-----------------------------------------------------------------------*/
 /* Get Drive Status                                                      */
@@ -80,9 +125,17 @@ DSTATUS disk_status (
 	case DEV_SD :
 		return SD_disk_status();;
 	case DEV_RAM :
-		return STA_NODISK;
+		if (!ram_disk.mem)
+			return STA_NODISK;
+		return ram_disk.init ? 0 : STA_NOINIT;
 	case DEV_USB :
 		return STA_NODISK;
+#ifdef LINUX_PLATFORM
+	case DEV_FILE :
+		if (file_disk.fd < 0)
+			return STA_NODISK;
+		return file_disk.init ? 0 : STA_NOINIT;
+#endif
 	default:
 		return STA_NODISK;
 	}
@@ -100,9 +153,19 @@ DSTATUS disk_initialize (
 	case DEV_SD :
 		return SD_disk_initialize();
 	case DEV_RAM :
-		return STA_NODISK;
+		if (!ram_disk.mem)
+			return STA_NODISK;
+		ram_disk.init = true;
+		return 0;
 	case DEV_USB :
 		return STA_NODISK;
+#ifdef LINUX_PLATFORM
+	case DEV_FILE :
+		if (file_disk.fd < 0)
+			return STA_NODISK;
+		file_disk.init = true;
+		return 0;
+#endif
 	}
 	return STA_NOINIT;
 }
@@ -122,9 +185,13 @@ DRESULT disk_read (
 	case DEV_SD :
 		return SD_disk_read(buff, sector, count);
 	case DEV_RAM :
-		return RES_NOTRDY;
+		return RAM_disk_read(buff, sector, count);
 	case DEV_USB :
 		return RES_NOTRDY;
+#ifdef LINUX_PLATFORM
+	case DEV_FILE :
+		return FILE_disk_read(buff, sector, count);
+#endif
 	}
 	return RES_PARERR;
 }
@@ -146,9 +213,13 @@ DRESULT disk_write (
 	case DEV_SD:
 		return SD_disk_write(buff, sector, count);
 	case DEV_RAM :
-		return RES_NOTRDY;
+		return RAM_disk_write(buff, sector, count);
 	case DEV_USB :
 		return RES_NOTRDY;
+#ifdef LINUX_PLATFORM
+	case DEV_FILE :
+		return FILE_disk_write(buff, sector, count);
+#endif
 	}
 
 	return RES_PARERR;
@@ -168,7 +239,11 @@ DRESULT disk_ioctl (
 	switch(pdrv) {
 	case DEV_SD:
 		switch (cmd){
-		case CTRL_SYNC: return RES_OK;
+		case CTRL_SYNC:
+			/* Write back the blocks held in the sd cache */
+			if (SUCCESS != sd_flush(sd_desc))
+				return RES_ERROR;
+			return RES_OK;
 		case GET_SECTOR_COUNT:
 			*(LBA_t *)buff = sd_desc->memory_size / DATA_BLOCK_LEN;
 			return RES_OK;
@@ -180,15 +255,19 @@ DRESULT disk_ioctl (
 		case GET_BLOCK_SIZE:
 			/* Block size in FatFs is the name for
 			 * sector size in the SD card specification */
-			*(DWORD *)buff = ERASE_SECTOR_SIZE;
+			*(DWORD *)buff = sd_desc->erase_block_size;
 			return RES_OK;
 		default: return RES_OK;
 		}
 		return RES_PARERR;
 	case DEV_RAM:
-		return RES_NOTRDY;
+		return RAM_disk_ioctl(cmd, buff);
 	case DEV_USB:
 		return RES_NOTRDY;
+#ifdef LINUX_PLATFORM
+	case DEV_FILE:
+		return FILE_disk_ioctl(cmd, buff);
+#endif
 	}
 	return RES_PARERR;
 }
@@ -230,4 +309,215 @@ DRESULT SD_disk_write(BYTE *buff, LBA_t sector, UINT count)
 	return RES_OK;
 }
 
+/**
+ * Attach a RAM buffer as the DEV_RAM drive.
+ * @param mem		- Disk content, of sector_count * 512 bytes. If NULL,
+ * 			  a zeroed buffer is allocated.
+ * @param sector_count	- Number of 512 bytes sectors
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t diskio_ram_attach(uint8_t *mem, uint32_t sector_count)
+{
+	if (ram_disk.mem || !sector_count)
+		return FAILURE;
+
+	ram_disk.allocated = false;
+	if (!mem) {
+		mem = calloc(sector_count, DISK_SECTOR_SIZE);
+		if (!mem)
+			return FAILURE;
+		ram_disk.allocated = true;
+	}
+	ram_disk.mem = mem;
+	ram_disk.sectors = sector_count;
+	ram_disk.init = false;
+
+	return SUCCESS;
+}
+
+/**
+ * Detach the DEV_RAM drive and free its buffer if it was allocated.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t diskio_ram_detach(void)
+{
+	if (!ram_disk.mem)
+		return FAILURE;
+
+	if (ram_disk.allocated)
+		free(ram_disk.mem);
+	memset(&ram_disk, 0, sizeof(ram_disk));
+
+	return SUCCESS;
+}
+
+static DRESULT RAM_disk_read(BYTE *buff, LBA_t sector, UINT count)
+{
+	if (!ram_disk.init)
+		return RES_NOTRDY;
+	if (sector >= ram_disk.sectors || count > ram_disk.sectors - sector)
+		return RES_PARERR;
+
+	memcpy(buff, ram_disk.mem + (size_t)sector * DISK_SECTOR_SIZE,
+	       (size_t)count * DISK_SECTOR_SIZE);
+
+	return RES_OK;
+}
+
+static DRESULT RAM_disk_write(const BYTE *buff, LBA_t sector, UINT count)
+{
+	if (!ram_disk.init)
+		return RES_NOTRDY;
+	if (sector >= ram_disk.sectors || count > ram_disk.sectors - sector)
+		return RES_PARERR;
+
+	memcpy(ram_disk.mem + (size_t)sector * DISK_SECTOR_SIZE, buff,
+	       (size_t)count * DISK_SECTOR_SIZE);
+
+	return RES_OK;
+}
+
+static DRESULT RAM_disk_ioctl(BYTE cmd, void *buff)
+{
+	if (!ram_disk.init)
+		return RES_NOTRDY;
+
+	switch (cmd) {
+	case CTRL_SYNC:
+		return RES_OK;
+	case GET_SECTOR_COUNT:
+		*(LBA_t *)buff = ram_disk.sectors;
+		return RES_OK;
+	case GET_SECTOR_SIZE:
+		*(WORD *)buff = DISK_SECTOR_SIZE;
+		return RES_OK;
+	case GET_BLOCK_SIZE:
+		/* No erase unit */
+		*(DWORD *)buff = 1;
+		return RES_OK;
+	default:
+		return RES_OK;
+	}
+}
+
+#ifdef LINUX_PLATFORM
+
+/**
+ * Attach a host file or disk image as the DEV_FILE drive.
+ * @param path		- Path of the image
+ * @param sector_count	- Number of 512 bytes sectors. The file is created or
+ * 			  resized to this size. If 0, the size of the existing
+ * 			  file is used.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t diskio_file_attach(const char *path, uint32_t sector_count)
+{
+	struct stat	st;
+	int		fd;
+
+	if (!path || file_disk.fd >= 0)
+		return FAILURE;
+
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return FAILURE;
+
+	if (sector_count) {
+		if (ftruncate(fd, (off_t)sector_count * DISK_SECTOR_SIZE) < 0)
+			goto error;
+	} else {
+		if (fstat(fd, &st) < 0 || st.st_size < DISK_SECTOR_SIZE)
+			goto error;
+		sector_count = st.st_size / DISK_SECTOR_SIZE;
+	}
+
+	file_disk.fd = fd;
+	file_disk.sectors = sector_count;
+	file_disk.init = false;
+
+	return SUCCESS;
+error:
+	close(fd);
+	return FAILURE;
+}
+
+/**
+ * Detach the DEV_FILE drive, writing its content to the host storage.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t diskio_file_detach(void)
+{
+	int32_t	ret = SUCCESS;
+
+	if (file_disk.fd < 0)
+		return FAILURE;
+
+	if (fsync(file_disk.fd) < 0)
+		ret = FAILURE;
+	if (close(file_disk.fd) < 0)
+		ret = FAILURE;
+	file_disk.fd = -1;
+	file_disk.init = false;
+
+	return ret;
+}
+
+static DRESULT FILE_disk_read(BYTE *buff, LBA_t sector, UINT count)
+{
+	size_t	len = (size_t)count * DISK_SECTOR_SIZE;
+	ssize_t	ret;
+
+	if (!file_disk.init)
+		return RES_NOTRDY;
+	if (sector >= file_disk.sectors || count > file_disk.sectors - sector)
+		return RES_PARERR;
+
+	ret = pread(file_disk.fd, buff, len, (off_t)sector * DISK_SECTOR_SIZE);
+	if (ret < 0 || (size_t)ret != len)
+		return RES_ERROR;
+
+	return RES_OK;
+}
+
+static DRESULT FILE_disk_write(const BYTE *buff, LBA_t sector, UINT count)
+{
+	size_t	len = (size_t)count * DISK_SECTOR_SIZE;
+	ssize_t	ret;
+
+	if (!file_disk.init)
+		return RES_NOTRDY;
+	if (sector >= file_disk.sectors || count > file_disk.sectors - sector)
+		return RES_PARERR;
+
+	ret = pwrite(file_disk.fd, buff, len, (off_t)sector * DISK_SECTOR_SIZE);
+	if (ret < 0 || (size_t)ret != len)
+		return RES_ERROR;
+
+	return RES_OK;
+}
+
+static DRESULT FILE_disk_ioctl(BYTE cmd, void *buff)
+{
+	if (!file_disk.init)
+		return RES_NOTRDY;
+
+	switch (cmd) {
+	case CTRL_SYNC:
+		if (fsync(file_disk.fd) < 0)
+			return RES_ERROR;
+		return RES_OK;
+	case GET_SECTOR_COUNT:
+		*(LBA_t *)buff = file_disk.sectors;
+		return RES_OK;
+	case GET_SECTOR_SIZE:
+		*(WORD *)buff = DISK_SECTOR_SIZE;
+		return RES_OK;
+	case GET_BLOCK_SIZE:
+		*(DWORD *)buff = 1;
+		return RES_OK;
+	default:
+		return RES_OK;
+	}
+}
 
+#endif /* LINUX_PLATFORM */
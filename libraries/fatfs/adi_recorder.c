@@ -0,0 +1,431 @@
+/***************************************************************************//**
+*   @file   adi_recorder.c
+*   @brief  Capture to storage recorder writing raw sectors of a preallocated file.
+********************************************************************************
+* Copyright 2026(c) Analog Devices, Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*  - Redistributions of source code must retain the above copyright
+*    notice, this list of conditions and the following disclaimer.
+*  - Redistributions in binary form must reproduce the above copyright
+*    notice, this list of conditions and the following disclaimer in
+*    the documentation and/or other materials provided with the
+*    distribution.
+*  - Neither the name of Analog Devices, Inc. nor the names of its
+*    contributors may be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*  - The use of this software may or may not infringe the patent rights
+*    of one or more patent holders.  This license does not release you
+*    from the requirement that you obtain separate licenses from these
+*    patent holders to use this software.
+*  - Use of the software either in source or binary form, must be run
+*    on or directly connected to an Analog Devices Inc. component.
+*
+* THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+* IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "ff.h"
+#include "diskio.h"
+#include "adi_diskio.h"
+#include "adi_recorder.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SECTOR_SIZE		512u
+
+/* Header fields, little endian */
+#define HDR_MAGIC		0u
+#define HDR_SIZE		8u
+#define HDR_SAMPLE_RATE		12u
+#define HDR_NB_CHANNELS		16u
+#define HDR_DATA_BYTES		24u
+#define HDR_DROPPED_BYTES	32u
+#define HDR_DROP_EVENTS		40u
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+static void put_le(uint8_t *buf, uint64_t val, uint8_t bytes)
+{
+	uint8_t	i;
+
+	for (i = 0; i < bytes; i++)
+		buf[i] = (val >> (8 * i)) & 0xFF;
+}
+
+/**
+ * Write sectors of the recording with the blocking disk interface
+ * @param desc		- Recorder instance
+ * @param buff		- Data, a multiple of the sector size
+ * @param sector	- First sector on the drive
+ * @param count		- Number of sectors
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t write_sectors(struct recorder_desc *desc, const uint8_t *buff,
+			     LBA_t sector, UINT count)
+{
+	if (desc->sd)
+		return sd_write(desc->sd, (uint8_t *)buff,
+				(uint64_t)sector * SECTOR_SIZE,
+				(uint64_t)count * SECTOR_SIZE);
+
+	return disk_write(desc->pdrv, buff, sector, count) == RES_OK ?
+	       SUCCESS : FAILURE;
+}
+
+/**
+ * Update the header with the current counters and write it
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t write_header(struct recorder_desc *desc)
+{
+	put_le(desc->header + HDR_DATA_BYTES, desc->data_bytes, 8);
+	put_le(desc->header + HDR_DROPPED_BYTES, desc->dropped_bytes, 8);
+	put_le(desc->header + HDR_DROP_EVENTS, desc->drop_events, 4);
+
+	return write_sectors(desc, desc->header, desc->first_sector - 1, 1);
+}
+
+/**
+ * Completion of an asynchronous buffer write
+ * @param ctx		- Recorder instance
+ * @param status	- Result of the write
+ */
+static void write_done(void *ctx, int32_t status)
+{
+	struct recorder_desc *desc = ctx;
+
+	if (status != SUCCESS)
+		desc->write_status = status;
+	desc->busy = false;
+}
+
+/**
+ * Record that data could not be stored
+ * @param desc	- Recorder instance
+ * @param len	- Number of bytes lost
+ */
+static void drop(struct recorder_desc *desc, uint32_t len)
+{
+	desc->dropped_bytes += len;
+	desc->drop_events++;
+}
+
+/**
+ * Start writing the active buffer and switch to the other one. Only the last
+ * buffer can be partial, it is padded with zeros up to a whole sector and the
+ * padding is not counted as recorded data.
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t submit(struct recorder_desc *desc)
+{
+	uint8_t		*buff = desc->buff[desc->active];
+	uint32_t	len = desc->fill;
+	LBA_t		count;
+
+	count = (len + SECTOR_SIZE - 1) / SECTOR_SIZE;
+	if (count > desc->nb_sectors - desc->next_sector) {
+		/* The preallocated file is full */
+		count = desc->nb_sectors - desc->next_sector;
+		drop(desc, len - count * SECTOR_SIZE);
+		len = count * SECTOR_SIZE;
+	}
+	memset(buff + len, 0, count * SECTOR_SIZE - len);
+
+	desc->active ^= 1;
+	desc->fill = 0;
+	if (!count)
+		return SUCCESS;
+
+	desc->data_bytes += len;
+	desc->next_sector += count;
+	if (!desc->sd)
+		return write_sectors(desc, buff, desc->first_sector +
+				     desc->next_sector - count, count);
+
+	desc->busy = true;
+	if (SUCCESS != sd_write_async(desc->sd, buff,
+				      (uint64_t)(desc->first_sector +
+						 desc->next_sector - count) * SECTOR_SIZE,
+				      (uint64_t)count * SECTOR_SIZE,
+				      write_done, desc)) {
+		desc->busy = false;
+		desc->write_status = FAILURE;
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Wait for the buffer being written. Each sd_process() call either advances
+ * the write or counts an idle poll, and the SD driver fails the write after
+ * a bounded number of idle polls, so this returns even if the card hangs.
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t wait_idle(struct recorder_desc *desc)
+{
+	while (desc->busy) {
+		if (SUCCESS != sd_process(desc->sd) ||
+		    (desc->busy && !sd_async_busy(desc->sd))) {
+			/* Failed, or ended without calling write_done() */
+			desc->busy = false;
+			desc->write_status = FAILURE;
+		}
+	}
+
+	return desc->write_status;
+}
+
+/**
+ * Submit the active buffer if it is full and the storage is free
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+static int32_t service(struct recorder_desc *desc)
+{
+	if (desc->busy && SUCCESS != sd_process(desc->sd)) {
+		desc->busy = false;
+		desc->write_status = FAILURE;
+	}
+	if (desc->write_status != SUCCESS)
+		return FAILURE;
+	if (desc->fill == desc->buffer_size && !desc->busy)
+		return submit(desc);
+
+	return SUCCESS;
+}
+
+/**
+ * Create a recording. The file is preallocated contiguously for max_size data
+ * bytes plus the header, so the data sectors are written without FatFs
+ * walking or updating the FAT.
+ * @param desc	- The recorder instance is returned here
+ * @param param	- Recorder configuration
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t recorder_init(struct recorder_desc **desc,
+		      const struct recorder_init_param *param)
+{
+	struct recorder_desc	*rec;
+	FATFS			*fs;
+	FSIZE_t			size;
+	uint8_t			*ch;
+	uint8_t			i;
+
+	if (!desc || !param || !param->path || !param->max_size ||
+	    !param->buffer_size || param->buffer_size % SECTOR_SIZE ||
+	    param->nb_channels > RECORDER_MAX_CHANNELS ||
+	    (param->nb_channels && !param->channels))
+		return FAILURE;
+
+	rec = calloc(1, sizeof(*rec));
+	if (!rec)
+		return FAILURE;
+	rec->buff[0] = malloc(param->buffer_size);
+	rec->buff[1] = malloc(param->buffer_size);
+	if (!rec->buff[0] || !rec->buff[1])
+		goto error_free;
+	rec->buffer_size = param->buffer_size;
+	rec->write_status = SUCCESS;
+
+	size = RECORDER_HEADER_SIZE +
+	       ((param->max_size + SECTOR_SIZE - 1) / SECTOR_SIZE) * SECTOR_SIZE;
+	if (f_open(&rec->file, param->path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+		goto error_free;
+	if (f_expand(&rec->file, size, 1) != FR_OK ||
+	    f_sync(&rec->file) != FR_OK)
+		goto error_close;
+
+	fs = rec->file.obj.fs;
+	rec->pdrv = fs->pdrv;
+	if (param->sd && rec->pdrv == DEV_SD)
+		rec->sd = param->sd;
+	/* Contiguous from the first cluster, the header is the first sector */
+	rec->first_sector = fs->database +
+			    (LBA_t)fs->csize * (rec->file.obj.sclust - 2) + 1;
+	rec->nb_sectors = size / SECTOR_SIZE - 1;
+
+	memcpy(rec->header + HDR_MAGIC, RECORDER_MAGIC, 8);
+	put_le(rec->header + HDR_SIZE, RECORDER_HEADER_SIZE, 4);
+	put_le(rec->header + HDR_SAMPLE_RATE, param->sample_rate, 4);
+	put_le(rec->header + HDR_NB_CHANNELS, param->nb_channels, 4);
+	for (i = 0; i < param->nb_channels; i++) {
+		ch = rec->header + RECORDER_CHANNELS_OFF + 8 * i;
+		ch[0] = param->channels[i].sign;
+		ch[1] = param->channels[i].realbits;
+		ch[2] = param->channels[i].storagebits;
+		ch[3] = param->channels[i].shift;
+		ch[4] = param->channels[i].is_big_endian;
+	}
+	if (SUCCESS != write_header(rec))
+		goto error_close;
+
+	*desc = rec;
+
+	return SUCCESS;
+error_close:
+	f_close(&rec->file);
+error_free:
+	free(rec->buff[0]);
+	free(rec->buff[1]);
+	free(rec);
+	return FAILURE;
+}
+
+/**
+ * Copy captured data, for example read from a sensor FIFO, into the
+ * recording. Data that does not fit because the storage is still writing
+ * the other buffer is dropped and counted.
+ * @param desc	- Recorder instance
+ * @param data	- Captured data
+ * @param len	- Length of data in bytes
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t recorder_push(struct recorder_desc *desc, const uint8_t *data,
+		      uint32_t len)
+{
+	uint32_t	part;
+
+	if (!desc || desc->lent || (len && !data))
+		return FAILURE;
+
+	while (len) {
+		if (SUCCESS != service(desc))
+			return FAILURE;
+		if (desc->fill == desc->buffer_size) {
+			drop(desc, len);
+			break;
+		}
+		part = desc->buffer_size - desc->fill;
+		if (part > len)
+			part = len;
+		memcpy(desc->buff[desc->active] + desc->fill, data, part);
+		desc->fill += part;
+		data += part;
+		len -= part;
+	}
+
+	return service(desc);
+}
+
+/**
+ * Get the free space of the active buffer to be filled directly by the
+ * capture, for example with axi_dmac_transfer(), and then passed back with
+ * recorder_commit(). The space follows the data already recorded, so pushed
+ * and captured data stay contiguous in the recording.
+ * If both buffers are in use, the capture must be discarded: one drop of
+ * buffer_size bytes is counted and FAILURE is returned.
+ * @param desc	- Recorder instance
+ * @param buff	- The free space is returned here
+ * @param len	- The size of the free space is returned here
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t recorder_get_buffer(struct recorder_desc *desc, uint8_t **buff,
+			    uint32_t *len)
+{
+	if (!desc || !buff || !len || desc->lent)
+		return FAILURE;
+
+	if (SUCCESS != service(desc))
+		return FAILURE;
+	if (desc->fill == desc->buffer_size) {
+		drop(desc, desc->buffer_size);
+		return FAILURE;
+	}
+
+	desc->lent = true;
+	*buff = desc->buff[desc->active] + desc->fill;
+	*len = desc->buffer_size - desc->fill;
+
+	return SUCCESS;
+}
+
+/**
+ * Hand back the space obtained with recorder_get_buffer()
+ * @param desc	- Recorder instance
+ * @param len	- Number of bytes captured in the space
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t recorder_commit(struct recorder_desc *desc, uint32_t len)
+{
+	if (!desc || !desc->lent || len > desc->buffer_size - desc->fill)
+		return FAILURE;
+
+	desc->lent = false;
+	desc->fill += len;
+
+	return service(desc);
+}
+
+/**
+ * Advance the storage side. Must be called periodically while recording.
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE if a write failed.
+ */
+int32_t recorder_process(struct recorder_desc *desc)
+{
+	if (!desc)
+		return FAILURE;
+
+	return service(desc);
+}
+
+/**
+ * Write the remaining data and the final header, trim the file to the
+ * recorded size and close it. The instance is freed even on failure.
+ * @param desc	- Recorder instance
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t recorder_stop(struct recorder_desc *desc)
+{
+	int32_t	ret;
+
+	if (!desc)
+		return FAILURE;
+
+	ret = wait_idle(desc);
+	if (ret == SUCCESS && desc->fill)
+		ret = submit(desc);
+	if (ret == SUCCESS)
+		ret = wait_idle(desc);
+	if (ret == SUCCESS)
+		ret = write_header(desc);
+
+	if (f_lseek(&desc->file, RECORDER_HEADER_SIZE + desc->data_bytes) != FR_OK ||
+	    f_truncate(&desc->file) != FR_OK)
+		ret = FAILURE;
+	if (f_close(&desc->file) != FR_OK)
+		ret = FAILURE;
+
+	free(desc->buff[0]);
+	free(desc->buff[1]);
+	free(desc);
+
+	return ret;
+}
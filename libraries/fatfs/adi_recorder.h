@@ -0,0 +1,166 @@
+/***************************************************************************//**
+*   @file   adi_recorder.h
+*   @brief  Header file of the capture to storage recorder.
+********************************************************************************
+* Copyright 2026(c) Analog Devices, Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*  - Redistributions of source code must retain the above copyright
+*    notice, this list of conditions and the following disclaimer.
+*  - Redistributions in binary form must reproduce the above copyright
+*    notice, this list of conditions and the following disclaimer in
+*    the documentation and/or other materials provided with the
+*    distribution.
+*  - Neither the name of Analog Devices, Inc. nor the names of its
+*    contributors may be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*  - The use of this software may or may not infringe the patent rights
+*    of one or more patent holders.  This license does not release you
+*    from the requirement that you obtain separate licenses from these
+*    patent holders to use this software.
+*  - Use of the software either in source or binary form, must be run
+*    on or directly connected to an Analog Devices Inc. component.
+*
+* THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+* IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+* MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+* IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef ADI_RECORDER_H_
+#define ADI_RECORDER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ff.h"
+#include "sd.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Size of the header at the beginning of the recording, one sector */
+#define RECORDER_HEADER_SIZE	512u
+/** Magic identifying a recording */
+#define RECORDER_MAGIC		"ADIREC01"
+/** Offset of the channel descriptions in the header */
+#define RECORDER_CHANNELS_OFF	48u
+/** Maximum number of channels described in the header */
+#define RECORDER_MAX_CHANNELS	\
+	((RECORDER_HEADER_SIZE - RECORDER_CHANNELS_OFF) / 8u)
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct recorder_channel
+ * @brief Layout of one channel in a scan, as in the IIO scan_type
+ */
+struct recorder_channel {
+	/** 's' or 'u' to specify signed or unsigned */
+	char		sign;
+	/** Number of valid bits of data */
+	uint8_t		realbits;
+	/** Realbits + padding */
+	uint8_t		storagebits;
+	/** Shift right by this before masking out realbits */
+	uint8_t		shift;
+	/** True if big endian, false if little endian */
+	bool		is_big_endian;
+};
+
+/**
+ * @struct recorder_init_param
+ * @brief Recorder configuration
+ */
+struct recorder_init_param {
+	/** Path of the recording, overwritten if it exists */
+	const char			*path;
+	/** Maximum number of data bytes recorded. Preallocated at init. */
+	uint32_t			max_size;
+	/** Size of each of the two buffers, multiple of 512 */
+	uint32_t			buffer_size;
+	/** Sample rate in Hz, stored in the header */
+	uint32_t			sample_rate;
+	/** Number of channels in a scan */
+	uint8_t				nb_channels;
+	/** Layout of the channels in a scan */
+	const struct recorder_channel	*channels;
+	/**
+	 * SD card backing the volume of path. If set, buffers are written
+	 * with sd_write_async() while the other buffer fills. Otherwise the
+	 * sectors are written with the blocking disk_write().
+	 */
+	struct sd_desc			*sd;
+};
+
+/**
+ * @struct recorder_desc
+ * @brief Recorder instance
+ */
+struct recorder_desc {
+	/** Preallocated file */
+	FIL		file;
+	/** Physical drive of the file */
+	BYTE		pdrv;
+	/** First data sector on the drive */
+	LBA_t		first_sector;
+	/** Number of data sectors preallocated */
+	LBA_t		nb_sectors;
+	/** Next data sector to be written */
+	LBA_t		next_sector;
+	/** Header sector */
+	uint8_t		header[RECORDER_HEADER_SIZE];
+	/** Double buffer */
+	uint8_t		*buff[2];
+	/** Size of each buffer */
+	uint32_t	buffer_size;
+	/** Buffer being filled */
+	uint8_t		active;
+	/** Bytes in the buffer being filled */
+	uint32_t	fill;
+	/** Free space handed out by recorder_get_buffer() */
+	bool		lent;
+	/** A buffer is being written */
+	volatile bool	busy;
+	/** Status of the last asynchronous write */
+	volatile int32_t	write_status;
+	/** SD card for asynchronous writes, may be NULL */
+	struct sd_desc	*sd;
+	/** Data bytes written to the storage */
+	uint64_t	data_bytes;
+	/** Bytes dropped because storage did not keep up or the file is full */
+	uint64_t	dropped_bytes;
+	/** Number of times data was dropped */
+	uint32_t	drop_events;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t recorder_init(struct recorder_desc **desc,
+		      const struct recorder_init_param *param);
+int32_t recorder_push(struct recorder_desc *desc, const uint8_t *data,
+		      uint32_t len);
+int32_t recorder_get_buffer(struct recorder_desc *desc, uint8_t **buff,
+			    uint32_t *len);
+int32_t recorder_commit(struct recorder_desc *desc, uint32_t len);
+int32_t recorder_process(struct recorder_desc *desc);
+int32_t recorder_stop(struct recorder_desc *desc);
+
+#endif /* ADI_RECORDER_H_ */
@@ -55,6 +55,7 @@
 #include "uart.h"
 #include "tcp_socket.h"
 #include "circular_buffer.h"
+#include "bus_stats.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -62,6 +63,8 @@
 
 #define IIOD_PORT		30431
 #define MAX_SOCKET_TO_HANDLE	4
+/** Debug attribute showing the statistics of all the buses */
+#define IIO_BUS_STATS_ATTR	"bus_stats"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -91,6 +94,28 @@ static char header[] =
 	"<context-attribute name=\"no-OS\" value=\"1.1.0-g0000000\" />";
 static char header_end[] = "</context>";
 
+#ifdef BUS_STATS
+/* Requests of an interface with statistics */
+enum iio_stats_req {
+	IIO_STATS_ATTR_READ,
+	IIO_STATS_ATTR_WRITE,
+	IIO_STATS_DEV_TO_MEM,
+	IIO_STATS_READ_DATA,
+	IIO_STATS_MEM_TO_DEV,
+	IIO_STATS_WRITE_DATA,
+	IIO_STATS_NB
+};
+
+static const char * const iio_stats_names[IIO_STATS_NB] = {
+	"iio_attr_read",
+	"iio_attr_write",
+	"iio_dev_to_mem",
+	"iio_read_data",
+	"iio_mem_to_dev",
+	"iio_write_data"
+};
+#endif
+
 /* Parameters used in show and store functions */
 struct attr_fun_params {
 	void			*dev_instance;
@@ -115,6 +140,10 @@ struct iio_interface {
 	void			*dev_instance;
 	/** Device descriptor(describes channels and attributes) */
 	struct iio_device	*dev_descriptor;
+#ifdef BUS_STATS
+	/** Statistics of the requests, the ID is the device number */
+	struct bus_stats	stats[IIO_STATS_NB];
+#endif
 };
 
 struct iio_desc {
@@ -462,6 +491,11 @@ static ssize_t iio_read_attr(const char *device_id, const char *attr, char *buf,
 	if (!dev)
 		return FAILURE;
 
+#ifdef BUS_STATS
+	if (debug && !strcmp(attr, IIO_BUS_STATS_ATTR))
+		return bus_stats_dump(buf, len);
+#endif
+
 	params.buf = buf;
 	params.len = len;
 	params.dev_instance = dev->dev_instance;
@@ -472,9 +506,12 @@ static ssize_t iio_read_attr(const char *device_id, const char *attr, char *buf,
 		attributes = dev->dev_descriptor->attributes;
 
 	if (!strcmp(attr, ""))
-		return iio_read_all_attr(&params, attributes);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_READ], 0,
+				      iio_read_all_attr(&params, attributes));
 	else
-		return iio_rd_wr_attribute(&params,attributes, attr, 0);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_READ], 0,
+				      iio_rd_wr_attribute(&params, attributes,
+						      attr, 0));
 }
 
 /**
@@ -498,6 +535,14 @@ static ssize_t iio_write_attr(const char *device_id, const char *attr,
 	if (!dev)
 		return -ENODEV;
 
+#ifdef BUS_STATS
+	/* Writing any value clears the statistics */
+	if (debug && !strcmp(attr, IIO_BUS_STATS_ATTR)) {
+		bus_stats_reset();
+		return len;
+	}
+#endif
+
 	params.buf = (char *)buf;
 	params.len = len;
 	params.dev_instance = dev->dev_instance;
@@ -508,9 +553,12 @@ static ssize_t iio_write_attr(const char *device_id, const char *attr,
 		attributes = dev->dev_descriptor->attributes;
 
 	if (!strcmp(attr, ""))
-		return iio_write_all_attr(&params, attributes);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_WRITE], len,
+				      iio_write_all_attr(&params, attributes));
 	else
-		return iio_rd_wr_attribute(&params, attributes, attr, 1);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_WRITE], len,
+				      iio_rd_wr_attribute(&params, attributes,
+						      attr, 1));
 }
 
 /**
@@ -549,9 +597,14 @@ static ssize_t iio_ch_read_attr(const char *device_id, const char *channel,
 	params.dev_instance = dev->dev_instance;
 	params.ch_info = &ch_info;
 	if (!strcmp(attr, ""))
-		return iio_read_all_attr(&params, ch->attributes);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_READ], 0,
+				      iio_read_all_attr(&params,
+							ch->attributes));
 	else
-		return iio_rd_wr_attribute(&params, ch->attributes, attr, 0);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_READ], 0,
+				      iio_rd_wr_attribute(&params,
+						      ch->attributes,
+						      attr, 0));
 }
 
 /**
@@ -590,9 +643,14 @@ static ssize_t iio_ch_write_attr(const char *device_id, const char *channel,
 	params.dev_instance = dev->dev_instance;
 	params.ch_info = &ch_info;
 	if (!strcmp(attr, ""))
-		return iio_write_all_attr(&params, ch->attributes);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_WRITE], len,
+				      iio_write_all_attr(&params,
+							 ch->attributes));
 	else
-		return iio_rd_wr_attribute(&params, ch->attributes, attr, 1);
+		return BUS_STATS_CALL(&dev->stats[IIO_STATS_ATTR_WRITE], len,
+				      iio_rd_wr_attribute(&params,
+						      ch->attributes,
+						      attr, 1));
 }
 
 /**
@@ -669,9 +727,12 @@ static ssize_t iio_transfer_dev_to_mem(const char *device, size_t bytes_count)
 	struct iio_interface *iio_interface = iio_get_interface(device);
 
 	if (iio_interface->dev_descriptor->transfer_dev_to_mem)
-		return iio_interface->dev_descriptor->transfer_dev_to_mem(
-			       iio_interface->dev_instance,
-			       bytes_count, iio_interface->ch_mask);
+		return BUS_STATS_CALL(
+			       &iio_interface->stats[IIO_STATS_DEV_TO_MEM],
+			       bytes_count,
+			       iio_interface->dev_descriptor->transfer_dev_to_mem(
+				       iio_interface->dev_instance,
+				       bytes_count, iio_interface->ch_mask));
 
 	return -ENOENT;
 }
@@ -693,10 +754,13 @@ static ssize_t iio_read_dev(const char *device, char *pbuf, size_t offset,
 	struct iio_interface *iio_interface = iio_get_interface(device);
 
 	if (iio_interface->dev_descriptor->read_data)
-		return iio_interface->dev_descriptor->read_data(
-			       iio_interface->dev_instance,
-			       pbuf, offset,
-			       bytes_count, iio_interface->ch_mask);
+		return BUS_STATS_CALL(
+			       &iio_interface->stats[IIO_STATS_READ_DATA],
+			       bytes_count,
+			       iio_interface->dev_descriptor->read_data(
+				       iio_interface->dev_instance,
+				       pbuf, offset,
+				       bytes_count, iio_interface->ch_mask));
 
 	return -ENOENT;
 }
@@ -712,9 +776,12 @@ static ssize_t iio_transfer_mem_to_dev(const char *device, size_t bytes_count)
 	struct iio_interface *iio_interface = iio_get_interface(device);
 
 	if (iio_interface->dev_descriptor->transfer_mem_to_dev)
-		return iio_interface->dev_descriptor->transfer_mem_to_dev(
-			       iio_interface->dev_instance,
-			       bytes_count, iio_interface->ch_mask);
+		return BUS_STATS_CALL(
+			       &iio_interface->stats[IIO_STATS_MEM_TO_DEV],
+			       bytes_count,
+			       iio_interface->dev_descriptor->transfer_mem_to_dev(
+				       iio_interface->dev_instance,
+				       bytes_count, iio_interface->ch_mask));
 
 	return -ENOENT;
 }
@@ -735,10 +802,13 @@ static ssize_t iio_write_dev(const char *device, const char *buf,
 {
 	struct iio_interface *iio_interface = iio_get_interface(device);
 	if(iio_interface->dev_descriptor->write_data)
-		return iio_interface->dev_descriptor->write_data(
-			       iio_interface->dev_instance,
-			       (char*)buf, offset, bytes_count,
-			       iio_interface->ch_mask);
+		return BUS_STATS_CALL(
+			       &iio_interface->stats[IIO_STATS_WRITE_DATA],
+			       bytes_count,
+			       iio_interface->dev_descriptor->write_data(
+				       iio_interface->dev_instance,
+				       (char*)buf, offset, bytes_count,
+				       iio_interface->ch_mask));
 
 	return -ENOENT;
 }
@@ -858,6 +928,10 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 			i += snprintf(buff + i, max(n - i, 0),
 				      "<debug-attribute name=\"%s\" />",
 				      device->debug_attributes[j]->name);
+#ifdef BUS_STATS
+	i += snprintf(buff + i, max(n - i, 0),
+		      "<debug-attribute name=\"%s\" />", IIO_BUS_STATS_ATTR);
+#endif
 
 	/* Write buffer attributes */
 	if (device->buffer_attributes)
@@ -871,6 +945,20 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 	return i;
 }
 
+/**
+ * @brief Remove the statistics of an interface from the bus statistics.
+ * @param iface - Interface to be removed.
+ */
+static void iio_stats_unregister(struct iio_interface *iface)
+{
+#ifdef BUS_STATS
+	int32_t i;
+
+	for (i = 0; i < IIO_STATS_NB; i++)
+		bus_stats_unregister(&iface->stats[i]);
+#endif
+}
+
 /**
  * @brief Register interface.
  * @param desc - iio descriptor
@@ -887,6 +975,9 @@ ssize_t iio_register(struct iio_desc *desc, struct iio_device *dev_descriptor,
 	int32_t	n;
 	int32_t	new_size;
 	char	*aux;
+#ifdef BUS_STATS
+	int32_t	i;
+#endif
 
 	iio_interface = (struct iio_interface *)calloc(1,
 			sizeof(*iio_interface));
@@ -922,6 +1013,11 @@ ssize_t iio_register(struct iio_desc *desc, struct iio_device *dev_descriptor,
 				desc->xml_desc + desc->xml_size_to_last_dev,
 				new_size - desc->xml_size_to_last_dev);
 	sprintf((char *)iio_interface->dev_id, "device%d", (int)desc->dev_count);
+#ifdef BUS_STATS
+	for (i = 0; i < IIO_STATS_NB; i++)
+		bus_stats_register(&iio_interface->stats[i],
+				   iio_stats_names[i], desc->dev_count);
+#endif
 	desc->xml_size_to_last_dev += n;
 	desc->xml_size += n;
 	/* Copy end header at the end */
@@ -951,6 +1047,7 @@ ssize_t iio_unregister(struct iio_desc *desc, char *name)
 			    (void **)&to_remove_interface, &search_interface);
 	if (IS_ERR_VALUE(ret))
 		return ret;
+	iio_stats_unregister(to_remove_interface);
 	free(to_remove_interface);
 
 	/* Get number of bytes needed for the xml of the device */
@@ -1099,8 +1196,10 @@ ssize_t iio_remove(struct iio_desc *desc)
 	struct iio_interface	*iio_interface;
 
 	while (SUCCESS == list_get_first(desc->interfaces_list,
-					 (void **)&iio_interface))
+					 (void **)&iio_interface)) {
+		iio_stats_unregister(iio_interface);
 		free(iio_interface);
+	}
 	list_remove(desc->interfaces_list);
 
 	free(desc->iiod_ops);
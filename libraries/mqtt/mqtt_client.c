@@ -54,15 +54,31 @@
 struct mqtt_desc {
 	MQTTClient		mqtt_client[1];
 	Network			network;
+	/* Millisecond timer of the client */
+	struct timer_desc	*timer;
+	/* Called when a message is received */
+	void			(*message_handler)(struct mqtt_message_data *);
+	/* Passed to the message handler */
+	void			*message_handler_ctx;
+	/* Queue of QoS0 publish packets */
+	uint8_t			*queue;
+	/* Size of the queue */
+	uint32_t		queue_size;
+	/* Bytes in the queue */
+	uint32_t		queue_len;
+	/* Timeout for a MQTT command to be executed */
+	uint32_t		command_timeout_ms;
 };
 
 /******************************************************************************/
 /**************************** Global Variables ********************************/
 /******************************************************************************/
 
-/* TODO: After initial commit, modify MQTT to support context to enable handler
- * for multiple clients */
-static void (*app_handler)(struct mqtt_message_data *);
+/*
+ * Client being executed. Paho calls the message handler without context, but
+ * always from a call made by this file for a specific client.
+ */
+static struct mqtt_desc *active_desc;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -79,6 +95,8 @@ static void mqtt_default_message_handler(MessageData *msg)
 	data.message.qos = (enum mqtt_qos)msg->message->qos;
 	data.message.retained = (bool)msg->message->retained;
 
+	data.ctx = active_desc->message_handler_ctx;
+
 	topic = &msg->topicName->lenstring;
 	data.topic = (uint8_t *)malloc(topic->len + 1);
 	if (!data.topic)
@@ -86,11 +104,74 @@ static void mqtt_default_message_handler(MessageData *msg)
 	memcpy(data.topic, topic->data, topic->len);
 	data.topic[topic->len] = '\0';
 
-	app_handler(&data);
+	if (active_desc->message_handler)
+		active_desc->message_handler(&data);
 
 	free(data.topic);
 }
 
+/* Make desc the client whose timer and handler are used by paho */
+static inline void mqtt_select(struct mqtt_desc *desc)
+{
+	active_desc = desc;
+	mqtt_timer_select(desc->timer);
+}
+
+/* Send the queued publish packets in one socket write */
+static int32_t mqtt_send_queue(struct mqtt_desc *desc)
+{
+	MQTTClient	*c = desc->mqtt_client;
+	int32_t		ret;
+	uint32_t	len;
+
+	if (!desc->queue_len)
+		return SUCCESS;
+
+	len = desc->queue_len;
+	ret = desc->network.mqttwrite(&desc->network, desc->queue, (int)len,
+				      (int)desc->command_timeout_ms);
+	if (ret != (int32_t)len)
+		/* Keep the packets queued so they can be sent again */
+		return FAILURE;
+
+	desc->queue_len = 0;
+
+	/* Same as paho does after sending a packet */
+	TimerCountdown(&c->last_sent, c->keepAliveInterval);
+
+	return SUCCESS;
+}
+
+/* Queue a QoS0 publish packet. Returns 1 if it doesn't fit in the queue */
+static int32_t mqtt_queue_publish(struct mqtt_desc *desc, const int8_t *topic,
+				  const struct mqtt_message *msg)
+{
+	MQTTString	topic_str = MQTTString_initializer;
+	int32_t		len;
+
+	if (!desc->mqtt_client->isconnected)
+		return FAILURE;
+
+	topic_str.cstring = (char *)topic;
+	len = MQTTSerialize_publish(desc->queue + desc->queue_len,
+				    desc->queue_size - desc->queue_len,
+				    0, 0, msg->retained, 0, topic_str,
+				    msg->payload, msg->len);
+	if (len > 0) {
+		desc->queue_len += len;
+		return SUCCESS;
+	}
+
+	/* Doesn't fit after the queued packets. Try in the emptied queue */
+	if (desc->queue_len) {
+		if (SUCCESS != mqtt_send_queue(desc))
+			return FAILURE;
+		return mqtt_queue_publish(desc, topic, msg);
+	}
+
+	return 1;
+}
+
 /**
  * @brief Initialize the MQTT client
  * @param desc - Address where to store the MQTT client reference
@@ -112,7 +193,8 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 	if (!ldesc)
 		return FAILURE;
 
-	ret = mqtt_timer_init(param->timer_id, param->extra_timer_init_param);
+	ret = mqtt_timer_init(&ldesc->timer, param->timer_id,
+			      param->extra_timer_init_param);
 	if (IS_ERR_VALUE(ret)) {
 		free(ldesc);
 		return FAILURE;
@@ -121,8 +203,18 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 	ldesc->network.sock = param->sock;
 	ldesc->network.mqttread = mqtt_noos_read;
 	ldesc->network.mqttwrite = mqtt_noos_write;
+	ldesc->network.wait_data = param->wait_data;
+	ldesc->network.wait_ctx = param->wait_ctx;
+
+	ldesc->message_handler = param->message_handler;
+	ldesc->message_handler_ctx = param->message_handler_ctx;
+	ldesc->queue = param->publish_queue;
+	ldesc->queue_size = param->publish_queue ?
+			    param->publish_queue_size : 0;
+	ldesc->command_timeout_ms = param->command_timeout_ms;
 
-	app_handler = param->message_handler;
+	/* Timers of the paho client are initialized with the client's timer */
+	mqtt_select(ldesc);
 
 	MQTTClientInit(ldesc->mqtt_client, &ldesc->network,
 		       (unsigned int)param->command_timeout_ms,
@@ -148,8 +240,10 @@ int32_t mqtt_remove(struct mqtt_desc *desc)
 	if (!desc)
 		return FAILURE;
 
+	if (active_desc == desc)
+		active_desc = NULL;
+	mqtt_timer_remove(desc->timer);
 	free(desc);
-	mqtt_timer_remove();
 
 	return SUCCESS;
 }
@@ -181,6 +275,8 @@ int32_t mqtt_connect(struct mqtt_desc *desc,
 	data.password.cstring = (char *)conf->password;
 	data.keepAliveInterval = (unsigned short)conf->keep_alive_ms;
 
+	mqtt_select(desc);
+	desc->queue_len = 0;
 	ret = MQTTConnectWithResults(desc->mqtt_client, &data, &res);
 	if (result_optional) {
 		result_optional->rc = res.rc;
@@ -202,11 +298,17 @@ int32_t mqtt_disconnect(struct mqtt_desc *desc)
 	if (!desc)
 		return FAILURE;
 
+	mqtt_select(desc);
+	mqtt_send_queue(desc);
+
 	return MQTTDisconnect(desc->mqtt_client);
 }
 
 /**
  * @brief Send publish to MQTT broker
+ *
+ * If a publish queue is configured, QoS0 messages are queued and sent
+ * together with the next ones. See \ref mqtt_init_param.publish_queue
  * @param desc - Reference to MQTT client
  * @param topic - Topic pattern which can include wildcards
  * @param msg - Message to send
@@ -217,11 +319,23 @@ int32_t mqtt_disconnect(struct mqtt_desc *desc)
 int32_t mqtt_publish(struct mqtt_desc *desc, const int8_t* topic,
 		     const struct mqtt_message* msg)
 {
+	int32_t	ret;
+
 	if (!desc || !msg)
 		return FAILURE;
 
 	MQTTMessage message = { 0 };
 
+	mqtt_select(desc);
+	if (msg->qos == MQTT_QOS0 && desc->queue_size) {
+		ret = mqtt_queue_publish(desc, topic, msg);
+		if (ret != 1)
+			return ret;
+		/* Larger than the queue, send it directly */
+	} else if (SUCCESS != mqtt_send_queue(desc)) {
+		return FAILURE;
+	}
+
 	message.payload = (void *)msg->payload;
 	message.payloadlen = (size_t)msg->len;
 	message.qos = (enum QoS)msg->qos;
@@ -250,6 +364,10 @@ int32_t mqtt_subscribe(struct mqtt_desc *desc, const int8_t *topic,
 	if (!desc)
 		return FAILURE;
 
+	mqtt_select(desc);
+	if (SUCCESS != mqtt_send_queue(desc))
+		return FAILURE;
+
 	ret = MQTTSubscribeWithResults(desc->mqtt_client, (char *)topic,
 				       (enum QoS)qos,
 				       mqtt_default_message_handler,
@@ -273,6 +391,10 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic)
 	if (!desc)
 		return FAILURE;
 
+	mqtt_select(desc);
+	if (SUCCESS != mqtt_send_queue(desc))
+		return FAILURE;
+
 	return MQTTUnsubscribe(desc->mqtt_client, (char *)topic);
 }
 
@@ -291,5 +413,29 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic)
  */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms)
 {
+	if (!desc)
+		return FAILURE;
+
+	mqtt_select(desc);
+	if (SUCCESS != mqtt_send_queue(desc))
+		return FAILURE;
+
 	return MQTTYield(desc->mqtt_client, timeout_ms);
 }
+
+/**
+ * @brief Send the queued QoS0 publish messages
+ * @param desc - Reference to MQTT client
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - \ref FAILURE : Otherwise
+ */
+int32_t mqtt_flush(struct mqtt_desc *desc)
+{
+	if (!desc)
+		return FAILURE;
+
+	mqtt_select(desc);
+
+	return mqtt_send_queue(desc);
+}
@@ -201,6 +201,8 @@ struct mqtt_message_data {
 	struct mqtt_message	message;
 	/** Topic */
 	uint8_t			*topic;
+	/** \ref mqtt_init_param.message_handler_ctx of the client */
+	void			*ctx;
 };
 
 /**
@@ -232,6 +234,25 @@ struct mqtt_init_param {
 	 * @param Message received from the broker.
 	 */
 	void			(*message_handler)(struct mqtt_message_data *);
+	/** Passed to message_handler in \ref mqtt_message_data.ctx */
+	void			*message_handler_ctx;
+	/**
+	 * Optional buffer where QoS0 publish packets are queued and sent
+	 * together in one socket write. The queue is sent when it is full,
+	 * by \ref mqtt_flush and before any other MQTT operation.
+	 */
+	uint8_t			*publish_queue;
+	/** Size of publish_queue */
+	uint32_t		publish_queue_size;
+	/**
+	 * Optional. Block until data is available on the socket or timeout_ms
+	 * elapses, for example sleeping until the network interrupt. If NULL,
+	 * socket_wait() is used, or the socket is polled if the network
+	 * interface can't wait on it.
+	 */
+	int32_t			(*wait_data)(void *ctx, uint32_t timeout_ms);
+	/** Parameter for wait_data */
+	void			*wait_ctx;
 };
 
 /**
@@ -267,5 +288,7 @@ int32_t mqtt_subscribe(struct mqtt_desc *desc, const int8_t *topic,
 int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic);
 /* Allow messages to be received */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms);
+/* Send the queued QoS0 publish messages */
+int32_t mqtt_flush(struct mqtt_desc *desc);
 
 #endif
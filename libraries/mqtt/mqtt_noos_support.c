@@ -44,27 +44,45 @@
 #include "mqtt_noos_support.h"
 #include <stdlib.h>
 #include "timer.h"
+#include "delay.h"
 #include "error.h"
 #include "util.h"
-#include "delay.h"
 #include "error.h"
 
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/* Hardware timer shared by the clients using the same timer id */
+struct mqtt_timer {
+	/* Timer id */
+	uint32_t		id;
+	/* Timer reference, NULL if the entry is unused */
+	struct timer_desc	*timer;
+	/* Number of clients using the timer */
+	uint32_t		nb_references;
+};
+
 /******************************************************************************/
 /**************************** Global Variables ********************************/
 /******************************************************************************/
 
-/* Timer reference used by the functions */
-static struct timer_desc	*timer;
+/* Timers used by the clients */
+static struct mqtt_timer	timers[MQTT_MAX_TIMERS];
 
-/* Number of timer references */
-static uint32_t			nb_references;
+/*
+ * Timer of the client being executed. Paho doesn't pass the client to the
+ * timer functions, so TimerInit links each countdown to this timer.
+ */
+static struct timer_desc	*current_timer;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
-/* Allcoate resources for timer. Must be called from mqqt_init */
-int32_t mqtt_timer_init(uint32_t timer_id, void *extra_init_param)
+/* Get the millisecond timer with timer_id. Must be called from mqtt_init */
+int32_t mqtt_timer_init(struct timer_desc **timer, uint32_t timer_id,
+			void *extra_init_param)
 {
 	struct timer_init_param init_param = {
 		.id = timer_id,
@@ -72,55 +90,86 @@ int32_t mqtt_timer_init(uint32_t timer_id, void *extra_init_param)
 		.load_value = 0,
 		.extra = extra_init_param
 	};
+	struct mqtt_timer	*entry;
 	int32_t			ret;
+	uint32_t		i;
+
+	entry = NULL;
+	for (i = 0; i < MQTT_MAX_TIMERS; i++) {
+		if (timers[i].timer && timers[i].id == timer_id) {
+			timers[i].nb_references++;
+			*timer = timers[i].timer;
+			return SUCCESS;
+		}
+		if (!timers[i].timer && !entry)
+			entry = &timers[i];
+	}
+	if (!entry)
+		return FAILURE;
 
-	ret = timer_init(&timer, &init_param);
+	ret = timer_init(&entry->timer, &init_param);
 	if (IS_ERR_VALUE(ret)) {
-		timer = NULL;
+		entry->timer = NULL;
 		return FAILURE;
 	}
 
-	ret = timer_start(timer);
+	ret = timer_start(entry->timer);
 	if (IS_ERR_VALUE(ret)) {
-		timer_remove(timer);
-		timer = NULL;
+		timer_remove(entry->timer);
+		entry->timer = NULL;
 		return FAILURE;
 	}
 
-	nb_references++;
+	entry->id = timer_id;
+	entry->nb_references = 1;
+	*timer = entry->timer;
 
 	return SUCCESS;
 }
 
-
-/* Remove resources allocated with \ref mqtt_timere_init. */
-void mqtt_timer_remove()
+/* Release a timer got with \ref mqtt_timer_init. */
+void mqtt_timer_remove(struct timer_desc *timer)
 {
-	nb_references--;
-	if (!nb_references) {
-		timer_remove(timer);
-		timer = NULL;
+	uint32_t i;
+
+	for (i = 0; i < MQTT_MAX_TIMERS; i++) {
+		if (timers[i].timer != timer)
+			continue;
+		if (!--timers[i].nb_references) {
+			timer_remove(timers[i].timer);
+			timers[i].timer = NULL;
+		}
+		break;
 	}
+	if (current_timer == timer)
+		current_timer = NULL;
+}
+
+/* Set the timer used by the countdowns initialized from now on */
+void mqtt_timer_select(struct timer_desc *timer)
+{
+	current_timer = timer;
 }
 
 /* Implementation of TimerInit used by MQTTClient.c */
 void TimerInit(Timer* t)
 {
-	UNUSED_PARAM(t);
-	/* Do nothing */
+	t->timer = current_timer;
+	t->start_time = 0;
+	t->ms = 0;
 }
 
 /* Implementation of TimerCountdownMS used by MQTTClient.c */
 void TimerCountdownMS(Timer* t, unsigned int ms)
 {
-	timer_counter_get(timer, &t->start_time);
+	timer_counter_get(t->timer, &t->start_time);
 	t->ms = ms;
 }
 
 /* Implementation of TimerCountdown used by MQTTClient.c */
 void TimerCountdown(Timer* t, unsigned int seconds)
 {
-	timer_counter_get(timer, &t->start_time);
+	timer_counter_get(t->timer, &t->start_time);
 	t->ms = seconds * 1000;
 }
 
@@ -129,7 +178,7 @@ int TimerLeftMS(Timer* t)
 {
 	uint32_t ms;
 
-	timer_counter_get(timer, &ms);
+	timer_counter_get(t->timer, &ms);
 	ms -= t->start_time;
 
 	if (ms > t->ms)
@@ -147,33 +196,49 @@ char TimerIsExpired(Timer* t)
 	return false;
 }
 
-/* Implementation of mqtt_noos_read used by MQTTClient.c */
+/*
+ * Implementation of mqtt_noos_read used by MQTTClient.c
+ * Returns as soon as len bytes are read. Between reads it blocks in
+ * Network.wait_data if available, else in socket_wait(). If the socket can't
+ * wait either, it polls every millisecond.
+ */
 int mqtt_noos_read(Network* net, unsigned char* buff, int len, int timeout)
 {
-	uint32_t	sent;
+	Timer		timer;
+	uint32_t	received;
 	int32_t		rc;
 
 	if (!len)
 		return 0;
 
-	sent = 0;
+	TimerInit(&timer);
+	TimerCountdownMS(&timer, timeout);
+	received = 0;
 	do {
- 		rc = socket_recv(net->sock, (void *)(buff + sent),
-				(uint32_t)(len - sent));
- 		if (rc != -EAGAIN) { //If data available or error
- 			if (IS_ERR_VALUE(rc))
- 				return rc;
-				 
- 			sent += rc;
- 			if (sent >= len)
- 				return sent;
- 		}
-
-		mdelay(1);
-	} while (--timeout);
-
-	/* 0 bytes have been read */
-	return 0;
+		rc = socket_recv(net->sock, (void *)(buff + received),
+				 (uint32_t)(len - received));
+		if (rc != -EAGAIN) { //If data available or error
+			if (IS_ERR_VALUE(rc))
+				return rc;
+
+			received += rc;
+			if (received >= (uint32_t)len)
+				return received;
+			continue;
+		}
+
+		if (net->wait_data)
+			rc = net->wait_data(net->wait_ctx, TimerLeftMS(&timer));
+		else
+			rc = socket_wait(net->sock, TimerLeftMS(&timer));
+		if (rc == -ENOSYS)
+			/* No way to wait for data, poll once per millisecond */
+			mdelay(1);
+		else if (IS_ERR_VALUE(rc))
+			return rc;
+	} while (!TimerIsExpired(&timer));
+
+	return received;
 }
 
 /* Implementation of mqtt_noos_write used by MQTTClient.c */
@@ -46,6 +46,14 @@
 
 #include <stdint.h>
 #include "tcp_socket.h"
+#include "timer.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of different hardware timers used by MQTT clients */
+#define MQTT_MAX_TIMERS		4
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -62,6 +70,8 @@ typedef struct network_port_noos	Network;
  * @brief Timer structure used by MQTTClient.
  */
 struct timer_port_noos {
+	/** Millisecond timer of the client that owns this countdown */
+	struct timer_desc	*timer;
 	/** Time when the countdown is started */
 	uint32_t	start_time;
 	/** Time when the countdown value */
@@ -80,16 +90,27 @@ struct network_port_noos {
 	/** Reference to no-os network wrapper write function */
 	int			(*mqttwrite)(Network*, unsigned char*, int,
 					     int);
+	/**
+	 * Optional. Block until data is available on the socket or timeout_ms
+	 * elapses. If NULL, socket_wait() is used, or the socket is polled
+	 * until the read timeout if the network interface can't wait on it.
+	 */
+	int32_t			(*wait_data)(void *ctx, uint32_t timeout_ms);
+	/** Parameter for wait_data */
+	void			*wait_ctx;
 };
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
-/* Init porting file */
-int32_t mqtt_timer_init(uint32_t timer_id, void *extra_init_param);
-/* Uninit porting file */
-void mqtt_timer_remove();
+/* Get the millisecond timer with timer_id, shared by clients using it */
+int32_t mqtt_timer_init(struct timer_desc **timer, uint32_t timer_id,
+			void *extra_init_param);
+/* Release a timer got with mqtt_timer_init */
+void mqtt_timer_remove(struct timer_desc *timer);
+/* Set the timer used by the countdowns initialized from now on */
+void mqtt_timer_select(struct timer_desc *timer);
 
 /* Function to be linked to Network.mqttread */
 int mqtt_noos_read(Network*, unsigned char*, int, int);
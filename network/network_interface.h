@@ -218,6 +218,22 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Wait until the socket has data to read or a connection to
+	 * accept.
+	 *
+	 * Optional, may be NULL.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param timeout_ms - Maximum time to wait
+	 * @return
+	 *  - Positive value : The socket is ready
+	 *  - 0 : On timeout
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_wait)(void *net, uint32_t sock_id,
+			       uint32_t timeout_ms);
 };
 
 #endif
@@ -92,6 +92,22 @@
  */
 #define MAX_CONTENT_LEN 2500
 
+/*
+ * Resume sessions with RFC 5077 session tickets when the server supports
+ * them. Session id resumption is always available. Both skip the
+ * certificate exchange and key agreement on reconnect.
+ */
+#define ENABLE_SESSION_TICKETS
+
+/*
+ * Allow negotiating the maximum fragment length (RFC 6066) through
+ * secure_init_param.max_frag_len. If MAX_OUT_CONTENT_LEN is also defined,
+ * the outgoing record buffer is reduced to it. It should be the
+ * max_frag_len used by the sockets.
+ */
+//#define ENABLE_MAX_FRAGMENT_LENGTH
+//#define MAX_OUT_CONTENT_LEN 1024
+
 /*
  * ENABLE_MEMORY_OPTIMIZATIONS should be defined in the case memory
  * is not enough. This could happen is using both a secure connection with
@@ -130,6 +146,17 @@
 #define MBEDTLS_SSL_MAX_CONTENT_LEN	MAX_CONTENT_LEN
 #endif
 
+#ifdef ENABLE_SESSION_TICKETS
+#define MBEDTLS_SSL_SESSION_TICKETS
+#endif
+
+#ifdef ENABLE_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#ifdef MAX_OUT_CONTENT_LEN
+#define MBEDTLS_SSL_OUT_CONTENT_LEN	MAX_OUT_CONTENT_LEN
+#endif
+#endif /* ENABLE_MAX_FRAGMENT_LENGTH */
+
 #ifdef ENABLE_TLS1_2
 
 #define MBEDTLS_SSL_PROTO_TLS1_2
@@ -43,6 +43,7 @@
 /******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "error.h"
 #include "tcp_socket.h"
 #include "util.h"
@@ -69,6 +70,14 @@
 #define DEFAULT_CONNECTION_BUFFER_SIZE 16384
 #endif /* MAX_CONTENT_LEN */
 
+/* Number of peers for which the last TLS session is kept */
+#ifndef TLS_SESSION_CACHE_SIZE
+#define TLS_SESSION_CACHE_SIZE		2
+#endif
+
+/* Longest peer address for which a session can be cached */
+#define TLS_SESSION_MAX_ADDR_LEN	64
+
 #endif /* DISABLE_SECURE_SOCKET */
 
 /******************************************************************************/
@@ -77,23 +86,59 @@
 
 #ifndef DISABLE_SECURE_SOCKET
 /**
- * @struct secure_socket_desc
- * @brief Fields used by secure socket
+ * @struct secure_shared_desc
+ * @brief Read-only TLS state shared by sockets with the same init param
  */
-struct secure_socket_desc {
+struct secure_shared_desc {
+	/** Next shared descriptor */
+	struct secure_shared_desc	*next;
+	/** Number of sockets using it */
+	uint32_t			refs;
+	/** Parameters it was initialized with */
+	struct secure_init_param	param;
 	/** True random number generator reference */
-	struct trng_desc	*trng;
+	struct trng_desc		*trng;
 	/* Mbed structures */
 	/** CA certificate */
-	mbedtls_x509_crt	cacert;
+	mbedtls_x509_crt		cacert;
 	/** Client certificate */
-	mbedtls_x509_crt	clicert;
+	mbedtls_x509_crt		clicert;
 	/** Client private key */
-	mbedtls_pk_context	pkey;
+	mbedtls_pk_context		pkey;
 	/** SSL configuration structure */
-	mbedtls_ssl_config	conf;
+	mbedtls_ssl_config		conf;
+};
+
+/**
+ * @struct secure_socket_desc
+ * @brief Fields used by secure socket
+ */
+struct secure_socket_desc {
+	/** Shared configuration */
+	struct secure_shared_desc	*shared;
 	/** Mbedtls tls context */
-	mbedtls_ssl_context	ssl;
+	mbedtls_ssl_context		ssl;
+	/** Set after the first handshake, the context must be reset */
+	bool				used;
+};
+
+/**
+ * @struct tls_session_entry
+ * @brief Last session negotiated with a peer
+ */
+struct tls_session_entry {
+	/** Set if the entry holds a session */
+	bool			valid;
+	/** Peer address */
+	char			addr[TLS_SESSION_MAX_ADDR_LEN];
+	/** Peer port */
+	uint16_t		port;
+	/** Configuration the session was negotiated with */
+	mbedtls_ssl_config	*conf;
+	/** Last time the entry was used */
+	uint32_t		last_use;
+	/** Session data: session id or ticket and master secret */
+	mbedtls_ssl_session	session;
 };
 #endif /* DISABLE_SECURE_SOCKET */
 
@@ -114,6 +159,16 @@ struct tcp_socket_desc {
 /******************************************************************************/
 
 #ifndef DISABLE_SECURE_SOCKET
+
+/* List of shared secure descriptors */
+static struct secure_shared_desc *shared_list;
+
+/* Sessions of the last contacted peers */
+static struct tls_session_entry session_cache[TLS_SESSION_CACHE_SIZE];
+
+/* Incremented on each session cache access */
+static uint32_t session_tick;
+
 /* Wrapper over socket_recv */
 static int tls_net_recv(struct tcp_socket_desc *sock, unsigned char *buff,
 			size_t len)
@@ -134,9 +189,147 @@ static int tls_net_send(struct tcp_socket_desc *sock, unsigned char *buff,
 	return sock->net->socket_send(sock->net->net, sock->id, buff, len);
 }
 
-/* Remove secure descriptor*/
-static void stcp_socket_remove(struct secure_socket_desc *desc)
+/* Find the cache entry for a peer. Return NULL if not found */
+static struct tls_session_entry *session_find(mbedtls_ssl_config *conf,
+		struct socket_address *addr)
+{
+	uint32_t i;
+
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++)
+		if (session_cache[i].valid &&
+		    session_cache[i].conf == conf &&
+		    session_cache[i].port == addr->port &&
+		    !strcmp(session_cache[i].addr, addr->addr))
+			return &session_cache[i];
+
+	return NULL;
+}
+
+/* Invalidate a cache entry */
+static void session_drop(struct tls_session_entry *entry)
+{
+	if (!entry->valid)
+		return ;
+
+	mbedtls_ssl_session_free(&entry->session);
+	entry->valid = false;
+}
+
+/* Save the session negotiated with a peer, replacing the least used entry */
+static void session_save(struct secure_socket_desc *desc,
+			 struct socket_address *addr)
+{
+	struct tls_session_entry	*entry;
+	uint32_t			i;
+
+	if (strlen(addr->addr) >= TLS_SESSION_MAX_ADDR_LEN)
+		return ;
+
+	entry = session_find(&desc->shared->conf, addr);
+	if (!entry) {
+		entry = &session_cache[0];
+		for (i = 1; i < TLS_SESSION_CACHE_SIZE; i++) {
+			if (!entry->valid)
+				break;
+			if (!session_cache[i].valid ||
+			    session_cache[i].last_use < entry->last_use)
+				entry = &session_cache[i];
+		}
+	}
+
+	session_drop(entry);
+	mbedtls_ssl_session_init(&entry->session);
+	if (mbedtls_ssl_get_session(&desc->ssl, &entry->session) != 0) {
+		mbedtls_ssl_session_free(&entry->session);
+		return ;
+	}
+
+	strcpy(entry->addr, addr->addr);
+	entry->port = addr->port;
+	entry->conf = &desc->shared->conf;
+	entry->last_use = ++session_tick;
+	entry->valid = true;
+}
+
+/* Drop the sessions negotiated with a configuration */
+static void session_drop_conf(mbedtls_ssl_config *conf)
+{
+	uint32_t i;
+
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++)
+		if (session_cache[i].conf == conf)
+			session_drop(&session_cache[i]);
+}
+
+/**
+ * @brief Drop all cached TLS sessions. Following connections will do a full
+ * handshake.
+ */
+void socket_clear_sessions(void)
 {
+	uint32_t i;
+
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++)
+		session_drop(&session_cache[i]);
+}
+
+/* Set the maximum fragment length extension */
+static int32_t stcp_set_max_frag_len(mbedtls_ssl_config *conf, uint32_t len)
+{
+#ifdef MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+	unsigned char code;
+
+	switch (len) {
+	case 512:
+		code = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+		break;
+	case 1024:
+		code = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+		break;
+	case 2048:
+		code = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+		break;
+	case 4096:
+		code = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return mbedtls_ssl_conf_max_frag_len(conf, code);
+#else
+	return -ENOSYS;
+#endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
+}
+
+/* Check if two parameters result in the same shared descriptor */
+static bool stcp_param_equal(struct secure_init_param *a,
+			     struct secure_init_param *b)
+{
+	return a->trng_init_param == b->trng_init_param &&
+	       a->ca_cert == b->ca_cert && a->ca_cert_len == b->ca_cert_len &&
+	       a->cli_cert == b->cli_cert &&
+	       a->cli_cert_len == b->cli_cert_len &&
+	       a->cli_pk == b->cli_pk && a->cli_pk_len == b->cli_pk_len &&
+	       a->max_frag_len == b->max_frag_len &&
+	       a->disable_resumption == b->disable_resumption;
+}
+
+/* Release a reference to a shared descriptor and free it if unused */
+static void stcp_shared_put(struct secure_shared_desc *desc)
+{
+	struct secure_shared_desc **it;
+
+	if (desc->refs && --desc->refs)
+		return ;
+
+	for (it = &shared_list; *it; it = &(*it)->next)
+		if (*it == desc) {
+			*it = desc->next;
+			break;
+		}
+
+	session_drop_conf(&desc->conf);
 	mbedtls_pk_free(&desc->pkey);
 	mbedtls_x509_crt_free(&desc->clicert);
 	mbedtls_x509_crt_free(&desc->cacert);
@@ -147,21 +340,27 @@ static void stcp_socket_remove(struct secure_socket_desc *desc)
 	free(desc);
 }
 
-/* Init secure descriptor */
-static int32_t stcp_socket_init(struct secure_socket_desc **desc,
-				struct tcp_socket_desc *sock,
-				struct secure_init_param *param)
+/* Get a shared descriptor for the parameters, creating it if needed */
+static int32_t stcp_shared_get(struct secure_shared_desc **desc,
+			       struct secure_init_param *param)
 {
-	struct secure_socket_desc	*ldesc;
+	struct secure_shared_desc	*ldesc;
 	int32_t				ret;
 
-	if (!desc || !param)
-		return FAILURE;
+	for (ldesc = shared_list; ldesc; ldesc = ldesc->next)
+		if (stcp_param_equal(&ldesc->param, param)) {
+			ldesc->refs++;
+			*desc = ldesc;
+
+			return SUCCESS;
+		}
 
 	ldesc = (typeof(ldesc))calloc(1, sizeof(*ldesc));
 	if (!ldesc)
 		return FAILURE;
 
+	ldesc->param = *param;
+
 	/* Initialize structures */
 	mbedtls_ssl_config_init(&ldesc->conf);
 	mbedtls_x509_crt_init(&ldesc->cacert);
@@ -229,14 +428,73 @@ static int32_t stcp_socket_init(struct secure_socket_desc **desc,
 			goto exit;
 	}
 
+	if (param->max_frag_len) {
+		ret = stcp_set_max_frag_len(&ldesc->conf, param->max_frag_len);
+		if (IS_ERR_VALUE(ret))
+			goto exit;
+	}
+
+#ifdef MBEDTLS_SSL_SESSION_TICKETS
+	mbedtls_ssl_conf_session_tickets(&ldesc->conf,
+					 param->disable_resumption ?
+					 MBEDTLS_SSL_SESSION_TICKETS_DISABLED :
+					 MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
 	/* Config Random number generator */
 	mbedtls_ssl_conf_rng(&ldesc->conf,
 			     (int (*)(void *, unsigned char *, size_t))
 			     trng_fill_buffer,
 			     (void *)ldesc->trng);
 
+	ldesc->refs = 1;
+	ldesc->next = shared_list;
+	shared_list = ldesc;
+	*desc = ldesc;
+
+	return SUCCESS;
+
+exit:
+	stcp_shared_put(ldesc);
+
+	return ret;
+}
+
+/* Remove secure descriptor*/
+static void stcp_socket_remove(struct secure_socket_desc *desc)
+{
+	mbedtls_ssl_free(&desc->ssl);
+	if (desc->shared)
+		stcp_shared_put(desc->shared);
+
+	free(desc);
+}
+
+/* Init secure descriptor */
+static int32_t stcp_socket_init(struct secure_socket_desc **desc,
+				struct tcp_socket_desc *sock,
+				struct secure_init_param *param)
+{
+	struct secure_socket_desc	*ldesc;
+	int32_t				ret;
+
+	if (!desc || !param)
+		return FAILURE;
+
+	ldesc = (typeof(ldesc))calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return FAILURE;
+
+	mbedtls_ssl_init(&ldesc->ssl);
+
+	ret = stcp_shared_get(&ldesc->shared, param);
+	if (IS_ERR_VALUE(ret)) {
+		ldesc->shared = NULL;
+		goto exit;
+	}
+
 	/* Set the resulting protocol configuration */
-	ret = mbedtls_ssl_setup(&ldesc->ssl, &ldesc->conf);
+	ret = mbedtls_ssl_setup(&ldesc->ssl, &ldesc->shared->conf);
 	if (IS_ERR_VALUE(ret))
 		goto exit;
 
@@ -254,6 +512,46 @@ exit:
 
 	return ret;
 }
+
+/* Do the TLS handshake, resuming the last session with the peer if any */
+static int32_t stcp_socket_handshake(struct secure_socket_desc *desc,
+				     struct socket_address *addr)
+{
+	struct tls_session_entry	*entry;
+	int32_t				ret;
+
+	if (desc->used) {
+		ret = mbedtls_ssl_session_reset(&desc->ssl);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+	}
+	desc->used = true;
+
+	entry = NULL;
+	if (!desc->shared->param.disable_resumption) {
+		entry = session_find(&desc->shared->conf, addr);
+		if (entry) {
+			entry->last_use = ++session_tick;
+			if (mbedtls_ssl_set_session(&desc->ssl,
+						    &entry->session) != 0)
+				entry = NULL;
+		}
+	}
+
+	do {
+		ret = mbedtls_ssl_handshake(&desc->ssl);
+	} while (ret == MBEDTLS_ERR_SSL_WANT_READ);
+	if (IS_ERR_VALUE(ret)) {
+		if (entry)
+			session_drop(entry);
+		return ret;
+	}
+
+	if (!desc->shared->param.disable_resumption)
+		session_save(desc, addr);
+
+	return SUCCESS;
+}
 #endif /* DISABLE_SECURE_SOCKET */
 
 /**
@@ -353,9 +651,7 @@ int32_t socket_connect(struct tcp_socket_desc *desc,
 
 #ifndef DISABLE_SECURE_SOCKET
 	if (desc->secure) {
-		do {
-			ret = mbedtls_ssl_handshake(&desc->secure->ssl);
-		} while (ret == MBEDTLS_ERR_SSL_WANT_READ);
+		ret = stcp_socket_handshake(desc->secure, addr);
 		if (IS_ERR_VALUE(ret))
 			return ret;
 	}
@@ -466,3 +762,16 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return SUCCESS;
 }
 
+/**
+ * @brief See \ref network_interface.socket_wait
+ *
+ * Returns -ENOSYS if the network interface can't wait on a socket.
+ */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms)
+{
+	if (!desc->net->socket_wait)
+		return -ENOSYS;
+
+	return desc->net->socket_wait(desc->net->net, desc->id, timeout_ms);
+}
+
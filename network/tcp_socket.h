@@ -47,6 +47,7 @@
 
 #include "network_interface.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -67,6 +68,10 @@ struct tcp_socket_desc;
 /**
  * @struct stcp_socket_init_param
  * @brief Parameter to initialize a TCP Socket
+ *
+ * Sockets initialized with identical secure parameters share the same TLS
+ * configuration, parsed certificates and random number generator. The
+ * referenced memory must stay valid until all of these sockets are removed.
  */
 struct secure_init_param {
 	/** Init param for true random number generator */
@@ -94,6 +99,19 @@ struct secure_init_param {
 	uint8_t			*cli_pk;
 	/** cli_pk length */
 	uint32_t		cli_pk_len;
+	/**
+	 * Maximum fragment length to negotiate with the server: 512, 1024,
+	 * 2048 or 4096 bytes. Needs ENABLE_MAX_FRAGMENT_LENGTH from
+	 * noos_mbedtls_config.h. The server may refuse it, so the socket
+	 * buffer is not reduced: set max_buff_size to size it.
+	 * 0 to not negotiate it.
+	 */
+	uint32_t		max_frag_len;
+	/**
+	 * Don't resume previous sessions with the same peer. A full handshake
+	 * is done on every connect.
+	 */
+	bool			disable_resumption;
 };
 
 #endif /* DISABLE_SECURE_SOCKET */
@@ -155,4 +173,12 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Socket wait */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms);
+
+#ifndef DISABLE_SECURE_SOCKET
+/* Drop all cached TLS sessions */
+void socket_clear_sessions(void);
+#endif /* DISABLE_SECURE_SOCKET */
+
 #endif
@@ -71,6 +71,12 @@
 #define PUI8(X)			((uint8_t *)(X))
 /* Timeout waiting for module response. (20 seconds) */
 #define MODULE_TIMEOUT		20000
+/* Bytes taken from a ring-buffered UART in one read */
+#define AT_RX_CHUNK		256u
+/* Pause before "+++" so it is not merged with transparent data */
+#define AT_TRANSPARENT_GUARD_MS	20u
+/* Time to wait after "+++" before sending a new AT command */
+#define AT_TRANSPARENT_EXIT_MS	1000u
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -96,7 +102,7 @@ static const struct cmd_desc g_map[] = {
 	{{PUI8("+CWLIF"), 6}, AT_EXECUTE_OP},
 	{{PUI8("+CIPSTATUS"), 10}, AT_EXECUTE_OP},
 	{{PUI8("+CIPSTART"), 9}, AT_TEST_OP | AT_SET_OP},
-	{{PUI8("+CIPSEND"), 8}, AT_SET_OP},
+	{{PUI8("+CIPSEND"), 8}, AT_SET_OP | AT_EXECUTE_OP},
 	{{PUI8("+CIPCLOSE"), 9}, AT_EXECUTE_OP | AT_SET_OP},
 	{{PUI8("+CIFSR"), 6}, AT_EXECUTE_OP},
 	{{PUI8("+CIPMUX"), 7}, AT_QUERY_OP | AT_SET_OP},
@@ -127,6 +133,8 @@ struct at_desc {
 	struct irq_ctrl_desc	*irq_desc;
 	/* Uart irq id */
 	uint32_t		uart_irq_id;
+	/* The UART buffers the received data and signals READ_DONE */
+	bool			uart_rx_ring;
 
 	/* - Connection related fields */
 	/* Structures storing connections status */
@@ -135,6 +143,8 @@ struct at_desc {
 	int32_t			current_conn;
 	/* Stores if running as single or multiple connection mode */
 	bool			multiple_conections;
+	/* The '>' prompt starts the transparent transmission */
+	volatile bool		transparent;
 
 	/* - Data fields */
 	/* Static allocated buffers */
@@ -142,6 +152,7 @@ struct at_desc {
 		uint8_t	result_buff[RESULT_BUFF_LEN];
 		uint8_t	app_result_buff[RESULT_BUFF_LEN];
 		uint8_t	cmd_buff[CMD_BUFF_LEN];
+		uint8_t	rx_buff[AT_RX_CHUNK];
 	} 			buffers;
 	/* Stores data received from the module */
 	volatile struct at_buff	result;
@@ -164,7 +175,9 @@ struct at_desc {
 		/* Used when a reset command have been sent */
 		RESETTING_MODULE,
 		/* Used when using AT_SEND to wait for the character '>' */
-		WAITING_SEND
+		WAITING_SEND,
+		/* Transparent transmission. Everything received is payload */
+		TRANSPARENT
 
 	}			callback_operation;
 	/* Indexes in the ready message */
@@ -173,6 +186,12 @@ struct at_desc {
 	uint8_t			async_idx[NB_ASYNC_MESSAGES];
 	/* Indexes in the response given by the driver */
 	uint8_t			resp_idx[NB_RESPONSE_MESSAGES];
+	/* Set by the callback when the command response is received */
+	volatile enum {
+		RESP_NONE,
+		RESP_OK,
+		RESP_ERROR
+	}			response;
 	/* Ipd idx */
 	uint8_t			ipd_idx;
 	/* State of ipd command message */
@@ -365,17 +384,13 @@ static inline void end_conn_read(struct at_desc *desc)
 	cb_end_async_write(conn->cbuff);
 }
 
-/* Start new read operation */
-static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
+/* Notify the application about a connection receiving its first payload */
+static inline void open_conn(struct at_desc *desc)
 {
 	struct connection_desc	*conn;
-	uint8_t			*buff;
-	uint32_t		available_len;
-	uint32_t		ret;
 
 	conn = &desc->conn[desc->current_conn];
-
-	if (is_new_message && !conn->active) {
+	if (!conn->active) {
 		/*
 		 * Notify that a new connection has started. Application needs
 		 * to set a cbuff for the connection where data will be written.
@@ -393,6 +408,20 @@ static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
 		 * uart_write_nonblocking
 		 */
 	}
+}
+
+/* Start new read operation */
+static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
+{
+	struct connection_desc	*conn;
+	uint8_t			*buff;
+	uint32_t		available_len;
+	uint32_t		ret;
+
+	conn = &desc->conn[desc->current_conn];
+
+	if (is_new_message)
+		open_conn(desc);
 
 	if (!conn->cbuff)
 		/* There is no buffer set for this connection */
@@ -416,39 +445,84 @@ dummy_read:
 	conn->to_read -= 1;
 }
 
-/* Handle the uart events */
-static void at_callback(struct at_desc *desc, uint32_t event, uint8_t *data)
+/* Signal the waiting command when its final response has been received */
+static void check_response(struct at_desc *desc, uint8_t ch)
+{
+	const static struct at_buff responses[NB_RESPONSE_MESSAGES] = {
+		{PUI8("\r\nERROR\r\n"), 9},
+		{PUI8("\r\nFAIL\r\n"), 8},
+		{PUI8("\r\nOK\r\n"), 6},
+		{PUI8("\r\nSEND OK\r\n"), 11}
+	};
+	uint32_t	j;
+
+	for (j = 0; j < NB_RESPONSE_MESSAGES; j++)
+		if (match_message(&responses[j], &desc->resp_idx[j], ch))
+			break;
+
+	if (j == NB_RESPONSE_MESSAGES)
+		return;
+
+	/* Remove the response from the result */
+	desc->result.len -= responses[j].len;
+	memset(desc->resp_idx, 0, sizeof(desc->resp_idx));
+	desc->response = (j < 2) ? RESP_ERROR : RESP_OK;
+}
+
+/*
+ * Interpret one char received outside of a payload.
+ * Return true if a payload starts after this char.
+ */
+static bool parse_ch(struct at_desc *desc, uint8_t ch)
 {
 	static const struct at_buff ready_msg = {PUI8("ready\r\n"), 7};
 
+	switch (desc->callback_operation) {
+	case RESETTING_MODULE:
+		if (match_message(&ready_msg, &desc->ready_idx, ch))
+			desc->callback_operation = READING_RESPONSES;
+		break;
+	case WAITING_SEND:
+	case READING_RESPONSES:
+		if (is_payload_message(desc, ch)) {
+			/* New payload received */
+			desc->callback_operation = READING_PAYLOAD;
+			return true;
+		}
+
+		if (ch == '>' && desc->callback_operation == WAITING_SEND) {
+			desc->callback_operation = desc->transparent ?
+						   TRANSPARENT :
+						   READING_RESPONSES;
+		} else if (desc->result.len >= RESULT_BUFF_LEN) {
+			desc->errors |= AT_ERROR_INTERNAL_BUFFER_OVERFLOW;
+			desc->result.len = 0;
+		} else if (!is_async_messages(desc, ch)) {
+			/* Add received character to result buffer */
+			desc->result.buff[desc->result.len++] = ch;
+			check_response(desc, ch);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return false;
+}
+
+/* Handle the uart events */
+static void at_callback(struct at_desc *desc, uint32_t event, uint8_t *data)
+{
 	switch (event) {
 	case READ_DONE:
 		switch (desc->callback_operation) {
 		case RESETTING_MODULE:
-			if (match_message(&ready_msg, &desc->ready_idx,
-					  desc->read_ch))
-				desc->callback_operation = READING_RESPONSES;
-			break;
 		case WAITING_SEND:
 		case READING_RESPONSES:
-			if (is_payload_message(desc, desc->read_ch)) {
-				/* New payload received */
-				desc->callback_operation = READING_PAYLOAD;
+			if (parse_ch(desc, desc->read_ch)) {
 				start_conn_read(desc, true);
 				return ;
 			}
-
-			if (desc->read_ch == '>' && desc->callback_operation ==
-			    WAITING_SEND) {
-				desc->callback_operation = READING_RESPONSES;
-			} else if (desc->result.len >= RESULT_BUFF_LEN) {
-				desc->errors |=
-					AT_ERROR_INTERNAL_BUFFER_OVERFLOW;
-				desc->result.len = 0;
-			} else if (!is_async_messages(desc, desc->read_ch))
-				/* Add received character to result buffer */
-				desc->result.buff[desc->result.len++] =
-					desc->read_ch;
 			break;
 		case READING_PAYLOAD:
 			/* Receiving payload from connection */
@@ -462,6 +536,12 @@ static void at_callback(struct at_desc *desc, uint32_t event, uint8_t *data)
 				return ;
 			}
 			break;
+		case TRANSPARENT:
+			if (desc->conn[0].cbuff &&
+			    IS_ERR_VALUE(cb_write(desc->conn[0].cbuff,
+						  &desc->read_ch, 1)))
+				desc->errors |= AT_ERROR_CONN_BUFFER_OVERRUN;
+			break;
 		}
 		break;
 	case ERROR:
@@ -476,94 +556,158 @@ static void at_callback(struct at_desc *desc, uint32_t event, uint8_t *data)
 	uart_read_nonblocking(desc->uart_desc, &desc->read_ch, 1);
 }
 
-/* Wait the response for the last command for MODULE_TIMEOUT milliseconds */
-static int32_t wait_for_response(struct at_desc *desc)
+/* Interpret a block of received data */
+static void parse_block(struct at_desc *desc, uint8_t *data, uint32_t len)
 {
-	const static struct at_buff responses[NB_RESPONSE_MESSAGES] = {
-		{PUI8("\r\nERROR\r\n"), 9},
-		{PUI8("\r\nFAIL\r\n"), 8},
-		{PUI8("\r\nOK\r\n"), 6},
-		{PUI8("\r\nSEND OK\r\n"), 11}
-	};
-	uint32_t	timeout;
-	uint32_t	result;
-	uint32_t	i;
-	uint32_t	j;
+	struct connection_desc	*conn;
+	uint32_t		n;
 
-	i = 0;
-	timeout = MODULE_TIMEOUT;
-	result = FAILURE;
-	do {
-		if (i < desc->result.len) {
-			for (j = 0; j < NB_RESPONSE_MESSAGES; j++)
-				if (match_message(&responses[j],
-						  &desc->resp_idx[j],
-						  desc->result.buff[i]))
-					break;
-
-			i++;
-			switch (j) {
-			case 0: // \r\nERROR\r\n
-			case 1: // \r\nFAIL\r\n
-				result = FAILURE;
-				goto end;
-			case 2: // \r\nOK\r\n
-			case 3: // \r\nSEND OK\r\n
-				result = SUCCESS;
-				goto end;
-			default:
-				break;
+	while (len) {
+		switch (desc->callback_operation) {
+		case TRANSPARENT:
+			/* Everything that follows is payload */
+			if (desc->conn[0].cbuff &&
+			    IS_ERR_VALUE(cb_write(desc->conn[0].cbuff,
+						  data, len)))
+				desc->errors |= AT_ERROR_CONN_BUFFER_OVERRUN;
+			return ;
+		case READING_PAYLOAD:
+			/* Copy the payload to the connection buffer */
+			conn = &desc->conn[desc->current_conn];
+			n = min(conn->to_read, len);
+			if (conn->cbuff &&
+			    IS_ERR_VALUE(cb_write(conn->cbuff, data, n)))
+				desc->errors |= AT_ERROR_CONN_BUFFER_OVERRUN;
+			conn->to_read -= n;
+			data += n;
+			len -= n;
+			if (!conn->to_read) {
+				desc->callback_operation = READING_RESPONSES;
+				desc->current_conn = -1;
 			}
+			break;
+		default:
+			if (parse_ch(desc, *data))
+				open_conn(desc);
+			data++;
+			len--;
+			break;
 		}
-		mdelay(1);
-	} while (--timeout);
+	}
+}
+
+/*
+ * Handle the events of a ring-buffered UART. Everything the UART has
+ * received is parsed on each READ_DONE.
+ */
+static void at_ring_callback(void *ctx, uint32_t event, void *extra)
+{
+	struct at_desc	*desc = ctx;
+	int32_t		len;
+
+	if (event == ERROR) {
+		if (desc->callback_operation != RESETTING_MODULE)
+			desc->errors |= AT_ERROR_UART;
+		return ;
+	}
 
-end:
-	if (timeout) //If a response arrived clean the result
-		desc->result.len -= desc->resp_idx[j];
+	do {
+		len = uart_read_nonblocking(desc->uart_desc,
+					    desc->buffers.rx_buff,
+					    AT_RX_CHUNK);
+		if (len <= 0)
+			break;
+		parse_block(desc, desc->buffers.rx_buff, len);
+	} while (len == AT_RX_CHUNK);
+}
+
+/* Conditions signalled by the callback */
+static bool is_response_received(void *ctx)
+{
+	struct at_desc *desc = ctx;
+
+	return desc->response != RESP_NONE;
+}
+
+static bool is_prompt_received(void *ctx)
+{
+	struct at_desc *desc = ctx;
 
+	return desc->callback_operation != WAITING_SEND;
+}
+
+static bool is_module_ready(void *ctx)
+{
+	struct at_desc *desc = ctx;
+
+	return desc->callback_operation != RESETTING_MODULE;
+}
+
+static bool is_wifi_disconnected(void *ctx)
+{
+	struct at_desc *desc = ctx;
+
+	return !desc->is_wifi_connected;
+}
+
+/*
+ * Wait until the callback signals the condition or MODULE_TIMEOUT
+ * milliseconds expire.
+ */
+static int32_t wait_event(struct at_desc *desc, bool (*done)(void *ctx))
+{
+	if (wait_until(done, desc, MODULE_TIMEOUT * 1000u) != SUCCESS)
+		return FAILURE;
+
+	return SUCCESS;
+}
+
+/* Wait the response for the last command for MODULE_TIMEOUT milliseconds */
+static int32_t wait_for_response(struct at_desc *desc)
+{
+	int32_t	ret;
+
+	ret = wait_event(desc, is_response_received);
+	if (ret == SUCCESS && desc->response != RESP_OK)
+		ret = FAILURE;
+	/* Ready for the next response */
+	desc->response = RESP_NONE;
 	memset(desc->resp_idx, 0, sizeof(desc->resp_idx));
 
-	return result;
+	return ret;
 }
 
 /* Send what is in desc->cmd over the UART and handle special case of AT_SEND */
 static int32_t send_cmd(struct at_desc *desc, enum at_cmd cmd,
 			union in_param *in_param)
 {
-	uint32_t timeout = MODULE_TIMEOUT;
-
+	desc->response = RESP_NONE;
+	if (cmd == AT_SEND)
+		desc->callback_operation = WAITING_SEND;
 	uart_write(desc->uart_desc, desc->cmd.buff, desc->cmd.len);
 	if (cmd == AT_SEND) {
-		desc->callback_operation = WAITING_SEND;
 		/* Waiting for ok */
-		if (SUCCESS != wait_for_response(desc))
+		if (SUCCESS != wait_for_response(desc)) {
+			desc->transparent = false;
+			desc->callback_operation = READING_RESPONSES;
 			return FAILURE;
-		/* Wait until '>' is received */
-		while (timeout--) {
-			if (WAITING_SEND != desc->callback_operation)
-				break;
-			mdelay(1);
 		}
-		if (timeout == 0)
+		/* Wait until '>' is received */
+		if (SUCCESS != wait_event(desc, is_prompt_received)) {
+			desc->transparent = false;
+			desc->callback_operation = READING_RESPONSES;
 			return FAILURE;
+		}
+		/* AT_SEND without parameters starts transparent transmission */
+		if (desc->transparent)
+			return SUCCESS;
 		/* Write payload */
 		uart_write(desc->uart_desc, in_param->send_data.data.buff,
 			   in_param->send_data.data.len);
 	} else if (cmd == AT_DISCONNECT_NETWORK) {
-		if (desc->is_wifi_connected) {
+		if (desc->is_wifi_connected)
 			/* Wait for WIFI_DISCONNECT */
-			do {
-				if (desc->is_wifi_connected == 0)
-					break;
-				mdelay(1);
-			} while (timeout--);
-
-			if (timeout == 0)
-				return FAILURE;
-
-			return SUCCESS;
-		}
+			return wait_event(desc, is_wifi_disconnected);
 	}
 
 	/* Wait for OK, SEND OK or ERROR */
@@ -777,6 +921,7 @@ static void build_cmd(struct at_desc *desc, enum at_cmd cmd,
 /* Send ATE0 command to stop echo */
 static int32_t stop_echo(struct at_desc *desc)
 {
+	desc->response = RESP_NONE;
 	uart_write(desc->uart_desc, (uint8_t *)"ATE0\r\n", 6);
 
 	if (SUCCESS != wait_for_response(desc))
@@ -789,23 +934,14 @@ static int32_t stop_echo(struct at_desc *desc)
 /* Handle special cases */
 static int32_t handle_special(struct at_desc *desc, enum at_cmd cmd)
 {
-	uint32_t timeout;
-
 	switch (cmd) {
 	case AT_RESET:
 		desc->callback_operation = RESETTING_MODULE;
 		uart_write(desc->uart_desc, desc->cmd.buff, desc->cmd.len);
-		timeout = MODULE_TIMEOUT;
-		do {
-			/* Wait for "ready" message */
-			if (desc->callback_operation != RESETTING_MODULE)
-				break;
-			mdelay(1);
-		} while (timeout--);
-		if (!timeout)
+		/* Wait for "ready" message */
+		if (SUCCESS != wait_event(desc, is_module_ready))
 			return FAILURE;
 
-		desc->callback_operation = READING_PAYLOAD;
 		desc->result.len = 0;
 		if (SUCCESS != stop_echo(desc))
 			return FAILURE;
@@ -852,14 +988,28 @@ int32_t at_run_cmd(struct at_desc *desc, enum at_cmd cmd, enum cmd_operation op,
 	uint32_t	id;
 	int32_t		ret;
 
-	if (!desc || cmd == AT_SET_TRANSPORT_MODE)
+	if (!desc)
 		return FAILURE;
 
 	if (!(g_map[cmd].type & op))
 		return FAILURE;
 
+	/* Commands would be sent as data */
+	if (desc->callback_operation == TRANSPARENT)
+		return -EBUSY;
+
 	build_cmd(desc, cmd, op, param);
 
+	if (cmd == AT_SEND && op == AT_EXECUTE_OP) {
+		if (desc->multiple_conections)
+			return FAILURE;
+		desc->transparent = true;
+		/* Received data goes to the buffer of connection 0 */
+		desc->current_conn = 0;
+		open_conn(desc);
+		desc->current_conn = -1;
+	}
+
 	if (cmd == AT_DEEP_SLEEP || cmd == AT_RESET)
 		return handle_special(desc, cmd);
 
@@ -895,6 +1045,69 @@ int32_t at_run_cmd(struct at_desc *desc, enum at_cmd cmd, enum cmd_operation op,
 	return SUCCESS;
 }
 
+/**
+ * @brief Write data in transparent transmission mode
+ *
+ * Transparent transmission is started with \ref AT_SEND executed without
+ * parameters, after \ref AT_SET_TRANSPORT_MODE set to UNVARNISHED_MODE in
+ * single connection mode. Data is sent to the module without any framing.
+ * @param desc - AT parser reference
+ * @param data - Data to send
+ * @param len - Number of bytes to send
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - \ref FAILURE : Otherwise
+ */
+int32_t at_transparent_write(struct at_desc *desc, const uint8_t *data,
+			     uint32_t len)
+{
+	if (!desc || !data || desc->callback_operation != TRANSPARENT)
+		return FAILURE;
+
+	return uart_write(desc->uart_desc, data, len);
+}
+
+/**
+ * @brief Leave transparent transmission mode
+ *
+ * Sends "+++" surrounded by the guard times required by the module. The
+ * connection stays open.
+ * @param desc - AT parser reference
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - \ref FAILURE : Otherwise
+ */
+int32_t at_transparent_exit(struct at_desc *desc)
+{
+	if (!desc || desc->callback_operation != TRANSPARENT)
+		return FAILURE;
+
+	/* "+++" must be received as a separate packet */
+	mdelay(AT_TRANSPARENT_GUARD_MS);
+	uart_write(desc->uart_desc, PUI8("+++"), 3);
+	/* Wait before sending the next AT command */
+	mdelay(AT_TRANSPARENT_EXIT_MS);
+
+	desc->transparent = false;
+	desc->callback_operation = READING_RESPONSES;
+	desc->result.len = 0;
+
+	return SUCCESS;
+}
+
+/* Stop receiving the UART events */
+static void at_release_uart(struct at_desc *desc)
+{
+	if (desc->uart_rx_ring) {
+		if (desc->irq_desc)
+			irq_disable(desc->irq_desc, desc->uart_irq_id);
+		desc->uart_desc->callback = NULL;
+		desc->uart_desc->callback_ctx = NULL;
+	} else {
+		irq_unregister(desc->irq_desc, desc->uart_irq_id);
+	}
+}
+
 /**
  * @brief Initialize the AT parser
  * @param desc - Address where to store the AT parser reference used by the
@@ -925,20 +1138,7 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	ldesc->uart_desc = param->uart_desc;
 	ldesc->irq_desc = param->irq_desc;
 	ldesc->uart_irq_id = param->uart_irq_id;
-	callback_desc.callback =
-		(void (*)(void*, uint32_t, void*))at_callback;
-	callback_desc.ctx = ldesc;
-	callback_desc.config = param->uart_irq_conf;
-	if (SUCCESS != irq_register_callback(ldesc->irq_desc,
-					     ldesc->uart_irq_id,
-					     &callback_desc))
-		goto free_desc;
-
-	if (SUCCESS != irq_enable(ldesc->irq_desc, ldesc->uart_irq_id))
-		goto free_irq;
-
-	/* The read will be handled by the callback */
-	uart_read_nonblocking(ldesc->uart_desc, &ldesc->read_ch, 1);
+	ldesc->uart_rx_ring = param->uart_rx_ring;
 
 	/* Link buffer structure with static buffers */
 	ldesc->result.buff = ldesc->buffers.result_buff;
@@ -948,6 +1148,32 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 
 	ldesc->callback_operation = READING_RESPONSES;
 
+	if (ldesc->uart_rx_ring) {
+		/* The UART interrupt is owned by the UART driver */
+		ldesc->uart_desc->callback_ctx = ldesc;
+		ldesc->uart_desc->callback = at_ring_callback;
+		if (ldesc->irq_desc &&
+		    SUCCESS != irq_enable(ldesc->irq_desc, ldesc->uart_irq_id))
+			goto free_irq;
+		/* Parse what was received before the callback was set */
+		at_ring_callback(ldesc, READ_DONE, NULL);
+	} else {
+		callback_desc.callback =
+			(void (*)(void*, uint32_t, void*))at_callback;
+		callback_desc.ctx = ldesc;
+		callback_desc.config = param->uart_irq_conf;
+		if (SUCCESS != irq_register_callback(ldesc->irq_desc,
+						     ldesc->uart_irq_id,
+						     &callback_desc))
+			goto free_desc;
+
+		if (SUCCESS != irq_enable(ldesc->irq_desc, ldesc->uart_irq_id))
+			goto free_irq;
+
+		/* The read will be handled by the callback */
+		uart_read_nonblocking(ldesc->uart_desc, &ldesc->read_ch, 1);
+	}
+
 	/* Disable echoing response */
 	if (SUCCESS != stop_echo(ldesc))
 		goto free_irq;
@@ -973,7 +1199,7 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	return SUCCESS;
 
 free_irq:
-	irq_unregister(ldesc->irq_desc, ldesc->uart_irq_id);
+	at_release_uart(ldesc);
 free_desc:
 	free(ldesc);
 	*desc = NULL;
@@ -992,7 +1218,7 @@ int32_t at_remove(struct at_desc *desc)
 	if (!desc)
 		return FAILURE;
 
-	irq_unregister(desc->irq_desc, desc->uart_irq_id);
+	at_release_uart(desc);
 	free(desc);
 
 	return SUCCESS;
@@ -182,7 +182,9 @@ enum at_cmd {
 	AT_START_CONNECTION,		// "+CIPSTART"
 	/**
 	 * Send data over connection
-	 * Use \ref in_param.send_data as set parameter
+	 * Use \ref in_param.send_data as set parameter.
+	 * Executed without parameters in UNVARNISHED_MODE it starts the
+	 * transparent transmission, see \ref at_transparent_write
 	 */
 	AT_SEND,			// "+CIPSEND"
 	/**
@@ -203,7 +205,7 @@ enum at_cmd {
 	 */
 	AT_SET_SERVER,			// "+CIPSERVER"
 	/**
-	 * Set transport mode: Not supported command.
+	 * Set transport mode. UNVARNISHED_MODE needs SINGLE_CONNECTION.
 	 * Use \ref in_param.transport_mode as set parameter
 	 */
 	AT_SET_TRANSPORT_MODE,		// "+CIPMODE"
@@ -317,6 +319,14 @@ struct at_init_param {
 	struct irq_ctrl_desc	*irq_desc;
 	uint32_t		uart_irq_id;
 	void			*uart_irq_conf;
+	/*
+	 * Set if the UART driver buffers the received data and calls the
+	 * uart_desc callback with READ_DONE (Xilinx and Linux UARTs with a
+	 * receive ring). The parser then reads everything available at once
+	 * and uart_irq_conf is not used. irq_desc may be NULL if the UART
+	 * events are always enabled.
+	 */
+	bool			uart_rx_ring;
 	/* Context that will be passed to the callback */
 	void			*callback_ctx;
 	/*
@@ -349,6 +359,11 @@ int32_t at_remove(struct at_desc *desc);
 /* Execute an AT command */
 int32_t at_run_cmd(struct at_desc *desc, enum at_cmd cmd, enum cmd_operation op,
 		   union in_out_param *param);
+/* Write data in transparent transmission mode */
+int32_t at_transparent_write(struct at_desc *desc, const uint8_t *data,
+			     uint32_t len);
+/* Leave transparent transmission mode */
+int32_t at_transparent_exit(struct at_desc *desc);
 /* Convert null terminated string to at_buff */
 int32_t str_to_at(struct at_buff *dest, const uint8_t *src);
 /* Convert at_buff to null terminated string */
@@ -71,6 +71,8 @@ struct socket_desc {
 	enum socket_protocol	type;
 	/* Connection id */
 	uint32_t		conn_id;
+	/* Traffic counters */
+	struct wifi_socket_stats	stats;
 	/* States of a socket structure */
 	enum {
 		/* The socket structure is unused */
@@ -109,6 +111,12 @@ struct wifi_desc {
 	struct network_interface	interface;
 	/* Will be used in callback */
 	int32_t				conn_id_to_sock_id[MAX_CONNECTIONS];
+	/* Transparent transmission allowed */
+	bool				transparent_mode;
+	/* Socket using transparent transmission or INVALID_ID */
+	uint32_t			transparent_id;
+	/* Time source for the statistics, may be NULL */
+	uint32_t			(*get_time_ms)(void);
 };
 
 /******************************************************************************/
@@ -316,11 +324,15 @@ int32_t wifi_init(struct wifi_desc **desc, struct wifi_init_param *param)
 	memset(ldesc->conn_id_to_sock_id, (int8_t)INVALID_ID,
 	       sizeof(ldesc->conn_id_to_sock_id));
 	ldesc->server.id = INVALID_ID;
+	ldesc->transparent_id = INVALID_ID;
+	ldesc->transparent_mode = param->transparent_mode;
+	ldesc->get_time_ms = param->get_time_ms;
 
 	at_param.irq_desc = param->irq_desc;
 	at_param.uart_desc = param->uart_desc;
 	at_param.uart_irq_conf = param->uart_irq_conf;
 	at_param.uart_irq_id = param->uart_irq_id;
+	at_param.uart_rx_ring = param->uart_rx_ring;
 	at_param.connection_callback = _wifi_connection_callback;
 	at_param.callback_ctx = ldesc;
 
@@ -466,6 +478,26 @@ int32_t wifi_get_ip(struct wifi_desc *desc, char *ip_buff, uint32_t buff_size)
 	return SUCCESS;
 }
 
+/**
+ * @brief Get the traffic counters of a socket
+ * @param desc - Wifi descriptor
+ * @param sock_id - Socket id
+ * @param stats - Where to copy the counters
+ * @return
+ *  - \ref SUCCESS : On success
+ *  - \ref -EINVAL : For invalid parameters
+ */
+int32_t wifi_get_socket_stats(struct wifi_desc *desc, uint32_t sock_id,
+			      struct wifi_socket_stats *stats)
+{
+	if (!desc || !stats || sock_id >= NB_SOCKETS)
+		return -EINVAL;
+
+	*stats = desc->sockets[sock_id].stats;
+
+	return SUCCESS;
+}
+
 /** @brief See \ref network_interface.socket_open */
 static int32_t wifi_socket_open(struct wifi_desc *desc, uint32_t *sock_id,
 				enum socket_protocol proto, uint32_t buff_size)
@@ -488,6 +520,7 @@ static int32_t wifi_socket_open(struct wifi_desc *desc, uint32_t *sock_id,
 
 	desc->sockets[id].type = proto;
 	desc->sockets[id].cb_size = buff_size;
+	memset(&desc->sockets[id].stats, 0, sizeof(desc->sockets[id].stats));
 
 	*sock_id = id;
 
@@ -540,6 +573,101 @@ static int32_t wifi_socket_close(struct wifi_desc *desc, uint32_t sock_id)
 	return SUCCESS;
 }
 
+/*
+ * Switch the module between multiple connection and transparent modes.
+ * The module accepts AT+CIPMUX=1 only in normal transport mode, so the
+ * transport mode is changed first when leaving the transparent mode.
+ */
+static int32_t _wifi_set_transparent(struct wifi_desc *desc, bool enable)
+{
+	union in_out_param	param;
+	int32_t			ret;
+
+	if (!enable) {
+		param.in.transport_mode = NORMAL_MODE;
+		ret = at_run_cmd(desc->at, AT_SET_TRANSPORT_MODE, AT_SET_OP,
+				 &param);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	param.in.conn_type = enable ? SINGLE_CONNECTION : MULTIPLE_CONNECTION;
+	ret = at_run_cmd(desc->at, AT_SET_CONNECTION_TYPE, AT_SET_OP, &param);
+	if (IS_ERR_VALUE(ret) || !enable)
+		return ret;
+
+	param.in.transport_mode = UNVARNISHED_MODE;
+	return at_run_cmd(desc->at, AT_SET_TRANSPORT_MODE, AT_SET_OP, &param);
+}
+
+/* Returns true if the socket can be the only, transparent, connection */
+static bool _wifi_can_be_transparent(struct wifi_desc *desc, uint32_t sock_id)
+{
+	uint32_t i;
+
+	if (!desc->transparent_mode || desc->server.id != INVALID_ID ||
+	    desc->sockets[sock_id].type != PROTOCOL_TCP)
+		return false;
+
+	for (i = 0; i < NB_SOCKETS; i++)
+		if (desc->sockets[i].state == SOCKET_CONNECTED)
+			return false;
+
+	return true;
+}
+
+/* Connect in single connection mode and start transparent transmission */
+static int32_t _wifi_transparent_connect(struct wifi_desc *desc,
+		uint32_t sock_id,
+		union in_out_param *param)
+{
+	int32_t ret;
+	int32_t err;
+
+	ret = _wifi_set_transparent(desc, true);
+	if (IS_ERR_VALUE(ret))
+		goto restore;
+
+	ret = at_run_cmd(desc->at, AT_START_CONNECTION, AT_SET_OP, param);
+	if (IS_ERR_VALUE(ret))
+		goto restore;
+
+	ret = at_run_cmd(desc->at, AT_SEND, AT_EXECUTE_OP, NULL);
+	if (IS_ERR_VALUE(ret)) {
+		at_run_cmd(desc->at, AT_STOP_CONNECTION, AT_EXECUTE_OP, NULL);
+		goto restore;
+	}
+
+	desc->transparent_id = sock_id;
+	desc->sockets[sock_id].stats.transparent = true;
+
+	return SUCCESS;
+restore:
+	/* Report if the module is left in single connection mode */
+	err = _wifi_set_transparent(desc, false);
+	if (IS_ERR_VALUE(err))
+		return err;
+
+	return ret;
+}
+
+/* Leave transparent transmission and close the connection */
+static int32_t _wifi_transparent_disconnect(struct wifi_desc *desc)
+{
+	int32_t ret;
+
+	ret = at_transparent_exit(desc->at);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	desc->sockets[desc->transparent_id].stats.transparent = false;
+	desc->transparent_id = INVALID_ID;
+	/* The connection may be already closed by the peer */
+	at_run_cmd(desc->at, AT_STOP_CONNECTION, AT_EXECUTE_OP, NULL);
+
+	return _wifi_set_transparent(desc, false);
+}
+
 /** @brief See \ref network_interface.socket_connect */
 static int32_t wifi_socket_connect(struct wifi_desc *desc, uint32_t sock_id,
 				   struct socket_address *addr)
@@ -559,6 +687,10 @@ static int32_t wifi_socket_connect(struct wifi_desc *desc, uint32_t sock_id,
 	if (sock->state == SOCKET_CONNECTED)
 		return -EISCONN;
 
+	/* Only one connection exists in transparent transmission */
+	if (desc->transparent_id != INVALID_ID)
+		return -EMLINK;
+
 	ret = _wifi_get_unused_conn(desc, sock_id);
 	if (IS_ERR_VALUE(ret))
 		return ret;
@@ -568,6 +700,13 @@ static int32_t wifi_socket_connect(struct wifi_desc *desc, uint32_t sock_id,
 	param.in.connection.id = sock->conn_id;
 	param.in.connection.soket_type = sock->type;
 
+	if (_wifi_can_be_transparent(desc, sock_id) &&
+	    !IS_ERR_VALUE(_wifi_transparent_connect(desc, sock_id, &param))) {
+		sock->state = SOCKET_CONNECTED;
+
+		return SUCCESS;
+	}
+
 	ret = at_run_cmd(desc->at, AT_START_CONNECTION, AT_SET_OP, &param);
 	if (IS_ERR_VALUE(ret)) {
 		_wifi_release_conn(desc, sock_id);
@@ -619,6 +758,11 @@ static int32_t wifi_socket_disconnect(struct wifi_desc *desc, uint32_t sock_id)
 
 		/* Remove server reference */
 		desc->server.id = INVALID_ID;
+	} else if (sock_id == desc->transparent_id) {
+		ret = _wifi_transparent_disconnect(desc);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+		_wifi_release_conn(desc, sock_id);
 	} else {
 		param.in.conn_id = sock->conn_id;
 		ret = at_run_cmd(desc->at, AT_STOP_CONNECTION, AT_SET_OP,
@@ -638,9 +782,10 @@ static int32_t wifi_socket_send(struct wifi_desc *desc, uint32_t sock_id,
 				const void *data, uint32_t size)
 {
 	union in_out_param	param;
-	uint32_t		ret;
+	int32_t			ret;
 	struct socket_desc	*sock;
 	uint32_t		to_send;
+	uint32_t		start;
 	uint32_t		i;
 
 	if (!desc || sock_id >= NB_SOCKETS || desc->server.id == sock_id)
@@ -650,18 +795,40 @@ static int32_t wifi_socket_send(struct wifi_desc *desc, uint32_t sock_id,
 	if (sock->state != SOCKET_CONNECTED)
 		return -ENOTCONN;
 
-	i = 0;
-	do {
-		to_send = min(size - i, MAX_CIPSEND_DATA);
-		param.in.send_data.id = sock->conn_id;
-		param.in.send_data.data.buff = ((uint8_t *)data) + i;
-		param.in.send_data.data.len = to_send;
-		ret = at_run_cmd(desc->at, AT_SEND, AT_SET_OP, &param);
-		if (IS_ERR_VALUE(ret))
-			return ret;
+	start = desc->get_time_ms ? desc->get_time_ms() : 0;
+	if (sock_id == desc->transparent_id) {
+		/* No framing and no handshake, the data is streamed */
+		ret = at_transparent_write(desc->at, data, size);
+		if (!IS_ERR_VALUE(ret))
+			sock->stats.bytes_sent += size;
+	} else {
+		/*
+		 * CIPSEND takes the payload length, so binary data is sent as
+		 * is. Each chunk is counted once its SEND OK is received.
+		 */
+		i = 0;
+		do {
+			to_send = min(size - i, MAX_CIPSEND_DATA);
+			param.in.send_data.id = sock->conn_id;
+			param.in.send_data.data.buff = ((uint8_t *)data) + i;
+			param.in.send_data.data.len = to_send;
+			ret = at_run_cmd(desc->at, AT_SEND, AT_SET_OP,
+					 &param);
+			if (IS_ERR_VALUE(ret))
+				break;
+
+			sock->stats.send_cmds++;
+			sock->stats.bytes_sent += to_send;
+			i += to_send;
+		} while (i < size);
+	}
+	if (desc->get_time_ms)
+		sock->stats.send_time_ms += desc->get_time_ms() - start;
 
-		i += to_send;
-	} while (i < size);
+	if (IS_ERR_VALUE(ret)) {
+		sock->stats.send_errors++;
+		return ret;
+	}
 
 	return (int32_t)size;
 }
@@ -689,6 +856,9 @@ static int32_t wifi_socket_recv(struct wifi_desc *desc, uint32_t sock_id,
 
 	size = min(available_size, size);
 	ret = cb_read(sock->cb, data, size);
+	/* On overrun the data is still consumed from the buffer */
+	if (ret == SUCCESS || ret == -EOVERRUN)
+		sock->stats.bytes_received += size;
 	if (IS_ERR_VALUE(ret))
 		return ret;
 
@@ -764,6 +934,10 @@ static int32_t wifi_socket_listen(struct wifi_desc *desc, uint32_t sock_id,
 	if (desc->server.id == INVALID_ID || sock_id != desc->server.id)
 		return -ENOTCONN;
 
+	/* The module can't run a server in single connection mode */
+	if (desc->transparent_id != INVALID_ID)
+		return -EMLINK;
+
 	server_sock = &desc->sockets[desc->server.id];
 	/* Initialize sockets in order to don't allocate memory in interrupts */
 	i = &desc->server.back_log_clients;
@@ -46,6 +46,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "network_interface.h"
 #include "uart.h"
 #include "irq.h"
@@ -60,6 +61,25 @@
  */
 struct wifi_desc;
 
+/**
+ * @struct wifi_socket_stats
+ * @brief Traffic counters of a socket, for throughput measurements
+ */
+struct wifi_socket_stats {
+	/** Bytes accepted by socket_send */
+	uint64_t	bytes_sent;
+	/** Bytes returned by socket_recv */
+	uint64_t	bytes_received;
+	/** Number of AT send commands issued. 0 in transparent mode */
+	uint32_t	send_cmds;
+	/** Number of failed sends */
+	uint32_t	send_errors;
+	/** Time spent in socket_send in ms. Needs get_time_ms */
+	uint32_t	send_time_ms;
+	/** True if the socket uses the transparent transmission mode */
+	bool		transparent;
+};
+
 /**
  * @struct wifi_init_param
  * @brief Parameter to initialize Wifi
@@ -73,6 +93,17 @@ struct wifi_init_param {
 	uint32_t		uart_irq_id;
 	/** Configuration param for registering uart callback */
 	void			*uart_irq_conf;
+	/** The UART buffers the received data, see \ref at_init_param */
+	bool			uart_rx_ring;
+	/**
+	 * Use the transparent transmission mode of the module for a TCP
+	 * client socket when it is the only connection. While such a socket
+	 * is connected, other sockets can't connect and no server can be
+	 * started.
+	 */
+	bool			transparent_mode;
+	/** Optional millisecond time source used for the socket statistics */
+	uint32_t		(*get_time_ms)(void);
 };
 
 /******************************************************************************/
@@ -93,5 +124,8 @@ int32_t wifi_get_network_interface(struct wifi_desc *desc,
 				   struct network_interface **net);
 /* Wifi get ip interface */
 int32_t wifi_get_ip(struct wifi_desc *desc, char *ip_buff, uint32_t buff_size);
+/* Wifi get the traffic counters of a socket */
+int32_t wifi_get_socket_stats(struct wifi_desc *desc, uint32_t sock_id,
+			      struct wifi_socket_stats *stats);
 
 #endif
@@ -24,6 +24,7 @@ SRCS += $(PLATFORM_DRIVERS)/uart.c					\
 	$(PLATFORM_DRIVERS)/irq.c					\
 	$(NO-OS)/util/xml.c						\
 	$(NO-OS)/util/fifo.c						\
+	$(NO-OS)/util/circular_buffer.c					\
 	$(NO-OS)/iio/iio.c						\
 	$(NO-OS)/iio/iio_ad713x/iio_ad713x.c				\
 	$(NO-OS)/iio/iio_app/iio_app.c
@@ -47,6 +48,7 @@ INCS +=	$(INCLUDE)/axi_io.h						\
 ifeq (y,$(strip $(TINYIIOD)))
 INCS += $(INCLUDE)/xml.h						\
 	$(INCLUDE)/fifo.h						\
+	$(INCLUDE)/circular_buffer.h					\
 	$(NO-OS)/iio/iio.h						\
 	$(NO-OS)/iio/iio_types.h					\
 	$(NO-OS)/iio/iio_ad713x/iio_ad713x.h				\
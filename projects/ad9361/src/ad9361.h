@@ -3160,6 +3160,8 @@ struct ad9361_phy_platform_data {
 	uint8_t			rf_dc_offset_count_low;
 	uint8_t			dig_interface_tune_skipmode;
 	uint8_t			dig_interface_tune_fir_disable;
+	uint8_t			dig_interface_tune_fast_mode;
+	uint32_t		dig_interface_tune_pn_dwell_us;
 	uint8_t			lo_powerdown_managed_en;
 	uint32_t			dcxo_coarse;
 	uint32_t			dcxo_fine;
@@ -3299,6 +3301,21 @@ enum dig_tune_flags {
 	RESTORE_DEFAULT = 32,
 };
 
+enum dig_tune_fast_mode {
+	/* Full sweep of all the delay combinations */
+	DIG_TUNE_FULL_SWEEP,
+	/* Coarse sweep with binary refinement at the eye edges */
+	DIG_TUNE_COARSE_FINE,
+	/* Start from the stored result, fall back to the coarse sweep */
+	DIG_TUNE_COARSE_FINE_STORED,
+};
+
+struct ad9361_dig_tune_eye {
+	bool			clk_delay;
+	uint8_t			start;
+	uint8_t			width;
+};
+
 enum ad9361_bist_mode {
 	BIST_DISABLE,
 	BIST_INJ_TX,
@@ -3394,6 +3411,7 @@ struct ad9361_rf_phy {
 	uint32_t				bist_tone_level_dB;
 	uint32_t				bist_tone_mask;
 	bool			bbpll_initialized;
+	struct ad9361_dig_tune_eye	dig_tune_eye[2];
 };
 
 struct refclk_scale {
@@ -399,6 +399,10 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 		(init_param->digital_interface_tune_skip_mode);
 	phy->pdata->dig_interface_tune_fir_disable =
 		(init_param->digital_interface_tune_fir_disable);
+	phy->pdata->dig_interface_tune_fast_mode =
+		(init_param->digital_interface_tune_fast_mode);
+	phy->pdata->dig_interface_tune_pn_dwell_us =
+		(init_param->digital_interface_tune_pn_dwell_us);
 	phy->pdata->port_ctrl.pp_conf[0] = (init_param->pp_tx_swap_enable << 7);
 	phy->pdata->port_ctrl.pp_conf[0] |= (init_param->pp_rx_swap_enable << 6);
 	phy->pdata->port_ctrl.pp_conf[0] |= (init_param->tx_channel_swap_enable << 5);
@@ -2182,3 +2186,22 @@ int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 
 	return 0;
 }
+
+/**
+ * Get the data eye found by the last digital interface tuning.
+ * @param phy The AD9361 current state structure.
+ * @param tx The interface: 0 for RX, 1 for TX.
+ * @param eye The clock or data delay that was swept, the first delay of the
+ *            eye and its width in delay steps.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_get_dig_tune_eye(struct ad9361_rf_phy *phy, uint8_t tx,
+				struct ad9361_dig_tune_eye *eye)
+{
+	if (tx > 1)
+		return -EINVAL;
+
+	*eye = phy->dig_tune_eye[tx];
+
+	return 0;
+}
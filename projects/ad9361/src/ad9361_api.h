@@ -212,6 +212,8 @@ typedef struct {
 	/* Digital Interface Control */
 	uint8_t		digital_interface_tune_skip_mode;	/* adi,digital-interface-tune-skip-mode */
 	uint8_t		digital_interface_tune_fir_disable;	/* adi,digital-interface-tune-fir-disable */
+	uint8_t		digital_interface_tune_fast_mode;	/* adi,digital-interface-tune-fast-mode */
+	uint32_t	digital_interface_tune_pn_dwell_us;	/* adi,digital-interface-tune-pn-dwell-us */
 	uint8_t		pp_tx_swap_enable;	/* adi,pp-tx-swap-enable */
 	uint8_t		pp_rx_swap_enable;	/* adi,pp-rx-swap-enable */
 	uint8_t		tx_channel_swap_enable;	/* adi,tx-channel-swap-enable */
@@ -548,4 +550,7 @@ int32_t ad9361_do_dcxo_tune_fine(struct ad9361_rf_phy *phy,
 /* Get the temperature. */
 int32_t ad9361_get_temperature(struct ad9361_rf_phy *phy,
 			       int32_t *temp);
+/* Get the data eye found by the last digital interface tuning. */
+int32_t ad9361_get_dig_tune_eye(struct ad9361_rf_phy *phy, uint8_t tx,
+				struct ad9361_dig_tune_eye *eye);
 #endif
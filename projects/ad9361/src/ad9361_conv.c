@@ -122,6 +122,10 @@
 /* PCORE Version > 8.00 */
 #define ADI_REG_DELAY(l)		(0x0800 + (l) * 0x4)
 
+/* Digital tune coarse sweep */
+#define DIG_TUNE_COARSE_STEP		4
+#define DIG_TUNE_MAX_COARSE_PTS		(32 / DIG_TUNE_COARSE_STEP + 1)
+
 #define SUCCESS		0
 #define FAILURE		-1
 
@@ -160,6 +164,10 @@ static uint32_t ad9361_num_phy_chan(struct axiadc_converter *conv)
 
 /**
  * Check PN checker status.
+ * @param phy The AD9361 state structure.
+ * @param tx The Synthesizer TX = 1, RX = 0.
+ * @param delay Settle time in milliseconds, used when no PN dwell time is
+ * 		configured.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_check_pn(struct ad9361_rf_phy *phy, bool tx,
@@ -173,7 +181,10 @@ static int32_t ad9361_check_pn(struct ad9361_rf_phy *phy, bool tx,
 	for (chan = 0; chan < num_chan; chan++)
 		axi_adc_write(axi_adc, ADI_REG_CHAN_STATUS(chan),
 			      ADI_PN_ERR | ADI_PN_OOS);
-	mdelay(delay);
+	if (phy->pdata->dig_interface_tune_pn_dwell_us)
+		udelay(phy->pdata->dig_interface_tune_pn_dwell_us);
+	else
+		mdelay(delay);
 	uint32_t adi_reg_status;
 	axi_adc_read(axi_adc, ADI_REG_STATUS, &adi_reg_status);
 	if (!tx && !(adi_reg_status & ADI_STATUS))
@@ -273,37 +284,6 @@ static int32_t ad9361_midscale_iodelay(struct ad9361_rf_phy *phy, bool tx)
 	return 0;
 }
 
-/**
- * Digital tune IO delay.
- * @param phy The AD9361 state structure.
- * @param tx The Synthesizer TX = 1, RX = 0.
- * @return 0 in case of success, negative error code otherwise.
- */
-static int32_t ad9361_dig_tune_iodelay(struct ad9361_rf_phy *phy, bool tx)
-{
-	struct axiadc_state *st = phy->adc_state;
-	int32_t i, j;
-	uint32_t s0, c0;
-	uint8_t field[32];
-
-	for (i = 0; i < 7; i++) {
-		for (j = 0; j < 32; j++) {
-			ad9361_iodelay_set(st, i, j, tx);
-			mdelay(1);
-			field[j] = ad9361_check_pn(phy, tx, 10);
-		}
-
-		c0 = ad9361_find_opt(&field[0], 32, &s0);
-		ad9361_iodelay_set(st, i, s0 + c0 / 2, tx);
-
-		dev_dbg(&phy->spi->dev,
-			"%s Lane %"PRId32", window cnt %"PRIu32" , start %"PRIu32", IODELAY set to %"PRIu32"\n",
-			tx ? "TX" :"RX",  i, c0, s0, s0 + c0 / 2);
-	}
-
-	return 0;
-}
-
 /**
  * Digital tune verbose print.
  * @param phy The AD9361 state structure.
@@ -360,6 +340,210 @@ static void ad9361_set_intf_delay(struct ad9361_rf_phy *phy, bool tx,
 		ad9361_ensm_force_state(phy, ENSM_STATE_FDD);
 }
 
+/**
+ * Probe one point of a digital tune sweep.
+ * @param phy The AD9361 state structure.
+ * @param tx The Synthesizer TX = 1, RX = 0.
+ * @param iodelay Set if sweeping the IO delay of a lane, clear if sweeping
+ * 		  the clock/data delay.
+ * @param sel The lane number or the clock/data delay sweep selection.
+ * @param val The delay value.
+ * @param first Set for the first point of a sweep.
+ * @return 0 if the PN check passed, 1 otherwise.
+ */
+static uint8_t ad9361_dig_tune_probe(struct ad9361_rf_phy *phy, bool tx,
+				     bool iodelay, uint32_t sel, uint32_t val,
+				     bool first)
+{
+	if (iodelay) {
+		ad9361_iodelay_set(phy->adc_state, sel, val, tx);
+		if (!phy->pdata->dig_interface_tune_pn_dwell_us)
+			mdelay(1);
+
+		return ad9361_check_pn(phy, tx, 10);
+	}
+
+	/*
+	 * sel == 0: clock delay = 0, data delay from 0 to 15
+	 * sel == 1: clock delay = 15, data delay from 15 to 0
+	 */
+	ad9361_set_intf_delay(phy, tx, sel ? 15 : 0,
+			      sel ? 15 - val : val, first);
+
+	return ad9361_check_pn(phy, tx, 4);
+}
+
+/**
+ * Sweep a delay and fill in the PN check result for each value.
+ * Unless the full sweep is selected, only every DIG_TUNE_COARSE_STEP value is
+ * checked and the edges of the widest passing window are then refined with
+ * a binary search. Values that are not checked are reported as failing,
+ * except the ones inside the window.
+ * @param phy The AD9361 state structure.
+ * @param tx The Synthesizer TX = 1, RX = 0.
+ * @param iodelay Set if sweeping the IO delay of a lane.
+ * @param sel The lane number or the clock/data delay sweep selection.
+ * @param field The PN check results, 0 = PASS.
+ * @param size The number of delay values.
+ * @return None.
+ */
+static void ad9361_dig_tune_sweep(struct ad9361_rf_phy *phy, bool tx,
+				  bool iodelay, uint32_t sel,
+				  uint8_t *field, uint32_t size)
+{
+	uint32_t pts[DIG_TUNE_MAX_COARSE_PTS];
+	uint32_t n, k, ks, ke, start, lo, hi, mid, j;
+	bool found = false;
+
+	if (phy->pdata->dig_interface_tune_fast_mode == DIG_TUNE_FULL_SWEEP) {
+		for (j = 0; j < size; j++)
+			field[j] = ad9361_dig_tune_probe(phy, tx, iodelay,
+							 sel, j, j == 0);
+		return;
+	}
+
+	memset(field, 1, size);
+
+	/* Coarse sweep, always including the last value */
+	for (n = 0, j = 0; n < DIG_TUNE_MAX_COARSE_PTS; j += DIG_TUNE_COARSE_STEP) {
+		if (j > size - 1)
+			j = size - 1;
+		pts[n] = j;
+		field[j] = ad9361_dig_tune_probe(phy, tx, iodelay,
+						 sel, j, n == 0);
+		n++;
+		if (j == size - 1)
+			break;
+	}
+
+	/* Widest run of passing coarse points */
+	ks = ke = 0;
+	for (k = 0, start = 0; k < n; k++) {
+		if (field[pts[k]]) {
+			start = k + 1;
+			continue;
+		}
+		if (!found || (pts[k] - pts[start]) > (pts[ke] - pts[ks])) {
+			ks = start;
+			ke = k;
+			found = true;
+		}
+	}
+
+	if (!found) {
+		/* The eye is narrower than the coarse step, check the rest */
+		for (j = 0; j < size; j++)
+			if (j % DIG_TUNE_COARSE_STEP && j != size - 1)
+				field[j] = ad9361_dig_tune_probe(phy, tx,
+								 iodelay, sel,
+								 j, false);
+		return;
+	}
+
+	for (j = pts[ks]; j <= pts[ke]; j++)
+		field[j] = 0;
+
+	/* Refine the left edge, lo fails and hi passes */
+	if (ks > 0) {
+		lo = pts[ks - 1];
+		hi = pts[ks];
+		while (hi - lo > 1) {
+			mid = (lo + hi) / 2;
+			if (ad9361_dig_tune_probe(phy, tx, iodelay, sel, mid,
+						  false))
+				lo = mid;
+			else
+				hi = mid;
+		}
+		for (j = hi; j < pts[ks]; j++)
+			field[j] = 0;
+	}
+
+	/* Refine the right edge, lo passes and hi fails */
+	if (ke < n - 1) {
+		lo = pts[ke];
+		hi = pts[ke + 1];
+		while (hi - lo > 1) {
+			mid = (lo + hi) / 2;
+			if (ad9361_dig_tune_probe(phy, tx, iodelay, sel, mid,
+						  false))
+				hi = mid;
+			else
+				lo = mid;
+		}
+		for (j = pts[ke] + 1; j <= lo; j++)
+			field[j] = 0;
+	}
+}
+
+/**
+ * Digital tune IO delay.
+ * @param phy The AD9361 state structure.
+ * @param tx The Synthesizer TX = 1, RX = 0.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_dig_tune_iodelay(struct ad9361_rf_phy *phy, bool tx)
+{
+	struct axiadc_state *st = phy->adc_state;
+	int32_t i;
+	uint32_t s0, c0;
+	uint8_t field[32];
+
+	for (i = 0; i < 7; i++) {
+		ad9361_dig_tune_sweep(phy, tx, true, i, field, 32);
+
+		c0 = ad9361_find_opt(&field[0], 32, &s0);
+		ad9361_iodelay_set(st, i, s0 + c0 / 2, tx);
+
+		dev_dbg(&phy->spi->dev,
+			"%s Lane %"PRId32", window cnt %"PRIu32" , start %"PRIu32", IODELAY set to %"PRIu32"\n",
+			tx ? "TX" :"RX",  i, c0, s0, s0 + c0 / 2);
+	}
+
+	return 0;
+}
+
+/**
+ * Check the stored clock/data delay and apply it if it still has margin.
+ * The stored value and its two neighbours must pass the PN check.
+ * @param phy The AD9361 state structure.
+ * @param tx The Synthesizer TX = 1, RX = 0.
+ * @return true if the stored delay was applied, false otherwise.
+ */
+static bool ad9361_dig_tune_stored(struct ad9361_rf_phy *phy, bool tx)
+{
+	uint8_t stored = tx ? phy->pdata->port_ctrl.tx_clk_data_delay :
+			 phy->pdata->port_ctrl.rx_clk_data_delay;
+	uint32_t clk = (stored >> 4) & 0xF;
+	uint32_t data = stored & 0xF;
+	bool clk_delay = clk != 0;
+	uint32_t d = clk_delay ? clk : data;
+	uint32_t v;
+
+	if (d == 0 || d == 15)
+		return false;
+
+	/* Sweeping the clock delay changes the clock at every step */
+	for (v = d - 1; v <= d + 1; v++) {
+		ad9361_set_intf_delay(phy, tx, clk_delay ? v : clk,
+				      clk_delay ? data : v,
+				      clk_delay || v == d - 1);
+		if (ad9361_check_pn(phy, tx, 4))
+			return false;
+	}
+
+	ad9361_set_intf_delay(phy, tx, clk, data, true);
+
+	phy->dig_tune_eye[tx].clk_delay = clk_delay;
+	phy->dig_tune_eye[tx].start = d - 1;
+	phy->dig_tune_eye[tx].width = 3;
+
+	dev_dbg(&phy->spi->dev, "%s: %s using stored delay 0x%X\n", __func__,
+		tx ? "TX" : "RX", stored);
+
+	return true;
+}
+
 /**
  * Digital interface timing analysis.
  * @param phy The AD9361 state structure.
@@ -445,6 +629,7 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 	uint32_t i, j, r;
 	bool half_data_rate;
 	uint8_t field[2][16];
+	uint8_t sweep[16];
 
 	if (((phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) ||
 	     !phy->pdata->rx2tx2))
@@ -452,6 +637,11 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 	else
 		half_data_rate = true;
 
+	if (!max_freq &&
+	    phy->pdata->dig_interface_tune_fast_mode == DIG_TUNE_COARSE_FINE_STORED &&
+	    ad9361_dig_tune_stored(phy, tx))
+		return 0;
+
 	memset(field, 0, 32);
 	for (r = 0; r < (max_freq ? ARRAY_SIZE(rates) : 1); r++) {
 		if (max_freq)
@@ -459,15 +649,9 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 							half_data_rate ? rates[r] / 2 : rates[r]);
 
 		for (i = 0; i < 2; i++) {
-			for (j = 0; j < 16; j++) {
-				/*
-				 * i == 0: clock delay = 0, data delay from 0 to 15
-				 * i == 1: clock delay = 15, data delay from 15 to 0
-				 */
-				ad9361_set_intf_delay(phy, tx, i ? 15 : 0,
-						      i ? 15 - j : j, j == 0);
-				field[i][j] |= ad9361_check_pn(phy, tx, 4);
-			}
+			ad9361_dig_tune_sweep(phy, tx, false, i, sweep, 16);
+			for (j = 0; j < 16; j++)
+				field[i][j] |= sweep[j];
 		}
 
 		if ((flags & BE_MOREVERBOSE) && max_freq) {
@@ -495,6 +679,10 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 	else
 		ad9361_set_intf_delay(phy, tx, 0, s0 + c0 / 2, true);
 
+	phy->dig_tune_eye[tx].clk_delay = c1 > c0;
+	phy->dig_tune_eye[tx].start = (c1 > c0) ? s1 : s0;
+	phy->dig_tune_eye[tx].width = (c1 > c0) ? c1 : c0;
+
 	return 0;
 }
 
@@ -296,6 +296,8 @@ AD9361_InitParam default_init_param = {
 	/* Digital Interface Control */
 	0,		//digital_interface_tune_skip_mode *** adi,digital-interface-tune-skip-mode
 	0,		//digital_interface_tune_fir_disable *** adi,digital-interface-tune-fir-disable
+	0,		//digital_interface_tune_fast_mode *** adi,digital-interface-tune-fast-mode
+	0,		//digital_interface_tune_pn_dwell_us *** adi,digital-interface-tune-pn-dwell-us
 	1,		//pp_tx_swap_enable *** adi,pp-tx-swap-enable
 	1,		//pp_rx_swap_enable *** adi,pp-rx-swap-enable
 	0,		//tx_channel_swap_enable *** adi,tx-channel-swap-enable
@@ -15,12 +15,14 @@
 #include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "common.h"
 #include "spi.h"
 #include "spi_extra.h"
 #include "gpio_extra.h"
 #include "gpio.h"
 #include "delay.h"
+#include "error.h"
 
 #include "parameters.h"
 
@@ -178,15 +180,52 @@ commonErr_t CMB_SPIWriteByte(spiSettings_t *spiSettings, uint16_t addr,
 	return(COMMONERR_OK);
 }
 
+/* number of consecutive addresses that can be sent in one streaming frame */
+static uint32_t cmb_spi_stream_len(spiSettings_t *spiSettings, uint16_t *addr,
+				   uint32_t count)
+{
+	uint32_t len = 1;
+	uint16_t next;
+
+	if (!spiSettings->enSpiStreaming)
+		return 1;
+
+	while ((len < count) && (len < CMB_SPI_STREAM_MAX)) {
+		next = spiSettings->autoIncAddrUp ? addr[len - 1] + 1 :
+		       addr[len - 1] - 1;
+		if (addr[len] != next)
+			break;
+		len++;
+	}
+
+	return len;
+}
+
 commonErr_t CMB_SPIWriteBytes(spiSettings_t *spiSettings, uint16_t *addr,
 			      uint8_t *data, uint32_t count)
 {
+	static uint8_t buf[CMB_SPI_STREAM_MAX + 2];
 	uint32_t index;
+	uint32_t len;
 
-	for (index = 0; index < count; index++)
-		if (CMB_SPIWriteByte(spiSettings, *(addr + index),
-				     *(data + index)) != COMMONERR_OK)
+	for (index = 0; index < count; index += len) {
+		len = cmb_spi_stream_len(spiSettings, &addr[index], count - index);
+		if (len == 1) {
+			if (CMB_SPIWriteByte(spiSettings, addr[index],
+					     data[index]) != COMMONERR_OK)
+				return(COMMONERR_FAILED);
+			continue;
+		}
+
+		spi_ad_desc->chip_select = spiSettings->chipSelectIndex - 1;
+
+		buf[0] = (uint8_t) ((addr[index] >> 8) & 0x7f);
+		buf[1] = (uint8_t) (addr[index] & 0xff);
+		memcpy(&buf[2], &data[index], len);
+
+		if (spi_write_and_read(spi_ad_desc, buf, len + 2) != SUCCESS)
 			return(COMMONERR_FAILED);
+	}
 
 	return(COMMONERR_OK);
 }
@@ -27,6 +27,11 @@ extern "C" {
 /* assuming 3 byte SPI message - integer math enforces floor() */
 #define SPIARRAYTRIPSIZE ((SPIARRAYSIZE / 3) * 3)
 
+/* maximum data bytes sent in one SPI frame when spiSettings->enSpiStreaming is set */
+#ifndef CMB_SPI_STREAM_MAX
+#define CMB_SPI_STREAM_MAX 256
+#endif
+
 /*========================================
  * Enums and structures
  *=======================================*/
@@ -65,8 +70,8 @@ typedef struct {
 	uint8_t MSBFirst;				///< 1 = MSBFirst, 0 = LSBFirst
 	uint8_t CPHA;					///< clock phase, sets which clock edge the data updates (valid 0 or 1)
 	uint8_t CPOL;					///< clock polarity 0 = clock starts low, 1 = clock starts high
-	uint8_t enSpiStreaming;			///< Not implemented. SW feature to improve SPI throughput.
-	uint8_t autoIncAddrUp;			///< Not implemented. For SPI Streaming, set address increment direction. 1= next addr = addr+1, 0:addr = addr-1
+	uint8_t enSpiStreaming;			///< 1 = CMB_SPIWriteBytes() sends consecutive addresses in one SPI frame (device must be in streaming mode)
+	uint8_t autoIncAddrUp;			///< For SPI Streaming, set address increment direction. 1= next addr = addr+1, 0:addr = addr-1
 	uint8_t fourWireMode;			///< 1: Use 4-wire SPI, 0: 3-wire SPI (SDIO pin is bidirectional). NOTE: ADI's FPGA platform always uses 4-wire mode.
 	uint32_t spiClkFreq_Hz;			///< SPI Clk frequency in Hz (default 25000000), platform will use next lowest frequency that it's baud rate generator can create */
 } spiSettings_t;
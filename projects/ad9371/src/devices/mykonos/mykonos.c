@@ -45,6 +45,9 @@ static mykonosErr_t MYKONOS_calculateScaledDeviceClk_kHz(mykonosDevice_t *device
 static mykonosErr_t MYKONOS_calculateDigitalClocks(mykonosDevice_t *device, uint32_t *hsDigClk_kHz, uint32_t *hsDigClkDiv4or5_kHz);
 static mykonosErr_t enableDpdTracking(mykonosDevice_t *device, uint8_t tx1Enable, uint8_t tx2Enable);
 static mykonosErr_t enableClgcTracking(mykonosDevice_t *device, uint8_t tx1Enable, uint8_t tx2Enable);
+#if (MYK_ENABLE_SPIWRITEARRAY == 1) && (MYK_ENABLE_ARM_SPISTREAMING == 1)
+static void mykArmSpiStreaming(mykonosDevice_t *device, uint8_t enable, uint8_t *savedSettings);
+#endif
 
 /**
  * \brief Verifies the Tx profile members are valid (in range) in the init structure
@@ -13326,6 +13329,9 @@ mykonosErr_t MYKONOS_loadArmConcurrent(mykonosDevice_t *device, uint8_t *binary,
     uint32_t dataIndex = 0;
     uint32_t spiBufferSize = MYK_SPIWRITEARRAY_BUFFERSIZE;
     uint16_t addrArray[MYK_SPIWRITEARRAY_BUFFERSIZE] = {0};
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+    uint8_t spiStreamSettings[2] = {0};
+#endif
 #endif
 
 #if (MYKONOS_VERBOSE == 1)
@@ -13376,6 +13382,10 @@ mykonosErr_t MYKONOS_loadArmConcurrent(mykonosDevice_t *device, uint8_t *binary,
 
 #elif (MYK_ENABLE_SPIWRITEARRAY == 1)
 
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+        mykArmSpiStreaming(device, 1, &spiStreamSettings[0]);
+#endif
+
         addrIndex = 0;
         dataIndex = 0;
         for (i = 0; i < count; i++)
@@ -13395,6 +13405,10 @@ mykonosErr_t MYKONOS_loadArmConcurrent(mykonosDevice_t *device, uint8_t *binary,
             CMB_SPIWriteBytes(device->spiSettings, &addrArray[0], &binary[dataIndex], addrIndex);
         }
 
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+        mykArmSpiStreaming(device, 0, &spiStreamSettings[0]);
+#endif
+
 #endif
 
         /* writing the stack pointer address */
@@ -15694,6 +15708,9 @@ mykonosErr_t MYKONOS_writeArmMem(mykonosDevice_t *device, uint32_t address, uint
     uint32_t dataIndex = 0;
     uint32_t spiBufferSize = MYK_SPIWRITEARRAY_BUFFERSIZE;
     uint16_t addrArray[MYK_SPIWRITEARRAY_BUFFERSIZE] = {0};
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+    uint8_t spiStreamSettings[2] = {0};
+#endif
 #endif
 
 #if (MYKONOS_VERBOSE == 1)
@@ -15753,6 +15770,10 @@ mykonosErr_t MYKONOS_writeArmMem(mykonosDevice_t *device, uint32_t address, uint
 
 #elif (MYK_ENABLE_SPIWRITEARRAY == 1)
 
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+    mykArmSpiStreaming(device, 1, &spiStreamSettings[0]);
+#endif
+
     addrIndex = 0;
     dataIndex = 0;
     for (i = 0; i < byteCount; i++)
@@ -15772,11 +15793,61 @@ mykonosErr_t MYKONOS_writeArmMem(mykonosDevice_t *device, uint32_t address, uint
         CMB_SPIWriteBytes(device->spiSettings, &addrArray[0], &data[dataIndex], addrIndex);
     }
 
+#if (MYK_ENABLE_ARM_SPISTREAMING == 1)
+    mykArmSpiStreaming(device, 0, &spiStreamSettings[0]);
+#endif
+
 #endif
 
     return MYKONOS_ERR_OK;
 }
 
+#if (MYK_ENABLE_SPIWRITEARRAY == 1) && (MYK_ENABLE_ARM_SPISTREAMING == 1)
+/**
+ * \brief Private helper to switch the Mykonos SPI port in or out of streaming mode
+ *
+ * While streaming with ascending addresses is enabled, CMB_SPIWriteBytes() sends
+ * each run of consecutive ARM data byte addresses (0xD04 - 0xD07) as a single SPI
+ * frame. The user SPI streaming settings are saved on enable and restored on disable.
+ *
+ * <B>Dependencies</B>
+ * - device->spiSettings->enSpiStreaming
+ * - device->spiSettings->autoIncAddrUp
+ *
+ * \param device is structure pointer to the Mykonos data structure containing settings
+ * \param enable 1 = save the user settings and enable streaming, 0 = restore the user settings
+ * \param savedSettings Two byte storage for the saved enSpiStreaming/autoIncAddrUp settings
+ */
+static void mykArmSpiStreaming(mykonosDevice_t *device, uint8_t enable, uint8_t *savedSettings)
+{
+    if (enable > 0)
+    {
+        savedSettings[0] = device->spiSettings->enSpiStreaming;
+        savedSettings[1] = device->spiSettings->autoIncAddrUp;
+
+        if ((savedSettings[0] > 0) && (savedSettings[1] > 0))
+        {
+            return;
+        }
+
+        device->spiSettings->enSpiStreaming = 1;
+        device->spiSettings->autoIncAddrUp = 1;
+    }
+    else
+    {
+        if ((savedSettings[0] > 0) && (savedSettings[1] > 0))
+        {
+            return;
+        }
+
+        device->spiSettings->enSpiStreaming = savedSettings[0];
+        device->spiSettings->autoIncAddrUp = savedSettings[1];
+    }
+
+    MYKONOS_setSpiSettings(device);
+}
+#endif
+
 /**
  * \brief Low level helper function used by Mykonos API to write the ARM memory config structures
  *
@@ -27,6 +27,11 @@ extern "C" {
 /* 3 Bytes per SPI transaction * 341 transactions = ~1024 byte buffer size */
 /* Minimum MYK_SPIWRITEARRAY_BUFFERSIZE = 27 */
 #define MYK_SPIWRITEARRAY_BUFFERSIZE 341
+
+/* Stream the ARM data bytes during ARM memory loads (needs MYK_ENABLE_SPIWRITEARRAY) */
+#ifndef MYK_ENABLE_ARM_SPISTREAMING
+#define MYK_ENABLE_ARM_SPISTREAMING 1
+#endif
 /*
  *****************************************
  * Rx, ObsRx, and Sniffer gain tables
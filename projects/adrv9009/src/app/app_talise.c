@@ -208,16 +208,9 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			goto error_11;
 		}
 
-		/* TALISE_verifyArmChecksum() will timeout after 200ms
-		 * if ARM checksum is not computed
+		/* The image is validated by the ARM computed checksum inside
+		 * TALISE_loadArmFromBinary(), no SPI readback is needed here.
 		 */
-		talAction = TALISE_verifyArmChecksum(pd);
-		if (talAction != TAL_ERR_OK) {
-			/*< user code- ARM did not load properly - check armBinary & clock/profile settings >*/
-			printf("error: TALISE_verifyArmChecksum() failed\n");
-			goto error_11;
-		}
-
 	} else {
 		/*< user code- check settings for proper CLKPLL lock  > ***/
 		printf("error: CLKPLL not locked\n");
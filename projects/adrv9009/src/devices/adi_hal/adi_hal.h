@@ -17,6 +17,8 @@
  * Enums and structures
  *=======================================*/
 
+struct adi_hal_field_cache;
+
 struct adi_hal {
 	struct gpio_desc	*gpio_adrv_resetb;
 	struct gpio_desc	*gpio_adrv_sysref_req;
@@ -26,6 +28,12 @@ struct adi_hal {
 	uint8_t			spi_adrv_csn;
 	void 			*extra_gpio;
 	uint8_t			gpio_adrv_resetb_num;
+	/* Set when the device accepts multi-byte (streaming) SPI messages */
+	uint8_t			spi_stream_en;
+	/* Streaming address direction: 1 = addr + 1, 0 = addr - 1 */
+	uint8_t			spi_stream_inc;
+	/* Shadow of the written registers, used by ADIHAL_spiWriteField() */
+	struct adi_hal_field_cache *field_cache;
 };
 
 /**
@@ -74,6 +82,16 @@ extern "C" {
 /* Minimum HAL_SPIWRITEARRAY_BUFFERSIZE = 18 */
 #define HAL_SPIWRITEARRAY_BUFFERSIZE 341
 
+/* Largest single SPI transfer issued by the HAL, limited by the platform */
+#ifndef HAL_SPI_MAX_TRANSFER_SIZE
+#define HAL_SPI_MAX_TRANSFER_SIZE (3 * HAL_SPIWRITEARRAY_BUFFERSIZE)
+#endif
+
+/* Number of registers held by the field cache (power of 2) */
+#ifndef HAL_SPI_FIELD_CACHE_SIZE
+#define HAL_SPI_FIELD_CACHE_SIZE 256
+#endif
+
 /*============================================================================
  * ADI Device Hardware Control Functions
  *===========================================================================*/
@@ -503,6 +521,26 @@ adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo, uint16_t addr,
 adiHalErr_t ADIHAL_spiReadField(void *devHalInfo, uint16_t addr,
 				uint8_t *fieldVal, uint8_t mask, uint8_t startBit);
 
+/**
+ * \brief Enables or disables the SPI field cache
+ *
+ * When enabled, every register written through the HAL is kept in a shadow
+ * table and ADIHAL_spiWriteField() uses the shadow value instead of reading
+ * the register back, saving one SPI read per field write. Only use it for
+ * write-only configuration sequences, where no register touched by
+ * ADIHAL_spiWriteField() is modified by the device itself.
+ * The cache is invalidated on ADIHAL_resetHw() and when it is disabled.
+ *
+ * \param devHalInfo Pointer to Platform HAL defined structure containing
+ *                   hardware settings describing the device of interest.
+ *
+ * \param enable 1 to enable the cache, 0 to disable it.
+ *
+ * \retval ADIHAL_OK if function completed successfully.
+ * \retval ADIHAL_GEN_SW if the cache could not be allocated.
+ */
+adiHalErr_t ADIHAL_spiFieldCacheEnable(void *devHalInfo, uint8_t enable);
+
 /**
  * \brief Delay or sleep for the specified number of microseconds.
  *
@@ -41,6 +41,8 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "adi_hal.h"
 #include "parameters.h"
 #include "spi.h"
@@ -49,10 +51,108 @@
 #include "error.h"
 #include "delay.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define HAL_SPI_INTERFACE_CONFIG_A	0x0000
+#define HAL_SPI_SOFT_RESET		0x81
+#define HAL_SPI_ADDR_ASCENSION		0x20
+#define HAL_SPI_INTERFACE_CONFIG_B	0x0001
+#define HAL_SPI_SINGLE_INSTRUCTION	0x80
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+struct adi_hal_field_cache {
+	uint16_t	addr[HAL_SPI_FIELD_CACHE_SIZE];
+	uint8_t		data[HAL_SPI_FIELD_CACHE_SIZE];
+	uint8_t		valid[HAL_SPI_FIELD_CACHE_SIZE];
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+/* Shared by all the devices, the HAL calls are not reentrant */
+static uint8_t hal_spi_buf[HAL_SPI_MAX_TRANSFER_SIZE];
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+static void adi_hal_cache_invalidate(struct adi_hal *dev_hal_data)
+{
+	if (dev_hal_data->field_cache)
+		memset(dev_hal_data->field_cache->valid, 0,
+		       sizeof(dev_hal_data->field_cache->valid));
+}
+
+static uint8_t adi_hal_cache_get(struct adi_hal *dev_hal_data,
+				 uint16_t addr, uint8_t *data)
+{
+	struct adi_hal_field_cache *cache = dev_hal_data->field_cache;
+	uint32_t idx = addr & (HAL_SPI_FIELD_CACHE_SIZE - 1);
+
+	if (!cache || !cache->valid[idx] || cache->addr[idx] != addr)
+		return 0;
+
+	*data = cache->data[idx];
+
+	return 1;
+}
+
+/*
+ * Keep the HAL view of the device in sync with a register write: the SPI
+ * streaming configuration and the field cache.
+ */
+static void adi_hal_spi_track(struct adi_hal *dev_hal_data,
+			      uint16_t addr, uint8_t data)
+{
+	struct adi_hal_field_cache *cache = dev_hal_data->field_cache;
+	uint32_t idx = addr & (HAL_SPI_FIELD_CACHE_SIZE - 1);
+
+	if (addr == HAL_SPI_INTERFACE_CONFIG_A) {
+		if (data & HAL_SPI_SOFT_RESET) {
+			dev_hal_data->spi_stream_en = 0;
+			adi_hal_cache_invalidate(dev_hal_data);
+			return;
+		}
+		dev_hal_data->spi_stream_inc = !!(data & HAL_SPI_ADDR_ASCENSION);
+	} else if (addr == HAL_SPI_INTERFACE_CONFIG_B) {
+		dev_hal_data->spi_stream_en = !(data & HAL_SPI_SINGLE_INSTRUCTION);
+	}
+
+	if (cache) {
+		cache->addr[idx] = addr;
+		cache->data[idx] = data;
+		cache->valid[idx] = 1;
+	}
+}
+
+/*
+ * Number of accesses, starting with addr[0], that can be done in a single
+ * streaming SPI message.
+ */
+static uint32_t adi_hal_spi_stream_len(struct adi_hal *dev_hal_data,
+				       uint16_t *addr, uint32_t count)
+{
+	uint32_t max = HAL_SPI_MAX_TRANSFER_SIZE - 2;
+	uint16_t next;
+	uint32_t i;
+
+	if (!dev_hal_data->spi_stream_en)
+		return 1;
+
+	for (i = 1; i < count && i < max; i++) {
+		next = dev_hal_data->spi_stream_inc ? addr[i - 1] + 1 :
+		       addr[i - 1] - 1;
+		if (addr[i] != next)
+			break;
+	}
+
+	return i;
+}
+
+
 adiHalErr_t ADIHAL_setTimeout(void *devHalInfo, uint32_t halTimeout_ms)
 {
 	return ADIHAL_OK;
@@ -92,6 +192,10 @@ adiHalErr_t ADIHAL_openHw(void *devHalInfo, uint32_t halTimeout_ms)
 	status |= gpio_get(&dev_hal_data->gpio_adrv_sysref_req,
 			   &gpio_adrv_sysref_req_param);
 
+	dev_hal_data->spi_stream_en = 0;
+	dev_hal_data->spi_stream_inc = 0;
+	dev_hal_data->field_cache = NULL;
+
 	if (status != SUCCESS)
 		return ADIHAL_ERR;
 	else
@@ -109,6 +213,9 @@ adiHalErr_t ADIHAL_closeHw(void *devHalInfo)
 
 	status |= spi_remove(dev_hal_data->spi_adrv_desc);
 
+	free(dev_hal_data->field_cache);
+	dev_hal_data->field_cache = NULL;
+
 	if (status != SUCCESS)
 		return ADIHAL_ERR;
 	else
@@ -126,6 +233,9 @@ adiHalErr_t ADIHAL_resetHw(void *devHalInfo)
 	gpio_direction_output(devHalData->gpio_adrv_resetb, 1);
 	mdelay(10);
 
+	devHalData->spi_stream_en = 0;
+	adi_hal_cache_invalidate(devHalData);
+
 	return ADIHAL_OK;
 }
 
@@ -162,20 +272,36 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 
 	if (status != SUCCESS)
 		return ADIHAL_SPI_FAIL;
-	else
-		return ADIHAL_OK;
+
+	adi_hal_spi_track(devHalData, addr, data);
+
+	return ADIHAL_OK;
 }
 
 adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 				 uint16_t *addr, uint8_t *data, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	uint32_t i, j, len;
+	int32_t status;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
+	/*
+	 * Without streaming every access needs its own chip select frame.
+	 * With streaming, runs of consecutive addresses go out in one message.
+	 */
+	for (i = 0; i < count; i += len) {
+		len = adi_hal_spi_stream_len(devHalData, &addr[i], count - i);
+
+		hal_spi_buf[0] = (addr[i] >> 8) & 0x7F;
+		hal_spi_buf[1] = addr[i] & 0xFF;
+		memcpy(&hal_spi_buf[2], &data[i], len);
+		status = spi_write_and_read(devHalData->spi_adrv_desc,
+					    hal_spi_buf, len + 2);
+		if (status != SUCCESS)
+			return ADIHAL_SPI_FAIL;
+
+		for (j = i; j < i + len; j++)
+			adi_hal_spi_track(devHalData, addr[j], data[j]);
 	}
 
 	return ADIHAL_OK;
@@ -205,13 +331,22 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	uint32_t i, len;
+	int32_t status;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
+	for (i = 0; i < count; i += len) {
+		len = adi_hal_spi_stream_len(devHalData, &addr[i], count - i);
+
+		hal_spi_buf[0] = 0x80 | ((addr[i] >> 8) & 0x7F);
+		hal_spi_buf[1] = addr[i] & 0xFF;
+		memset(&hal_spi_buf[2], 0, len);
+		status = spi_write_and_read(devHalData->spi_adrv_desc,
+					    hal_spi_buf, len + 2);
+		if (status != SUCCESS)
+			return ADIHAL_SPI_FAIL;
+
+		memcpy(&readdata[i], &hal_spi_buf[2], len);
 	}
 
 	return ADIHAL_OK;
@@ -223,9 +358,11 @@ adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
 	adiHalErr_t errVal;
 	uint8_t readVal;
 
-	errVal = ADIHAL_spiReadByte(devHalInfo, addr, &readVal);
-	if (errVal != ADIHAL_OK)
-		return errVal;
+	if (!adi_hal_cache_get(devHalInfo, addr, &readVal)) {
+		errVal = ADIHAL_spiReadByte(devHalInfo, addr, &readVal);
+		if (errVal != ADIHAL_OK)
+			return errVal;
+	}
 
 	readVal = (readVal & ~mask) | ((fieldVal << startBit) & mask);
 
@@ -247,6 +384,30 @@ adiHalErr_t ADIHAL_spiReadField(void *devHalInfo,
 	return ADIHAL_OK;
 }
 
+adiHalErr_t ADIHAL_spiFieldCacheEnable(void *devHalInfo, uint8_t enable)
+{
+	struct adi_hal *dev_hal_data = (struct adi_hal *)devHalInfo;
+
+	if (devHalInfo == NULL)
+		return (ADIHAL_GEN_SW);
+
+	if (!enable) {
+		free(dev_hal_data->field_cache);
+		dev_hal_data->field_cache = NULL;
+
+		return ADIHAL_OK;
+	}
+
+	if (!dev_hal_data->field_cache) {
+		dev_hal_data->field_cache = calloc(1,
+						   sizeof(*dev_hal_data->field_cache));
+		if (!dev_hal_data->field_cache)
+			return ADIHAL_GEN_SW;
+	}
+
+	return ADIHAL_OK;
+}
+
 adiHalErr_t  ADIHAL_wait_us(void *devHalInfo, uint32_t time_us)
 {
 	udelay(time_us);
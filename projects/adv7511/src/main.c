@@ -355,6 +355,7 @@ int main()
 #if defined(_XPARAMETERS_PS_H_)
 	xil_timer_init.active_tmr = 0;
 	xil_timer_init.type = TIMER_PS;
+	xil_timer_init.irq_desc = NULL;
 	timer_init.id = XPAR_XSCUTIMER_0_DEVICE_ID;
 	timer_init.freq_hz = XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 2;
 	timer_init.load_value = timer_init.freq_hz / 1000;
@@ -362,6 +363,7 @@ int main()
 #else
 	xil_timer_init.active_tmr = 0;
 	xil_timer_init.type = TIMER_PL;
+	xil_timer_init.irq_desc = NULL;
 	timer_init.id = XPAR_AXI_TIMER_DEVICE_ID;
 	timer_init.freq_hz = XPAR_AXI_TIMER_CLOCK_FREQ_HZ;
 	timer_init.load_value = timer_init.freq_hz / 1000;
@@ -46,6 +46,7 @@
 #include "app_config.h"
 #include "parameters.h"
 #include "error.h"
+#include <string.h>
 #include "iio.h"
 #include "irq.h"
 #include "irq_extra.h"
@@ -208,6 +209,7 @@ int main(void)
 	if (status < 0)
 		return status;
 
+	memset(&wifi_param, 0, sizeof(wifi_param));
 	wifi_param.irq_desc = irq_desc;
 	wifi_param.uart_desc = uart_desc;
 #ifdef ADUCM_PLATFORM
@@ -0,0 +1,57 @@
+################################################################################
+#									       #
+#     Shared variables:							       #
+#	- PROJECT							       #
+#	- DRIVERS							       #
+#	- INCLUDE							       #
+#	- PLATFORM_DRIVERS						       #
+#	- NO-OS								       #
+#									       #
+################################################################################
+
+SRCS := $(PROJECT)/src/main.c
+SRCS += $(PROJECTS_DIR)/ad9361/src/ad9361.c				\
+	$(PROJECTS_DIR)/ad9361/src/ad9361_conv.c			\
+	$(PROJECTS_DIR)/ad9361/src/ad9361_util.c
+SRCS += $(DRIVERS)/spi/spi.c						\
+	$(DRIVERS)/adc/ad7124/ad7124.c					\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.c				\
+	$(DRIVERS)/accel/adxl372/adxl372.c				\
+	$(DRIVERS)/accel/adxl372/adxl372_spi.c				\
+	$(DRIVERS)/accel/adxl372/adxl372_i2c.c				\
+	$(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c			\
+	$(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.c			\
+	$(DRIVERS)/axi_core/axi_dmac/axi_dmac.c				\
+	$(NO-OS)/util/util.c
+SRCS +=	$(PLATFORM_DRIVERS)/sim_bus.c					\
+	$(PLATFORM_DRIVERS)/sim_spi.c					\
+	$(PLATFORM_DRIVERS)/i2c.c					\
+	$(PLATFORM_DRIVERS)/axi_io.c					\
+	$(PLATFORM_DRIVERS)/gpio.c					\
+	$(PLATFORM_DRIVERS)/delay.c					\
+	$(PLATFORM_DRIVERS)/sim_ad7124.c				\
+	$(PLATFORM_DRIVERS)/sim_adxl372.c				\
+	$(PLATFORM_DRIVERS)/sim_ad9361.c				\
+	$(PLATFORM_DRIVERS)/sim_axi_dmac.c
+INCS := $(PROJECTS_DIR)/ad9361/src/ad9361.h				\
+	$(PROJECTS_DIR)/ad9361/src/ad9361_util.h			\
+	$(PROJECTS_DIR)/ad9361/src/common.h				\
+	$(PROJECTS_DIR)/ad9361/src/app_config.h
+INCS += $(DRIVERS)/adc/ad7124/ad7124.h					\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.h				\
+	$(DRIVERS)/accel/adxl372/adxl372.h				\
+	$(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.h			\
+	$(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.h			\
+	$(DRIVERS)/axi_core/axi_dmac/axi_dmac.h
+INCS +=	$(PLATFORM_DRIVERS)/sim_bus.h					\
+	$(PLATFORM_DRIVERS)/sim_models.h				\
+	$(PLATFORM_DRIVERS)/spi_extra.h					\
+	$(PLATFORM_DRIVERS)/i2c_extra.h
+INCS +=	$(INCLUDE)/axi_io.h						\
+	$(INCLUDE)/spi.h						\
+	$(INCLUDE)/i2c.h						\
+	$(INCLUDE)/gpio.h						\
+	$(INCLUDE)/error.h						\
+	$(INCLUDE)/delay.h						\
+	$(INCLUDE)/bus_stats.h						\
+	$(INCLUDE)/util.h
@@ -0,0 +1,452 @@
+/***************************************************************************//**
+ *   @file   main.c
+ *   @brief  Driver benchmark on the simulation platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "error.h"
+#include "spi.h"
+#include "spi_extra.h"
+#include "i2c.h"
+#include "i2c_extra.h"
+#include "sim_bus.h"
+#include "sim_models.h"
+#include "ad7124.h"
+#include "ad7124_regs.h"
+#include "adxl372.h"
+#include "axi_dmac.h"
+#include "ad9361.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define BENCH_ITERATIONS	1000
+#define DDR_BASEADDR		0x00800000
+#define DDR_SIZE		0x00100000
+#define RX_DMA_BASEADDR		0x7C400000
+#define RX_DMA_SIZE		0x10000
+#define RX_DMA_BYTES		0x10000
+#define ADXL372_FIFO_SETS	32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct bench_op
+ * @brief Driver operation measured by the benchmark.
+ */
+struct bench_op {
+	/** Name printed in the report */
+	const char	*name;
+	/** Runs the operation once */
+	int32_t		(*run)(void);
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+static struct ad7124_dev *ad7124;
+static struct adxl372_dev *adxl372_spi;
+static struct adxl372_dev *adxl372_i2c;
+static struct ad9361_rf_phy *ad9361;
+static struct axi_dmac *rx_dmac;
+
+static int16_t fir_coef[128];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+static int32_t bench_ad7124_read_reg(void)
+{
+	return ad7124_read_register(ad7124, &ad7124_regs[AD7124_ID]);
+}
+
+static int32_t bench_ad7124_write_reg(void)
+{
+	return ad7124_write_register(ad7124, ad7124_regs[AD7124_Channel_0]);
+}
+
+static int32_t bench_ad7124_conversion(void)
+{
+	int32_t sample;
+	int32_t ret;
+
+	ret = ad7124_wait_for_conv_ready(ad7124, 25000);
+	if (ret < 0)
+		return ret;
+
+	return ad7124_read_data(ad7124, &sample);
+}
+
+static int32_t bench_adxl372_accel(struct adxl372_dev *dev)
+{
+	struct adxl372_xyz_accel_data data;
+
+	return adxl372_get_accel_data(dev, &data);
+}
+
+static int32_t bench_adxl372_spi_accel(void)
+{
+	return bench_adxl372_accel(adxl372_spi);
+}
+
+static int32_t bench_adxl372_i2c_accel(void)
+{
+	return bench_adxl372_accel(adxl372_i2c);
+}
+
+static int32_t bench_adxl372_fifo(struct adxl372_dev *dev)
+{
+	struct adxl372_xyz_accel_data data[ADXL372_FIFO_SETS];
+	uint8_t status1, status2;
+	uint16_t entries;
+	int32_t ret;
+
+	/* Wait for the FIFO to hold the sets to read, plus one */
+	do {
+		ret = adxl372_get_status(dev, &status1, &status2, &entries);
+		if (ret < 0)
+			return ret;
+	} while (entries < (ADXL372_FIFO_SETS + 1) * 3);
+
+	return adxl372_get_fifo_xyz_data(dev, data, ADXL372_FIFO_SETS * 3);
+}
+
+static int32_t bench_adxl372_spi_fifo(void)
+{
+	return bench_adxl372_fifo(adxl372_spi);
+}
+
+static int32_t bench_adxl372_i2c_fifo(void)
+{
+	return bench_adxl372_fifo(adxl372_i2c);
+}
+
+static int32_t bench_ad9361_read_reg(void)
+{
+	return ad9361_spi_read(ad9361->spi, REG_PRODUCT_ID);
+}
+
+static int32_t bench_ad9361_write_reg(void)
+{
+	return ad9361_spi_write(ad9361->spi, REG_TX_FILTER_COEF_ADDR, 0x5A);
+}
+
+static int32_t bench_ad9361_get_temp(void)
+{
+	return ad9361_get_temp(ad9361);
+}
+
+static int32_t bench_ad9361_load_fir(void)
+{
+	return ad9361_load_fir_filter_coef(ad9361, FIR_TX1_TX2, 0, 128,
+					   fir_coef);
+}
+
+static int32_t bench_axi_dmac_transfer(void)
+{
+	return axi_dmac_transfer(rx_dmac, DDR_BASEADDR, RX_DMA_BYTES);
+}
+
+/**
+ * @brief Run an operation and print the transactions and the simulated time
+ * it takes on average.
+ * @param op - The operation.
+ * @param iterations - Number of runs.
+ * @return SUCCESS in case of success, the operation error code otherwise.
+ */
+static int32_t bench_run(const struct bench_op *op, uint32_t iterations)
+{
+	struct sim_counters c;
+	uint64_t start;
+	uint32_t i;
+	int32_t ret;
+
+	sim_reset_counters();
+	start = sim_get_time_ns();
+	for (i = 0; i < iterations; i++) {
+		ret = op->run();
+		if (ret < 0) {
+			printf("%-28s failed: %"PRIi32"\n", op->name, ret);
+			return ret;
+		}
+	}
+	sim_get_counters(&c);
+
+	printf("%-28s %10.1f %10.1f %12.3f %12.3f %6"PRIu32"\n", op->name,
+	       (double)c.transactions / iterations,
+	       (double)c.bytes / iterations,
+	       (double)c.bus_ns / iterations / 1000,
+	       (double)(sim_get_time_ns() - start) / iterations / 1000,
+	       c.errors);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Check that the DMA buffer holds the built-in ramp.
+ * @return SUCCESS if the data is correct, FAILURE otherwise.
+ */
+static int32_t bench_check_dma_data(void)
+{
+	uint16_t *buf;
+	uint32_t i;
+
+	buf = sim_mem_ptr(DDR_BASEADDR, RX_DMA_BYTES);
+	if (!buf)
+		return FAILURE;
+
+	for (i = 1; i < RX_DMA_BYTES / 2; i++)
+		if ((uint16_t)(buf[i] - buf[i - 1]) != 1)
+			return FAILURE;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Benchmark main function.
+ * @param argc - Number of arguments.
+ * @param argv - The optional argument is the number of runs per operation.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int main(int argc, char **argv)
+{
+	struct sim_model *ad7124_model, *adxl372_spi_model, *adxl372_i2c_model;
+	struct sim_model *ad9361_model, *dmac_model;
+	struct sim_timing timing;
+	uint32_t iterations = BENCH_ITERATIONS;
+	uint32_t i;
+	int32_t ret;
+
+	const struct bench_op ops[] = {
+		{"ad7124_read_register", bench_ad7124_read_reg},
+		{"ad7124_write_register", bench_ad7124_write_reg},
+		{"ad7124_conversion", bench_ad7124_conversion},
+		{"adxl372_spi_get_accel_data", bench_adxl372_spi_accel},
+		{"adxl372_spi_fifo_32", bench_adxl372_spi_fifo},
+		{"adxl372_i2c_get_accel_data", bench_adxl372_i2c_accel},
+		{"adxl372_i2c_fifo_32", bench_adxl372_i2c_fifo},
+		{"ad9361_spi_read", bench_ad9361_read_reg},
+		{"ad9361_spi_write", bench_ad9361_write_reg},
+		{"ad9361_get_temp", bench_ad9361_get_temp},
+		{"ad9361_load_fir_128", bench_ad9361_load_fir},
+		{"axi_dmac_transfer_64k", bench_axi_dmac_transfer},
+	};
+
+	struct sim_model_init_param ad7124_model_param = {
+		.name = "ad7124",
+		.ops = &sim_ad7124_ops,
+	};
+	struct sim_model_init_param adxl372_model_param = {
+		.name = "adxl372",
+		.ops = &sim_adxl372_ops,
+	};
+	struct sim_model_init_param ad9361_model_param = {
+		.name = "ad9361",
+		.ops = &sim_ad9361_ops,
+	};
+	struct sim_axi_dmac_init_param dmac_param = {
+		.mem_to_dev = false,
+		/* 2 channels of I/Q 16-bit samples at 30.72 MSPS */
+		.bytes_per_sec = 245760000,
+	};
+	struct sim_model_init_param dmac_model_param = {
+		.name = "rx_dmac",
+		.ops = &sim_axi_dmac_ops,
+		.extra = &dmac_param,
+	};
+
+	struct sim_spi_init_param ad7124_sim_spi = { 0 };
+	struct spi_init_param ad7124_spi = {
+		.max_speed_hz = 5000000,
+		.chip_select = 0,
+		.mode = SPI_MODE_3,
+		.platform_ops = &sim_platform_ops,
+		.extra = &ad7124_sim_spi,
+	};
+	struct ad7124_init_param ad7124_param = {
+		.spi_init = &ad7124_spi,
+		.regs = ad7124_regs,
+		.spi_rdy_poll_cnt = 25000,
+	};
+
+	struct sim_spi_init_param adxl372_sim_spi = { 0 };
+	struct sim_i2c_init_param adxl372_sim_i2c = { 0 };
+	struct adxl372_init_param adxl372_param = {
+		.spi_init = {
+			.max_speed_hz = 10000000,
+			.chip_select = 1,
+			.mode = SPI_MODE_0,
+			.platform_ops = &sim_platform_ops,
+			.extra = &adxl372_sim_spi,
+		},
+		.i2c_init = {
+			.max_speed_hz = 400000,
+			.slave_address = 0x53,
+			.extra = &adxl372_sim_i2c,
+		},
+		.gpio_int1 = { .number = 0 },
+		.gpio_int2 = { .number = 1 },
+		.bw = ADXL372_BW_3200HZ,
+		.odr = ADXL372_ODR_6400HZ,
+		.wur = ADXL372_WUR_52ms,
+		.act_proc_mode = ADXL372_LOOPED,
+		.th_mode = ADXL372_INSTANT_ON_LOW_TH,
+		.filter_settle = ADXL372_FILTER_SETTLE_16,
+		.fifo_config = {
+			.fifo_mode = ADXL372_FIFO_STREAMED,
+			.fifo_format = ADXL372_XYZ_FIFO,
+			.fifo_samples = 128,
+		},
+		.op_mode = ADXL372_FULL_BW_MEASUREMENT,
+	};
+
+	struct sim_spi_init_param ad9361_sim_spi = { 0 };
+	struct spi_init_param ad9361_spi = {
+		.max_speed_hz = 10000000,
+		.chip_select = 2,
+		.mode = SPI_MODE_1,
+		.platform_ops = &sim_platform_ops,
+		.extra = &ad9361_sim_spi,
+	};
+
+	struct axi_dmac_init rx_dmac_param = {
+		.name = "rx_dmac",
+		.base = RX_DMA_BASEADDR,
+		.direction = DMA_DEV_TO_MEM,
+		.flags = 0,
+	};
+
+	if (argc > 1)
+		iterations = strtoul(argv[1], NULL, 0);
+	if (!iterations)
+		return -EINVAL;
+
+	ret = sim_mem_init(DDR_BASEADDR, DDR_SIZE);
+	if (ret != SUCCESS)
+		return ret;
+
+	ret = sim_model_init(&ad7124_model, &ad7124_model_param);
+	ret |= sim_model_init(&adxl372_spi_model, &adxl372_model_param);
+	ret |= sim_model_init(&adxl372_i2c_model, &adxl372_model_param);
+	ret |= sim_model_init(&ad9361_model, &ad9361_model_param);
+	ret |= sim_model_init(&dmac_model, &dmac_model_param);
+	if (ret != SUCCESS)
+		return ret;
+
+	ad7124_sim_spi.model = ad7124_model;
+	adxl372_sim_spi.model = adxl372_spi_model;
+	adxl372_sim_i2c.model = adxl372_i2c_model;
+	ad9361_sim_spi.model = ad9361_model;
+	ret = sim_axi_attach(RX_DMA_BASEADDR, RX_DMA_SIZE, dmac_model);
+	if (ret != SUCCESS)
+		return ret;
+
+	ret = ad7124_setup(&ad7124, &ad7124_param);
+	if (ret != SUCCESS) {
+		printf("ad7124_setup() failed: %"PRIi32"\n", ret);
+		return ret;
+	}
+
+	adxl372_param.comm_type = SPI;
+	ret = adxl372_init(&adxl372_spi, adxl372_param);
+	if (ret != SUCCESS) {
+		printf("adxl372_init() over SPI failed: %"PRIi32"\n", ret);
+		return ret;
+	}
+
+	adxl372_param.comm_type = I2C;
+	ret = adxl372_init(&adxl372_i2c, adxl372_param);
+	if (ret != SUCCESS) {
+		printf("adxl372_init() over I2C failed: %"PRIi32"\n", ret);
+		return ret;
+	}
+
+	ad9361 = calloc(1, sizeof(*ad9361));
+	if (!ad9361)
+		return -ENOMEM;
+	ret = spi_init(&ad9361->spi, &ad9361_spi);
+	if (ret != SUCCESS)
+		return ret;
+	for (i = 0; i < 128; i++)
+		fir_coef[i] = i * 64 - 4096;
+
+	ret = axi_dmac_init(&rx_dmac, &rx_dmac_param);
+	if (ret != SUCCESS)
+		return ret;
+
+	sim_get_timing(&timing);
+	printf("SPI CS %"PRIu32" ns, I2C overhead %"PRIu32" ns, "
+	       "AXI access %"PRIu32" ns, %"PRIu32" runs per operation\n\n",
+	       timing.spi_cs_ns, timing.i2c_overhead_ns, timing.axi_access_ns,
+	       iterations);
+	printf("%-28s %10s %10s %12s %12s %6s\n", "operation", "xfers/op",
+	       "bytes/op", "bus us/op", "total us/op", "errors");
+
+	for (i = 0; i < ARRAY_SIZE(ops); i++) {
+		ret = bench_run(&ops[i], iterations);
+		if (ret != SUCCESS)
+			return ret;
+	}
+
+	if (bench_check_dma_data() != SUCCESS) {
+		printf("DMA data check failed\n");
+		return FAILURE;
+	}
+
+	ad7124_remove(ad7124);
+	spi_remove(ad9361->spi);
+	free(ad9361);
+	axi_dmac_remove(rx_dmac);
+	sim_model_remove(ad7124_model);
+	sim_model_remove(adxl372_spi_model);
+	sim_model_remove(adxl372_i2c_model);
+	sim_model_remove(ad9361_model);
+	sim_model_remove(dmac_model);
+	sim_mem_remove();
+
+	return SUCCESS;
+}
@@ -0,0 +1,58 @@
+################################################################################
+#									       #
+#     Shared variables:							       #
+#	- PROJECT							       #
+#	- DRIVERS							       #
+#	- INCLUDE							       #
+#	- PLATFORM_DRIVERS						       #
+#	- NO-OS								       #
+#									       #
+################################################################################
+
+SRCS := $(PROJECT)/src/main.c						\
+	$(PROJECT)/src/test_ad9081_hal.c				\
+	$(PROJECT)/src/test_recorder.c
+SRCS += $(DRIVERS)/adc/ad9081/api/adi_ad9081_hal.c
+SRCS += $(NO-OS)/libraries/fatfs/source/ff.c				\
+	$(NO-OS)/libraries/fatfs/source/ffsystem.c			\
+	$(NO-OS)/libraries/fatfs/source/ffunicode.c			\
+	$(NO-OS)/libraries/fatfs/adi_diskio.c				\
+	$(NO-OS)/libraries/fatfs/adi_recorder.c				\
+	$(DRIVERS)/sd-card/sd.c						\
+	$(DRIVERS)/spi/spi.c						\
+	$(NO-OS)/util/util.c
+SRCS +=	$(PLATFORM_DRIVERS)/sim_bus.c					\
+	$(PLATFORM_DRIVERS)/sim_spi.c					\
+	$(PLATFORM_DRIVERS)/delay.c
+INCS := $(PROJECT)/src/sim_tests.h
+INCS += $(DRIVERS)/adc/ad9081/api/adi_ad9081.h				\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_hal.h			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_config.h			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_ad9081.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_impala_tc.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_jrxa_des.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_jtx_dual_link.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_jtx_qbf_ad9081.h	\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_lcpll_28nm.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_main.h			\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_nb_coarse_nco.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_nb_ddc_dformat.h	\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_nb_fine_nco.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_rx_paging.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_ser_phy.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_spi_only_up.h		\
+	$(DRIVERS)/adc/ad9081/api/adi_cms_api_common.h			\
+	$(DRIVERS)/adc/ad9081/api/adi_cms_api_config.h
+INCS +=	$(INCLUDE)/error.h						\
+	$(INCLUDE)/util.h
+INCS += $(NO-OS)/libraries/fatfs/source/ff.h				\
+	$(NO-OS)/libraries/fatfs/source/ffconf.h			\
+	$(NO-OS)/libraries/fatfs/source/diskio.h			\
+	$(NO-OS)/libraries/fatfs/adi_diskio.h				\
+	$(NO-OS)/libraries/fatfs/adi_recorder.h				\
+	$(DRIVERS)/sd-card/sd.h						\
+	$(INCLUDE)/spi.h						\
+	$(INCLUDE)/bus_stats.h						\
+	$(INCLUDE)/delay.h
+INCS +=	$(PLATFORM_DRIVERS)/sim_bus.h					\
+	$(PLATFORM_DRIVERS)/spi_extra.h
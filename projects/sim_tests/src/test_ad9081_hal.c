@@ -0,0 +1,172 @@
+/***************************************************************************//**
+ *   @file   test_ad9081_hal.c
+ *   @brief  Tests of the AD9081 HAL bit-field accesses.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "adi_ad9081_hal.h"
+#include "sim_tests.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bit-field info: offset in bits 7:0, width in bits 15:8 */
+#define BF_INFO(offset, width)	(((width) << 8) | (offset))
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/* Direct register space of the emulated device */
+static uint8_t regs[0x4000];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Emulate the direct space SPI accesses, streaming like CONFIG_A selects */
+static int32_t test_spi_xfer(void *user_data, uint8_t *in_data,
+			     uint8_t *out_data, uint32_t size_bytes)
+{
+	uint16_t addr = ((in_data[0] & 0x3F) << 8) | in_data[1];
+	uint32_t len = size_bytes & 0xFFFF;
+	int32_t step = ((regs[0] & 0x24) == 0x24) ? 1 : -1;
+	uint32_t i;
+
+	for (i = 2; i < len; i++) {
+		if (in_data[0] & 0x80)
+			out_data[i] = regs[addr & 0x3FFF];
+		else
+			regs[addr & 0x3FFF] = in_data[i];
+		addr += step;
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+/* Set a field and check it reads back and the other bits are kept */
+static void test_field(adi_ad9081_device_t *device, uint16_t reg,
+		       uint8_t offset, uint8_t width, uint64_t value)
+{
+	uint8_t before[8], after[8], mask[8] = { 0 };
+	uint64_t field = 0, expected = value;
+	uint32_t i;
+
+	/* Bits of the registers that belong to the field */
+	for (i = offset; i < (uint32_t)offset + width; i++)
+		mask[i / 8] |= 1 << (i % 8);
+
+	memcpy(before, &regs[reg], sizeof(before));
+	TEST_CHECK(adi_ad9081_hal_bf_set(device, reg, BF_INFO(offset, width),
+					 value) == API_CMS_ERROR_OK);
+	memcpy(after, &regs[reg], sizeof(after));
+
+	for (i = 0; i < 8; i++)
+		TEST_CHECK((after[i] & ~mask[i]) == (before[i] & ~mask[i]));
+
+	TEST_CHECK(adi_ad9081_hal_bf_get(device, reg, BF_INFO(offset, width),
+					 (uint8_t *)&field,
+					 sizeof(field)) == API_CMS_ERROR_OK);
+	if (width < 64)
+		expected &= ((uint64_t)1 << width) - 1;
+	TEST_CHECK(field == expected);
+}
+
+/**
+ * @brief Check bit-field writes, in particular fields that are not aligned
+ * and span several registers, alone and inside a transaction.
+ */
+void test_ad9081_hal(void)
+{
+	static adi_ad9081_hal_cache_t cache;
+	adi_ad9081_device_t device;
+
+	memset(&device, 0, sizeof(device));
+	device.hal_info.spi_xfer = test_spi_xfer;
+	memset(regs, 0, sizeof(regs));
+
+	/* Field at bit 4 of 0x100, 8 bits wide: 0x100[7:4] and 0x101[3:0] */
+	regs[0x100] = 0xA5;
+	regs[0x101] = 0x5A;
+	TEST_CHECK(adi_ad9081_hal_bf_set(&device, 0x100, BF_INFO(4, 8),
+					 0xC3) == API_CMS_ERROR_OK);
+	TEST_CHECK(regs[0x100] == 0x35);
+	TEST_CHECK(regs[0x101] == 0x5C);
+
+	/* Field over three registers, the bits around it are all set */
+	memset(&regs[0x200], 0xFF, 3);
+	TEST_CHECK(adi_ad9081_hal_bf_set(&device, 0x200, BF_INFO(3, 14),
+					 0) == API_CMS_ERROR_OK);
+	TEST_CHECK(regs[0x200] == 0x07);
+	TEST_CHECK(regs[0x201] == 0x00);
+	TEST_CHECK(regs[0x202] == 0xFE);
+
+	test_field(&device, 0x300, 1, 7, 0x55);
+	test_field(&device, 0x310, 7, 2, 0x3);
+	test_field(&device, 0x320, 5, 21, 0x12345);
+	test_field(&device, 0x330, 2, 40, 0x5A5A5A5A5AULL);
+
+	/* Same fields in a transaction, streaming with ascending addresses */
+	TEST_CHECK(adi_ad9081_hal_cache_set(&device, &cache) ==
+		   API_CMS_ERROR_OK);
+	TEST_CHECK(adi_ad9081_hal_reg_set(&device, 0x000, 0x3C) ==
+		   API_CMS_ERROR_OK);
+	regs[0x400] = 0xA5;
+	regs[0x401] = 0x5A;
+	memset(&regs[0x402], 0xFF, 3);
+	TEST_CHECK(adi_ad9081_hal_bf_txn_begin(&device) == API_CMS_ERROR_OK);
+	TEST_CHECK(adi_ad9081_hal_bf_set(&device, 0x400, BF_INFO(4, 8),
+					 0xC3) == API_CMS_ERROR_OK);
+	TEST_CHECK(adi_ad9081_hal_bf_set(&device, 0x402, BF_INFO(3, 14),
+					 0) == API_CMS_ERROR_OK);
+	/* Nothing is written before the commit */
+	TEST_CHECK(regs[0x400] == 0xA5);
+	TEST_CHECK(adi_ad9081_hal_bf_txn_commit(&device) == API_CMS_ERROR_OK);
+	TEST_CHECK(regs[0x400] == 0x35);
+	TEST_CHECK(regs[0x401] == 0x5C);
+	TEST_CHECK(regs[0x402] == 0x07);
+	TEST_CHECK(regs[0x403] == 0x00);
+	TEST_CHECK(regs[0x404] == 0xFE);
+
+	test_field(&device, 0x500, 6, 11, 0x7FF);
+	TEST_CHECK(adi_ad9081_hal_cache_set(&device, NULL) ==
+		   API_CMS_ERROR_OK);
+}
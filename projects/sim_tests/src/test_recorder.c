@@ -0,0 +1,256 @@
+/***************************************************************************//**
+ *   @file   test_recorder.c
+ *   @brief  Tests of the capture to storage recorder on a RAM disk.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "ff.h"
+#include "adi_diskio.h"
+#include "adi_recorder.h"
+#include "error.h"
+#include "sim_tests.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define SECTOR_SIZE		512u
+/* FAT12 volume with one sector per cluster */
+#define DISK_SECTORS		2048u
+#define FAT_SECTORS		6u
+#define ROOT_ENTRIES		512u
+
+#define REC_PATH		"1:REC.BIN"
+#define REC_BUFFER_SIZE		1024u
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/* Needed by the SD backend of adi_diskio.c, not used here */
+struct sd_desc *sd_desc;
+
+static uint8_t disk[DISK_SECTORS * SECTOR_SIZE];
+static FATFS fs;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Fixed timestamp for the directory entries */
+DWORD get_fattime(void)
+{
+	return ((DWORD)(2020 - 1980) << 25) | (1 << 21) | (1 << 16);
+}
+
+static void put_le16(uint8_t *buf, uint16_t val)
+{
+	buf[0] = val & 0xFF;
+	buf[1] = val >> 8;
+}
+
+static uint64_t get_le(const uint8_t *buf, uint8_t bytes)
+{
+	uint64_t val = 0;
+
+	while (bytes--)
+		val = (val << 8) | buf[bytes];
+
+	return val;
+}
+
+/* Format the RAM disk as an empty FAT12 volume, FF_USE_MKFS is off */
+static void format_disk(void)
+{
+	uint8_t *bs = disk;
+	uint8_t *fat = disk + SECTOR_SIZE;
+
+	memset(disk, 0, sizeof(disk));
+	memcpy(bs, "\xEB\x3C\x90" "MSDOS5.0", 11);
+	put_le16(bs + 11, SECTOR_SIZE);
+	bs[13] = 1;				/* Sectors per cluster */
+	put_le16(bs + 14, 1);			/* Reserved sectors */
+	bs[16] = 1;				/* Number of FATs */
+	put_le16(bs + 17, ROOT_ENTRIES);
+	put_le16(bs + 19, DISK_SECTORS);
+	bs[21] = 0xF8;				/* Media */
+	put_le16(bs + 22, FAT_SECTORS);
+	put_le16(bs + 24, 32);			/* Sectors per track */
+	put_le16(bs + 26, 2);			/* Heads */
+	bs[36] = 0x80;				/* Drive number */
+	bs[38] = 0x29;				/* Extended boot signature */
+	memcpy(bs + 43, "NO NAME    FAT12   ", 19);
+	bs[510] = 0x55;
+	bs[511] = 0xAA;
+
+	fat[0] = 0xF8;
+	fat[1] = 0xFF;
+	fat[2] = 0xFF;
+}
+
+/* Test pattern, byte i of the recording */
+static uint8_t pattern(uint32_t i)
+{
+	return (i * 7 + 3) & 0xFF;
+}
+
+static void fill_pattern(uint8_t *buff, uint32_t start, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		buff[i] = pattern(start + i);
+}
+
+/* Read back the recording and check its header and data */
+static void check_recording(uint64_t data_bytes, uint64_t dropped_bytes,
+			    uint32_t drop_events)
+{
+	uint8_t header[RECORDER_HEADER_SIZE];
+	uint8_t data[64];
+	uint32_t offset, errors;
+	FIL file;
+	UINT i, br;
+
+	TEST_CHECK(f_open(&file, REC_PATH, FA_READ) == FR_OK);
+	TEST_CHECK(f_size(&file) == RECORDER_HEADER_SIZE + data_bytes);
+	TEST_CHECK(f_read(&file, header, sizeof(header), &br) == FR_OK &&
+		   br == sizeof(header));
+	TEST_CHECK(!memcmp(header, RECORDER_MAGIC, 8));
+	TEST_CHECK(get_le(header + 24, 8) == data_bytes);
+	TEST_CHECK(get_le(header + 32, 8) == dropped_bytes);
+	TEST_CHECK(get_le(header + 40, 4) == drop_events);
+
+	/* The pushed and captured data must be contiguous, without padding */
+	errors = 0;
+	offset = 0;
+	do {
+		if (f_read(&file, data, sizeof(data), &br) != FR_OK)
+			break;
+		for (i = 0; i < br; i++)
+			if (data[i] != pattern(offset + i))
+				errors++;
+		offset += br;
+	} while (br);
+	TEST_CHECK(offset == data_bytes);
+	TEST_CHECK(errors == 0);
+	TEST_CHECK(f_close(&file) == FR_OK);
+}
+
+/* Interleave pushed data with data captured in place */
+static void test_mixed(void)
+{
+	struct recorder_init_param param = {
+		.path = REC_PATH,
+		.max_size = 16 * REC_BUFFER_SIZE,
+		.buffer_size = REC_BUFFER_SIZE,
+		.sample_rate = 1000,
+	};
+	struct recorder_desc *rec;
+	uint8_t src[1500];
+	uint8_t *buff;
+	uint32_t len, pos;
+
+	pos = 0;
+	TEST_CHECK(recorder_init(&rec, &param) == SUCCESS);
+
+	fill_pattern(src, pos, 100);
+	TEST_CHECK(recorder_push(rec, src, 100) == SUCCESS);
+	pos += 100;
+
+	/* The free space follows the pushed bytes */
+	TEST_CHECK(recorder_get_buffer(rec, &buff, &len) == SUCCESS);
+	TEST_CHECK(len == REC_BUFFER_SIZE - 100);
+	fill_pattern(buff, pos, len);
+	TEST_CHECK(recorder_commit(rec, len) == SUCCESS);
+	pos += len;
+
+	fill_pattern(src, pos, sizeof(src));
+	TEST_CHECK(recorder_push(rec, src, sizeof(src)) == SUCCESS);
+	pos += sizeof(src);
+
+	/* A partial capture is kept in the buffer, not padded */
+	TEST_CHECK(recorder_get_buffer(rec, &buff, &len) == SUCCESS);
+	fill_pattern(buff, pos, 10);
+	TEST_CHECK(recorder_commit(rec, 10) == SUCCESS);
+	pos += 10;
+
+	fill_pattern(src, pos, 20);
+	TEST_CHECK(recorder_push(rec, src, 20) == SUCCESS);
+	pos += 20;
+
+	TEST_CHECK(recorder_stop(rec) == SUCCESS);
+	check_recording(pos, 0, 0);
+}
+
+/* Data that does not fit in the preallocated file is dropped and counted */
+static void test_full(void)
+{
+	struct recorder_init_param param = {
+		.path = REC_PATH,
+		.max_size = REC_BUFFER_SIZE,
+		.buffer_size = REC_BUFFER_SIZE,
+	};
+	struct recorder_desc *rec;
+	uint8_t src[3000];
+
+	TEST_CHECK(recorder_init(&rec, &param) == SUCCESS);
+	fill_pattern(src, 0, sizeof(src));
+	TEST_CHECK(recorder_push(rec, src, sizeof(src)) == SUCCESS);
+	TEST_CHECK(recorder_stop(rec) == SUCCESS);
+	check_recording(REC_BUFFER_SIZE, sizeof(src) - REC_BUFFER_SIZE, 2);
+}
+
+/**
+ * @brief Check the recorder writes the data contiguously on a RAM disk with
+ * the blocking write path, and counts what does not fit.
+ */
+void test_recorder(void)
+{
+	format_disk();
+	TEST_CHECK(diskio_ram_attach(disk, DISK_SECTORS) == SUCCESS);
+	TEST_CHECK(f_mount(&fs, "1:", 1) == FR_OK);
+
+	test_mixed();
+	test_full();
+
+	TEST_CHECK(f_mount(NULL, "1:", 0) == FR_OK);
+	TEST_CHECK(diskio_ram_detach() == SUCCESS);
+}
@@ -249,10 +249,17 @@ CFLAGS		+= -D_USE_STD_INT_TYPES
 
 CLEAN_IIO	= $(MAKE) -C $(IIO_DIR) clean
 $(IIO_LIB):
-	$(MAKE) -C $(IIO_DIR)
+	$(MAKE) -C $(IIO_DIR) BUS_STATS=$(BUS_STATS)
 
 endif
 
+#	BUS STATISTICS
+ifeq (y,$(strip $(BUS_STATS)))
+CFLAGS		+= -DBUS_STATS
+SRCS		+= $(NO-OS)/util/bus_stats.c
+INCS		+= $(INCLUDE)/bus_stats.h
+endif
+
 LIB_FLAGS = $(addprefix -l,$(subst lib,,$(basename $(LIBS))))
 LIB_DIR_FLAGS = $(addprefix -L,$(LIBS_DIRS))
 LIB_TARGETS = $(MBEDTLS_TARGETS) $(FATFS_LIB) $(MQTT_LIB) $(IIO_LIB)
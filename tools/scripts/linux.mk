@@ -43,6 +43,13 @@ ifndef SRCS
 include $(PROJECTS_DIR)/$(TARGET)/src.mk
 endif
 
+#------------------------------------------------------------------------------
+#                               RUN ARGUMENTS
+#------------------------------------------------------------------------------
+# Iteration count passed to the executable by "make run" on the sim platform,
+# e.g. make run ITER=100 for sim_benchmark. Empty for the program default.
+ITER ?=
+
 #------------------------------------------------------------------------------
 #                               VERBOSE LEVEL                                  
 #------------------------------------------------------------------------------
@@ -111,6 +118,12 @@ TINYIIOD_STD_TYPES = _USE_STD_INT_TYPES
 CFLAGS += -D $(TINYIIOD_STD_TYPES)
 endif
 
+ifeq (y,$(strip $(BUS_STATS)))
+CFLAGS += -D BUS_STATS
+SRCS += $(NO-OS)/util/bus_stats.c
+INCS += $(INCLUDE)/bus_stats.h
+endif
+
 ifeq (y,$(strip $(MBEDTLS)))
 #Specify configuration file to build mbedtls
 CFLAGS += -I $(NO-OS)/network/transport -D MBEDTLS_CONFIG_FILE='"noos_mbedtls_config.h"'
@@ -267,6 +280,31 @@ STAMP +=   --thread_model hal						\
 	   --stdout_dev sys_uart					\
 	   --sopc_system_name system_bd					\
 	   --sopcinfo $(HARDWARE)
+else
+########|----------------------------------------------------------------------
+########|                         SIMULATION                                   
+########|----------------------------------------------------------------------
+ifeq (sim,$(strip $(PLATFORM)))
+
+# The simulation platform runs on the build host, the device register maps
+# are modeled in software and there is no hardware file, bsp or linker script.
+# LINUX_PLATFORM enables the host only code, like the FatFs file drive.
+CFLAGS += -D SIM_PLATFORM						\
+	  -D LINUX_PLATFORM						\
+	  -O2								\
+	  -g
+
+CC := gcc
+
+LD := $(CC)
+
+LSCRIPT :=
+
+LIBS := -lm
+
+LDFLAGS := $(LIBS)
+
+endif
 endif
 endif
 
@@ -283,7 +321,7 @@ OBJS = $(SRCS:.c=.o)
 	-o $(addprefix $(OBJECTS_DIR)/,$(notdir $@))
 
 # Link the resulted object files
-$(EXEC): $(subst LOCAL_PLATFORM,xilinx,$(OBJS))				\
+$(EXEC): $(subst LOCAL_PLATFORM,$(PLATFORM),$(OBJS))			\
 		$(LSCRIPT)
 	$(call print,[LD] $(shell ls $(OBJECTS_DIR)) \n)
 	$(MUTE)$(LD) $(LDFLAGS) $(LIB_PATHS) 				\
@@ -307,6 +345,8 @@ bsp:
 		$(MAKE) -s xilinx-bsp;					\
 	elif [ "$(PLATFORM)" = "altera" ];then				\
 		$(MAKE) -s altera-bsp;					\
+	elif [ "$(PLATFORM)" = "sim" ];then				\
+		true;							\
 	else								\
 		$(call print_err,Can't generate the bsp\n);		\
 		exit 1;							\
@@ -354,6 +394,7 @@ clean:
 # Check for .hdf files inside the project directory
 .SILENT:eval-hardware
 eval-hardware:	
+ifneq (sim,$(strip $(PLATFORM)))
 ifndef HARDWARE
 	$(eval HARDWARE = $(shell					\
 	if [ -z $(HARDWARE) ]; then					\
@@ -388,6 +429,10 @@ endif
 		$(call print_err,Platform not found\n)			\
 		exit 1;							\
 	fi;
+else
+	mkdir -p $(TEMP_DIR)
+	echo host > $(TEMP_DIR)/arch.txt
+endif
 
 .SILENT:altera-bsp
 altera-bsp:
@@ -422,6 +467,8 @@ post-build:
 	@ if [ "$(PLATFORM)" = "xilinx" ];then				\
 		rm -rf \.Xil;						\
 		rm -rf \.metadata;					\
+	elif [ "$(PLATFORM)" = "sim" ];then				\
+		true;							\
 	else								\
 		$(MAKE) -s altera-elf;					\
 		mv -f sw.map $(TEMP_DIR);				\
@@ -440,6 +487,8 @@ run: eval-hardware
 		nios2-configure-sof *.sof;				\
 		nios2-download -r -g $(BUILD_DIR)/$(EXEC).elf;		\
 		nios2-terminal;						\
+	elif [ "$(PLATFORM)" = "sim" ];then				\
+		$(BUILD_DIR)/$(EXEC).elf $(ITER);			\
 	elif [ "$(PLATFORM)" = "none" ]; then				\
 		$(call print_err,Platform not found\n)			\
 		exit 1;							\
@@ -118,6 +118,12 @@ LIB_TINYIIOD_PATH = ""
 LIB_TINYIIOD = ""
 TINYIIOD_STD_TYPES = ""
 
+ifeq (y,$(strip $(BUS_STATS)))
+CFLAGS += -D BUS_STATS
+SRCS += $(NO-OS)/util/bus_stats.c
+INCS += $(INCLUDE)/bus_stats.h
+endif
+
 #------------------------------------------------------------------------------
 #                            COMMON LINKER FLAGS                               
 #------------------------------------------------------------------------------
@@ -0,0 +1,256 @@
+/***************************************************************************//**
+ *   @file   bus_stats.c
+ *   @brief  Bus transaction statistics.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "bus_stats.h"
+#include "timer.h"
+#include "error.h"
+#include "util.h"
+
+/* Compiled only in the builds with the statistics enabled */
+#ifdef BUS_STATS
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum number of AXI base addresses with statistics */
+#define BUS_STATS_AXI_MAX	16
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/** Timer used to measure the latencies */
+static struct timer_desc	*stats_timer;
+/** Registered statistics */
+static struct bus_stats		*stats_list;
+/** Statistics of the AXI base addresses */
+static struct bus_stats		axi_stats[BUS_STATS_AXI_MAX];
+/** Number of used axi_stats entries */
+static uint32_t			axi_stats_nb;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Set the timer used to measure the latencies.
+ *
+ * The latencies are 0 until a timer is set. The timer is only read with
+ * timer_get_time_ns(), which uses the fastest monotonic clock of the platform.
+ * @param timer - Timer descriptor, NULL to stop measuring the latencies.
+ */
+void bus_stats_init(struct timer_desc *timer)
+{
+	stats_timer = timer;
+}
+
+/**
+ * @brief Clear the statistics and add them to the list shown by
+ * bus_stats_dump().
+ * @param stats - Statistics to register.
+ * @param name - Name of the bus.
+ * @param id - Identifier of the device on the bus.
+ */
+void bus_stats_register(struct bus_stats *stats, const char *name,
+			uint32_t id)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->name = name;
+	stats->id = id;
+	stats->next = stats_list;
+	stats_list = stats;
+}
+
+/**
+ * @brief Remove the statistics from the list shown by bus_stats_dump().
+ * @param stats - Statistics to remove.
+ */
+void bus_stats_unregister(struct bus_stats *stats)
+{
+	struct bus_stats **it;
+
+	for (it = &stats_list; *it; it = &(*it)->next)
+		if (*it == stats) {
+			*it = stats->next;
+			break;
+		}
+}
+
+/**
+ * @brief Get the timestamp of the start of a transaction.
+ * @return Timestamp in ns, 0 if no timer is set.
+ */
+uint64_t bus_stats_start(void)
+{
+	uint64_t ns;
+
+	if (!stats_timer || timer_get_time_ns(stats_timer, &ns) != SUCCESS)
+		return 0;
+
+	return ns;
+}
+
+/**
+ * @brief Record a transaction.
+ * @param stats - Statistics of the bus descriptor. May be NULL.
+ * @param start - Value returned by bus_stats_start() before the transaction.
+ * @param bytes - Number of bytes transferred.
+ * @param error - Set if the transaction failed.
+ */
+void bus_stats_end(struct bus_stats *stats, uint64_t start, uint32_t bytes,
+		   bool error)
+{
+	uint64_t	latency;
+	uint32_t	bucket;
+
+	if (!stats)
+		return;
+
+	latency = start ? bus_stats_start() - start : 0;
+	latency = min_t(uint64_t, latency, UINT32_MAX);
+
+	stats->count++;
+	if (error)
+		stats->errors++;
+	else
+		stats->bytes += bytes;
+	stats->total_ns += latency;
+	stats->max_ns = max_t(uint32_t, stats->max_ns, latency);
+
+	bucket = latency ? log_base_2(latency) : 0;
+	stats->hist[min_t(uint32_t, bucket, BUS_STATS_BUCKETS - 1)]++;
+}
+
+/**
+ * @brief Get the statistics of an AXI base address.
+ *
+ * The statistics are registered at the first access to the base address.
+ * @param base - Base address.
+ * @return The statistics, NULL if there are too many base addresses.
+ */
+struct bus_stats *bus_stats_axi(uint32_t base)
+{
+	uint32_t i;
+
+	for (i = 0; i < axi_stats_nb; i++)
+		if (axi_stats[i].id == base)
+			return &axi_stats[i];
+
+	if (axi_stats_nb == BUS_STATS_AXI_MAX)
+		return NULL;
+
+	bus_stats_register(&axi_stats[axi_stats_nb], "axi_io", base);
+
+	return &axi_stats[axi_stats_nb++];
+}
+
+/**
+ * @brief Clear all the registered statistics.
+ */
+void bus_stats_reset(void)
+{
+	struct bus_stats *stats;
+
+	for (stats = stats_list; stats; stats = stats->next) {
+		stats->count = 0;
+		stats->errors = 0;
+		stats->bytes = 0;
+		stats->total_ns = 0;
+		stats->max_ns = 0;
+		memset(stats->hist, 0, sizeof(stats->hist));
+	}
+}
+
+/**
+ * @brief Print all the registered statistics, one line per bus descriptor.
+ *
+ * The line has the number of transactions, failed transactions and bytes, the
+ * average and highest latencies, followed by the non empty histogram buckets
+ * as log2(ns):count.
+ * @param buf - Buffer where the text is written.
+ * @param len - Size of the buffer. The text is truncated if it is too small.
+ * @return Length of the text, without the truncated part.
+ */
+int32_t bus_stats_dump(char *buf, uint32_t len)
+{
+	struct bus_stats	*stats;
+	uint32_t		avg_ns;
+	uint32_t		i;
+	int32_t			n;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	n = 0;
+	buf[0] = '\0';
+	for (stats = stats_list; stats; stats = stats->next) {
+		avg_ns = stats->count ?
+			 div_u64(stats->total_ns, stats->count) : 0;
+		n += snprintf(buf + n, len - n, "%s[0x%lx]: n=%lu err=%lu "
+			      "bytes=%llu avg_ns=%lu max_ns=%lu hist=",
+			      stats->name, (unsigned long)stats->id,
+			      (unsigned long)stats->count,
+			      (unsigned long)stats->errors,
+			      (unsigned long long)stats->bytes,
+			      (unsigned long)avg_ns,
+			      (unsigned long)stats->max_ns);
+		if (n >= (int32_t)len)
+			break;
+
+		for (i = 0; i < BUS_STATS_BUCKETS && n < (int32_t)len; i++)
+			if (stats->hist[i])
+				n += snprintf(buf + n, len - n, "%lu:%lu ",
+					      (unsigned long)i,
+					      (unsigned long)stats->hist[i]);
+		if (n < (int32_t)len)
+			n += snprintf(buf + n, len - n, "\n");
+		if (n >= (int32_t)len)
+			break;
+	}
+
+	return min_t(int32_t, n, len - 1);
+}
+
+#endif /* BUS_STATS */